@@ -0,0 +1,201 @@
+#include "DedicatedServer.h"
+#include "Networking/Packet/PacketRegistry.h"
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Parses the dedicated server's command line.
+ * @param argc Argument count, as passed to main.
+ * @param argv Arguments, as passed to main.
+ * @param error Set to a description of the first invalid argument, if any.
+ * @return The settings, or nothing if --help was given or an argument is invalid.
+ */
+std::optional<DedicatedServerConfig> DedicatedServerConfig::parse(int argc, char** argv, std::string& error) {
+	DedicatedServerConfig config;
+	error.clear();
+
+	for (int i = 1; i < argc; i++) {
+		std::string option = argv[i];
+		if (option == "--help" || option == "-h") {
+			return std::nullopt;
+		}
+
+		if (i + 1 >= argc) {
+			error = "Missing value for " + option;
+			return std::nullopt;
+		}
+		std::string value = argv[++i];
+
+		// Reads value as a whole number in [min, max]
+		auto read_number = [&](int& out, int min, int max) {
+			try {
+				size_t used = 0;
+				int number = std::stoi(value, &used);
+				if (used == value.size() && number >= min && number <= max) {
+					out = number;
+					return true;
+				}
+			}
+			catch (const std::exception&) {}
+			error = "Invalid value for " + option + ": '" + value + "' (expected " + std::to_string(min) + " to " + std::to_string(max) + ")";
+			return false;
+		};
+
+		if (option == "--address") {
+			config.address = value;
+		}
+		else if (option == "--port") {
+			if (!read_number(config.port, 1, 65535)) return std::nullopt;
+		}
+		else if (option == "--name") {
+			config.lobby_name = value;
+		}
+		else if (option == "--max-players") {
+			if (!read_number(config.max_players, 1, 255)) return std::nullopt;
+		}
+		else if (option == "--min-players") {
+			if (!read_number(config.min_players, 1, 255)) return std::nullopt;
+		}
+		else if (option == "--room-size") {
+			if (!read_number(config.room_size, 1, 255)) return std::nullopt;
+		}
+		else if (option == "--tick-rate") {
+			if (!read_number(config.tick_rate, 1, 1000)) return std::nullopt;
+		}
+		else if (option == "--sim-threads") {
+			if (!read_number(config.simulation_threads, 0, 256)) return std::nullopt;
+		}
+		else {
+			error = "Unknown option " + option;
+			return std::nullopt;
+		}
+	}
+
+	if (config.min_players > config.room_size) {
+		error = "--min-players cannot be more than --room-size";
+		return std::nullopt;
+	}
+	if (config.room_size > config.max_players) {
+		error = "--room-size cannot be more than --max-players";
+		return std::nullopt;
+	}
+	return config;
+}
+
+/**
+ * @brief Gets the command line help text.
+ * @return The usage text, listing every option and its default.
+ */
+std::string DedicatedServerConfig::usage() {
+	DedicatedServerConfig defaults;
+	std::ostringstream oss;
+	oss << "Usage: echodungeon-server [options]\n"
+		<< "  --address <ip>       Address to bind to (default " << defaults.address << ")\n"
+		<< "  --port <port>        Port to bind to (default " << defaults.port << ")\n"
+		<< "  --name <name>        Lobby name shown to players (default \"" << defaults.lobby_name << "\")\n"
+		<< "  --max-players <n>    Most players connected at once, across every room (default " << defaults.max_players << ")\n"
+		<< "  --min-players <n>    Players needed before a room starts (default " << defaults.min_players << ")\n"
+		<< "  --room-size <n>      Most players in one room (default " << defaults.room_size << ")\n"
+		<< "  --tick-rate <hz>     World simulation ticks per second (default " << defaults.tick_rate << ")\n"
+		<< "  --sim-threads <n>    Threads ticking the rooms, 0 for one per hardware thread (default " << defaults.simulation_threads << ")\n"
+		<< "  --help               Show this help\n";
+	return oss.str();
+}
+
+/**
+ * @brief Initialises logging, ENet and the packet registry, and creates the server and the simulation threads.
+ * @param config The settings to run with.
+ */
+DedicatedServer::DedicatedServer(const DedicatedServerConfig& config) : config(config) {
+	Logger::init(); // Initialise logger first
+	if (enet_initialize() != 0) { // Initialise ENet
+		ERROR("Failed to initialize ENet");
+		throw std::runtime_error("Failed to initialize ENet");
+	}
+
+	server = std::make_shared<Server>(config.address, config.port);
+	server->server_info.lobby_name = config.lobby_name;
+	server->server_info.max_players = static_cast<uint8_t>(config.max_players);
+
+	simulations = std::make_unique<SimulationPool>(static_cast<size_t>(config.simulation_threads));
+	world_events = std::make_unique<ServerWorldEvents>(*server);
+}
+
+/**
+ * @brief Ends every room, destroys the server, then deinitialises ENet.
+ */
+DedicatedServer::~DedicatedServer() {
+	rooms.clear();
+	world_events.reset();
+	simulations.reset();
+	server = nullptr; // Disconnects everyone and stops the networking loop
+	enet_deinitialize();
+	TRACE("Dedicated server de-initialised");
+}
+
+/**
+ * @brief Runs the server until stop_requested is set, checking the lobby and rooms tick_rate times a second.
+ * @param stop_requested Set (eg from a signal handler) to shut the server down cleanly.
+ * @return The process exit code: 0 after a clean shutdown, 1 if the server could not be started.
+ */
+int DedicatedServer::run(const std::atomic<bool>& stop_requested) {
+	if (server->host == nullptr) {
+		ERROR("Server could not be created on " + config.address + ":" + std::to_string(config.port));
+		return 1;
+	}
+
+	server->start();
+	INFO("Dedicated server '" + config.lobby_name + "' running on " + config.address + ":" + std::to_string(config.port));
+
+	// Worlds tick on the simulation threads, this loop only runs deferred events and starts and ends rooms
+	const auto check_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(1.0 / config.tick_rate));
+	auto next_check = std::chrono::steady_clock::now();
+
+	while (!stop_requested.load()) {
+		EventDispatch::run_deferred(); // Run event callbacks deferred to this thread
+
+		update_rooms();
+
+		// Sleep until the next check, without trying to catch up on checks that were missed
+		next_check = (std::max)(next_check + check_interval, std::chrono::steady_clock::now());
+		std::this_thread::sleep_until(next_check);
+	}
+
+	INFO("Dedicated server shutting down");
+	rooms.clear();
+	server->stop().get();
+	return 0;
+}
+
+/**
+ * @brief Starts a room for each group of players waiting in the lobby, and ends the rooms every player has left.
+ * Groups are filled up to room_size, and a room only starts once at least min_players are waiting.
+ */
+void DedicatedServer::update_rooms() {
+	for (auto it = rooms.begin(); it != rooms.end(); ) {
+		if (it->second->player_count() == 0) {
+			it = rooms.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	// Players who have waited longest go first
+	std::vector<PeerEntry> lobby = server->peers.get_room_peers(DEFAULT_ROOM);
+	std::sort(lobby.begin(), lobby.end(), [](const PeerEntry& a, const PeerEntry& b) {
+		return a.data.connected_at < b.data.connected_at;
+	});
+
+	size_t next_player = 0;
+	while (lobby.size() - next_player >= static_cast<size_t>(config.min_players)) {
+		size_t count = (std::min)(lobby.size() - next_player, static_cast<size_t>(config.room_size));
+		std::vector<PeerEntry> players(lobby.begin() + next_player, lobby.begin() + next_player + count);
+		next_player += count;
+
+		RoomId id = next_room_id++;
+		rooms.emplace(id, std::make_unique<Room>(id, server, *world_events, *simulations, config.tick_rate, players));
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Server/Server.h"
+#include "Game/World/Systems/ServerWorldEvents.h"
+#include "Game/World/Systems/SimulationPool.h"
+#include "Game/Room.h"
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+// Settings of a dedicated server, read from its command line
+struct DedicatedServerConfig {
+	std::string address = "0.0.0.0"; // Address to bind to
+	int port = NetworkConstants::DEFAULT_PORT; // Port to bind to
+	std::string lobby_name = "Dedicated Server"; // Lobby name shown to players
+	int max_players = 64; // Most players connected at once, across every room
+	int min_players = 1; // Players needed in the lobby before a room starts
+	int room_size = 8; // Most players in one room
+	int tick_rate = 60; // World simulation ticks per second
+	int simulation_threads = 0; // Threads ticking the rooms' worlds, 0 for one per hardware thread
+
+	// Parse the command line. Empty with an empty error for --help, empty with the error if an argument is invalid.
+	static std::optional<DedicatedServerConfig> parse(int argc, char** argv, std::string& error);
+	static std::string usage(); // Command line help text
+};
+
+/**
+ * @brief Runs a Server and the game rooms its players play in, with no window, graphics context or ImGui.
+ *
+ * Players wait in the lobby until min_players have joined, then up to room_size of them move into
+ * a new Room, which plays a game the way a hosting client does. Any number of rooms run at once,
+ * their worlds ticked by one SimulationPool, and a room ends once every player in it has left.
+ * run() keeps serving until it is asked to stop (eg by SIGTERM).
+ */
+class DedicatedServer {
+public:
+	DedicatedServer(const DedicatedServerConfig& config);
+	~DedicatedServer();
+
+	int run(const std::atomic<bool>& stop_requested); // Serve until stop_requested is set, returns the exit code
+
+private:
+	DedicatedServerConfig config; // Settings from the command line
+	std::shared_ptr<Server> server; // The server players connect to
+	std::unique_ptr<SimulationPool> simulations; // Ticks every room's world
+	std::unique_ptr<ServerWorldEvents> world_events; // Routes the server's packets to the world of the sender's room
+	std::unordered_map<RoomId, std::unique_ptr<Room>> rooms; // Rooms being played
+	RoomId next_room_id = DEFAULT_ROOM + 1; // Never reused, so a room's ID only ever tags its own players
+
+	void update_rooms(); // Start rooms for the players waiting in the lobby, end rooms everyone has left
+};
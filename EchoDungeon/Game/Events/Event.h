@@ -1,6 +1,13 @@
 #pragma once
 #include "Imports/common.h"
-#include <future>
+#include "Game/Events/EventDispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 /*
 * @brief Base class for all event data. Event data is returned to callbacks when an event is triggered.
@@ -12,6 +19,12 @@ public:
 
 /*
 * @brief Template class for managing events with specific event data types.
+* Callbacks are kept in an immutable list that register/unregister replace as a whole
+* (copy on write), so trigger only takes an atomic snapshot of the current list and loops over it.
+* Each trigger (and each deferred or pooled call) counts itself in flight while it runs callbacks,
+* and unregister_callback waits for those to finish, so once it returns the callback is never called again
+* and whatever it captured can be destroyed. The exception is unregistering from inside a callback of the
+* same event: waiting would wait on itself, so triggers on other threads may still call it.
 * @tparam EventData The type of data associated with the event, must derive from BaseEventData.
 */
 template <typename EventData>
@@ -21,14 +34,29 @@ public:
 	using Callback = std::function<void(const EventData&)>; // Data returned to callbacks
 	using CallbackID = int; // Unique identifier for each registered callback to allow unregistering
 
+	struct CallbackEntry {
+		CallbackID id;
+		Callback callback;
+	};
+	using CallbackList = std::vector<CallbackEntry>; // Registered callbacks, in registration order
+
 	/*
 	* @brief Register a callback for the event.
 	* @param callback The callback to register.
-	* @return A unique identifier for the registered callback.
+	* @return A unique identifier for the registered callback, or -1 if the callback is empty.
 	*/
 	static CallbackID register_callback(Callback callback) {
+		if (!callback) {
+			ERROR("Cannot register an empty callback.");
+			return -1;
+		}
+
+		std::lock_guard<std::mutex> lock(writer_mutex);
 		CallbackID callback_id = next_callback_id++;
-		callbacks[callback_id] = callback;
+
+		auto updated = std::make_shared<CallbackList>(*callbacks.load(std::memory_order_acquire));
+		updated->push_back({ callback_id, std::move(callback) });
+		callbacks.store(std::move(updated), std::memory_order_release);
 		return callback_id;
 	}
 
@@ -38,41 +66,156 @@ public:
 	* @return True if the callback is registered, false otherwise.
 	*/
 	static bool is_callback_registered(CallbackID callback_id) {
-		return callbacks.find(callback_id) != callbacks.end();
+		std::shared_ptr<const CallbackList> current = callbacks.load();
+		return std::any_of(current->begin(), current->end(),
+			[callback_id](const CallbackEntry& entry) { return entry.id == callback_id; });
 	}
 
 	/*
 	* @brief Remove a callback from the event, so it is no longer triggered.
+	* Waits for triggers already running on other threads, so the callback is not running and will not run
+	* once this returns. Safe to call from any thread, including from inside a callback of this event,
+	* in which case it does not wait (see the class comment).
 	* @param callback_id The unique identifier of the callback to remove.
 	*/
 	static void unregister_callback(CallbackID callback_id) {
-		auto it = callbacks.find(callback_id);
-		if (it != callbacks.end()) {
-			callbacks.erase(it);
+		{
+			std::lock_guard<std::mutex> lock(writer_mutex);
+
+			std::shared_ptr<const CallbackList> current = callbacks.load();
+			auto it = std::find_if(current->begin(), current->end(),
+				[callback_id](const CallbackEntry& entry) { return entry.id == callback_id; });
+			if (it == current->end()) return;
+
+			auto updated = std::make_shared<CallbackList>();
+			updated->reserve(current->size() - 1);
+			updated->insert(updated->end(), current->begin(), it);
+			updated->insert(updated->end(), std::next(it), current->end());
+			callbacks.store(std::move(updated));
+		}
+
+		// Not under writer_mutex, so callbacks being waited for can still (un)register callbacks
+		if (trigger_depth == 0) wait_for_triggers();
+	}
+
+	/*
+	* @brief Set how trigger runs this event's callbacks.
+	* Event data holding references (eg to an ENetEvent on the triggering thread's stack) cannot
+	* outlive trigger, so such events stay INLINE. Data that declares OWNS_DATA keeps what it
+	* refers to alive itself (eg a pooled packet handle) and may be deferred.
+	* @param policy The dispatch policy to use from now on.
+	*/
+	static void set_dispatch_policy(DispatchPolicy policy) {
+		if (policy != DispatchPolicy::INLINE && !outlives_trigger()) {
+			ERROR("Event data holds references, it can only be dispatched inline.");
+			return;
 		}
+		dispatch_policy = policy;
 	}
 
 	/*
-	* @brief Trigger an event with the given data, calling all registered callbacks asynchronously.
+	* @brief Get how trigger runs this event's callbacks.
+	* @return The current dispatch policy.
+	*/
+	static DispatchPolicy get_dispatch_policy() {
+		return dispatch_policy;
+	}
+
+	/*
+	* @brief Trigger an event with the given data, running all registered callbacks according to the dispatch policy.
 	* @param data The event data to attach
 	*/
 	static void trigger(const EventData& data) {
-		auto callbacks_copy = callbacks; // or just: auto callbacks_copy = callbacks;
+		InFlight in_flight;
 
-		for (const auto& [id, callback] : callbacks_copy) {
-			if (callback) {
-				std::async(std::launch::async, callback, data);
-			}
-			else {
-				ERROR("Invalid callback with id " + std::to_string(id) + " found.");
-				callbacks.erase(id); // Remove invalid callback if it is null
+		// The snapshot stays valid while callbacks (un)register callbacks
+		std::shared_ptr<const CallbackList> current = callbacks.load();
+		if (current->empty()) return;
+
+		// Deferred and pooled calls outlive data, so they share one copy of it
+		std::shared_ptr<const EventData> shared_data;
+		if (dispatch_policy != DispatchPolicy::INLINE) {
+			shared_data = std::make_shared<const EventData>(data);
+		}
+
+		for (const CallbackEntry& entry : *current) {
+			const Callback& callback = entry.callback;
+			switch (dispatch_policy) {
+			case DispatchPolicy::INLINE:
+				EventDispatch::invoke([&callback, &data]() { callback(data); });
+				break;
+			case DispatchPolicy::DEFERRED:
+				EventDispatch::defer([id = entry.id, callback, shared_data]() { call_if_registered(id, callback, *shared_data); });
+				break;
+			case DispatchPolicy::POOL:
+				EventDispatch::submit([id = entry.id, callback, shared_data]() { call_if_registered(id, callback, *shared_data); });
+				break;
 			}
 		}
+	}
 
+	// Whether a copy of the event data stays valid after trigger returns
+	static constexpr bool outlives_trigger() {
+		if constexpr (requires { EventData::OWNS_DATA; }) return EventData::OWNS_DATA;
+		else return std::is_copy_assignable<EventData>::value;
 	}
 
 	static CallbackID next_callback_id; // Next available callback ID (incremented on each registration)
-	static std::unordered_map<CallbackID, Callback> callbacks; // Map of registered callbacks
+	static std::atomic<std::shared_ptr<const CallbackList>> callbacks; // Current list of registered callbacks, never null
+	static std::mutex writer_mutex; // Serialises register/unregister, trigger never takes it
+	static DispatchPolicy dispatch_policy; // How trigger runs the callbacks
+
+private:
+	/*
+	* @brief Counts a trigger (or a deferred/pooled call) in flight for as long as it is in scope.
+	* It is counted before the callback list is loaded, so a trigger that loaded a list still holding
+	* an unregistered callback is always seen by that unregister's wait_for_triggers.
+	*/
+	class InFlight {
+	public:
+		InFlight() : counter(triggers_in_flight[trigger_epoch.load() & 1]) {
+			counter.fetch_add(1);
+			trigger_depth++;
+		}
+		~InFlight() {
+			trigger_depth--;
+			counter.fetch_sub(1);
+		}
+		InFlight(const InFlight&) = delete;
+		InFlight& operator=(const InFlight&) = delete;
+
+	private:
+		std::atomic<size_t>& counter;
+	};
+
+	/*
+	* @brief Run a deferred or pooled call, unless its callback was unregistered after it was queued.
+	* @param callback_id The unique identifier of the callback.
+	* @param callback The callback to run.
+	* @param data The event data to pass it.
+	*/
+	static void call_if_registered(CallbackID callback_id, const Callback& callback, const EventData& data) {
+		InFlight in_flight;
+		if (is_callback_registered(callback_id)) callback(data);
+	}
+
+	/*
+	* @brief Wait until every trigger that was in flight when this was called has finished.
+	* Triggers count themselves under the parity of trigger_epoch. Each counter is seen at zero after
+	* flipping the epoch away from it, so new triggers cannot keep it busy.
+	*/
+	static void wait_for_triggers() {
+		for (uint64_t parity = 0; parity < 2; parity++) {
+			uint64_t epoch = trigger_epoch.load();
+			if ((epoch & 1) == parity) trigger_epoch.compare_exchange_strong(epoch, epoch + 1);
+
+			while (triggers_in_flight[parity].load() != 0) std::this_thread::yield();
+		}
+	}
+
+	static std::atomic<uint64_t> trigger_epoch; // Its parity picks the in-flight counter new triggers use
+	static std::atomic<size_t> triggers_in_flight[2]; // Triggers running, per epoch parity
+	static thread_local int trigger_depth; // Triggers of this event running on this thread
 };
 
 
@@ -81,4 +224,20 @@ template <typename EventData>
 typename Event<EventData>::CallbackID Event<EventData>::next_callback_id = 0;
 
 template <typename EventData>
-std::unordered_map<typename Event<EventData>::CallbackID, typename Event<EventData>::Callback> Event<EventData>::callbacks;
\ No newline at end of file
+std::atomic<std::shared_ptr<const typename Event<EventData>::CallbackList>> Event<EventData>::callbacks{
+	std::make_shared<const typename Event<EventData>::CallbackList>() };
+
+template <typename EventData>
+std::mutex Event<EventData>::writer_mutex;
+
+template <typename EventData>
+DispatchPolicy Event<EventData>::dispatch_policy = DispatchPolicy::INLINE;
+
+template <typename EventData>
+std::atomic<uint64_t> Event<EventData>::trigger_epoch{ 0 };
+
+template <typename EventData>
+std::atomic<size_t> Event<EventData>::triggers_in_flight[2]{};
+
+template <typename EventData>
+thread_local int Event<EventData>::trigger_depth = 0;
@@ -0,0 +1,47 @@
+#include "EventDispatch.h"
+#include <thread>
+
+/*
+* @brief Queues a call to run on the main thread during the next run_deferred().
+* @param call The call to queue.
+*/
+void EventDispatch::defer(Call call) {
+	deferred_calls().push(std::move(call));
+}
+
+/*
+* @brief Runs every deferred call in the order they were queued.
+* Must only be called from the main thread, which owns the deferred queue.
+* @return The number of calls run.
+*/
+size_t EventDispatch::run_deferred() {
+	size_t count = 0;
+	Call call;
+	while (deferred_calls().pop(call)) {
+		invoke(call);
+		count++;
+	}
+	return count;
+}
+
+/*
+* @brief Runs a call on the shared worker pool.
+* @param call The call to run.
+*/
+void EventDispatch::submit(Call call) {
+	pool().submit([call = std::move(call)]() { invoke(call); });
+}
+
+MpscQueue<EventDispatch::Call>& EventDispatch::deferred_calls() {
+	static MpscQueue<Call> calls;
+	return calls;
+}
+
+ThreadPool& EventDispatch::pool() {
+	// Started on first use, leaving one core for the thread that triggers events
+	static ThreadPool workers([]() {
+		unsigned int cores = std::thread::hardware_concurrency();
+		return cores > 1 ? cores - 1 : 1;
+	}());
+	return workers;
+}
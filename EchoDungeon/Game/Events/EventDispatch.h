@@ -0,0 +1,41 @@
+#pragma once
+#include "Imports/common.h"
+#include "Utils/MpscQueue.h"
+#include "Utils/ThreadPool.h"
+#include <functional>
+
+/*
+* @brief How Event<EventData>::trigger runs the registered callbacks, set per event type.
+*/
+enum class DispatchPolicy : uint8_t {
+	INLINE,   // Call every callback on the triggering thread before trigger returns (default)
+	DEFERRED, // Queue the calls for the main thread, which runs them in EventDispatch::run_deferred()
+	POOL      // Hand each call to the shared worker pool, trigger returns straight away
+};
+
+/*
+* @brief Shared machinery behind the DEFERRED and POOL dispatch policies.
+*/
+class EventDispatch {
+public:
+	using Call = std::function<void()>;
+
+	static void defer(Call call); // Queue a call for run_deferred() (any thread)
+	static size_t run_deferred(); // Run every deferred call (main thread, once per frame)
+	static void submit(Call call); // Run a call on the worker pool (any thread)
+
+	// Run a call, logging instead of propagating exceptions. A template so inline dispatch never allocates.
+	template <typename Function>
+	static void invoke(const Function& call) {
+		try {
+			call();
+		}
+		catch (const std::exception& e) {
+			ERROR(std::string("Event callback threw an exception: ") + e.what());
+		}
+	}
+
+private:
+	static MpscQueue<Call>& deferred_calls();
+	static ThreadPool& pool();
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include "Game/Events/Event.h"
+#include "Networking/Packet/PacketTypes.h"
+#include "Networking/Packet/PacketPool.h"
 #include "Networking/Packet/Instances/ConnectionInitiation.h"
 #include "Networking/Packet/Instances/ConnectionRefusal.h"
 #include "Networking/Packet/Instances/ConnectionConfirmation.h"
@@ -22,25 +24,44 @@
 #include "Networking/Packet/Instances/Player/PlayerAttack.h"
 #include "Networking/Packet/Instances/Item/ItemPickup.h"
 #include "Networking/Packet/Instances/Item/ItemDiscard.h"
+#include "Networking/Packet/Instances/SnapshotAck.h"
 
+// Packet event data shares the pooled packet it was decoded into (see PacketPool), copying
+// the data (eg for a deferred dispatch) only copies the handle, never the packet.
 #define SERVER_PACKET_EVENT_DECLARATION(BaseName) \
     class BaseName##EventData : public BaseEventData { \
     public: \
-        BaseName##Packet packet; \
+        static constexpr bool OWNS_DATA = true; \
+        PacketPool<BaseName##Packet>::Handle handle; \
+        const BaseName##Packet& packet; \
         ENetPeer* peer; \
-        BaseName##EventData(const BaseName##Packet& p, ENetPeer* pr) \
-            : packet(p), peer(pr) {} \
+        BaseName##EventData(PacketPool<BaseName##Packet>::Handle h, ENetPeer* pr) \
+            : handle(std::move(h)), packet(*handle), peer(pr) {} \
     }; \
     using BaseName##Event = Event<BaseName##EventData>;
 
 #define CLIENT_PACKET_EVENT_DECLARATION(BaseName) \
     class BaseName##EventData : public BaseEventData { \
     public: \
-        BaseName##Packet packet; \
-        BaseName##EventData(const BaseName##Packet& p) : packet(p) {} \
+        static constexpr bool OWNS_DATA = true; \
+        PacketPool<BaseName##Packet>::Handle handle; \
+        const BaseName##Packet& packet; \
+        BaseName##EventData(PacketPool<BaseName##Packet>::Handle h) \
+            : handle(std::move(h)), packet(*handle) {} \
     }; \
     using BaseName##Event = Event<BaseName##EventData>;
 
+// Declare a packet's event on the side(s) its ECHO_PACKET_LIST direction reaches
+#define SERVER_EVENT_TO_SERVER(BaseName) SERVER_PACKET_EVENT_DECLARATION(BaseName)
+#define SERVER_EVENT_TO_CLIENT(BaseName)
+#define SERVER_EVENT_BOTH(BaseName) SERVER_PACKET_EVENT_DECLARATION(BaseName)
+#define CLIENT_EVENT_TO_SERVER(BaseName)
+#define CLIENT_EVENT_TO_CLIENT(BaseName) CLIENT_PACKET_EVENT_DECLARATION(BaseName)
+#define CLIENT_EVENT_BOTH(BaseName) CLIENT_PACKET_EVENT_DECLARATION(BaseName)
+
+#define SERVER_EVENT_FOR_PACKET(Id, BaseName, Direction, Delivery) SERVER_EVENT_##Direction(BaseName)
+#define CLIENT_EVENT_FOR_PACKET(Id, BaseName, Direction, Delivery) CLIENT_EVENT_##Direction(BaseName)
+
 
 // ============================================================================
 // SERVER-SIDE PACKET EVENTS
@@ -48,26 +69,8 @@
 // ============================================================================
 namespace ServerEvents {
 
-	// ConnectionInitiation Event (Packet ID: 1)
-    SERVER_PACKET_EVENT_DECLARATION(ConnectionInitiation)
-
-	// DisconnectionInfo Event (Packet ID: 4)
-    SERVER_PACKET_EVENT_DECLARATION(DisconnectInfo)
-
-	// GeneralInformationUpdate Event (Packet ID: 8)
-	SERVER_PACKET_EVENT_DECLARATION(GeneralInformationUpdate)
-
-	// PlayerInput Event (Packet ID: 9)
-	SERVER_PACKET_EVENT_DECLARATION(PlayerInput)
-
-    // RequestWorldSnapshot Event (Packet ID: 10)
-    SERVER_PACKET_EVENT_DECLARATION(RequestWorldSnapshot)
-
-    // PlayerAttack Event (Packet ID: 22)
-    SERVER_PACKET_EVENT_DECLARATION(PlayerAttack)
-
-    // ItemDiscard Event (Packet ID: 24)
-    SERVER_PACKET_EVENT_DECLARATION(ItemDiscard)
+	// One event per packet type received by the server, see ECHO_PACKET_LIST
+	ECHO_PACKET_LIST(SERVER_EVENT_FOR_PACKET)
 
     // Pure events
 
@@ -108,51 +111,8 @@ namespace ServerEvents {
 // ============================================================================
 namespace ClientEvents {
 
-	// ConnectionRefusal Event (Packet ID: 2)
-	CLIENT_PACKET_EVENT_DECLARATION(ConnectionRefusal)
-
-    // ConnectionConfirmation Event (Packet ID: 3)
-	CLIENT_PACKET_EVENT_DECLARATION(ConnectionConfirmation)
-
-	// DisconnectKick Event (Packet ID: 5)
-	CLIENT_PACKET_EVENT_DECLARATION(DisconnectKick)
-
-	// UserDataUpdate Event (Packet ID: 6)
-	CLIENT_PACKET_EVENT_DECLARATION(ServerDataUpdate)
-
-	// StateChange Event (Packet ID: 7)
-	CLIENT_PACKET_EVENT_DECLARATION(StateChange)
-
-	// WorldSnapshot Event (Packet ID: 11)
-	CLIENT_PACKET_EVENT_DECLARATION(WorldSnapshot)
-
-	// PlayerSpawn Event (Packet ID: 14)
-	CLIENT_PACKET_EVENT_DECLARATION(PlayerSpawn)
-
-	// PlayerUpdate Event (Packet ID: 15)
-	CLIENT_PACKET_EVENT_DECLARATION(PlayerUpdate)
-
-	// PlayerDestroy Event (Packet ID: 16)
-	CLIENT_PACKET_EVENT_DECLARATION(PlayerDestroy)
-
-	// EnemySpawn Event (Packet ID: 17)
-	CLIENT_PACKET_EVENT_DECLARATION(EnemySpawn)
-
-	// EnemyUpdate Event (Packet ID: 18)
-	CLIENT_PACKET_EVENT_DECLARATION(EnemyUpdate)
-
-	// EnemyDestroy Event (Packet ID: 19)
-	CLIENT_PACKET_EVENT_DECLARATION(EnemyDestroy)
-
-	// ObjectSpawn Event (Packet ID: 20)
-	CLIENT_PACKET_EVENT_DECLARATION(ObjectSpawn)
-
-	// ObjectDestroy Event (Packet ID: 21)
-	CLIENT_PACKET_EVENT_DECLARATION(ObjectDestroy)
-
-	// ItemPickup Event (Packet ID: 23)
-	CLIENT_PACKET_EVENT_DECLARATION(ItemPickup)
-
+	// One event per packet type received by the client, see ECHO_PACKET_LIST
+	ECHO_PACKET_LIST(CLIENT_EVENT_FOR_PACKET)
 
     // Pure events
 
@@ -18,7 +18,9 @@ Game::Game() : state_manager(GameStateManager()){
 	}
 	atexit(enet_deinitialize); // Ensure ENet deinitializes on exit
 
-	PacketRegistry::initializeRegistry(); // Initialize packet registry
+	// Events run their callbacks inline on the networking thread unless set here.
+	// State changes activate game states, which load assets, so they must run on the main thread.
+	ClientEvents::StateChangeEvent::set_dispatch_policy(DispatchPolicy::DEFERRED);
 
 
 	// Setup raylib window
@@ -75,6 +77,9 @@ void Game::update() {
 	// Update input manager
 	Input::update();
 
+	// Run event callbacks deferred to the main thread
+	EventDispatch::run_deferred();
+
 	// Draw
 	BeginDrawing(); // Tell Raylib we are going to draw
 
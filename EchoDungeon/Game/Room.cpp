@@ -0,0 +1,73 @@
+#include "Room.h"
+#include "Game/World/Systems/LevelGenerator.h"
+#include "Networking/Packet/Instances/StateChange.h"
+
+/**
+ * @brief Moves players into a new room, creates its world and starts their game.
+ * The world handles packets before the state change goes out, so no early snapshot request is lost.
+ * @param id The room's ID, unique for the server's lifetime.
+ * @param server The server the players are connected to.
+ * @param world_events Routes the server's packets to the world of each room.
+ * @param simulations The pool to tick the room's world on.
+ * @param tick_rate Simulation ticks per second.
+ * @param players The peers to play in the room.
+ */
+Room::Room(RoomId id, std::shared_ptr<Server> server, ServerWorldEvents& world_events, SimulationPool& simulations,
+	int tick_rate, const std::vector<PeerEntry>& players)
+	: id(id), server(server), world_events(world_events), simulations(simulations) {
+	for (const PeerEntry& player : players) {
+		server->peers.set_room(player.data.server_side_id, id);
+	}
+
+	world = std::make_unique<ServerWorldManager>(server, id);
+	world->set_tick_rate(tick_rate);
+	world_events.attach(id, *world);
+
+	for (const PeerEntry& player : players) {
+		world->add_player(player.data.server_side_id, player.data.username);
+	}
+	LevelGenerator::generate_level(*world);
+
+	simulation = simulations.add(tick_rate, [world = world.get()]() { world->update(); });
+
+	// Clients request their world snapshot once they have switched state
+	auto packet = StateChangePacket("World");
+	for (const PeerEntry& player : players) {
+		server->send_packet(packet, player.data.server_side_id);
+	}
+
+	INFO("Room " + std::to_string(id) + " started with " + std::to_string(players.size()) + " players");
+}
+
+/**
+ * @brief Stops ticking the world, stops routing packets to it, then destroys it.
+ */
+Room::~Room() {
+	SimulationStats stats = simulations.get_stats(simulation);
+	simulations.remove(simulation);
+	world_events.detach(id);
+
+	world->log_system_stats();
+	world->clear();
+	world.reset();
+
+	INFO("Room " + std::to_string(id) + " ended after " + std::to_string(stats.ticks) + " ticks"
+		+ " (max " + std::to_string(stats.max_tick_ms) + "ms, overruns " + std::to_string(stats.overruns)
+		+ ", dropped " + std::to_string(stats.dropped_ticks) + ")");
+}
+
+/**
+ * @brief Counts the room's peers that are still connected.
+ * @return The number of peers in the room.
+ */
+size_t Room::player_count() const {
+	return server->peers.get_room_peers(id).size();
+}
+
+/**
+ * @brief Gets the timing of the room's ticks since it started.
+ * @return A copy of the room's simulation stats.
+ */
+SimulationStats Room::get_stats() const {
+	return simulations.get_stats(simulation);
+}
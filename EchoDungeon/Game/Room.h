@@ -0,0 +1,38 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Server/Server.h"
+#include "Game/World/Managers/ServerWorldManager.h"
+#include "Game/World/Systems/ServerWorldEvents.h"
+#include "Game/World/Systems/SimulationPool.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief One game on a dedicated server: its world, the peers playing it and its simulation.
+ *
+ * The peers in a room are the server's peers tagged with its RoomId, so broadcasts from its world
+ * only reach them, and ServerWorldEvents routes only their packets to it. The world is ticked by
+ * a SimulationPool shared with every other room, never on more than one thread at a time.
+ * Creating a room moves its players out of the lobby and into the game; destroying it ends the game.
+ */
+class Room {
+public:
+	Room(RoomId id, std::shared_ptr<Server> server, ServerWorldEvents& world_events, SimulationPool& simulations,
+		int tick_rate, const std::vector<PeerEntry>& players);
+	~Room(); // Stops the simulation and destroys the world
+
+	Room(const Room&) = delete;
+	Room& operator=(const Room&) = delete;
+
+	RoomId get_id() const { return id; }
+	size_t player_count() const; // Peers still connected in the room
+	SimulationStats get_stats() const; // Timing of the room's ticks
+
+private:
+	RoomId id;
+	std::shared_ptr<Server> server; // Server the room's peers are connected to
+	ServerWorldEvents& world_events; // Routes the room's packets to world
+	SimulationPool& simulations; // Ticks world
+	std::unique_ptr<ServerWorldManager> world; // The room's game
+	SimulationPool::SimulationId simulation = 0; // world's place in simulations
+};
@@ -19,7 +19,8 @@ void World::on_activate() {
 	// Create ServerWorldManager (only if hosting)
 	if (game.is_hosting()) {
 		s_world_manager = std::make_unique<ServerWorldManager>(game.server);
-		setup_server_events();
+		server_world_events = std::make_unique<ServerWorldEvents>(*game.server);
+		server_world_events->attach(DEFAULT_ROOM, *s_world_manager);
 
 		TRACE("ServerWorldManager created");
 
@@ -33,6 +34,9 @@ void World::on_activate() {
 
 		// Broadcast initial world snapshot to all clients
 		s_world_manager->broadcast_world_snapshot();
+
+		// Tick the world on its own thread from now on, independent of the frame rate
+		s_world_manager->start_simulation(ServerWorldManager::DEFAULT_TICK_RATE);
 	}
 
 	// If not hosting, request world snapshot from server
@@ -89,32 +93,7 @@ void World::on_deactivate() {
 	}
 	
 	// Unsubscribe from server events (if hosting)
-	if (game.is_hosting()) {
-		if (server_player_input_sub != -1) {
-			ServerEvents::PlayerInputEvent::unregister_callback(server_player_input_sub);
-			server_player_input_sub = -1;
-		}
-		if (server_request_snapshot_sub != -1) {
-			ServerEvents::RequestWorldSnapshotEvent::unregister_callback(server_request_snapshot_sub);
-			server_request_snapshot_sub = -1;
-		}
-		if (server_player_attack_sub != -1) {
-			ServerEvents::PlayerAttackEvent::unregister_callback(server_player_attack_sub);
-			server_player_attack_sub = -1;
-		}
-		if (server_player_disconnect_sub != -1) {
-			ServerEvents::DisconnectEvent::unregister_callback(server_player_disconnect_sub);
-			server_player_disconnect_sub = -1;
-		}
-		if (server_player_disconnect_timeout_sub != -1) {
-			ServerEvents::DisconnectTimeoutEvent::unregister_callback(server_player_disconnect_timeout_sub);
-			server_player_disconnect_timeout_sub = -1;
-		}
-		if (server_item_discard_sub != -1) {
-			ServerEvents::ItemDiscardEvent::unregister_callback(server_item_discard_sub);
-			server_item_discard_sub = -1;
-		}
-	}
+	server_world_events.reset();
 	
 	// Clear and destroy ClientWorldManager
 	if (c_world_manager) {
@@ -125,6 +104,7 @@ void World::on_deactivate() {
 	
 	// Clear and destroy ServerWorldManager (if hosting)
 	if (s_world_manager) {
+		s_world_manager->stop_simulation();
 		s_world_manager->clear();
 		s_world_manager.reset();
 		s_world_manager = nullptr;
@@ -138,6 +118,11 @@ void World::update() {
 		TRACE("Quit flag set in world state, returning to main menu");
 		should_quit_to_mainmenu.store(false);
 
+		// Stop the simulation before the server it sends through
+		if (s_world_manager) {
+			s_world_manager->stop_simulation();
+		}
+
 		// Destroy server if it exists
 		if (game.server) {
 			game.server->stop().get();
@@ -161,11 +146,6 @@ void World::update() {
 		return;
 	}
 
-	// Update ServerWorldManager (if hosting)
-	if (game.is_hosting() && s_world_manager) {
-		s_world_manager->update(GetFrameTime());
-	}
-
 	if (c_world_manager->get_local_player() == nullptr) {
 		// The client has not received a server loading packet yet
 		DrawText("Loading world...", 10, 10, 20, BLACK);
@@ -211,12 +191,16 @@ void World::update() {
 }
 
 void World::setup_client_events() {
+	// Packets are applied by c_world_manager->update(), see InboundQueue
+
 	// WorldSnapshot - Receive full world state
 	client_world_snapshot_sub = ClientEvents::WorldSnapshotEvent::register_callback(
 		[this](const ClientEvents::WorldSnapshotEventData& data) {
 			if (c_world_manager) {
-				c_world_manager->apply_world_snapshot(data.packet);
-				TRACE("Applied world snapshot");
+				c_world_manager->get_inbound_queue().post([this, packet = data.handle]() {
+					c_world_manager->apply_world_snapshot(*packet);
+					TRACE("Applied world snapshot");
+				});
 			}
 		}
 	);
@@ -231,21 +215,23 @@ void World::setup_client_events() {
 				e.health = data.packet.health;
 				e.spawns_items = data.packet.spawns_items;
 
-				c_world_manager->add_enemy(e);
-				TRACE("Spawned enemy: ID=" + std::to_string(e.id));
+				c_world_manager->get_inbound_queue().post([this, e]() {
+					c_world_manager->add_enemy(e);
+					TRACE("Spawned enemy: ID=" + std::to_string(e.id));
+				});
 			}
 		}
 	);
 
-	// EnemyUpdate - Enemy updated in world
+	// EnemyUpdate - Enemy updated in world (droppable, the next update supersedes it)
 	client_enemy_update_sub = ClientEvents::EnemyUpdateEvent::register_callback(
 		[this](const ClientEvents::EnemyUpdateEventData& data) {
 			if (c_world_manager) {
-				for (const auto& update : data.packet.updates) {
-					c_world_manager->update_enemy(update.id, update.transform, update.health);
-					TRACE("Enemy updated: ID=" + std::to_string(update.id)
-						+ "transform pos=" + update.transform.get_position().ToString());
-				}
+				c_world_manager->get_inbound_queue().post([this, packet = data.handle]() {
+					c_world_manager->apply_enemy_updates(*packet);
+					TRACE("Enemy update applied: sequence=" + std::to_string(packet->sequence)
+						+ " changed=" + std::to_string(packet->updates.size()));
+				}, true);
 			}
 		}
 	);
@@ -254,8 +240,10 @@ void World::setup_client_events() {
 	client_enemy_destroy_sub = ClientEvents::EnemyDestroyEvent::register_callback(
 		[this](const ClientEvents::EnemyDestroyEventData& data) {
 			if (c_world_manager) {
-				c_world_manager->remove_enemy(data.packet.id);
-				TRACE("Enemy destroyed: ID=" + std::to_string(data.packet.id));
+				c_world_manager->get_inbound_queue().post([this, id = data.packet.id]() {
+					c_world_manager->remove_enemy(id);
+					TRACE("Enemy destroyed: ID=" + std::to_string(id));
+				});
 			}
 		}
 	);
@@ -268,8 +256,10 @@ void World::setup_client_events() {
 				o.transform = data.packet.transform;
 				o.color = data.packet.color;
 
-				c_world_manager->add_object(o);
-				TRACE("Spawned object: ID=" + std::to_string(o.id));
+				c_world_manager->get_inbound_queue().post([this, o]() {
+					c_world_manager->add_object(o);
+					TRACE("Spawned object: ID=" + std::to_string(o.id));
+				});
 			}
 		}
 	);
@@ -278,24 +268,23 @@ void World::setup_client_events() {
 	client_object_destroy_sub = ClientEvents::ObjectDestroyEvent::register_callback(
 		[this](const ClientEvents::ObjectDestroyEventData& data) {
 			if (c_world_manager) {
-				c_world_manager->remove_object(data.packet.id);
-				TRACE("Destroyed object: ID=" + std::to_string(data.packet.id));
+				c_world_manager->get_inbound_queue().post([this, id = data.packet.id]() {
+					c_world_manager->remove_object(id);
+					TRACE("Destroyed object: ID=" + std::to_string(id));
+				});
 			}
 		}
 	);
 	
-	// PlayerUpdate - New object spawned in world
+	// PlayerUpdate - Players updated in world (droppable, the next update supersedes it)
 	client_player_update_sub = ClientEvents::PlayerUpdateEvent::register_callback(
 		[this](const ClientEvents::PlayerUpdateEventData& data) {
 			if (c_world_manager) {
-				for (const auto& update : data.packet.updates) {
-					c_world_manager->update_player(update.id, update.transform, update.health,
-						update.damage, update.max_health, update.range, update.speed,
-						update.attack_cooldown, update.last_attack_time, update.attacking,
-						update.inventory
-					);
-					TRACE("Player updated: ID=" + std::to_string(update.id));
-				}
+				c_world_manager->get_inbound_queue().post([this, packet = data.handle]() {
+					c_world_manager->apply_player_updates(*packet);
+					TRACE("Player update applied: sequence=" + std::to_string(packet->sequence)
+						+ " changed=" + std::to_string(packet->updates.size()));
+				}, true);
 			}
 		}
 	);
@@ -304,8 +293,10 @@ void World::setup_client_events() {
 	client_player_destroy_sub = ClientEvents::PlayerDestroyEvent::register_callback(
 		[this](const ClientEvents::PlayerDestroyEventData& data) {
 			if (c_world_manager) {
-				c_world_manager->remove_player(data.packet.id);
-				TRACE("Player removed: ID=" + std::to_string(data.packet.id));
+				c_world_manager->get_inbound_queue().post([this, id = data.packet.id]() {
+					c_world_manager->remove_player(id);
+					TRACE("Player removed: ID=" + std::to_string(id));
+				});
 			}
 		}
 	);
@@ -324,8 +315,10 @@ void World::setup_client_events() {
 				p.range = data.packet.range;
 				p.last_attack_time = data.packet.last_attack_time;
 
-				c_world_manager->add_player(p);
-				TRACE("Player spawned: " + p.name + " ID=" + std::to_string(p.id));
+				c_world_manager->get_inbound_queue().post([this, p]() {
+					c_world_manager->add_player(p);
+					TRACE("Player spawned: " + p.name + " ID=" + std::to_string(p.id));
+				});
 			}
 		}
 	);
@@ -334,93 +327,10 @@ void World::setup_client_events() {
 	client_item_pickup_sub = ClientEvents::ItemPickupEvent::register_callback(
 		[this](const ClientEvents::ItemPickupEventData& data) {
 			if (c_world_manager) {
-				c_world_manager->handle_item_pickup(
-					data.packet.player_id,
-					data.packet.item
-				);
+				c_world_manager->get_inbound_queue().post([this, player_id = data.packet.player_id, item = data.packet.item]() {
+					c_world_manager->handle_item_pickup(player_id, item);
+				});
 			}
 		}
 	);
 }
-
-void World::setup_server_events() {
-	// PlayerInput - Client sends their movement/transform
-	server_player_input_sub = ServerEvents::PlayerInputEvent::register_callback(
-		[this](const ServerEvents::PlayerInputEventData& data) {
-			if (s_world_manager) {
-				auto peer_opt = game.server->peers.get_peer_by_enet(data.peer);
-				if (peer_opt.has_value()) {
-					uint16_t peer_id = peer_opt.value().data.server_side_id;
-					s_world_manager->handle_player_input(peer_id, data.packet.transform);
-				}
-			}
-		}
-	);
-	
-	// RequestWorldSnapshot - Client requests full world state
-	server_request_snapshot_sub = ServerEvents::RequestWorldSnapshotEvent::register_callback(
-		[this](const ServerEvents::RequestWorldSnapshotEventData& data) {
-			if (s_world_manager) {
-				// Send world snapshot to the requesting client only
-				s_world_manager->send_world_snapshot(data.peer);
-				TRACE("Sent world snapshot to peer");
-			}
-		}
-	);
-
-	// PlayerAttack - Client attacks
-	server_player_attack_sub = ServerEvents::PlayerAttackEvent::register_callback(
-		[this](const ServerEvents::PlayerAttackEventData& data) {
-			if (s_world_manager) {
-				auto peer_opt = game.server->peers.get_peer_by_enet(data.peer);
-				if (peer_opt.has_value()) {
-					uint16_t peer_id = peer_opt.value().data.server_side_id;
-					s_world_manager->handle_player_attack(peer_id);
-					TRACE("Player attacked: ID=" + std::to_string(peer_id));
-				}
-			}
-		}
-	);
-
-	// Player disconnect - Remove player from world
-	server_player_disconnect_sub = ServerEvents::DisconnectEvent::register_callback(
-		[this](const ServerEvents::DisconnectEventData& data) {
-			if (s_world_manager) {
-				auto peer_opt = game.server->peers.get_peer_by_enet(data.event.peer);
-				if (peer_opt.has_value()) {
-					uint16_t peer_id = peer_opt.value().data.server_side_id;
-					s_world_manager->remove_player(peer_id);
-					TRACE("Removed disconnected player: ID=" + std::to_string(peer_id));
-				}
-			}
-		}
-	);
-
-	// Player disconnect timeout - Remove player from world
-	server_player_disconnect_timeout_sub = ServerEvents::DisconnectTimeoutEvent::register_callback(
-		[this](const ServerEvents::DisconnectTimeoutEventData& data) {
-			if (s_world_manager) {
-				auto peer_opt = game.server->peers.get_peer_by_enet(data.event.peer);
-				if (peer_opt.has_value()) {
-					uint16_t peer_id = peer_opt.value().data.server_side_id;
-					s_world_manager->remove_player(peer_id);
-					TRACE("Removed timed-out player: ID=" + std::to_string(peer_id));
-				}
-			}
-		}
-	);
-	
-	// ItemDiscard - Player discards an item
-	server_item_discard_sub = ServerEvents::ItemDiscardEvent::register_callback(
-		[this](const ServerEvents::ItemDiscardEventData& data) {
-			if (s_world_manager) {
-				auto peer_opt = game.server->peers.get_peer_by_enet(data.peer);
-				if (!peer_opt.has_value()) return;
-				s_world_manager->handle_item_discard(
-					peer_opt.value().data.server_side_id,
-					data.packet.item_id
-				);
-			}
-		}
-	);
-}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Game/World/Entities/Player.h"
 #include "Game/World/Managers/ClientWorldManager.h"
 #include "Game/World/Managers/ServerWorldManager.h"
+#include "Game/World/Systems/ServerWorldEvents.h"
 
 class World : public GameState {
 public:
@@ -14,11 +15,11 @@ public:
 
 	std::unique_ptr<ClientWorldManager> c_world_manager; // Client-side world manager
 	std::unique_ptr<ServerWorldManager> s_world_manager; // Server-side world manager (only if hosting)
+	std::unique_ptr<ServerWorldEvents> server_world_events; // Feeds server packets to s_world_manager (only if hosting)
 
 private:
 	// Setup methods
 	void setup_client_events();
-	void setup_server_events();
 
 	// Client-side event subscription IDs
 	int client_world_snapshot_sub = -1;
@@ -32,13 +33,5 @@ private:
 	int client_object_destroy_sub = -1;
 	int client_item_pickup_sub = -1;
 
-	// Server-side event subscription IDs
-	int server_player_input_sub = -1;
-	int server_request_snapshot_sub = -1;
-	int server_player_attack_sub = -1;
-	int server_player_disconnect_sub = -1;
-	int server_player_disconnect_timeout_sub = -1;
-	int server_item_discard_sub = -1;
-
 	std::atomic<bool> should_quit_to_mainmenu = false;
 };
\ No newline at end of file
@@ -16,6 +16,9 @@ public:
 	bool has_item(uint32_t item_id) const;
 	const std::vector<uint32_t>& get_item_ids() const;
 
+	bool operator==(const Inventory& other) const { return item_ids == other.item_ids; }
+	bool operator!=(const Inventory& other) const { return item_ids != other.item_ids; }
+
 	template <typename Archive>
 	void serialize(Archive& archive) {
 		archive(item_ids);
@@ -2,6 +2,7 @@
 #include "Imports/common.h"
 #include "ObjectTransform.h"
 #include "Game/World/Assets/AssetMap.h"
+#include "Networking/Packet/BitPacketArchive.h"
 #include <variant>
 
 enum class ObjectType : uint8_t {
@@ -29,15 +30,13 @@ public:
 
    template <typename Archive>
    void save(Archive& archive) const {
-       uint8_t type_value = static_cast<uint8_t>(type);
-       archive(id, asset_id, type_value, transform, color);
+       ObjectType type_value = type;
+       archive(id, asset_id, make_ranged(type_value, ObjectType::MODEL, ObjectType::IMAGE_MODEL), transform, color);
    }
 
    template <typename Archive>
    void load(Archive& archive) {
-       uint8_t type_value;
-       archive(id, asset_id, type_value, transform, color);
-       type = static_cast<ObjectType>(type_value);
+       archive(id, asset_id, make_ranged(type, ObjectType::MODEL, ObjectType::IMAGE_MODEL), transform, color);
    }
 
 private:
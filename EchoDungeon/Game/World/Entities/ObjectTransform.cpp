@@ -64,3 +64,9 @@ void ObjectTransform::set_is_static(bool is_static_) {
 bool ObjectTransform::get_is_static() const {
 	return is_static;
 }
+
+// Comparison
+bool ObjectTransform::operator==(const ObjectTransform& other) const {
+	return position == other.position && rotation == other.rotation && scale == other.scale
+		&& has_collision == other.has_collision && is_static == other.is_static;
+}
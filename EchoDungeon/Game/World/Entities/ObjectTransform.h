@@ -39,6 +39,9 @@ public:
 	void set_is_static(bool is_static);
 	bool get_is_static() const;
 
+	// Comparison
+	bool operator==(const ObjectTransform& other) const;
+	bool operator!=(const ObjectTransform& other) const { return !(*this == other); }
 
 	template <class Archive>
 	void serialize(Archive& archive) {
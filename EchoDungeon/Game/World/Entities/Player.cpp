@@ -1,6 +1,9 @@
 #include "Player.h"
 #include "Utils/MathUtils.h"
+#include <algorithm>
+#ifdef _WIN32
 #include <windows.h>  // For SEH
+#endif
 
 Player::Player() :
 	id(65534),
@@ -100,15 +103,15 @@ void Player::apply_item_effects(const ItemEffects& effects) {
 	temp_attack_cooldown *= (1.0f - effects.atk_cooldown_percent_reduction);
 	temp_health *= (1.0f + effects.healing_percentage);
 
-	temp_health = min(temp_health, temp_max_health); // Clamp health to max_health
+	temp_health = (std::min)(temp_health, temp_max_health); // Clamp health to max_health
 
 	// Ensure no stats are below 0
-	damage = max(0, temp_damage);
-	max_health = max(1, temp_max_health); // At least 1 max health
-	range = max(0.1f, temp_range); // At least 0.1 range
-	speed = max(0.1f, temp_speed); // At least 0.1 speed
-	attack_cooldown = max(uint64_t(0), temp_attack_cooldown); // At least 0 ms cooldown
-	health = max(1, temp_health); // At least 1 health
+	damage = (std::max)(0.0f, temp_damage);
+	max_health = (std::max)(1.0f, temp_max_health); // At least 1 max health
+	range = (std::max)(0.1f, temp_range); // At least 0.1 range
+	speed = (std::max)(0.1f, temp_speed); // At least 0.1 speed
+	attack_cooldown = (std::max)(uint64_t(0), temp_attack_cooldown); // At least 0 ms cooldown
+	health = (std::max)(1.0f, temp_health); // At least 1 health
 }
 
 void Player::remove_item_effects(uint32_t item_id, const std::unordered_map<uint32_t, Item>& item_registry) {
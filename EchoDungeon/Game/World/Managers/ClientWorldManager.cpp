@@ -5,6 +5,8 @@
 #include "Networking/Packet/Instances/Player/PlayerAttack.h"
 #include "Networking/Packet/Instances/PlayerInput.h"
 #include "Networking/Packet/Instances/Item/ItemDiscard.h"
+#include "Networking/Packet/Instances/SnapshotAck.h"
+#include "Networking/Packet/TransformCodec.h"
 #include "Libraries/raylib-imgui-compat/rlImGui.h"
 
 ClientWorldManager::ClientWorldManager(std::shared_ptr<Client> client)
@@ -21,6 +23,9 @@ ClientWorldManager::ClientWorldManager(std::shared_ptr<Client> client)
 
 void ClientWorldManager::update(float delta_time) {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+
+    // Apply the packets that arrived since the last update
+    inbound_queue.drain();
     
     uint64_t current_time = NetUtils::get_current_time_millis();
     const uint64_t attack_visual_duration = 300; // 300ms attack visual for all players
@@ -144,6 +149,8 @@ void ClientWorldManager::clear() {
     enemies.clear();
     items.clear();
     show_inventory = false;
+    player_history.clear();
+    enemy_history.clear();
 }
 
 
@@ -164,6 +171,17 @@ void ClientWorldManager::add_player(const Player& player) {
         // Initialize last_sent_transform when local player is added
         last_sent_transform = players[player.id].transform;
     }
+
+    // Updates arrive on the state channel and can overtake the spawn,
+    // so catch up on any state already replicated for this player
+    if (auto latest = player_history.latest()) {
+        if (const PlayerUpdateData* found = latest->entities.find(player.id)) {
+            const PlayerUpdateData& update = *found;
+            update_player(update.id, update.transform, update.health,
+                update.damage, update.max_health, update.range, update.speed, update.attack_cooldown,
+                update.last_attack_time, update.attacking, update.inventory);
+        }
+    }
 }
 
 void ClientWorldManager::remove_player(uint32_t peer_id) {
@@ -181,7 +199,8 @@ void ClientWorldManager::update_player(uint32_t peer_id,
     if (it != players.end()) {
         // Don't update local player's transform from server, as it causes jittering
         if (peer_id != client->peers.local_server_side_id) {
-            it->second.transform = transform;
+            // Updates only carry position and yaw, scale and flags stay as spawned
+            TransformCodec::apply_replicated(it->second.transform, transform);
             
             // For non-local players: detect when they start attacking
             // and set client-side last_attack_time for visual duration tracking
@@ -236,7 +255,14 @@ Object* ClientWorldManager::get_object(uint32_t object_id) {
 void ClientWorldManager::add_enemy(const Enemy& enemy) {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
     enemies[enemy.id] = enemy;
-    
+
+    // Updates arrive on the state channel and can overtake the spawn,
+    // so catch up on any state already replicated for this enemy
+    if (auto latest = enemy_history.latest()) {
+        if (const EnemyUpdateData* update = latest->entities.find(enemy.id)) {
+            update_enemy(enemy.id, update->transform, update->health);
+        }
+    }
 }
 
 void ClientWorldManager::remove_enemy(uint32_t enemy_id) {
@@ -249,7 +275,7 @@ void ClientWorldManager::update_enemy(uint32_t enemy_id, const ObjectTransform&
     
     auto it = enemies.find(enemy_id);
     if (it != enemies.end()) {
-        it->second.transform = transform;
+        TransformCodec::apply_replicated(it->second.transform, transform);
         it->second.health = health;
     }
     else {
@@ -297,18 +323,82 @@ void ClientWorldManager::apply_world_snapshot(const WorldSnapshotPacket& snapsho
     }
 }
 
-void ClientWorldManager::apply_player_updates(const std::vector<PlayerUpdateData>& updates) {
-    for (const auto& update : updates) {
+/**
+ * @brief Reconstructs the player snapshot described by a delta update, applies the players
+ * that changed since the last applied snapshot, and acknowledges it to the server.
+ * @param packet The received PlayerUpdatePacket.
+ */
+void ClientWorldManager::apply_player_updates(const PlayerUpdatePacket& packet) {
+    std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+
+    auto previous = player_history.latest();
+    if (previous && packet.sequence <= previous->sequence) return; // Stale update
+
+    std::shared_ptr<const EntitySnapshot<PlayerUpdateData>> baseline;
+    if (packet.baseline_sequence != 0) {
+        baseline = player_history.find(packet.baseline_sequence);
+        if (!baseline) {
+            // Baseline fell out of the history, ask the server for full state
+            WARNING("Player update baseline " + std::to_string(packet.baseline_sequence) + " not found, requesting full state");
+            send_snapshot_ack(0, enemy_history.latest() ? enemy_history.latest()->sequence : 0);
+            return;
+        }
+    }
+
+    auto snapshot = DeltaReplication<PlayerUpdateData>::decode(baseline.get(), packet.sequence, packet.updates, packet.removed);
+
+    // Skip players that are unchanged from what the world already shows
+    DeltaReplication<PlayerUpdateData>::for_each_changed(previous.get(), *snapshot, [&](const PlayerUpdateData& update) {
         update_player(update.id, update.transform, update.health,
             update.damage, update.max_health, update.range, update.speed, update.attack_cooldown,
             update.last_attack_time, update.attacking, update.inventory);
-    }
+    });
+
+    player_history.push(snapshot);
+    send_snapshot_ack(snapshot->sequence, enemy_history.latest() ? enemy_history.latest()->sequence : 0);
 }
 
-void ClientWorldManager::apply_enemy_updates(const std::vector<EnemyUpdateData>& updates) {
-    for (const auto& update : updates) {
-        update_enemy(update.id, update.transform, update.health);
+/**
+ * @brief Reconstructs the enemy snapshot described by a delta update, applies the enemies
+ * that changed since the last applied snapshot, and acknowledges it to the server.
+ * @param packet The received EnemyUpdatePacket.
+ */
+void ClientWorldManager::apply_enemy_updates(const EnemyUpdatePacket& packet) {
+    std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+
+    auto previous = enemy_history.latest();
+    if (previous && packet.sequence <= previous->sequence) return; // Stale update
+
+    std::shared_ptr<const EntitySnapshot<EnemyUpdateData>> baseline;
+    if (packet.baseline_sequence != 0) {
+        baseline = enemy_history.find(packet.baseline_sequence);
+        if (!baseline) {
+            // Baseline fell out of the history, ask the server for full state
+            WARNING("Enemy update baseline " + std::to_string(packet.baseline_sequence) + " not found, requesting full state");
+            send_snapshot_ack(player_history.latest() ? player_history.latest()->sequence : 0, 0);
+            return;
+        }
     }
+
+    auto snapshot = DeltaReplication<EnemyUpdateData>::decode(baseline.get(), packet.sequence, packet.updates, packet.removed);
+
+    // Skip enemies that are unchanged from what the world already shows
+    DeltaReplication<EnemyUpdateData>::for_each_changed(previous.get(), *snapshot, [&](const EnemyUpdateData& update) {
+        update_enemy(update.id, update.transform, update.health);
+    });
+
+    enemy_history.push(snapshot);
+    send_snapshot_ack(player_history.latest() ? player_history.latest()->sequence : 0, snapshot->sequence);
+}
+
+/**
+ * @brief Acknowledges the newest reconstructed update snapshots to the server.
+ * @param player_sequence Newest applied PlayerUpdate sequence (0 = request full state).
+ * @param enemy_sequence Newest applied EnemyUpdate sequence (0 = request full state).
+ */
+void ClientWorldManager::send_snapshot_ack(uint32_t player_sequence, uint32_t enemy_sequence) {
+    SnapshotAckPacket packet(player_sequence, enemy_sequence);
+    client->send_packet(packet);
 }
 
 void ClientWorldManager::send_local_player_input() {
@@ -13,6 +13,8 @@
 #include <mutex>
 #include "PhysicsManager.h"
 #include "Game/World/Entities/Enemy.h"
+#include "Game/World/Systems/DeltaReplication.h"
+#include "Game/World/Systems/InboundQueue.h"
 
 class Client;  // Forward declaration
 
@@ -27,6 +29,7 @@ public:
     ~ClientWorldManager() = default;
 
     void update(float delta_time);  // Called every frame
+    InboundQueue& get_inbound_queue() { return inbound_queue; }  // Packets applied at the start of the next update
     void draw_3d();  // Draw 3D entities
     void draw_2d();  // Draw 2D UI elements
     void clear();  // Clear all entities
@@ -51,8 +54,8 @@ public:
     Enemy* get_enemy(uint32_t enemy_id);
 
     void apply_world_snapshot(const WorldSnapshotPacket& snapshot);
-    void apply_player_updates(const std::vector<PlayerUpdateData>& updates);
-    void apply_enemy_updates(const std::vector<EnemyUpdateData>& updates);
+    void apply_player_updates(const PlayerUpdatePacket& packet);  // Decode a player delta and apply what changed
+    void apply_enemy_updates(const EnemyUpdatePacket& packet);  // Decode an enemy delta and apply what changed
     void send_local_player_input();  // Send local player transform to server
 
     // Item system
@@ -76,6 +79,8 @@ private:
     
     // Thread synchronization for world state (recursive to allow nested locks from same thread)
     mutable std::recursive_mutex world_state_mutex;
+
+    InboundQueue inbound_queue;  // Decoded packets from the networking thread, drained by update()
     
     // Camera
     raylib::Camera3D camera;
@@ -90,8 +95,13 @@ private:
     std::chrono::steady_clock::time_point last_input_send_time;
     const float input_send_interval = 1.0f / 60.0f;  // Send input 60 times per second
     ObjectTransform last_sent_transform;  // Track last sent transform to avoid redundant sends
+
+    // Delta replication (reconstructed server snapshots, newest is what the world reflects)
+    SnapshotHistory<PlayerUpdateData> player_history;
+    SnapshotHistory<EnemyUpdateData> enemy_history;
     
     // Helper methods
     void process_local_player_input(float delta_time);
     bool has_local_player_moved() const;
+    void send_snapshot_ack(uint32_t player_sequence, uint32_t enemy_sequence);  // Tell the server which updates were applied
 };
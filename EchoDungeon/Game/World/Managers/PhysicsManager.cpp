@@ -1,13 +1,30 @@
 #include "PhysicsManager.h"
 #include "ServerWorldManager.h"
 #include "ClientWorldManager.h"
+#include "Utils/JobSystem.h"
+
+/**
+ * @brief Runs job over [0, count) in BROADPHASE_GRAIN chunks on a job system, or in one go on the calling thread.
+ * @param jobs The job system to spread the chunks over, or nullptr (eg on the client, which never starts worker threads).
+ * @param count The number of items.
+ * @param job Called with each chunk's [begin, end).
+ */
+void PhysicsManager::for_each_chunk(JobSystem* jobs, size_t count, const std::function<void(size_t begin, size_t end)>& job) {
+	if (jobs) {
+		jobs->parallel_for(count, BROADPHASE_GRAIN, job);
+	}
+	else if (count > 0) {
+		job(0, count);
+	}
+}
 
 void PhysicsManager::update(
 std::unordered_map<uint32_t, Player>* players,
 std::unordered_map<uint32_t, Enemy>* enemies,
 std::unordered_map<uint32_t, Object>* objects,
 ServerWorldManager* server_world_manager,
-ClientWorldManager* client_world_manager) {
+ClientWorldManager* client_world_manager,
+JobSystem* jobs) {
 
 	if (!players || !objects && !enemies) return;
 
@@ -15,10 +32,6 @@ ClientWorldManager* client_world_manager) {
 	std::unordered_map<uint32_t, raylib::BoundingBox> object_boxes;
 	object_boxes.reserve(objects->size());
 
-	// Pre-calculate all enemy bounding boxes once per frame
-	std::unordered_map<uint32_t, raylib::BoundingBox> enemy_boxes;
-	enemy_boxes.reserve(enemies->size());
-
 	for (auto& [object_id, object] : *objects) {
 		ObjectTransform& object_transform = object.transform;
 		
@@ -43,29 +56,43 @@ ClientWorldManager* client_world_manager) {
 		);
 	}
 
+	// Pre-calculate all enemy bounding boxes once per frame, spread over the job system if there is one
+	std::vector<EnemyBox> enemy_boxes;
+	enemy_boxes.reserve(enemies->size());
 	for (auto& [enemy_id, enemy] : *enemies) {
-		ObjectTransform& enemy_transform = enemy.transform;
-
-		// Skip if enemy has no collision
-		if (!enemy_transform.get_has_collision()) continue;
+		enemy_boxes.push_back({ enemy_id, &enemy });
+	}
 
-		raylib::Vector3 enemy_pos = enemy_transform.get_position();
-		raylib::Vector3 enemy_scale = enemy_transform.get_scale();
+	for_each_chunk(jobs, enemy_boxes.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			EnemyBox& enemy_box = enemy_boxes[i];
+			ObjectTransform& enemy_transform = enemy_box.enemy->transform;
+
+			// Skip if enemy has no collision
+			enemy_box.has_collision = enemy_transform.get_has_collision();
+			if (!enemy_box.has_collision) continue;
+
+			raylib::Vector3 enemy_pos = enemy_transform.get_position();
+			raylib::Vector3 enemy_scale = enemy_transform.get_scale();
+
+			enemy_box.box = raylib::BoundingBox(
+				raylib::Vector3( // Reduce slightly to improve balance
+					enemy_pos.x - enemy_scale.x * 0.4f,
+					enemy_pos.y - enemy_scale.y * 0.4f,
+					enemy_pos.z - enemy_scale.z * 0.4f
+				),
+				raylib::Vector3(
+					enemy_pos.x + enemy_scale.x * 0.4f,
+					enemy_pos.y + enemy_scale.y * 0.4f,
+					enemy_pos.z + enemy_scale.z * 0.4f
+				)
+			);
+		}
+	});
 
-		// Create and cache bounding box for this enemy
-		enemy_boxes[enemy_id] = raylib::BoundingBox(
-			raylib::Vector3( // Reduce slightly to improve balance
-				enemy_pos.x - enemy_scale.x * 0.4f,
-				enemy_pos.y - enemy_scale.y * 0.4f,
-				enemy_pos.z - enemy_scale.z * 0.4f
-			),
-			raylib::Vector3(
-				enemy_pos.x + enemy_scale.x * 0.4f,
-				enemy_pos.y + enemy_scale.y * 0.4f,
-				enemy_pos.z + enemy_scale.z * 0.4f
-			)
-		);
-	}
+	// Boxes of the players that can collide, in the order they are checked
+	std::vector<PlayerBox> player_boxes;
+	player_boxes.reserve(players->size());
 
 	// Check each player against all cached object bounding boxes
 	for (auto& [player_id, player] : *players) {
@@ -137,30 +164,54 @@ ClientWorldManager* client_world_manager) {
 			}
 		}
 
-		// Check against all cached enemy bounding boxes
-		for (auto& [enemy_id, enemy_box] : enemy_boxes) {
-			// Get the actual enemy for position data (needed for pushback calculation)
-			auto ene_it = enemies->find(enemy_id);
-			if (ene_it == enemies->end()) continue;
-			Enemy& enemy = ene_it->second;
-			raylib::Vector3 enemy_pos = enemy.transform.get_position();
-			
-			// Check collision
-			if (player_box.CheckCollision(enemy_box)) {
-				if (server_world_manager) {
-					player.health -= enemy.damage;
-					INFO("SERVER-SIDE: Player " + std::to_string(player_id) +
-						" took " + std::to_string(enemy.damage) + " damage from enemy "
-						+ std::to_string(enemy_id) + ". New health: " + std::to_string(player.health));
-					server_world_manager->destroy_enemy(enemy_id);
-					// Player health is updated on the next frame anyway
-				}
-				if (client_world_manager) {
-					INFO("CLIENT-SIDE: Player " + std::to_string(player_id) +
-						" took " + std::to_string(enemy.damage) + " damage from enemy "
-						+ std::to_string(enemy_id) + ". New health: " + std::to_string(player.health));
+		player_boxes.push_back({ player_id, &player, player_box });
+	}
+
+	// Find the first player each enemy overlaps (boxes taken before pushback, as the objects were), spread over
+	// the job system if there is one. Hits are rare, so the players after it are only checked when applying.
+	std::vector<int> first_hit(enemy_boxes.size(), -1);
+	for_each_chunk(jobs, enemy_boxes.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			if (!enemy_boxes[i].has_collision) continue;
+
+			for (size_t p = 0; p < player_boxes.size(); p++) {
+				if (player_boxes[p].box.CheckCollision(enemy_boxes[i].box)) {
+					first_hit[i] = static_cast<int>(p);
+					break;
 				}
 			}
 		}
+	});
+
+	// Apply the hits in order, destroying enemies is not thread safe
+	for (size_t i = 0; i < enemy_boxes.size(); i++) {
+		if (first_hit[i] < 0) continue;
+
+		size_t first = static_cast<size_t>(first_hit[i]);
+		uint32_t enemy_id = enemy_boxes[i].enemy_id;
+		Enemy& enemy = *enemy_boxes[i].enemy;
+
+		// Every player the enemy overlaps is hit, until the server destroys it
+		for (size_t p = first; p < player_boxes.size(); p++) {
+			if (p != first && !player_boxes[p].box.CheckCollision(enemy_boxes[i].box)) continue;
+
+			uint32_t player_id = player_boxes[p].player_id;
+			Player& player = *player_boxes[p].player;
+
+			if (server_world_manager) {
+				player.health -= enemy.damage;
+				INFO("SERVER-SIDE: Player " + std::to_string(player_id) +
+					" took " + std::to_string(enemy.damage) + " damage from enemy "
+					+ std::to_string(enemy_id) + ". New health: " + std::to_string(player.health));
+				server_world_manager->destroy_enemy(enemy_id);
+				// Player health is updated on the next frame anyway
+				break; // Destroyed, so no other player finds it
+			}
+			if (client_world_manager) {
+				INFO("CLIENT-SIDE: Player " + std::to_string(player_id) +
+					" took " + std::to_string(enemy.damage) + " damage from enemy "
+					+ std::to_string(enemy_id) + ". New health: " + std::to_string(player.health));
+			}
+		}
 	}
 }
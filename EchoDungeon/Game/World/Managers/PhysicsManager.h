@@ -8,6 +8,7 @@
 // Forward declarations
 class ServerWorldManager;
 class ClientWorldManager;
+class JobSystem;
 
 class PhysicsManager {
 public:
@@ -16,6 +17,25 @@ public:
 		std::unordered_map<uint32_t, Enemy>* enemies,
 		std::unordered_map<uint32_t, Object>* objects,
 		ServerWorldManager* server_world_manager,
-		ClientWorldManager* client_world_manager);
+		ClientWorldManager* client_world_manager,
+		JobSystem* jobs = nullptr); // Spreads the broadphase over jobs, or runs it on the calling thread if nullptr
+
+private:
+	static constexpr size_t BROADPHASE_GRAIN = 512; // Enemies boxed or tested per job system chunk
+
+	static void for_each_chunk(JobSystem* jobs, size_t count, const std::function<void(size_t begin, size_t end)>& job);
+
+	struct EnemyBox {
+		uint32_t enemy_id;
+		Enemy* enemy;
+		raylib::BoundingBox box; // Only set if has_collision
+		bool has_collision = false;
+	};
+
+	struct PlayerBox {
+		uint32_t player_id;
+		Player* player;
+		raylib::BoundingBox box;
+	};
 
 };
\ No newline at end of file
@@ -3,34 +3,136 @@
 #include "Utils/NetUtils.h"
 #include "Game/World/Systems/ItemGenerator.h"
 #include "Networking/Packet/Instances/Item/ItemPickup.h"
+#include "Networking/Packet/TransformCodec.h"
+#include "Utils/JobSystem.h"
 #include <sstream>
 #include <iomanip>
 
-ServerWorldManager::ServerWorldManager(std::shared_ptr<Server> server)
-    : server(server), last_update_time(std::chrono::steady_clock::now()), 
-      game_start_time(std::chrono::steady_clock::now()) {
+ServerWorldManager::ServerWorldManager(std::shared_ptr<Server> server, RoomId room_id)
+    : server(server), room_id(room_id), game_start_time(std::chrono::steady_clock::now()),
+      simulation([this](float) { update(); }) {
+    register_systems();
+    scheduler.set_tick_rate(DEFAULT_TICK_RATE);
 }
 
-void ServerWorldManager::update(float delta_time) {
+ServerWorldManager::~ServerWorldManager() {
+    stop_simulation();
+}
+
+/**
+ * @brief Adds the server tick's systems to the scheduler, with their rates and the world data they touch.
+ * Replication runs every tick at 30 Hz and every other tick at 60 Hz. AI runs on two ticks of
+ * three at 30 Hz and every third at 60 Hz, so at 60 Hz it shares one tick in six with replication
+ * and leaves the rest to it. Spawning's phase puts it on a tick neither AI nor (at 60 Hz)
+ * replication runs on. Physics only pushes entities out of what they overlap, it has no time step,
+ * and runs every tick so nothing that moved (AI on one tick, player input on any) is replicated
+ * before it is resolved.
+ */
+void ServerWorldManager::register_systems() {
+    scheduler.add_system("enemy_spawning", 2.0f, 29, WORLD_PLAYERS, WORLD_ENEMIES | WORLD_NETWORK,
+        [this](float delta_time) { regular_enemy_spawning_update(delta_time); });
+
+    scheduler.add_system("enemy_ai", static_cast<float>(AI_RATE), 0, WORLD_PLAYERS, WORLD_ENEMIES,
+        [this](float delta_time) { update_enemy_ai(delta_time); });
+
+    scheduler.add_system("attack_cooldowns", SystemScheduler::EVERY_TICK, 0, WORLD_PLAYERS, WORLD_PLAYERS,
+        [this](float) { update_attack_cooldowns(); });
+
+    scheduler.add_system("physics", SystemScheduler::EVERY_TICK, 0, WORLD_PLAYERS | WORLD_ENEMIES | WORLD_OBJECTS,
+        WORLD_PLAYERS | WORLD_ENEMIES | WORLD_OBJECTS | WORLD_ITEMS | WORLD_NETWORK,
+        [this](float) { PhysicsManager::update(&players, &enemies, &objects, this, nullptr, &get_job_system()); });
+
+    // This tick's batched events (spawns, destroys, items), ahead of the entity updates
+    scheduler.add_system("event_batches", SystemScheduler::EVERY_TICK, 0, 0, WORLD_NETWORK,
+        [this](float) { server->flush_batches(room_id); });
+
+    scheduler.add_system("replication", static_cast<float>(REPLICATION_RATE), 0, WORLD_PLAYERS | WORLD_ENEMIES, WORLD_NETWORK,
+        [this](float) { broadcast_entity_updates(); });
+}
+
+/**
+ * @brief Starts running update() on the simulation thread, tick_rate times a second.
+ * The calling thread must not touch the world afterwards except through the inbound queue.
+ * @param tick_rate Simulation ticks per second.
+ */
+void ServerWorldManager::start_simulation(int tick_rate) {
+    set_tick_rate(tick_rate);
+    simulation.start(tick_rate);
+}
+
+/**
+ * @brief Sets the rate update() is called at, for a world ticked from outside (eg by a SimulationPool).
+ * @param tick_rate Simulation ticks per second.
+ */
+void ServerWorldManager::set_tick_rate(int tick_rate) {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
-    
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::duration<float>>(now - last_update_time);
-    
-    // Spawn new enemies over time
-	regular_enemy_spawning_update(delta_time);
+    scheduler.set_tick_rate(tick_rate);
+}
+
+/**
+ * @brief Stops the simulation thread and logs where its ticks spent their time.
+ */
+void ServerWorldManager::stop_simulation() {
+    if (!simulation.is_running()) return;
+
+    simulation.stop();
+    log_system_stats();
+}
+
+/**
+ * @brief Sets the job system the tick's AI, physics and replication loops are spread over, eg one
+ * sized for a benchmark. Must not be called while the world is ticking.
+ * @param jobs The job system. Must outlive the world.
+ */
+void ServerWorldManager::set_job_system(JobSystem& jobs) {
+    std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+    this->jobs = &jobs;
+}
+
+JobSystem& ServerWorldManager::get_job_system() {
+    return jobs ? *jobs : JobSystem::shared();
+}
+
+/**
+ * @brief Logs where the world's ticks spent their time, per system.
+ */
+void ServerWorldManager::log_system_stats() const {
+    scheduler.log_stats();
+}
+
+void ServerWorldManager::update() {
+    std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+
+    // Apply the packets that arrived since the last update
+    inbound_queue.drain();
 
-    // Update enemies
+    // Run the systems due this tick
+    tick_count++;
+    scheduler.run_tick(tick_count);
+}
+
+void ServerWorldManager::update_enemy_ai(float delta_time) {
+    // Gather pointers to all players for enemy AI
+    std::vector<Player*> player_ptrs;
+    for (auto& [peer_id, player] : players) {
+        player_ptrs.push_back(&player);
+    }
+
+    // Each enemy only moves itself and reads the players, so enemies can tick on any thread
+    std::vector<Enemy*> enemy_ptrs;
+    enemy_ptrs.reserve(enemies.size());
     for (auto& [enemy_id, enemy] : enemies) {
-        // Gather pointers to all players for enemy AI
-        std::vector<Player*> player_ptrs;
-        for (auto& [peer_id, player] : players) {
-            player_ptrs.push_back(&player);     
-        }
-        enemy.tick(delta_time, player_ptrs);
+        enemy_ptrs.push_back(&enemy);
     }
 
-    // Update player .attacking
+    get_job_system().parallel_for(enemy_ptrs.size(), ENEMY_AI_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            enemy_ptrs[i]->tick(delta_time, player_ptrs);
+        }
+    });
+}
+
+void ServerWorldManager::update_attack_cooldowns() {
 	uint64_t current_time = NetUtils::get_current_time_millis();
     for (auto& [peer_id, player] : players) {
         if (player.attacking && 
@@ -38,16 +140,6 @@ void ServerWorldManager::update(float delta_time) {
             player.attacking = false; // Reset attacking state after cooldown
         }
 	}
-
-
-    // Update collisions
-    PhysicsManager::update(&players, &enemies, &objects, this, nullptr);
-
-    // Send entity updates at fixed interval (20 Hz)
-    if (elapsed.count() >= update_interval) {
-        broadcast_entity_updates();
-        last_update_time = now;
-    }
 }
 
 void ServerWorldManager::clear() {
@@ -57,6 +149,9 @@ void ServerWorldManager::clear() {
     items.clear();
     next_object_id = 0;
     next_item_id = 1;
+    player_history.clear();
+    enemy_history.clear();
+    replication_states.clear();
 }
 
 
@@ -82,16 +177,17 @@ void ServerWorldManager::add_player(uint32_t peer_id, const std::string& name) {
         player.asset_id,
         player.inventory
     );
-    server->broadcast_packet(packet);
+    server->queue_broadcast(packet, std::nullopt, room_id);
 }
 
 void ServerWorldManager::remove_player(uint32_t peer_id) {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
     
+    replication_states.erase(peer_id);
     if (players.erase(peer_id) > 0) {
         // Broadcast player destroy
         PlayerDestroyPacket packet(peer_id);
-        server->broadcast_packet(packet);
+        server->queue_broadcast(packet, std::nullopt, room_id);
     }
 }
 
@@ -124,7 +220,7 @@ uint32_t ServerWorldManager::spawn_object(ObjectType type, const std::string& as
         obj.transform,
         obj.color
     );
-    server->broadcast_packet(packet);
+    server->queue_broadcast(packet, std::nullopt, room_id);
     
     return object_id;
 }
@@ -135,7 +231,7 @@ void ServerWorldManager::destroy_object(uint32_t object_id) {
     if (objects.erase(object_id) > 0) {
         // Broadcast object destroy
         ObjectDestroyPacket packet(object_id);
-        server->broadcast_packet(packet);
+        server->queue_broadcast(packet, std::nullopt, room_id);
     }
 }
 
@@ -150,7 +246,6 @@ uint32_t ServerWorldManager::spawn_enemy(float max_health, float speed, float da
     const raylib::Vector3& position) {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
 
-    static uint32_t next_enemy_id = 1;
     uint32_t enemy_id = next_enemy_id++;
 
     std::string asset_id = "zombie";
@@ -179,7 +274,7 @@ uint32_t ServerWorldManager::spawn_enemy(float max_health, float speed, float da
         enemy.spawns_items,
         enemy.asset_id
     );
-    server->broadcast_packet(packet);
+    server->queue_broadcast(packet, std::nullopt, room_id);
 
 	INFO("SERVER-SIDE: Spawned enemy ID " + std::to_string(enemy_id) +
          " at position (" + std::to_string(position.x) + ", " + 
@@ -202,7 +297,7 @@ void ServerWorldManager::destroy_enemy(uint32_t enemy_id) {
         // Broadcast enemy destroy
         INFO("Destroyed enemy: " + std::to_string(enemy_id));
         EnemyDestroyPacket packet(enemy_id);
-        server->broadcast_packet(packet);
+        server->queue_broadcast(packet, std::nullopt, room_id);
     }
 }
 
@@ -210,35 +305,119 @@ void ServerWorldManager::broadcast_world_snapshot() {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
     
     WorldSnapshotPacket packet(players, objects, enemies);
-    server->broadcast_packet(packet);
+    server->broadcast_packet(packet, std::nullopt, room_id);
 }
 
 void ServerWorldManager::send_world_snapshot(ENetPeer* peer) {
     std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
     
     WorldSnapshotPacket packet(players, objects, enemies);
-    enet_peer_send(peer, 0, packet.to_enet_packet());
+    server->send_packet_to_peer(packet, peer);
 }
 
+/**
+ * @brief Takes a snapshot of player and enemy state and sends each client the delta
+ * against the newest snapshot it has acknowledged. Clients without an acknowledged
+ * baseline get the full state; clients with nothing changed get nothing.
+ */
 void ServerWorldManager::broadcast_entity_updates() {
-    // Collect and broadcast player updates
-    std::vector<PlayerUpdateData> player_updates;
-    collect_player_updates(player_updates);
-    if (!player_updates.empty()) {
-        PlayerUpdatePacket player_packet(player_updates);
-        server->broadcast_packet(player_packet);
+    std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+
+    uint32_t sequence = ++replication_sequence;
+
+    // Each snapshot starts as a copy of the previous one, so shards with nothing changed stay shared
+    // and encoding skips them for every client whose baseline shares them too
+    auto player_snapshot = std::make_shared<EntitySnapshot<PlayerUpdateData>>();
+    player_snapshot->sequence = sequence;
+    if (auto previous = player_history.latest()) player_snapshot->entities = previous->entities;
+    collect_player_updates(player_snapshot->entities);
+    player_history.push(player_snapshot);
+
+    auto enemy_snapshot = std::make_shared<EntitySnapshot<EnemyUpdateData>>();
+    enemy_snapshot->sequence = sequence;
+    if (auto previous = enemy_history.latest()) enemy_snapshot->entities = previous->entities;
+    collect_enemy_updates(enemy_snapshot->entities);
+    enemy_history.push(enemy_snapshot);
+
+    // Find every client's state up front, so encoding in parallel never inserts into replication_states
+    std::vector<std::pair<uint32_t, ClientReplicationState*>> clients;
+    for (const auto& peer_entry : server->peers.get_room_peers(room_id)) {
+        uint32_t peer_id = peer_entry.data.server_side_id;
+        clients.emplace_back(peer_id, &replication_states[peer_id]);
     }
-    
-    // Collect and broadcast enemy updates
-    std::vector<EnemyUpdateData> enemy_updates;
-    collect_enemy_updates(enemy_updates);
-    if (!enemy_updates.empty()) {
-        EnemyUpdatePacket enemy_packet(enemy_updates);
-        server->broadcast_packet(enemy_packet);
+
+    // Each client's packets are encoded and sent by one job, so they still go out in order
+    get_job_system().parallel_for(clients.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            send_entity_updates(clients[i].first, *clients[i].second, *player_snapshot, *enemy_snapshot);
+        }
+    });
+}
+
+/**
+ * @brief Encodes one client's player and enemy deltas against its baselines and sends them.
+ * Runs on a job system thread: it only reads the client's state and the snapshots.
+ * @param peer_id The client's server-side id.
+ * @param state The client's acknowledged baselines.
+ * @param player_snapshot The newest player snapshot.
+ * @param enemy_snapshot The newest enemy snapshot.
+ */
+void ServerWorldManager::send_entity_updates(uint32_t peer_id, const ClientReplicationState& state,
+    const EntitySnapshot<PlayerUpdateData>& player_snapshot, const EntitySnapshot<EnemyUpdateData>& enemy_snapshot) {
+    uint32_t sequence = player_snapshot.sequence;
+
+    // Player updates, relative to this client's acknowledged baseline
+    const auto* player_baseline = state.player_baseline.get();
+    PlayerUpdatePacket player_packet(sequence, player_baseline ? player_baseline->sequence : 0);
+    DeltaReplication<PlayerUpdateData>::encode(player_baseline, player_snapshot,
+        player_packet.updates, player_packet.removed);
+    if (!player_packet.updates.empty() || !player_packet.removed.empty()) {
+        server->send_packet(player_packet, peer_id);
+    }
+
+    // Enemy updates, relative to this client's acknowledged baseline
+    const auto* enemy_baseline = state.enemy_baseline.get();
+    EnemyUpdatePacket enemy_packet(sequence, enemy_baseline ? enemy_baseline->sequence : 0);
+    DeltaReplication<EnemyUpdateData>::encode(enemy_baseline, enemy_snapshot,
+        enemy_packet.updates, enemy_packet.removed);
+    if (!enemy_packet.updates.empty() || !enemy_packet.removed.empty()) {
+        server->send_packet(enemy_packet, peer_id);
     }
 }
 
-void ServerWorldManager::collect_player_updates(std::vector<PlayerUpdateData>& updates) {
+/**
+ * @brief Moves a client's delta baselines forward to the snapshots it acknowledged.
+ * An ack of 0 drops the baseline, so the next update is sent in full.
+ * @param peer_id The client's server-side id.
+ * @param player_sequence Newest PlayerUpdate sequence the client applied.
+ * @param enemy_sequence Newest EnemyUpdate sequence the client applied.
+ */
+void ServerWorldManager::handle_snapshot_ack(uint32_t peer_id, uint32_t player_sequence, uint32_t enemy_sequence) {
+    std::lock_guard<std::recursive_mutex> lock(world_state_mutex);
+
+    ClientReplicationState& state = replication_states[peer_id];
+
+    if (player_sequence == 0) {
+        state.player_baseline = nullptr;
+    }
+    else if (!state.player_baseline || player_sequence > state.player_baseline->sequence) {
+        // Acks are unreliable and may arrive out of order, only ever move forward
+        if (auto snapshot = player_history.find(player_sequence)) {
+            state.player_baseline = snapshot;
+        }
+    }
+
+    if (enemy_sequence == 0) {
+        state.enemy_baseline = nullptr;
+    }
+    else if (!state.enemy_baseline || enemy_sequence > state.enemy_baseline->sequence) {
+        if (auto snapshot = enemy_history.find(enemy_sequence)) {
+            state.enemy_baseline = snapshot;
+        }
+    }
+}
+
+void ServerWorldManager::collect_player_updates(EntityTable<PlayerUpdateData>& updates) {
     // Collect player updates
     for (const auto& [peer_id, player] : players) {
         PlayerUpdateData update;
@@ -253,19 +432,25 @@ void ServerWorldManager::collect_player_updates(std::vector<PlayerUpdateData>& u
 		update.last_attack_time = player.last_attack_time;
 		update.attacking = player.attacking;
 		update.inventory = player.inventory;
-        updates.push_back(update);
+        updates.update(update);
     }
+
+    // Drop players that left since the previous snapshot
+    updates.erase_if([&](uint32_t peer_id, const PlayerUpdateData&) { return players.find(peer_id) == players.end(); });
 }
 
-void ServerWorldManager::collect_enemy_updates(std::vector<EnemyUpdateData>& updates) {
+void ServerWorldManager::collect_enemy_updates(EntityTable<EnemyUpdateData>& updates) {
     // Collect enemy updates
     for (const auto& [enemy_id, enemy] : enemies) {
         EnemyUpdateData update;
         update.id = enemy_id;
         update.transform = enemy.transform;
         update.health = enemy.health;
-        updates.push_back(update);
+        updates.update(update);
     }
+
+    // Drop enemies that died since the previous snapshot
+    updates.erase_if([&](uint32_t enemy_id, const EnemyUpdateData&) { return enemies.find(enemy_id) == enemies.end(); });
 }
 
 
@@ -282,7 +467,8 @@ void ServerWorldManager::handle_player_input(uint32_t peer_id, const ObjectTrans
 
     // Validate the transform (anti-cheat, collision, etc.)
     if (validate_player_transform(*player, input_transform)) {
-        player->transform = input_transform;
+        // Only position and yaw are sent by clients, scale and flags stay as spawned
+        TransformCodec::apply_replicated(player->transform, input_transform);
         // Updates will be broadcast in the next update() call
     }
 }
@@ -341,7 +527,7 @@ void ServerWorldManager::handle_player_attack(uint32_t peer_id) {
         if (enemies.erase(enemy_id) > 0) {
             INFO("Destroyed enemy: " + std::to_string(enemy_id));
             EnemyDestroyPacket packet(enemy_id);
-            server->broadcast_packet(packet);
+            server->queue_broadcast(packet, std::nullopt, room_id);
         }
     }
 }
@@ -384,7 +570,7 @@ uint32_t ServerWorldManager::create_item_for_player_internal(uint32_t player_id)
     
     // Broadcast item pickup to all clients
     ItemPickupPacket packet(player_id, item);
-    server->broadcast_packet(packet);
+    server->queue_broadcast(packet, std::nullopt, room_id);
     
     INFO("Player " + std::to_string(player_id) + 
          " received item: " + item.item_name);
@@ -19,8 +19,14 @@
 #include <mutex>
 #include "PhysicsManager.h"
 #include "Game/World/Entities/Enemy.h"
+#include "Game/World/Systems/DeltaReplication.h"
+#include "Game/World/Systems/InboundQueue.h"
+#include "Game/World/Systems/SimulationLoop.h"
+#include "Game/World/Systems/SystemScheduler.h"
+#include "Networking/Server/ServerPeerlist.h"
 
 class Server;  // Forward declaration
+class JobSystem;
 
 /**
  * @brief Server-side world state manager.
@@ -29,10 +35,23 @@ class Server;  // Forward declaration
  */
 class ServerWorldManager {
 public:
-    ServerWorldManager(std::shared_ptr<Server> server);
-    ~ServerWorldManager() = default;
+    static constexpr int DEFAULT_TICK_RATE = 30;  // Simulation ticks per second when hosting from the game
+    static constexpr int AI_RATE = 20;  // Enemy AI updates per second (enemy_ai system rate)
+    static constexpr int REPLICATION_RATE = 30;  // Entity update broadcasts per second (replication system rate)
 
-    void update(float delta_time);  // Called every server tick
+    ServerWorldManager(std::shared_ptr<Server> server, RoomId room_id = DEFAULT_ROOM);  // Plays with the peers in room_id
+    ~ServerWorldManager();  // Stops the simulation thread
+
+    void update();  // One server tick, run by the simulation thread
+    void start_simulation(int tick_rate);  // Start ticking on the simulation thread
+    void set_tick_rate(int tick_rate);  // Rate update() is called at when something else ticks the world
+    void stop_simulation();  // Stop ticking, waits for the current tick to finish
+    void set_job_system(JobSystem& jobs);  // Spread the tick's loops over jobs instead of JobSystem::shared()
+    SimulationStats get_simulation_stats() const { return simulation.get_stats(); }
+    std::vector<SystemStats> get_system_stats() const { return scheduler.get_stats(); }  // Time spent in each system
+    void log_system_stats() const;  // Log the time spent in each system
+    RoomId get_room_id() const { return room_id; }
+    InboundQueue& get_inbound_queue() { return inbound_queue; }  // Packets applied at the start of the next update
     void clear();  // Clear all entities (e.g., when changing levels)
 
     void add_player(uint32_t peer_id, const std::string& name);
@@ -53,7 +72,8 @@ public:
 
     void broadcast_world_snapshot();  // Send full state to all clients
     void send_world_snapshot(ENetPeer* peer);  // Send full state to specific client
-    void broadcast_entity_updates();  // Send delta updates (called every tick)
+    void broadcast_entity_updates();  // Send delta updates (called on replication ticks)
+    void handle_snapshot_ack(uint32_t peer_id, uint32_t player_sequence, uint32_t enemy_sequence);  // Client acknowledged updates
 
     void handle_player_input(uint32_t peer_id, const ObjectTransform& input_transform);
     void handle_player_attack(uint32_t peer_id);
@@ -69,9 +89,12 @@ public:
 
 private:
    std::shared_ptr<Server> server;  // Reference to server for broadcasting
+   RoomId room_id;  // Broadcasts only reach the peers in this room
     
    // Thread synchronization for world state (recursive to allow nested locks from same thread)
    mutable std::recursive_mutex world_state_mutex;
+
+   InboundQueue inbound_queue;  // Decoded packets from the networking thread, drained by update()
     
    // World state
    std::unordered_map<uint32_t, Player> players;  // Keyed by peer_id
@@ -82,6 +105,7 @@ std::unordered_map<uint32_t, Enemy> enemies; // Keyed by enemy id
     
     // Entity ID generation
     uint32_t next_object_id = 1;
+    uint32_t next_enemy_id = 1;
     uint32_t next_item_id = 1;
     
     // Item drop configuration
@@ -92,13 +116,36 @@ std::unordered_map<uint32_t, Enemy> enemies; // Keyed by enemy id
     // Game start time for difficulty scaling
     std::chrono::steady_clock::time_point game_start_time;
     
-    // Update tracking
-    std::chrono::steady_clock::time_point last_update_time;
-    const float update_interval = 1.0f / 30.0f;  // 30 updates per second
+    // Tick tracking
+    uint64_t tick_count = 0;  // Ticks run since the world was created
+
+    // Delta replication
+    struct ClientReplicationState {
+        std::shared_ptr<const EntitySnapshot<PlayerUpdateData>> player_baseline;  // Newest player snapshot acked by the client
+        std::shared_ptr<const EntitySnapshot<EnemyUpdateData>> enemy_baseline;  // Newest enemy snapshot acked by the client
+    };
+    uint32_t replication_sequence = 0;  // Sequence of the last replication tick (0 is never used)
+    SnapshotHistory<PlayerUpdateData> player_history;  // Recent player snapshots, shared by all clients
+    SnapshotHistory<EnemyUpdateData> enemy_history;  // Recent enemy snapshots, shared by all clients
+    std::unordered_map<uint32_t, ClientReplicationState> replication_states;  // Keyed by peer_id
+    void send_entity_updates(uint32_t peer_id, const ClientReplicationState& state,
+        const EntitySnapshot<PlayerUpdateData>& player_snapshot, const EntitySnapshot<EnemyUpdateData>& enemy_snapshot);  // One client's deltas, on any thread
     
     // Helper methods
-    void collect_player_updates(std::vector<PlayerUpdateData>& updates);
-    void collect_enemy_updates(std::vector<EnemyUpdateData>& updates);
+    void collect_player_updates(EntityTable<PlayerUpdateData>& updates);  // Write changed players over the previous snapshot's
+    void collect_enemy_updates(EntityTable<EnemyUpdateData>& updates);  // Write changed enemies over the previous snapshot's
     bool validate_player_transform(const Player& player, const ObjectTransform& new_transform);
     uint32_t create_item_for_player_internal(uint32_t player_id);  // Internal version, must hold mutex
+
+    // Tick systems
+    void register_systems();  // Add every tick system to the scheduler
+    static constexpr size_t ENEMY_AI_GRAIN = 256;  // Enemies ticked per job system chunk
+    void update_enemy_ai(float delta_time);  // Move enemies towards players, in parallel
+    void update_attack_cooldowns();  // Clear attacking once a player's cooldown has passed
+
+    JobSystem* jobs = nullptr;  // Runs the tick's parallel loops, JobSystem::shared() if nullptr
+    JobSystem& get_job_system();
+
+    SystemScheduler scheduler;  // Runs each system at its own rate within a tick
+    SimulationLoop simulation;  // Runs update() at a fixed rate, last so it stops before the state it ticks is destroyed
 };
\ No newline at end of file
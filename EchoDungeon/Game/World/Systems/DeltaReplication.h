@@ -0,0 +1,292 @@
+#pragma once
+#include "Imports/common.h"
+#include <unordered_map>
+#include <array>
+#include <iterator>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+
+/**
+ * @brief Entity states keyed by id, split into shards that copies of the table share.
+ * Copying a table only copies its shard pointers. Writing to a shard another table still
+ * shares copies that shard first, so a snapshot built from an older one copies the few
+ * shards that changed and shares the rest with it.
+ */
+template <typename UpdateData>
+class EntityTable {
+public:
+	using Shard = std::unordered_map<uint32_t, UpdateData>;
+	static constexpr size_t SHARD_COUNT = 64; // Ids are spread over the shards by their low bits
+
+	// Walks every entity, shard by shard
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename Shard::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const value_type*;
+		using reference = const value_type&;
+
+		const_iterator(const EntityTable* _table, size_t _index) : table(_table), index(_index) {
+			if (index < SHARD_COUNT && table->shards[index]) entry = table->shards[index]->begin();
+			skip_finished_shards();
+		}
+
+		reference operator*() const { return *entry; }
+		pointer operator->() const { return &*entry; }
+
+		const_iterator& operator++() {
+			++entry;
+			skip_finished_shards();
+			return *this;
+		}
+
+		bool operator==(const const_iterator& other) const {
+			return index == other.index && (index == SHARD_COUNT || entry == other.entry);
+		}
+		bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+	private:
+		const EntityTable* table;
+		size_t index;
+		typename Shard::const_iterator entry;
+
+		void skip_finished_shards() {
+			while (index < SHARD_COUNT && (!table->shards[index] || entry == table->shards[index]->end())) {
+				if (++index < SHARD_COUNT && table->shards[index]) entry = table->shards[index]->begin();
+			}
+		}
+	};
+
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, SHARD_COUNT); }
+
+	// Entity with the given id, or nullptr
+	const UpdateData* find(uint32_t id) const {
+		const Shard* entries = shard(shard_of(id));
+		if (!entries) return nullptr;
+		auto it = entries->find(id);
+		return it == entries->end() ? nullptr : &it->second;
+	}
+
+	// Entity with the given id, inserted if missing
+	UpdateData& operator[](uint32_t id) {
+		return writable(shard_of(id))[id];
+	}
+
+	// Stores state under state.id, unless the stored entity has no changed fields, which keeps its shard shared
+	void update(const UpdateData& state) {
+		const UpdateData* stored = find(state.id);
+		if (stored && state.changed_fields(*stored) == 0) return;
+		(*this)[state.id] = state;
+	}
+
+	void erase(uint32_t id) {
+		if (find(id)) writable(shard_of(id)).erase(id);
+	}
+
+	// Erases every entity the predicate returns true for, copying only the shards it erases from
+	template <typename Predicate>
+	void erase_if(Predicate remove) {
+		for (size_t index = 0; index < SHARD_COUNT; index++) {
+			if (!shards[index]) continue;
+			auto matches = [&](const typename Shard::value_type& entry) { return remove(entry.first, entry.second); };
+			if (std::any_of(shards[index]->begin(), shards[index]->end(), matches)) {
+				std::erase_if(writable(index), matches);
+			}
+		}
+	}
+
+	size_t size() const {
+		size_t count = 0;
+		for (const auto& entries : shards) {
+			if (entries) count += entries->size();
+		}
+		return count;
+	}
+
+	// One shard's entities, or nullptr if it never held any
+	const Shard* shard(size_t index) const { return shards[index].get(); }
+
+	// The two tables hold the same copy of a shard, so its entities are identical
+	bool shares_shard(const EntityTable& other, size_t index) const { return shards[index] == other.shards[index]; }
+
+	static size_t shard_of(uint32_t id) { return id % SHARD_COUNT; }
+
+private:
+	std::array<std::shared_ptr<Shard>, SHARD_COUNT> shards;
+
+	// A shard this table can write to, copied first if another table shares it
+	Shard& writable(size_t index) {
+		std::shared_ptr<Shard>& entries = shards[index];
+		if (!entries) entries = std::make_shared<Shard>();
+		else if (entries.use_count() > 1) entries = std::make_shared<Shard>(*entries);
+		return *entries;
+	}
+};
+
+/**
+ * @brief Full replicated state of one entity type at a single replication tick.
+ * UpdateData is PlayerUpdateData or EnemyUpdateData.
+ */
+template <typename UpdateData>
+struct EntitySnapshot {
+	uint32_t sequence = 0; // Replication tick this snapshot was taken at
+	EntityTable<UpdateData> entities; // Full state, keyed by entity id, sharing unchanged shards with older snapshots
+};
+
+/**
+ * @brief Bounded history of recent snapshots, oldest first.
+ * Snapshots are immutable once pushed and shared, so the server keeps one history
+ * for all clients and each client only pins the snapshot it last acknowledged.
+ */
+template <typename UpdateData>
+class SnapshotHistory {
+public:
+	using Snapshot = EntitySnapshot<UpdateData>;
+
+	void push(std::shared_ptr<const Snapshot> snapshot) {
+		snapshots.push_back(std::move(snapshot));
+		while (snapshots.size() > MAX_SNAPSHOTS) {
+			snapshots.pop_front();
+		}
+	}
+
+	// Find a snapshot by sequence, or nullptr if it is too old (or was never recorded)
+	std::shared_ptr<const Snapshot> find(uint32_t sequence) const {
+		for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it) {
+			if ((*it)->sequence == sequence) return *it;
+			if ((*it)->sequence < sequence) break;
+		}
+		return nullptr;
+	}
+
+	// Newest snapshot, or nullptr if the history is empty
+	std::shared_ptr<const Snapshot> latest() const {
+		return snapshots.empty() ? nullptr : snapshots.back();
+	}
+
+	void clear() { snapshots.clear(); }
+
+private:
+	static constexpr size_t MAX_SNAPSHOTS = 64; // ~2 seconds at ServerWorldManager::REPLICATION_RATE (30 Hz)
+	std::deque<std::shared_ptr<const Snapshot>> snapshots;
+};
+
+/**
+ * @brief Field-level delta encoding of entity snapshots against an acknowledged baseline.
+ * UpdateData provides `fields`, `ALL_FIELDS`, `changed_fields(baseline)` and `apply_delta(delta)`.
+ */
+template <typename UpdateData>
+class DeltaReplication {
+public:
+	using Snapshot = EntitySnapshot<UpdateData>;
+
+	/**
+	 * @brief Builds the delta from baseline to current.
+	 * Unchanged entities are omitted, changed entities carry only their changed fields,
+	 * and entities missing from the baseline are sent in full.
+	 * @param baseline The snapshot the receiver has acknowledged, or nullptr for a full update.
+	 * @param current The snapshot to encode.
+	 * @param updates Output list of (partial) entity updates.
+	 * @param removed Output list of entity ids in the baseline that are gone from current.
+	 */
+	static void encode(const Snapshot* baseline, const Snapshot& current,
+		std::vector<UpdateData>& updates, std::vector<uint32_t>& removed) {
+		using Table = EntityTable<UpdateData>;
+		for (size_t index = 0; index < Table::SHARD_COUNT; index++) {
+			if (baseline && current.entities.shares_shard(baseline->entities, index)) continue; // Nothing in it changed
+
+			const typename Table::Shard* entries = current.entities.shard(index);
+			const typename Table::Shard* baseline_entries = baseline ? baseline->entities.shard(index) : nullptr;
+			if (entries) {
+				for (const auto& [id, state] : *entries) {
+					auto fields = UpdateData::ALL_FIELDS;
+					if (baseline_entries) {
+						auto it = baseline_entries->find(id);
+						if (it != baseline_entries->end()) {
+							fields = state.changed_fields(it->second);
+							if (fields == 0) continue; // Unchanged since the baseline
+						}
+					}
+
+					updates.push_back(state);
+					updates.back().fields = fields;
+				}
+			}
+
+			if (!baseline_entries) continue;
+			for (const auto& [id, state] : *baseline_entries) {
+				if (!entries || entries->find(id) == entries->end()) {
+					removed.push_back(id);
+				}
+			}
+		}
+
+		// Sorted ids make the id column (written as differences) small
+		std::sort(updates.begin(), updates.end(),
+			[](const UpdateData& a, const UpdateData& b) { return a.id < b.id; });
+	}
+
+	/**
+	 * @brief Reconstructs the full snapshot described by a delta.
+	 * @param baseline The snapshot the delta was encoded against, or nullptr for a full update.
+	 * @param sequence The sequence of the reconstructed snapshot.
+	 * @param updates The (partial) entity updates from the packet.
+	 * @param removed The removed entity ids from the packet.
+	 * @return The reconstructed snapshot.
+	 */
+	static std::shared_ptr<Snapshot> decode(const Snapshot* baseline, uint32_t sequence,
+		const std::vector<UpdateData>& updates, const std::vector<uint32_t>& removed) {
+		auto snapshot = std::make_shared<Snapshot>();
+		snapshot->sequence = sequence;
+		if (baseline) {
+			snapshot->entities = baseline->entities; // Shares every shard, only the ones written below are copied
+		}
+
+		for (uint32_t id : removed) {
+			snapshot->entities.erase(id);
+		}
+
+		for (const UpdateData& delta : updates) {
+			bool is_new = snapshot->entities.find(delta.id) == nullptr;
+			UpdateData& state = snapshot->entities[delta.id];
+			if (is_new) {
+				state = delta; // New entity, the delta holds every field
+			}
+			else {
+				state.apply_delta(delta);
+			}
+			state.fields = UpdateData::ALL_FIELDS;
+		}
+
+		return snapshot;
+	}
+
+	/**
+	 * @brief Calls apply(state) for every entity in current that is new or changed since previous.
+	 * Shards current still shares with previous are skipped without looking at their entities.
+	 * @param previous The snapshot applied before, or nullptr to visit every entity.
+	 * @param current The snapshot being applied.
+	 */
+	template <typename Apply>
+	static void for_each_changed(const Snapshot* previous, const Snapshot& current, Apply&& apply) {
+		using Table = EntityTable<UpdateData>;
+		for (size_t index = 0; index < Table::SHARD_COUNT; index++) {
+			const typename Table::Shard* entries = current.entities.shard(index);
+			if (!entries) continue;
+			if (previous && current.entities.shares_shard(previous->entities, index)) continue;
+
+			const typename Table::Shard* previous_entries = previous ? previous->entities.shard(index) : nullptr;
+			for (const auto& [id, state] : *entries) {
+				if (previous_entries) {
+					auto it = previous_entries->find(id);
+					if (it != previous_entries->end() && state.changed_fields(it->second) == 0) continue;
+				}
+				apply(state);
+			}
+		}
+	}
+};
@@ -0,0 +1,70 @@
+#include "InboundQueue.h"
+#include "Networking/NetworkUser.h"
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief Queues a message to run at the start of the world manager's next update.
+ * A full queue drops droppable messages. Other messages wait up to INBOUND_QUEUE_FULL_WAIT_MS
+ * for the update to drain it, then run here instead so a stalled update can never block
+ * the networking thread (eg while the server is being stopped).
+ * Threads that run no networking loop share one list, as a ring only takes one producer.
+ * @param message The message to run.
+ * @param droppable Whether the message may be dropped when the queue is full.
+ */
+void InboundQueue::post(Message message, bool droppable) {
+	if (!NetworkConstants::QUEUE_WORLD_PACKETS) {
+		message();
+		return;
+	}
+
+	if (!NetworkUser::on_networking_thread()) {
+		std::lock_guard<std::mutex> lock(other_threads_mutex);
+		other_threads.push_back(std::move(message));
+		return;
+	}
+
+	Ring& ring = rings[NetworkUser::current_shard() % rings.size()];
+	if (ring.push(message)) return;
+
+	if (droppable) {
+		TRACE("Inbound queue full, dropping state message");
+		return;
+	}
+
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(NetworkConstants::INBOUND_QUEUE_FULL_WAIT_MS);
+	while (std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::yield();
+		if (ring.push(message)) return;
+	}
+
+	WARNING("Inbound queue still full, applying event on the networking thread");
+	message();
+}
+
+/**
+ * @brief Runs every queued message, each networking thread's in the order they were posted.
+ * At most one ring's worth runs per ring and call, so a busy network cannot keep the update from finishing.
+ * @return The number of messages run.
+ */
+size_t InboundQueue::drain() {
+	size_t count = 0;
+	Message message;
+	for (Ring& ring : rings) {
+		for (size_t pending = NetworkConstants::INBOUND_QUEUE_CAPACITY; pending > 0 && ring.pop(message); pending--) {
+			message();
+			count++;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(other_threads_mutex);
+		other_threads_draining.swap(other_threads); // Messages posted while these run wait for the next call
+	}
+	for (Message& posted : other_threads_draining) {
+		posted();
+		count++;
+	}
+	other_threads_draining.clear();
+	return count;
+}
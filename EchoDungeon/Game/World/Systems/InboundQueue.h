@@ -0,0 +1,43 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/NetworkConstants.h"
+#include "Utils/SpscRing.h"
+#include <array>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Hands decoded world packets from the networking thread to a world manager's update.
+ *
+ * With NetworkConstants::QUEUE_WORLD_PACKETS on, packet handlers post() a message that applies
+ * the packet, and the world manager runs every posted message in arrival order at the start of
+ * its update(). The simulation then never waits on the networking thread for its state, and
+ * each tick sees exactly the packets that arrived before it began.
+ * With it off, post() applies the packet straight away, as before.
+ *
+ * Each server shard's networking thread posts into its own ring, so several threads can feed
+ * one simulation without sharing a producer index. A client is only ever serviced by one shard,
+ * so its messages still run in the order they arrived. Threads that run no networking loop
+ * (eg DEFERRED or POOL event callbacks) post into a list behind a mutex instead, as any number
+ * of them may post at once.
+ */
+class InboundQueue {
+public:
+	using Message = std::function<void()>;
+
+	// Queue a message, from any thread. Droppable messages (unreliable state that the next
+	// update supersedes) are discarded when a networking thread's ring is full, anything else is kept.
+	void post(Message message, bool droppable = false);
+
+	// Run every queued message (world manager update thread only). Returns how many ran.
+	size_t drain();
+
+private:
+	using Ring = SpscRing<Message, NetworkConstants::INBOUND_QUEUE_CAPACITY>;
+	std::array<Ring, NetworkConstants::SERVER_SHARDS> rings; // One per networking thread, see NetworkUser::current_shard()
+
+	std::mutex other_threads_mutex;
+	std::vector<Message> other_threads; // Posted from threads that run no networking loop
+	std::vector<Message> other_threads_draining; // Swapped with other_threads by drain(), keeps both lists' capacity
+};
@@ -184,7 +184,7 @@ float ItemGenerator::get_difficulty_multiplier(uint64_t game_time_ms) {
 	// ~4.5x at 1800s (30 min)
 
 	// Cap at 10.0x
-	return min(multiplier, 5.0f);
+	return (std::min)(multiplier, 5.0f);
 }
 
 std::string ItemGenerator::generate_item_name(const ItemEffects& effects, std::vector<float> dist_rolls, float difficulty) {
@@ -1,4 +1,5 @@
 #include "LevelGenerator.h"
+#include "Game/World/Managers/ServerWorldManager.h"
 
 void LevelGenerator::generate_level(ServerWorldManager& manager) {
 	raylib::Color obstacle_color = { 110, 110, 110, 250 };
@@ -6,21 +7,23 @@ void LevelGenerator::generate_level(ServerWorldManager& manager) {
 	//	will be visible 
 	
 	// ===== BORDER WALLS =====
+	// Centred just outside the floor, scale is half the size on each axis
+	const float wall_offset = HALF_EXTENT + WALL_HALF_THICKNESS;
 	// Left wall
 	manager.spawn_object(ObjectType::MODEL, "cube",
-		{ -25.5f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.5f, 0.5f, 25.0f },
+		{ -wall_offset, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { WALL_HALF_THICKNESS, 0.5f, HALF_EXTENT },
 		obstacle_color);
 	// Right wall
 	manager.spawn_object(ObjectType::MODEL, "cube",
-		{ 25.5f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.5f, 0.5f, 25.0f },
+		{ wall_offset, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { WALL_HALF_THICKNESS, 0.5f, HALF_EXTENT },
 		obstacle_color);
 	// Top wall
 	manager.spawn_object(ObjectType::MODEL, "cube",
-		{ 0.0f, 1.0f, -25.5f }, { 0.0f, 0.0f, 0.0f }, { 25.0f, 0.5f, 0.5f },
+		{ 0.0f, 1.0f, -wall_offset }, { 0.0f, 0.0f, 0.0f }, { HALF_EXTENT, 0.5f, WALL_HALF_THICKNESS },
 		obstacle_color);
 	// Bottom wall
 	manager.spawn_object(ObjectType::MODEL, "cube",
-		{ 0.0f, 1.0f, 25.5f }, { 0.0f, 0.0f, 0.0f }, { 25.0f, 0.5f, 0.5f },
+		{ 0.0f, 1.0f, wall_offset }, { 0.0f, 0.0f, 0.0f }, { HALF_EXTENT, 0.5f, WALL_HALF_THICKNESS },
 		obstacle_color);
 
 	// (A) Top-left L-shape
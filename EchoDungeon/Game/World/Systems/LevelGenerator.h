@@ -1,9 +1,14 @@
 #pragma once
 #include "Imports/common.h"
-#include "Game/World/Managers/ServerWorldManager.h"
+
+class ServerWorldManager;
 
 class LevelGenerator {
 public:
+	static constexpr float HALF_EXTENT = 25.0f; // The floor spans -HALF_EXTENT to HALF_EXTENT on X and Z, inside the border walls
+	static constexpr float WALL_HALF_THICKNESS = 0.5f;
+	static constexpr float OUTER_EXTENT = HALF_EXTENT + 2.0f * WALL_HALF_THICKNESS; // Outside faces of the border walls
+
 	static void generate_level(ServerWorldManager& manager);
 
 };
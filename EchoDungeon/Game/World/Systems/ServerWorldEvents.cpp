@@ -0,0 +1,153 @@
+#include "ServerWorldEvents.h"
+#include "Networking/Server/Server.h"
+#include "Game/World/Managers/ServerWorldManager.h"
+
+/**
+ * @brief Posts a message to the inbound queue of the world attached to a room.
+ * Packets from a room with no world (eg a peer still in the lobby) are dropped.
+ * @param room_id The sender's room.
+ * @param apply Applies the packet to the world, on the world's simulation thread.
+ * @param droppable Whether the message may be dropped when the queue is full, see InboundQueue::post.
+ */
+template <typename Apply>
+void ServerWorldEvents::post(RoomId room_id, Apply apply, bool droppable) {
+	std::shared_lock<std::shared_mutex> lock(worlds_mutex);
+	auto it = worlds.find(room_id);
+	if (it == worlds.end()) return;
+
+	ServerWorldManager* world = it->second;
+	world->get_inbound_queue().post([world, apply = std::move(apply)]() { apply(*world); }, droppable);
+}
+
+/**
+ * @brief Registers the server packet callbacks that feed the attached worlds.
+ * Packets are applied by their world's update(), see InboundQueue. Peers are looked up here,
+ * while the ENetPeer is known to still be theirs, and the lookup gives the room to route to.
+ * @param _server The server whose packets to handle.
+ */
+ServerWorldEvents::ServerWorldEvents(Server& _server) : server(_server) {
+	// PlayerInput - Client sends their movement/transform (droppable, the next input supersedes it)
+	player_input_sub = ServerEvents::PlayerInputEvent::register_callback(
+		[this](const ServerEvents::PlayerInputEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.peer);
+			if (peer_opt.has_value()) {
+				uint16_t peer_id = peer_opt.value().data.server_side_id;
+				post(peer_opt.value().room_id, [peer_id, transform = data.packet.transform](ServerWorldManager& world) {
+					world.handle_player_input(peer_id, transform);
+				}, true);
+			}
+		}
+	);
+
+	// RequestWorldSnapshot - Client requests full world state
+	request_snapshot_sub = ServerEvents::RequestWorldSnapshotEvent::register_callback(
+		[this](const ServerEvents::RequestWorldSnapshotEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.peer);
+			if (!peer_opt.has_value()) return;
+			post(peer_opt.value().room_id, [peer = data.peer](ServerWorldManager& world) {
+				// Send world snapshot to the requesting client only
+				world.send_world_snapshot(peer);
+				TRACE("Sent world snapshot to peer");
+			});
+		}
+	);
+
+	// PlayerAttack - Client attacks
+	player_attack_sub = ServerEvents::PlayerAttackEvent::register_callback(
+		[this](const ServerEvents::PlayerAttackEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.peer);
+			if (peer_opt.has_value()) {
+				uint16_t peer_id = peer_opt.value().data.server_side_id;
+				post(peer_opt.value().room_id, [peer_id](ServerWorldManager& world) {
+					world.handle_player_attack(peer_id);
+					TRACE("Player attacked: ID=" + std::to_string(peer_id));
+				});
+			}
+		}
+	);
+
+	// Player disconnect - Remove player from world
+	player_disconnect_sub = ServerEvents::DisconnectEvent::register_callback(
+		[this](const ServerEvents::DisconnectEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.event.peer);
+			if (peer_opt.has_value()) {
+				uint16_t peer_id = peer_opt.value().data.server_side_id;
+				post(peer_opt.value().room_id, [peer_id](ServerWorldManager& world) {
+					world.remove_player(peer_id);
+					TRACE("Removed disconnected player: ID=" + std::to_string(peer_id));
+				});
+			}
+		}
+	);
+
+	// Player disconnect timeout - Remove player from world
+	player_disconnect_timeout_sub = ServerEvents::DisconnectTimeoutEvent::register_callback(
+		[this](const ServerEvents::DisconnectTimeoutEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.event.peer);
+			if (peer_opt.has_value()) {
+				uint16_t peer_id = peer_opt.value().data.server_side_id;
+				post(peer_opt.value().room_id, [peer_id](ServerWorldManager& world) {
+					world.remove_player(peer_id);
+					TRACE("Removed timed-out player: ID=" + std::to_string(peer_id));
+				});
+			}
+		}
+	);
+
+	// ItemDiscard - Player discards an item
+	item_discard_sub = ServerEvents::ItemDiscardEvent::register_callback(
+		[this](const ServerEvents::ItemDiscardEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.peer);
+			if (!peer_opt.has_value()) return;
+			post(peer_opt.value().room_id,
+				[peer_id = peer_opt.value().data.server_side_id, item_id = data.packet.item_id](ServerWorldManager& world) {
+					world.handle_item_discard(peer_id, item_id);
+				});
+		}
+	);
+
+	// SnapshotAck - Client acknowledged entity updates, advance its delta baseline (droppable, acks are cumulative)
+	snapshot_ack_sub = ServerEvents::SnapshotAckEvent::register_callback(
+		[this](const ServerEvents::SnapshotAckEventData& data) {
+			auto peer_opt = server.peers.get_peer_by_enet(data.peer);
+			if (!peer_opt.has_value()) return;
+			post(peer_opt.value().room_id,
+				[peer_id = peer_opt.value().data.server_side_id,
+				player_sequence = data.packet.player_sequence, enemy_sequence = data.packet.enemy_sequence](ServerWorldManager& world) {
+					world.handle_snapshot_ack(peer_id, player_sequence, enemy_sequence);
+				}, true);
+		}
+	);
+}
+
+/**
+ * @brief Unregisters every callback, so no more packets are posted to any world.
+ */
+ServerWorldEvents::~ServerWorldEvents() {
+	ServerEvents::PlayerInputEvent::unregister_callback(player_input_sub);
+	ServerEvents::RequestWorldSnapshotEvent::unregister_callback(request_snapshot_sub);
+	ServerEvents::PlayerAttackEvent::unregister_callback(player_attack_sub);
+	ServerEvents::DisconnectEvent::unregister_callback(player_disconnect_sub);
+	ServerEvents::DisconnectTimeoutEvent::unregister_callback(player_disconnect_timeout_sub);
+	ServerEvents::ItemDiscardEvent::unregister_callback(item_discard_sub);
+	ServerEvents::SnapshotAckEvent::unregister_callback(snapshot_ack_sub);
+}
+
+/**
+ * @brief Starts routing the packets of the peers in a room to a world.
+ * @param room_id The room whose peers play in world.
+ * @param world The world to post their packets to. Must stay alive until detach(room_id).
+ */
+void ServerWorldEvents::attach(RoomId room_id, ServerWorldManager& world) {
+	std::unique_lock<std::shared_mutex> lock(worlds_mutex);
+	worlds[room_id] = &world;
+}
+
+/**
+ * @brief Stops routing a room's packets. Once this returns, no callback is posting to the room's world.
+ * @param room_id The room to detach.
+ */
+void ServerWorldEvents::detach(RoomId room_id) {
+	std::unique_lock<std::shared_mutex> lock(worlds_mutex);
+	worlds.erase(room_id);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Imports/common.h"
+#include "Game/Events/EventList.h"
+#include "Networking/Server/ServerPeerlist.h"
+#include <shared_mutex>
+#include <unordered_map>
+
+class Server;
+class ServerWorldManager;
+
+/**
+ * @brief Hands the server's world packets (input, attacks, snapshot requests, disconnects) to the ServerWorldManager of each sender's room.
+ *
+ * One instance registers the callbacks for the whole server, however many rooms it runs; each
+ * packet is posted to the world attached to its sender's room, so the callback lists do not grow
+ * with the number of rooms. Attach a world once it exists and detach it before destroying it.
+ * Used by the World state when hosting (one world, in DEFAULT_ROOM) and by the dedicated server.
+ */
+class ServerWorldEvents {
+public:
+	ServerWorldEvents(Server& server); // Register the callbacks
+	~ServerWorldEvents(); // Unregister the callbacks
+
+	ServerWorldEvents(const ServerWorldEvents&) = delete;
+	ServerWorldEvents& operator=(const ServerWorldEvents&) = delete;
+
+	void attach(RoomId room_id, ServerWorldManager& world); // Route the room's packets to world
+	void detach(RoomId room_id); // Stop routing the room's packets, waits for posts in progress
+
+private:
+	Server& server; // Server the packets arrive on, used to look up their senders
+	std::unordered_map<RoomId, ServerWorldManager*> worlds; // World of each room being played
+	std::shared_mutex worlds_mutex; // Networking threads post under a shared lock
+
+	template <typename Apply>
+	void post(RoomId room_id, Apply apply, bool droppable = false); // Post to the world of room_id, if it has one
+
+	// Event subscription IDs
+	int player_input_sub = -1;
+	int request_snapshot_sub = -1;
+	int player_attack_sub = -1;
+	int player_disconnect_sub = -1;
+	int player_disconnect_timeout_sub = -1;
+	int item_discard_sub = -1;
+	int snapshot_ack_sub = -1;
+};
@@ -0,0 +1,121 @@
+#include "SimulationLoop.h"
+
+/**
+ * @brief Creates a stopped loop.
+ * @param tick Function that advances the simulation by the delta time it is given.
+ */
+SimulationLoop::SimulationLoop(Tick tick) : tick(std::move(tick)) {}
+
+SimulationLoop::~SimulationLoop() {
+	stop();
+}
+
+/**
+ * @brief Starts the simulation thread. Does nothing if the loop is already running.
+ * @param tick_rate Ticks per second, eg 20, 30 or 60.
+ */
+void SimulationLoop::start(int tick_rate) {
+	if (running.load()) return;
+	if (tick_rate <= 0) {
+		ERROR("Invalid simulation tick rate: " + std::to_string(tick_rate));
+		return;
+	}
+
+	this->tick_rate = tick_rate;
+	{
+		std::lock_guard<std::mutex> lock(stats_mutex);
+		stats = SimulationStats();
+	}
+
+	running.store(true);
+	thread = std::thread(&SimulationLoop::run, this);
+	INFO("Simulation started at " + std::to_string(tick_rate) + " ticks per second");
+}
+
+/**
+ * @brief Stops the simulation thread and logs its stats. The tick running when called finishes first.
+ */
+void SimulationLoop::stop() {
+	{
+		std::lock_guard<std::mutex> lock(wake_mutex);
+		if (!running.exchange(false)) return;
+	}
+	wake.notify_all();
+
+	if (thread.joinable()) {
+		thread.join();
+	}
+
+	SimulationStats final_stats = get_stats();
+	double mean_tick_ms = final_stats.ticks > 0 ? final_stats.total_tick_ms / final_stats.ticks : 0.0;
+	INFO("Simulation stopped after " + std::to_string(final_stats.ticks) + " ticks"
+		+ " (mean " + std::to_string(mean_tick_ms) + "ms, max " + std::to_string(final_stats.max_tick_ms) + "ms"
+		+ ", overruns " + std::to_string(final_stats.overruns)
+		+ ", dropped " + std::to_string(final_stats.dropped_ticks) + ")");
+}
+
+/**
+ * @brief Gets the loop's timing since it was last started.
+ * @return A copy of the stats, safe to read from any thread.
+ */
+SimulationStats SimulationLoop::get_stats() const {
+	std::lock_guard<std::mutex> lock(stats_mutex);
+	return stats;
+}
+
+/**
+ * @brief Accumulates wall time and runs one tick per whole interval of it until stopped.
+ */
+void SimulationLoop::run() {
+	const float delta_time = 1.0f / tick_rate;
+	const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(1.0 / tick_rate));
+
+	auto previous = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::duration accumulator = interval; // Tick straight away
+
+	while (running.load()) {
+		auto now = std::chrono::steady_clock::now();
+		accumulator += now - previous;
+		previous = now;
+
+		int ran = 0;
+		while (accumulator >= interval && ran < MAX_CATCH_UP_TICKS && running.load()) {
+			run_tick(interval, delta_time);
+			accumulator -= interval;
+			ran++;
+		}
+
+		// Too far behind to catch up, let the simulation lag real time instead
+		if (accumulator >= interval) {
+			uint64_t behind = accumulator / interval;
+			accumulator -= interval * behind;
+			drop_ticks(behind);
+		}
+
+		// Wait for the next tick to be due (or for stop())
+		std::unique_lock<std::mutex> lock(wake_mutex);
+		wake.wait_until(lock, previous + (interval - accumulator), [this]() { return !running.load(); });
+	}
+}
+
+void SimulationLoop::run_tick(std::chrono::steady_clock::duration interval, float delta_time) {
+	auto start = std::chrono::steady_clock::now();
+	tick(delta_time);
+	auto duration = std::chrono::steady_clock::now() - start;
+
+	double duration_ms = std::chrono::duration<double, std::milli>(duration).count();
+	std::lock_guard<std::mutex> lock(stats_mutex);
+	stats.ticks++;
+	stats.total_tick_ms += duration_ms;
+	stats.max_tick_ms = (std::max)(stats.max_tick_ms, duration_ms);
+	if (duration > interval) {
+		stats.overruns++;
+	}
+}
+
+void SimulationLoop::drop_ticks(uint64_t count) {
+	std::lock_guard<std::mutex> lock(stats_mutex);
+	stats.dropped_ticks += count;
+	WARNING("Simulation fell behind, dropped " + std::to_string(count) + " ticks (" + std::to_string(stats.dropped_ticks) + " in total)");
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Imports/common.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Timing of a SimulationLoop since it was started
+struct SimulationStats {
+	uint64_t ticks = 0; // Ticks run
+	uint64_t overruns = 0; // Ticks that took longer than one tick interval to run
+	uint64_t dropped_ticks = 0; // Ticks skipped because the loop fell more than MAX_CATCH_UP_TICKS behind
+	double total_tick_ms = 0.0; // Time spent running ticks
+	double max_tick_ms = 0.0; // Longest tick
+};
+
+/**
+ * @brief Runs a fixed-timestep simulation on its own thread.
+ *
+ * Wall time accumulates between iterations, and the tick function runs once per whole tick
+ * interval accumulated, always with the same delta time. Simulation speed therefore never
+ * depends on how often anything else (eg the render loop) runs. A loop that falls behind runs
+ * at most MAX_CATCH_UP_TICKS ticks back to back, then drops the rest of the backlog rather than
+ * spiralling further behind; the dropped ticks and overlong ticks are counted in the stats.
+ */
+class SimulationLoop {
+public:
+	using Tick = std::function<void(float)>;
+
+	static constexpr int MAX_CATCH_UP_TICKS = 5; // Most ticks run back to back before the backlog is dropped
+
+	SimulationLoop(Tick tick);
+	~SimulationLoop(); // Stops the loop
+
+	SimulationLoop(const SimulationLoop&) = delete;
+	SimulationLoop& operator=(const SimulationLoop&) = delete;
+
+	void start(int tick_rate); // Start ticking tick_rate times a second (no-op if running)
+	void stop(); // Stop ticking, waits for the current tick to finish
+
+	bool is_running() const { return running.load(); }
+	int get_tick_rate() const { return tick_rate; }
+	SimulationStats get_stats() const; // Copy of the stats since the last start()
+
+private:
+	Tick tick; // Runs one tick, given the fixed delta time
+	int tick_rate = 0; // Ticks per second of the current run
+
+	std::thread thread; // Runs run()
+	std::atomic<bool> running = false;
+	std::mutex wake_mutex; // Guards the wait between ticks
+	std::condition_variable wake; // Notified by stop() to end the wait early
+
+	mutable std::mutex stats_mutex;
+	SimulationStats stats;
+
+	void run(); // Loop body, on the simulation thread
+	void run_tick(std::chrono::steady_clock::duration interval, float delta_time); // Run and time one tick
+	void drop_ticks(uint64_t count); // Record ticks skipped to catch up
+};
@@ -0,0 +1,147 @@
+#include "SimulationPool.h"
+
+/**
+ * @brief Starts the pool's threads, with no simulations to tick yet.
+ * @param thread_count Number of threads, or 0 for one per hardware thread.
+ */
+SimulationPool::SimulationPool(size_t thread_count) {
+	if (thread_count == 0) {
+		thread_count = (std::max)(1u, std::thread::hardware_concurrency());
+	}
+
+	threads.reserve(thread_count);
+	for (size_t i = 0; i < thread_count; i++) {
+		threads.emplace_back(&SimulationPool::run, this);
+	}
+	INFO("Simulation pool started with " + std::to_string(thread_count) + " threads");
+}
+
+SimulationPool::~SimulationPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	changed.notify_all();
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+/**
+ * @brief Adds a simulation, its first tick is due straight away.
+ * @param tick_rate Ticks per second.
+ * @param tick Runs one tick. Never called on two threads at once.
+ * @return The simulation's ID, for remove() and get_stats(). 0 if tick_rate is invalid.
+ */
+SimulationPool::SimulationId SimulationPool::add(int tick_rate, Tick tick) {
+	if (tick_rate <= 0) {
+		ERROR("Invalid simulation tick rate: " + std::to_string(tick_rate));
+		return 0;
+	}
+
+	Simulation simulation;
+	simulation.tick = std::move(tick);
+	simulation.interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(1.0 / tick_rate));
+	simulation.next_tick = std::chrono::steady_clock::now();
+
+	SimulationId id;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		id = next_id++;
+		simulations.emplace(id, std::move(simulation));
+	}
+	changed.notify_all();
+	return id;
+}
+
+/**
+ * @brief Removes a simulation. Once this returns its tick is not running and will not run again.
+ * @param id The simulation to remove.
+ */
+void SimulationPool::remove(SimulationId id) {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		auto it = simulations.find(id);
+		if (it == simulations.end()) return;
+
+		// Adding simulations may rehash the map and invalidate it, but not the element itself
+		const Simulation& simulation = it->second;
+		changed.wait(lock, [&simulation]() { return !simulation.ticking; });
+		simulations.erase(id);
+	}
+	changed.notify_all();
+}
+
+/**
+ * @brief Gets one simulation's timing since it was added.
+ * @param id The simulation.
+ * @return A copy of its stats, or empty stats if there is no such simulation.
+ */
+SimulationStats SimulationPool::get_stats(SimulationId id) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = simulations.find(id);
+	return it != simulations.end() ? it->second.stats : SimulationStats();
+}
+
+/**
+ * @brief Repeatedly runs the tick of the most overdue simulation no other thread is ticking.
+ */
+void SimulationPool::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (!stopping) {
+		Simulation* next = nullptr;
+		for (auto& [id, simulation] : simulations) {
+			if (!simulation.ticking && (next == nullptr || simulation.next_tick < next->next_tick)) {
+				next = &simulation;
+			}
+		}
+
+		if (next == nullptr) {
+			changed.wait(lock);
+			continue;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		if (next->next_tick > now) {
+			changed.wait_until(lock, next->next_tick);
+			continue;
+		}
+
+		// Too far behind to catch up, let the simulation lag real time instead
+		uint64_t behind = (now - next->next_tick) / next->interval;
+		if (behind > SimulationLoop::MAX_CATCH_UP_TICKS) {
+			uint64_t dropped = behind - SimulationLoop::MAX_CATCH_UP_TICKS;
+			next->next_tick += next->interval * dropped;
+			next->stats.dropped_ticks += dropped;
+
+			// An overloaded pool drops ticks on most passes, so warn at most once a second per simulation
+			if (now - next->last_drop_warning >= std::chrono::seconds(1)) {
+				next->last_drop_warning = now;
+				WARNING("Simulation fell behind, dropped " + std::to_string(next->stats.dropped_ticks) + " ticks in total");
+			}
+		}
+
+		next->ticking = true;
+		lock.unlock();
+
+		auto start = std::chrono::steady_clock::now();
+		next->tick();
+		auto duration = std::chrono::steady_clock::now() - start;
+
+		lock.lock();
+		double duration_ms = std::chrono::duration<double, std::milli>(duration).count();
+		next->stats.ticks++;
+		next->stats.total_tick_ms += duration_ms;
+		next->stats.max_tick_ms = (std::max)(next->stats.max_tick_ms, duration_ms);
+		if (duration > next->interval) {
+			next->stats.overruns++;
+		}
+
+		next->next_tick += next->interval;
+		next->ticking = false;
+		changed.notify_all();
+	}
+}
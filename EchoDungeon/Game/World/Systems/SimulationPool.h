@@ -0,0 +1,56 @@
+#pragma once
+#include "Imports/common.h"
+#include "Game/World/Systems/SimulationLoop.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Ticks many fixed-rate simulations (eg one world per game room) on a fixed set of threads.
+ *
+ * Each simulation keeps its own tick rate and next tick time. An idle thread takes the simulation
+ * whose tick is the most overdue, runs that one tick and hands the simulation back, so a simulation
+ * only ever ticks on one thread at a time, though successive ticks may run on different threads.
+ * As with SimulationLoop, a simulation more than SimulationLoop::MAX_CATCH_UP_TICKS behind drops
+ * the rest of its backlog.
+ */
+class SimulationPool {
+public:
+	using Tick = std::function<void()>;
+	using SimulationId = uint32_t;
+
+	explicit SimulationPool(size_t thread_count); // 0 for one thread per hardware thread
+	~SimulationPool(); // Stops the threads, waiting for ticks in progress
+
+	SimulationPool(const SimulationPool&) = delete;
+	SimulationPool& operator=(const SimulationPool&) = delete;
+
+	SimulationId add(int tick_rate, Tick tick); // Start ticking tick_rate times a second, from now
+	void remove(SimulationId id); // Stop ticking, waits for a tick in progress to finish
+	SimulationStats get_stats(SimulationId id) const; // Timing of one simulation (empty if unknown)
+	size_t get_thread_count() const { return threads.size(); }
+
+private:
+	struct Simulation {
+		Tick tick;
+		std::chrono::steady_clock::duration interval; // Time between ticks
+		std::chrono::steady_clock::time_point next_tick; // When the next tick is due
+		std::chrono::steady_clock::time_point last_drop_warning; // When dropped ticks were last logged
+		bool ticking = false; // A thread is running its tick right now
+		SimulationStats stats;
+	};
+
+	mutable std::mutex mutex; // Guards everything below
+	std::condition_variable changed; // A simulation was added, removed or finished a tick, or the pool is stopping
+	std::unordered_map<SimulationId, Simulation> simulations; // Node based, so a ticking simulation stays put
+	SimulationId next_id = 1;
+	bool stopping = false;
+
+	std::vector<std::thread> threads;
+
+	void run(); // Thread body
+};
@@ -0,0 +1,194 @@
+#include "SystemScheduler.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief Adds a system. Call before the simulation starts, then set_tick_rate().
+ * @param name Name shown in the stats.
+ * @param rate Runs per second, or EVERY_TICK.
+ * @param phase Ticks to offset the system's runs by, to keep it off the ticks other systems run on.
+ * @param reads WorldData the system reads.
+ * @param writes WorldData the system writes.
+ * @param run Runs the system, given the time since its last run.
+ */
+void SystemScheduler::add_system(const std::string& name, float rate, uint32_t phase, uint32_t reads, uint32_t writes, Run run) {
+	systems.push_back({ name, rate, phase, reads, writes, std::move(run) });
+	sort_systems();
+
+	if (tick_rate > 0) {
+		set_tick_rate(tick_rate);
+	}
+	else {
+		std::lock_guard<std::mutex> lock(stats_mutex);
+		stats.emplace_back().name = name;
+	}
+}
+
+/**
+ * @brief Works out how often each system runs, and resets the stats.
+ * A system runs on rate / tick_rate of the ticks. A system asking for more than the tick rate
+ * cannot run more than once per tick, so it is clamped to every tick with a warning.
+ * @param tick_rate Simulation ticks per second.
+ */
+void SystemScheduler::set_tick_rate(int tick_rate) {
+	this->tick_rate = tick_rate;
+
+	std::lock_guard<std::mutex> lock(stats_mutex);
+	stats.assign(systems.size(), SystemStats());
+
+	for (size_t i = 0; i < systems.size(); i++) {
+		System& system = systems[i];
+		if (system.rate <= EVERY_TICK) {
+			system.run_rate = tick_rate;
+		}
+		else {
+			if (system.rate > tick_rate) {
+				std::ostringstream oss;
+				oss << "System " << system.name << " asks for " << system.rate << "Hz, more than the "
+					<< tick_rate << "Hz tick rate, it runs once every tick instead";
+				WARNING(oss.str());
+			}
+			system.run_rate = (std::min)(static_cast<double>(system.rate), static_cast<double>(tick_rate));
+		}
+		system.has_run = false;
+
+		stats[i].name = system.name;
+		stats[i].period = static_cast<float>(tick_rate / system.run_rate);
+		stats[i].rate = static_cast<float>(system.run_rate);
+	}
+}
+
+/**
+ * @brief Runs every system whose rate and phase put it on tick, timing each one.
+ * @param tick Number of the tick being run.
+ */
+void SystemScheduler::run_tick(uint64_t tick) {
+	if (tick_rate <= 0) return; // set_tick_rate() not called yet
+
+	const float tick_time = 1.0f / tick_rate;
+
+	for (size_t index : order) {
+		System& system = systems[index];
+		if (!is_due(system, tick)) continue;
+
+		// Time since the previous run, or the mean time between runs for the first
+		float delta_time = system.has_run ? tick_time * (tick - system.last_tick) : static_cast<float>(1.0 / system.run_rate);
+		system.last_tick = tick;
+		system.has_run = true;
+
+		auto start = std::chrono::steady_clock::now();
+		system.run(delta_time);
+		double duration_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::lock_guard<std::mutex> lock(stats_mutex);
+		SystemStats& system_stats = stats[index];
+		system_stats.runs++;
+		system_stats.total_ms += duration_ms;
+		system_stats.max_ms = (std::max)(system_stats.max_ms, duration_ms);
+		system_stats.last_ms = duration_ms;
+	}
+}
+
+/**
+ * @brief Gets each system's timing.
+ * @return A copy of the stats, in run order.
+ */
+std::vector<SystemStats> SystemScheduler::get_stats() const {
+	std::lock_guard<std::mutex> lock(stats_mutex);
+
+	std::vector<SystemStats> ordered;
+	ordered.reserve(order.size());
+	for (size_t index : order) {
+		ordered.push_back(stats[index]);
+	}
+	return ordered;
+}
+
+/**
+ * @brief Logs each system's rate and timing, one line per system in run order.
+ */
+void SystemScheduler::log_stats() const {
+	for (const SystemStats& system : get_stats()) {
+		double mean_ms = system.runs > 0 ? system.total_ms / system.runs : 0.0;
+
+		std::ostringstream oss;
+		oss << std::fixed << std::setprecision(3)
+			<< "System " << system.name << ": " << system.rate << "Hz (every " << system.period << " ticks on average), "
+			<< system.runs << " runs, mean " << mean_ms << "ms, max " << system.max_ms << "ms, total " << system.total_ms << "ms";
+		INFO(oss.str());
+	}
+}
+
+/**
+ * @brief Orders the systems so writers run before readers, falling back to the order they were added.
+ * A dependency cycle is broken at the earliest added system still waiting.
+ */
+void SystemScheduler::sort_systems() {
+	const size_t count = systems.size();
+	std::vector<std::vector<size_t>> runs_after(count); // runs_after[i]: systems that must wait for i
+	std::vector<size_t> waiting_on(count, 0);
+
+	for (size_t i = 0; i < count; i++) {
+		for (size_t j = i + 1; j < count; j++) {
+			int direction = dependency(systems[i], systems[j]);
+			if (direction > 0) {
+				runs_after[i].push_back(j);
+				waiting_on[j]++;
+			}
+			else if (direction < 0) {
+				runs_after[j].push_back(i);
+				waiting_on[i]++;
+			}
+		}
+	}
+
+	order.clear();
+	std::vector<bool> placed(count, false);
+	while (order.size() < count) {
+		// Earliest added system with nothing left to wait on
+		size_t next = count;
+		for (size_t i = 0; i < count && next == count; i++) {
+			if (!placed[i] && waiting_on[i] == 0) next = i;
+		}
+
+		if (next == count) {
+			for (size_t i = 0; i < count && next == count; i++) {
+				if (!placed[i]) next = i;
+			}
+			WARNING("Systems have cyclic dependencies, running " + systems[next].name + " first");
+		}
+
+		placed[next] = true;
+		order.push_back(next);
+		for (size_t after : runs_after[next]) {
+			if (waiting_on[after] > 0) waiting_on[after]--;
+		}
+	}
+}
+
+/**
+ * @brief Whether a system runs on a tick: it does when the whole number of runs it is owed, counting
+ * from its phase, goes up during the tick. A system whose rate divides the tick rate runs when
+ * tick + phase is a multiple of its period, the others are spread as evenly as whole ticks allow.
+ * @param system The system.
+ * @param tick Number of the tick.
+ */
+bool SystemScheduler::is_due(const System& system, uint64_t tick) const {
+	if (system.run_rate >= tick_rate) return true;
+
+	// Whole rates and tick rates keep these exact, so a run owed at the end of a tick is never lost to rounding
+	double position = static_cast<double>(tick + system.phase);
+	return std::floor(position * system.run_rate / tick_rate) > std::floor((position - 1.0) * system.run_rate / tick_rate);
+}
+
+int SystemScheduler::dependency(const System& earlier, const System& later) {
+	bool later_reads_earlier = (earlier.writes & later.reads) != 0;
+	bool earlier_reads_later = (later.writes & earlier.reads) != 0;
+	bool both_write = (earlier.writes & later.writes) != 0;
+
+	if (earlier_reads_later && !later_reads_earlier) return -1; // later writes what earlier only reads
+	if (later_reads_earlier || earlier_reads_later || both_write) return 1;
+	return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "Imports/common.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// World data a system reads or writes, combined into masks for SystemScheduler::add_system
+enum WorldData : uint32_t {
+	WORLD_PLAYERS = 1 << 0,
+	WORLD_ENEMIES = 1 << 1,
+	WORLD_OBJECTS = 1 << 2,
+	WORLD_ITEMS = 1 << 3,
+	WORLD_NETWORK = 1 << 4, // Packets queued on the server
+};
+
+// Timing of one system since the scheduler's tick rate was last set
+struct SystemStats {
+	std::string name;
+	float period = 1.0f; // Mean ticks between runs
+	float rate = 0.0f; // Effective runs per second at the current tick rate
+	uint64_t runs = 0; // Times run
+	double total_ms = 0.0; // Time spent running
+	double max_ms = 0.0; // Longest run
+	double last_ms = 0.0; // Most recent run
+};
+
+/**
+ * @brief Runs each simulation system at its own rate within a fixed-rate tick.
+ *
+ * A system asks for a rate in Hz and runs that many times a second, never more than once per tick
+ * (a rate above the tick rate is clamped, with a warning). A rate that does not divide the tick
+ * rate is kept on average: 20Hz at a 30Hz tick runs on two ticks of every three. Its delta time is
+ * the time since its previous run. The phase offsets a system by that many ticks, so expensive
+ * systems can be placed on ticks the others leave free instead of all landing on the same one.
+ * Phases only separate systems that skip some ticks.
+ *
+ * Systems declare the WorldData they read and write. On a tick where several are due, a system
+ * writing data runs before a system that only reads it. Otherwise (two writers, or systems that
+ * each read what the other writes) they run in the order they were added.
+ *
+ * Simulation thread only, except get_stats().
+ */
+class SystemScheduler {
+public:
+	static constexpr float EVERY_TICK = 0.0f; // Rate of a system that runs on every tick
+
+	using Run = std::function<void(float)>;
+
+	// Add a system. rate is in Hz (or EVERY_TICK), phase in ticks, reads and writes are WorldData masks.
+	void add_system(const std::string& name, float rate, uint32_t phase, uint32_t reads, uint32_t writes, Run run);
+	void set_tick_rate(int tick_rate); // Work out every system's period, resets the stats
+	void run_tick(uint64_t tick); // Run every system due on tick
+
+	std::vector<SystemStats> get_stats() const; // Copy of every system's stats, in run order (any thread)
+	void log_stats() const; // Log every system's stats
+
+private:
+	struct System {
+		std::string name;
+		float rate; // Requested runs per second
+		uint32_t phase; // Tick offset
+		uint32_t reads; // WorldData read
+		uint32_t writes; // WorldData written
+		Run run;
+		double run_rate = 0.0; // Runs per second at the current tick rate, at most the tick rate
+		uint64_t last_tick = 0; // Tick of the previous run
+		bool has_run = false; // Whether last_tick is set, since the tick rate was last set
+	};
+
+	std::vector<System> systems; // In the order they were added
+	std::vector<size_t> order; // Indices into systems, in run order
+	int tick_rate = 0;
+
+	mutable std::mutex stats_mutex;
+	std::vector<SystemStats> stats; // Same order as systems
+
+	void sort_systems(); // Work out the run order from the dependencies
+	bool is_due(const System& system, uint64_t tick) const; // Whether system runs on tick
+	static int dependency(const System& earlier, const System& later); // 1 if earlier runs first, -1 if later does, 0 if unrelated
+};
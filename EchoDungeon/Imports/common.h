@@ -5,8 +5,11 @@ Common imports that usually clash.
 
 #include "raylib-cpp/raylib-cpp.hpp"
 
+// The dedicated server (ECHO_HEADLESS) only uses raylib's math and collision types, never ImGui
+#ifndef ECHO_HEADLESS
 #include "raylib-imgui-compat/rlImGui.h"
 #include <imgui.h>
+#endif
 
 // Disable deprecated API warnings for enet.h
 #define _WINSOCK_DEPRECATED_NO_WARNINGS
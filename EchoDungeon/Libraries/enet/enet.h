@@ -517,6 +517,7 @@ extern "C" {
         ENET_SOCKOPT_NODELAY   = 9,
         ENET_SOCKOPT_IPV6_V6ONLY = 10,
         ENET_SOCKOPT_TTL       = 11,
+        ENET_SOCKOPT_REUSEPORT = 12,
     } ENetSocketOption;
 
     typedef enum _ENetSocketShutdown {
@@ -824,6 +825,7 @@ extern "C" {
         size_t                duplicatePeers;     /**< optional number of allowed peers from duplicate IPs, defaults to ENET_PROTOCOL_MAXIMUM_PEER_ID */
         size_t                maximumPacketSize;  /**< the maximum allowable packet size that may be sent or received on a peer */
         size_t                maximumWaitingData; /**< the maximum aggregate amount of buffer space a peer may use waiting for packets to be delivered */
+        struct _ENetSocketBatch * socketBatch;    /**< batched socket I/O state, NULL unless enet_host_batch_socket_io() switched it on */
     } ENetHost;
 
     /**
@@ -1012,6 +1014,7 @@ extern "C" {
     ENET_API enet_uint32  enet_crc32(const ENetBuffer *, size_t);
 
     ENET_API ENetHost * enet_host_create(const ENetAddress *, size_t, size_t, enet_uint32, enet_uint32);
+    ENET_API ENetHost * enet_host_create_shared(const ENetAddress *, size_t, size_t, enet_uint32, enet_uint32);
     ENET_API void       enet_host_destroy(ENetHost *);
     ENET_API ENetPeer * enet_host_connect(ENetHost *, const ENetAddress *, size_t, enet_uint32);
     ENET_API int        enet_host_check_events(ENetHost *, ENetEvent *);
@@ -1022,6 +1025,7 @@ extern "C" {
     ENET_API void       enet_host_flush(ENetHost *);
     ENET_API void       enet_host_broadcast(ENetHost *, enet_uint8, ENetPacket *);
     ENET_API void       enet_host_compress(ENetHost *, const ENetCompressor *);
+    ENET_API int        enet_host_batch_socket_io(ENetHost *, size_t, int);
     ENET_API void       enet_host_channel_limit(ENetHost *, size_t);
     ENET_API void       enet_host_bandwidth_limit(ENetHost *, enet_uint32, enet_uint32);
     extern   void       enet_host_bandwidth_throttle(ENetHost *);
@@ -1557,6 +1561,327 @@ extern "C" {
         return ENET_HOST_TO_NET_32(~crc);
     }
 
+// =======================================================================//
+// !
+// ! Batched socket I/O (Linux)
+// !
+// =======================================================================//
+
+#if defined(__linux__) && defined(_GNU_SOURCE)
+    #define ENET_SOCKET_BATCHING 1
+
+    #ifndef SOL_UDP
+    #define SOL_UDP 17
+    #endif
+
+    #ifndef UDP_SEGMENT
+    #define UDP_SEGMENT 103
+    #endif
+
+    #define ENET_SOCKET_BATCH_MAXIMUM_SEGMENTS 64 /* UDP_MAX_SEGMENTS, the most datagrams one GSO send may carry */
+
+    /** Datagrams received ahead by recvmmsg() and datagrams waiting for sendmmsg(), see enet_host_batch_socket_io() */
+    typedef struct _ENetSocketBatch {
+        size_t capacity;       /**< datagrams per recvmmsg()/sendmmsg() call */
+        int segmentOffload;    /**< group datagrams to the same address into one UDP GSO send */
+
+        struct mmsghdr *     receiveMessages;
+        struct iovec *       receiveVectors;
+        struct sockaddr_in6 *receiveAddresses;
+        enet_uint8 *         receiveData;     /**< capacity datagrams of ENET_PROTOCOL_MAXIMUM_MTU bytes */
+        size_t               receiveCount;    /**< datagrams returned by the last recvmmsg() */
+        size_t               receiveIndex;    /**< next of those to hand to the protocol */
+
+        struct mmsghdr *     sendMessages;
+        struct iovec *       sendVectors;
+        struct sockaddr_in6 *sendAddresses;   /**< destination of each queued datagram */
+        enet_uint8 *         sendData;        /**< capacity datagrams of ENET_PROTOCOL_MAXIMUM_MTU bytes */
+        size_t *             sendLengths;
+        enet_uint8 *         sendGrouped;     /**< scratch flags while grouping datagrams for GSO */
+        char *               sendControl;     /**< one UDP_SEGMENT control message per sendmmsg() entry */
+        size_t               sendCount;       /**< datagrams queued since the last flush */
+    } ENetSocketBatch;
+
+    #define ENET_SOCKET_BATCH_CONTROL_SIZE CMSG_SPACE(sizeof(enet_uint16))
+
+    static void enet_socket_batch_destroy(ENetHost *host) {
+        ENetSocketBatch *batch = host->socketBatch;
+        if (batch == NULL) {
+            return;
+        }
+
+        enet_free(batch->receiveMessages);
+        enet_free(batch->receiveVectors);
+        enet_free(batch->receiveAddresses);
+        enet_free(batch->receiveData);
+        enet_free(batch->sendMessages);
+        enet_free(batch->sendVectors);
+        enet_free(batch->sendAddresses);
+        enet_free(batch->sendData);
+        enet_free(batch->sendLengths);
+        enet_free(batch->sendGrouped);
+        enet_free(batch->sendControl);
+        enet_free(batch);
+        host->socketBatch = NULL;
+    }
+
+    /** Receives the next datagram, refilling the batch with one recvmmsg() once it is used up.
+     *  Same results as enet_socket_receive(), but buffer->data is pointed at the datagram instead of filled.
+     */
+    static int enet_socket_batch_receive(ENetHost *host, ENetBuffer *buffer) {
+        ENetSocketBatch *batch = host->socketBatch;
+        struct msghdr *message;
+        const struct sockaddr_in6 *sin;
+        size_t i;
+
+        if (batch->receiveIndex >= batch->receiveCount) {
+            int received;
+
+            batch->receiveCount = batch->receiveIndex = 0;
+            for (i = 0; i < batch->capacity; ++i) {
+                batch->receiveVectors[i].iov_base = batch->receiveData + i * ENET_PROTOCOL_MAXIMUM_MTU;
+                batch->receiveVectors[i].iov_len  = host->mtu;
+
+                message = &batch->receiveMessages[i].msg_hdr;
+                memset(message, 0, sizeof(struct msghdr));
+                message->msg_name    = &batch->receiveAddresses[i];
+                message->msg_namelen = sizeof(struct sockaddr_in6);
+                message->msg_iov     = &batch->receiveVectors[i];
+                message->msg_iovlen  = 1;
+            }
+
+            received = recvmmsg(host->socket, batch->receiveMessages, (unsigned int) batch->capacity, MSG_DONTWAIT, NULL);
+            if (received < 0) {
+                return (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR) ? 0 : -1;
+            }
+            if (received == 0) {
+                return 0;
+            }
+            batch->receiveCount = (size_t) received;
+        }
+
+        i       = batch->receiveIndex++;
+        message = &batch->receiveMessages[i].msg_hdr;
+        if (message->msg_flags & MSG_TRUNC) {
+            return -2;
+        }
+
+        sin = &batch->receiveAddresses[i];
+        host->receivedAddress.host          = sin->sin6_addr;
+        host->receivedAddress.port          = ENET_NET_TO_HOST_16(sin->sin6_port);
+        host->receivedAddress.sin6_scope_id = sin->sin6_scope_id;
+
+        buffer->data       = batch->receiveVectors[i].iov_base;
+        buffer->dataLength = batch->receiveMessages[i].msg_len;
+        return (int) batch->receiveMessages[i].msg_len;
+    }
+
+    /** Sends every queued datagram with as few sendmmsg() calls as possible.
+     *  With segment offload, consecutive datagrams to one address that share a size (the last may
+     *  be shorter) go out as a single UDP GSO send, the kernel splits them back up.
+     *  Datagrams the socket has no room for are dropped, as enet_socket_send() would.
+     *  @retval 0 on success, < 0 on a socket error
+     */
+    static int enet_socket_batch_flush(ENetHost *host) {
+        ENetSocketBatch *batch = host->socketBatch;
+        size_t messageCount = 0, vectorCount = 0, sent = 0, i, j;
+
+        if (batch == NULL || batch->sendCount == 0) {
+            return 0;
+        }
+
+        memset(batch->sendGrouped, 0, batch->sendCount);
+        for (i = 0; i < batch->sendCount; ++i) {
+            struct msghdr *message;
+            size_t segments = 1, segmentSize = batch->sendLengths[i], last = i;
+
+            if (batch->sendGrouped[i]) {
+                continue;
+            }
+
+            message = &batch->sendMessages[messageCount].msg_hdr;
+            memset(message, 0, sizeof(struct msghdr));
+            message->msg_name    = &batch->sendAddresses[i];
+            message->msg_namelen = sizeof(struct sockaddr_in6);
+            message->msg_iov     = &batch->sendVectors[vectorCount];
+
+            batch->sendVectors[vectorCount].iov_base = batch->sendData + i * ENET_PROTOCOL_MAXIMUM_MTU;
+            batch->sendVectors[vectorCount].iov_len  = segmentSize;
+            ++vectorCount;
+
+            /* Later datagrams to the same peer, in order, while every one so far is a full segment */
+            for (j = i + 1; batch->segmentOffload && j < batch->sendCount && segments < ENET_SOCKET_BATCH_MAXIMUM_SEGMENTS; ++j) {
+                if (batch->sendGrouped[j] ||
+                    batch->sendAddresses[j].sin6_port != batch->sendAddresses[i].sin6_port ||
+                    memcmp(&batch->sendAddresses[j].sin6_addr, &batch->sendAddresses[i].sin6_addr, sizeof(struct in6_addr)) != 0) {
+                    continue;
+                }
+                if (batch->sendLengths[last] != segmentSize || batch->sendLengths[j] > segmentSize ||
+                    (segments + 1) * segmentSize > 65000) {
+                    break;
+                }
+
+                batch->sendGrouped[j] = 1;
+                batch->sendVectors[vectorCount].iov_base = batch->sendData + j * ENET_PROTOCOL_MAXIMUM_MTU;
+                batch->sendVectors[vectorCount].iov_len  = batch->sendLengths[j];
+                ++vectorCount;
+                ++segments;
+                last = j;
+            }
+
+            message->msg_iovlen = segments;
+            if (segments > 1) {
+                struct cmsghdr *control;
+
+                message->msg_control    = batch->sendControl + messageCount * ENET_SOCKET_BATCH_CONTROL_SIZE;
+                message->msg_controllen = ENET_SOCKET_BATCH_CONTROL_SIZE;
+                control = CMSG_FIRSTHDR(message);
+                control->cmsg_level = SOL_UDP;
+                control->cmsg_type  = UDP_SEGMENT;
+                control->cmsg_len   = CMSG_LEN(sizeof(enet_uint16));
+                *(enet_uint16 *) CMSG_DATA(control) = (enet_uint16) segmentSize;
+            }
+
+            ++messageCount;
+        }
+
+        batch->sendCount = 0;
+
+        while (sent < messageCount) {
+            int result = sendmmsg(host->socket, batch->sendMessages + sent, (unsigned int) (messageCount - sent), MSG_NOSIGNAL);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if ((errno == EIO || errno == EINVAL) && batch->segmentOffload) {
+                    batch->segmentOffload = 0; /* No GSO for this socket or route, send everything separately from now on */
+                }
+                if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EMSGSIZE || errno == EIO || errno == EINVAL) {
+                    ++sent; /* Drop the datagram(s) at the front, like a failed sendmsg() */
+                    continue;
+                }
+                return -1;
+            }
+            sent += (size_t) result;
+        }
+
+        return 0;
+    }
+
+    /** Queues the datagram in host->buffers for the next enet_socket_batch_flush(), copying it out.
+     *  @returns the datagram's length, like a successful enet_socket_send()
+     */
+    static int enet_socket_batch_send(ENetHost *host, const ENetAddress *address) {
+        ENetSocketBatch *batch = host->socketBatch;
+        struct sockaddr_in6 *sin;
+        enet_uint8 *data;
+        size_t length = 0, i;
+
+        if (batch->sendCount >= batch->capacity && enet_socket_batch_flush(host) < 0) {
+            return -1;
+        }
+
+        data = batch->sendData + batch->sendCount * ENET_PROTOCOL_MAXIMUM_MTU;
+        for (i = 0; i < host->bufferCount; ++i) {
+            if (length + host->buffers[i].dataLength > ENET_PROTOCOL_MAXIMUM_MTU) {
+                return -2;
+            }
+            memcpy(data + length, host->buffers[i].data, host->buffers[i].dataLength);
+            length += host->buffers[i].dataLength;
+        }
+
+        sin = &batch->sendAddresses[batch->sendCount];
+        memset(sin, 0, sizeof(struct sockaddr_in6));
+        sin->sin6_family   = AF_INET6;
+        sin->sin6_port     = ENET_HOST_TO_NET_16(address->port);
+        sin->sin6_addr     = address->host;
+        sin->sin6_scope_id = address->sin6_scope_id;
+
+        batch->sendLengths[batch->sendCount++] = length;
+        return (int) length;
+    }
+
+    /** Switches a host's socket to batched I/O: recvmmsg() reads up to batchSize datagrams per call,
+     *  and the datagrams of one enet_host_service()/enet_host_flush() go out through sendmmsg().
+     *  @param host           host to configure
+     *  @param batchSize      datagrams per system call, 0 switches batching off again
+     *  @param segmentOffload whether to also merge datagrams to the same peer into UDP GSO sends
+     *  @retval 0 on success, < 0 if batched I/O is not available
+     *  @remarks Linux only. Elsewhere (or without _GNU_SOURCE) this returns -1 and the host keeps the stock path.
+     */
+    int enet_host_batch_socket_io(ENetHost *host, size_t batchSize, int segmentOffload) {
+        ENetSocketBatch *batch;
+
+        if (host->socketBatch != NULL) {
+            if (enet_socket_batch_flush(host) < 0 || host->socketBatch->receiveIndex < host->socketBatch->receiveCount) {
+                return -1; /* Received datagrams would be lost */
+            }
+            enet_socket_batch_destroy(host);
+        }
+
+        if (batchSize == 0) {
+            return 0;
+        }
+
+        batch = (ENetSocketBatch *) enet_malloc(sizeof(ENetSocketBatch));
+        if (batch == NULL) {
+            return -1;
+        }
+        memset(batch, 0, sizeof(ENetSocketBatch));
+        host->socketBatch = batch;
+
+        batch->capacity         = batchSize;
+        batch->segmentOffload   = segmentOffload;
+        batch->receiveMessages  = (struct mmsghdr *) enet_malloc(batchSize * sizeof(struct mmsghdr));
+        batch->receiveVectors   = (struct iovec *) enet_malloc(batchSize * sizeof(struct iovec));
+        batch->receiveAddresses = (struct sockaddr_in6 *) enet_malloc(batchSize * sizeof(struct sockaddr_in6));
+        batch->receiveData      = (enet_uint8 *) enet_malloc(batchSize * ENET_PROTOCOL_MAXIMUM_MTU);
+        batch->sendMessages     = (struct mmsghdr *) enet_malloc(batchSize * sizeof(struct mmsghdr));
+        batch->sendVectors      = (struct iovec *) enet_malloc(batchSize * sizeof(struct iovec));
+        batch->sendAddresses    = (struct sockaddr_in6 *) enet_malloc(batchSize * sizeof(struct sockaddr_in6));
+        batch->sendData         = (enet_uint8 *) enet_malloc(batchSize * ENET_PROTOCOL_MAXIMUM_MTU);
+        batch->sendLengths      = (size_t *) enet_malloc(batchSize * sizeof(size_t));
+        batch->sendGrouped      = (enet_uint8 *) enet_malloc(batchSize);
+        batch->sendControl      = (char *) enet_malloc(batchSize * ENET_SOCKET_BATCH_CONTROL_SIZE);
+
+        if (batch->receiveMessages == NULL || batch->receiveVectors == NULL || batch->receiveAddresses == NULL ||
+            batch->receiveData == NULL || batch->sendMessages == NULL || batch->sendVectors == NULL ||
+            batch->sendAddresses == NULL || batch->sendData == NULL || batch->sendLengths == NULL ||
+            batch->sendGrouped == NULL || batch->sendControl == NULL) {
+            enet_socket_batch_destroy(host);
+            return -1;
+        }
+
+        memset(batch->sendControl, 0, batchSize * ENET_SOCKET_BATCH_CONTROL_SIZE);
+        return 0;
+    }
+#else
+    int enet_host_batch_socket_io(ENetHost *host, size_t batchSize, int segmentOffload) {
+        (void) segmentOffload;
+        return (host == NULL || batchSize == 0) ? 0 : -1;
+    }
+#endif
+
+    /** Receives one datagram, through the host's socket batch if it has one */
+    static int enet_protocol_receive_datagram(ENetHost *host, ENetBuffer *buffer) {
+#ifdef ENET_SOCKET_BATCHING
+        if (host->socketBatch != NULL) {
+            return enet_socket_batch_receive(host, buffer);
+        }
+#endif
+        return enet_socket_receive(host->socket, &host->receivedAddress, buffer, 1);
+    }
+
+    /** Sends the datagram in host->buffers, or queues it in the host's socket batch if it has one */
+    static int enet_protocol_send_datagram(ENetHost *host, const ENetAddress *address) {
+#ifdef ENET_SOCKET_BATCHING
+        if (host->socketBatch != NULL) {
+            return enet_socket_batch_send(host, address);
+        }
+#endif
+        return enet_socket_send(host->socket, address, host->buffers, host->bufferCount);
+    }
+
 // =======================================================================//
 // !
 // ! Protocol
@@ -2809,7 +3134,7 @@ extern "C" {
             // buffer.dataLength = sizeof (host->packetData[0]);
             buffer.dataLength = host->mtu;
 
-            receivedLength    = enet_socket_receive(host->socket, &host->receivedAddress, &buffer, 1);
+            receivedLength    = enet_protocol_receive_datagram(host, &buffer);
 
             if (receivedLength == -2)
                 continue;
@@ -2822,7 +3147,7 @@ extern "C" {
                 return 0;
             }
 
-            host->receivedData       = host->packetData[0];
+            host->receivedData       = (enet_uint8 *) buffer.data;
             host->receivedDataLength = receivedLength;
 
             host->totalReceivedData += receivedLength;
@@ -3136,7 +3461,7 @@ extern "C" {
         return canPing;
     } /* enet_protocol_send_reliable_outgoing_commands */
 
-    static int enet_protocol_send_outgoing_commands(ENetHost *host, ENetEvent *event, int checkForTimeouts) {
+    static int enet_protocol_send_peer_datagrams(ENetHost *host, ENetEvent *event, int checkForTimeouts) {
         enet_uint8 headerData[
             sizeof(ENetProtocolHeader) 
 #ifdef ENET_USE_MORE_PEERS
@@ -3286,7 +3611,7 @@ extern "C" {
                 }
 
                 currentPeer->lastSendTime = host->serviceTime;
-                sentLength = enet_socket_send(host->socket, &currentPeer->address, host->buffers, host->bufferCount);
+                sentLength = enet_protocol_send_datagram(host, &currentPeer->address);
                 enet_protocol_remove_sent_unreliable_commands(currentPeer, &sentUnreliableCommands);
 
                 if (sentLength < 0) {
@@ -3309,6 +3634,19 @@ extern "C" {
         host->buffers[0].data = NULL;
 
         return 0;
+    } /* enet_protocol_send_peer_datagrams */
+
+    static int enet_protocol_send_outgoing_commands(ENetHost *host, ENetEvent *event, int checkForTimeouts) {
+        int result = enet_protocol_send_peer_datagrams(host, event, checkForTimeouts);
+
+#ifdef ENET_SOCKET_BATCHING
+        /* Datagrams queued in the socket batch go out together, whichever way the pass above ended */
+        if (enet_socket_batch_flush(host) < 0) {
+            return -1;
+        }
+#endif
+
+        return result;
     } /* enet_protocol_send_outgoing_commands */
 
     /** Sends any queued packets on the host specified to its designated peers.
@@ -4524,6 +4862,8 @@ extern "C" {
 // !
 // =======================================================================//
 
+    static ENetHost * enet_host_create_socket(const ENetAddress *, size_t, size_t, enet_uint32, enet_uint32, int);
+
     /** Creates a host for communicating to peers.
      *
      *  @param address   the address at which other peers may connect to this host.  If NULL, then no peers may connect to the host.
@@ -4540,6 +4880,22 @@ extern "C" {
      *  at any given time.
      */
     ENetHost * enet_host_create(const ENetAddress *address, size_t peerCount, size_t channelLimit, enet_uint32 incomingBandwidth, enet_uint32 outgoingBandwidth) {
+        return enet_host_create_socket(address, peerCount, channelLimit, incomingBandwidth, outgoingBandwidth, 0);
+    }
+
+    /** Creates a host like enet_host_create(), whose socket may share its address with other such hosts.
+     *
+     *  The socket gets SO_REUSEPORT before it is bound, so several hosts (eg one per thread) can bind the
+     *  same port.  The kernel then hands each one the datagrams of the remote addresses that hash to it,
+     *  so a given peer always talks to the same host as long as the set of bound hosts does not change.
+     *
+     *  @returns the host on success and NULL on failure, including on platforms without SO_REUSEPORT
+     */
+    ENetHost * enet_host_create_shared(const ENetAddress *address, size_t peerCount, size_t channelLimit, enet_uint32 incomingBandwidth, enet_uint32 outgoingBandwidth) {
+        return enet_host_create_socket(address, peerCount, channelLimit, incomingBandwidth, outgoingBandwidth, 1);
+    }
+
+    static ENetHost * enet_host_create_socket(const ENetAddress *address, size_t peerCount, size_t channelLimit, enet_uint32 incomingBandwidth, enet_uint32 outgoingBandwidth, int sharePort) {
         ENetHost *host;
         ENetPeer *currentPeer;
 
@@ -4564,7 +4920,9 @@ extern "C" {
             enet_socket_set_option (host->socket, ENET_SOCKOPT_IPV6_V6ONLY, 0);
         }
 
-        if (host->socket == ENET_SOCKET_NULL || (address != NULL && enet_socket_bind(host->socket, address) < 0)) {
+        if (host->socket == ENET_SOCKET_NULL ||
+            (sharePort && enet_socket_set_option(host->socket, ENET_SOCKOPT_REUSEPORT, 1) < 0) ||
+            (address != NULL && enet_socket_bind(host->socket, address) < 0)) {
             if (host->socket != ENET_SOCKET_NULL) {
                 enet_socket_destroy(host->socket);
             }
@@ -4640,7 +4998,7 @@ extern "C" {
         }
 
         return host;
-    } /* enet_host_create */
+    } /* enet_host_create_socket */
 
     /** Destroys the host and all resources associated with it.
      *  @param host pointer to the host to destroy
@@ -4658,6 +5016,10 @@ extern "C" {
             enet_peer_reset(currentPeer);
         }
 
+#ifdef ENET_SOCKET_BATCHING
+        enet_socket_batch_destroy(host);
+#endif
+
         if (host->compressor.context != NULL && host->compressor.destroy) {
             (*host->compressor.destroy)(host->compressor.context);
         }
@@ -5618,6 +5980,12 @@ extern "C" {
                 result = setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, (char *)&value, sizeof(int));
                 break;
 
+            case ENET_SOCKOPT_REUSEPORT:
+            #ifdef SO_REUSEPORT
+                result = setsockopt(socket, SOL_SOCKET, SO_REUSEPORT, (char *)&value, sizeof(int));
+            #endif
+                break;
+
             case ENET_SOCKOPT_RCVBUF:
                 result = setsockopt(socket, SOL_SOCKET, SO_RCVBUF, (char *)&value, sizeof(int));
                 break;
@@ -6027,6 +6395,10 @@ extern "C" {
                 result = setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, (char *)&value, sizeof(int));
                 break;
 
+            case ENET_SOCKOPT_REUSEPORT:
+                /* Windows has no load balancing SO_REUSEPORT, result stays SOCKET_ERROR */
+                break;
+
             case ENET_SOCKOPT_RCVBUF:
                 result = setsockopt(socket, SOL_SOCKET, SO_RCVBUF, (char *)&value, sizeof(int));
                 break;
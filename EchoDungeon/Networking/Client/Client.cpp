@@ -1,5 +1,6 @@
 #include "Client.h"
 #include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/PacketCompression.h"
 #include "Networking/Packet/Instances/ConnectionInitiation.h"
 #include "Networking/Packet/Instances/ConnectionConfirmation.h"
 #include "Networking/Packet/Instances/ConnectionRefusal.h"
@@ -19,6 +20,7 @@ Client::Client(const std::string& username) : NetworkUser(), peers(ClientPeerlis
 		ERROR("Failed to create ENet host");
 		return;
 	}
+	PacketCompression::configure_host(host);
 
 	// Register event callbacks for connection flow packets
 	
@@ -77,14 +79,14 @@ bool Client::is_connected() const {
 * @param packet The packet to send.
 */
 bool Client::send_packet(Packet& packet) {
-	TRACE("Sending packet " + PacketRegistry::getPacketName(packet.header.type) + " to server");
+	TRACE("Sending packet " + std::string(PacketRegistry::getPacketName(packet.header.type)) + " to server");
 
 	if (!is_connected()) {
 		ERROR("Client is not connected, cannot send packet");
 		return false;
 	}
 
-	return NetworkUser::send_packet(packet.to_enet_packet(), peers.server_peer);
+	return NetworkUser::send_packet(packet.to_enet_packet(), peers.server_peer, packet.delivery().channel);
 }
 
 
@@ -101,7 +103,7 @@ void Client::start() {
 		return;
 	}
 
-	if (thread_id == std::this_thread::get_id()) {
+	if (thread_id.load() == std::this_thread::get_id()) {
 		WARNING("Client update loop already exists in this thread, cannot start");
 		return;
 	}
@@ -174,6 +176,7 @@ void Client::update() {
 					connection_promise.reset();
 				}
 				
+				forget_peer(event.peer);
 				peers.server_peer = nullptr;
 				connection_state = ClientConnectionState::DISCONNECTED;
 				
@@ -342,9 +345,8 @@ std::future<bool> Client::disconnect(const std::string& reason) {
 		auto packet = DisconnectInfoPacket(reason);
 		send_packet(packet);
 
-		// Send ENetDisconnection request
-		enet_peer_disconnect(peers.server_peer, 0);
-		enet_host_flush(host);
+		// Send ENetDisconnection request once the info packet has gone out
+		queue_disconnect(peers.server_peer, DisconnectMode::LATER);
 
 		// Reset data
 		reset();
@@ -364,7 +366,7 @@ bool Client::force_disconnect() {
 		return false;
 	}
 
-	enet_peer_disconnect_now(peers.server_peer, 0);
+	queue_disconnect(peers.server_peer, DisconnectMode::NOW);
 	reset();
 	
 	INFO("Client forcefully disconnected from server");
@@ -2,11 +2,17 @@
 #include "Imports/common.h"
 
 namespace NetworkConstants {
-	// Sleep duration for the networking loop in milliseconds (Server/Client)
+	// Sleep duration for the networking loop in milliseconds, when BLOCKING_SERVICE is off (Server/Client)
 	constexpr const long LOOP_SLEEP_DURATION_MS = 1;
 
-	// Max simultaneous connections (Server)
-	constexpr const int MAX_SIMULTANEOUS_CONNECTIONS = 4;
+	// Block the networking loop on the socket instead of polling every LOOP_SLEEP_DURATION_MS (Server/Client)
+	constexpr const bool BLOCKING_SERVICE = true;
+
+	// Longest the networking loop blocks with no activity, so ENet still resends and pings on time (Server/Client)
+	constexpr const enet_uint32 SERVICE_TIMEOUT_MS = 10;
+
+	// Max simultaneous connections per host (Server). OpenServer::max_players is the limit players see
+	constexpr const int MAX_SIMULTANEOUS_CONNECTIONS = 255;
 
 	// Default port for networking (Server/Client)
 	constexpr const int DEFAULT_PORT = 7422;
@@ -14,9 +20,54 @@ namespace NetworkConstants {
 	// Maximum number of channels for ENet communication (Server/Client)
 	constexpr const int MAX_CHANNELS = 2;
 
+	// Channel for reliable gameplay and session events (Server/Client)
+	constexpr const uint8_t CHANNEL_EVENTS = 0;
+
+	// Channel for unreliable high-rate state streams, eg entity updates and player input (Server/Client)
+	constexpr const uint8_t CHANNEL_STATE = 1;
+
+	static_assert(CHANNEL_EVENTS < MAX_CHANNELS && CHANNEL_STATE < MAX_CHANNELS, "Every channel must be allocated");
+
 	// Bandwidth limits for ENet (Server/Client)
 	constexpr const int BANDWIDTH_LIMIT = 0;   // Unlimited
 
+	// Payload compression (Server/Client, both ends must use the same mode)
+	enum class CompressionMode {
+		NONE,       // Send everything as encoded
+		HOST,       // ENet compresses every datagram with LzCodec
+		PER_PACKET  // Only packets of at least COMPRESSION_THRESHOLD bytes are compressed, flagged in their type byte
+	};
+	constexpr const CompressionMode COMPRESSION_MODE = CompressionMode::PER_PACKET;
+
+	// Smallest encoded packet worth compressing in PER_PACKET mode, in bytes
+	constexpr const size_t COMPRESSION_THRESHOLD = 256;
+
+	// Queue decoded world packets for the world managers to apply at the start of their next
+	// update, instead of applying them on the networking thread (Server/Client)
+	constexpr const bool QUEUE_WORLD_PACKETS = true;
+
+	// Messages each world manager's inbound queue holds before the networking thread has to wait (power of two)
+	constexpr const size_t INBOUND_QUEUE_CAPACITY = 1024;
+
+	// Longest the networking thread waits for space in a full inbound queue before applying an event itself
+	constexpr const long INBOUND_QUEUE_FULL_WAIT_MS = 50;
+
+	// Hold unsent UNRELIABLE_SEQUENCED packets per peer and type, so a newer one replaces an older one
+	// instead of queueing behind it while the peer's link is backed up (Server/Client)
+	constexpr const bool CONFLATE_STATE_PACKETS = true;
+
+	// Datagrams the server receives and sends per system call with recvmmsg/sendmmsg (Linux only, 0 = one call per datagram)
+	constexpr const size_t SOCKET_BATCH_SIZE = 32;
+
+	// Merge a flush's datagrams to the same peer into UDP GSO sends when batching (Server, Linux only)
+	constexpr const bool UDP_SEGMENT_OFFLOAD = false;
+
+	// ENet hosts the server binds to its port, each serviced by its own networking thread (Server).
+	// More than one shares the port with SO_REUSEPORT (not on Windows), the kernel keeps each client on one host
+	constexpr const size_t SERVER_SHARDS = 1;
+
+	static_assert(SERVER_SHARDS > 0, "The server needs at least one host");
+
 	// Timeout duration for built-in ENet (Server/Client)
 	constexpr const int ENET_TIMEOUT = 0; // No timeout
 
@@ -1,7 +1,52 @@
 #include "NetworkUser.h"
 #include "Utils/NetUtils.h"
+#include <cstring>
+#include <algorithm>
+
+// Payload of the datagrams wake() sends to the host's own socket
+static const uint8_t WAKE_MAGIC[8] = { 'E', 'D', 'W', 'A', 'K', 'E', 0, 1 };
+
+// Shard serviced by the networking loop running on this thread
+static thread_local size_t current_shard_index = 0;
+static thread_local bool running_loop = false; // A networking loop is running on this thread
+
 NetworkUser::NetworkUser() {}
 
+NetworkUser::~NetworkUser() {
+	// Free packets that were never sent
+	SendCommand command;
+	while (send_queue.pop(command)) {
+		if (command.packet && command.packet->referenceCount == 0) {
+			enet_packet_destroy(command.packet);
+		}
+	}
+
+	if (wake_socket != ENET_SOCKET_NULL) {
+		enet_socket_destroy(wake_socket);
+	}
+	if (wake_receiver != ENET_SOCKET_NULL) {
+		enet_socket_destroy(wake_receiver);
+	}
+}
+
+/*
+* @brief Gets the shard whose networking loop runs on the calling thread.
+* Lets code reached from several networking threads (eg packet handlers) keep per-shard state without locking.
+* @return The loop's shard index, or 0 when called from a thread that runs no networking loop.
+*/
+size_t NetworkUser::current_shard() {
+	return current_shard_index;
+}
+
+/*
+* @brief Whether a networking loop is running on the calling thread.
+* Code keeping per-shard state with current_shard() must take another path on any other thread,
+* where current_shard() is 0 and would share shard 0's state with its networking thread.
+*/
+bool NetworkUser::on_networking_thread() {
+	return running_loop;
+}
+
 /*
 * @brief Starts the networking loop in a separate thread.
 */
@@ -13,6 +58,33 @@ void NetworkUser::start() {
 	}
 	is_running.store(true); 
 
+	if (NetworkConstants::BLOCKING_SERVICE && host && wake_socket == ENET_SOCKET_NULL) {
+		wake_socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+		if (wake_socket != ENET_SOCKET_NULL) {
+			enet_socket_set_option(wake_socket, ENET_SOCKOPT_IPV6_V6ONLY, 0); // Must reach IPv4-bound hosts too
+			enet_socket_set_option(wake_socket, ENET_SOCKOPT_NONBLOCK, 1);
+		}
+		else {
+			WARNING("Failed to create wake-up socket, networking loop will only wake on its timeout");
+		}
+		enet_host_set_intercept(host, &NetworkUser::intercept_wake);
+
+		// Another host bound to a shared port may be handed the wake-ups, so this one gets its own socket to wake on
+		if (shared_port && wake_socket != ENET_SOCKET_NULL) {
+			ENetAddress loopback = { 0 };
+			enet_address_set_host_ip(&loopback, "::1");
+			wake_receiver = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+			if (wake_receiver == ENET_SOCKET_NULL || enet_socket_bind(wake_receiver, &loopback) < 0) {
+				WARNING("Failed to create wake-up receiver, networking loop will only wake on its timeout");
+				if (wake_receiver != ENET_SOCKET_NULL) enet_socket_destroy(wake_receiver);
+				wake_receiver = ENET_SOCKET_NULL;
+			}
+			else {
+				enet_socket_set_option(wake_receiver, ENET_SOCKOPT_NONBLOCK, 1);
+			}
+		}
+	}
+
 	// Start the networking loop asynchronously in a new thread
 	loop_future = std::async(std::launch::async, &NetworkUser::update_loop, this); 
 }
@@ -28,12 +100,13 @@ void NetworkUser::stop() {
 		return;
 	}
 
-	if (std::this_thread::get_id() == thread_id) { // Check for deadlock condition
+	if (std::this_thread::get_id() == thread_id.load()) { // Check for deadlock condition
 		ERROR("stop() called from within the networking loop thread, this would cause a deadlock. Ignoring stop() call.");
 		return;
 	}
 
 	is_running.store(false); 
+	wake(); // Don't wait out the service timeout
 	if (loop_future.valid()) {
 		loop_future.get(); // Wait for the networking loop to finish
 	}
@@ -43,35 +116,236 @@ void NetworkUser::stop() {
 * @brief The networking loop function that continuously calls the update method.
 */
 void NetworkUser::update_loop() {
-	thread_id = std::this_thread::get_id(); // Store the thread ID of the networking loop
+	thread_id.store(std::this_thread::get_id()); // Store the thread ID of the networking loop
+	current_shard_index = shard_index;
+	running_loop = true;
 	while (is_running.load()) {
+		wake_pending.store(false); // Wakes from here on must interrupt the next wait
 		update(); // Call the derived class's update method
-		std::this_thread::sleep_for(std::chrono::milliseconds(NetworkConstants::LOOP_SLEEP_DURATION_MS)); // Sleep to reduce load
+		flush_send_queue(); // Send everything queued by this update and by other threads
+
+		if (NetworkConstants::BLOCKING_SERVICE) {
+			wait_for_activity();
+		}
+		else {
+			std::this_thread::sleep_for(std::chrono::milliseconds(NetworkConstants::LOOP_SLEEP_DURATION_MS)); // Sleep to reduce load
+		}
+	}
+
+	flush_send_queue(); // Anything queued while stopping (eg disconnect kicks)
+	thread_id.store(std::thread::id()); // The thread may be reused for other work once the loop returns
+	current_shard_index = 0;
+	running_loop = false;
+}
+
+/*
+* @brief Blocks until the host's socket has data to receive, wake() is called, or SERVICE_TIMEOUT_MS passes.
+* The timeout keeps ENet's own timers (resends, pings, timeouts) running while nothing arrives.
+*/
+void NetworkUser::wait_for_activity() {
+	if (!host) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(NetworkConstants::SERVICE_TIMEOUT_MS));
+		return;
 	}
+
+	if (wake_receiver != ENET_SOCKET_NULL) {
+		ENetSocketSet read_set;
+		ENET_SOCKETSET_EMPTY(read_set);
+		ENET_SOCKETSET_ADD(read_set, host->socket);
+		ENET_SOCKETSET_ADD(read_set, wake_receiver);
+		if (enet_socketset_select(std::max(host->socket, wake_receiver), &read_set, nullptr, NetworkConstants::SERVICE_TIMEOUT_MS) > 0 &&
+			ENET_SOCKETSET_CHECK(read_set, wake_receiver)) {
+			uint8_t discard[sizeof(WAKE_MAGIC)];
+			ENetBuffer buffer;
+			buffer.data = discard;
+			buffer.dataLength = sizeof(discard);
+			while (enet_socket_receive(wake_receiver, nullptr, &buffer, 1) > 0) {} // Only wake-ups arrive here
+		}
+		return;
+	}
+
+	enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE | ENET_SOCKET_WAIT_INTERRUPT;
+	enet_socket_wait(host->socket, &condition, NetworkConstants::SERVICE_TIMEOUT_MS);
 }
 
 /*
-* @brief Sends an ENetPacket to a specified ENetPeet.
-* @param packet The ENetPacket to send.
-* @param peer The ENetPeer to send the packet to.
-* @return True if the packet was sent successfully, false otherwise.
+* @brief Wakes the networking loop from wait_for_activity() by sending a small datagram to the host's own socket
+* (or to its wake-up receiver, when the host shares its port).
+* Called from other threads after they queue work for the host (eg a send) and on shutdown.
+* Repeated calls before the loop runs again send only one datagram.
 */
-bool NetworkUser::send_packet(ENetPacket* packet, ENetPeer* peer) {
-	if (!host) { // Check that the local host is valid
-		ERROR("Cannot send packet, ENetHost is null.");
-		return false;
+void NetworkUser::wake() {
+	if (!NetworkConstants::BLOCKING_SERVICE || !host || wake_socket == ENET_SOCKET_NULL) return;
+	if (std::this_thread::get_id() == thread_id.load()) return; // The loop is running, not waiting
+	if (wake_pending.exchange(true)) return; // Already woken
+
+	ENetAddress target;
+	ENetSocket target_socket = wake_receiver != ENET_SOCKET_NULL ? wake_receiver : host->socket;
+	if (enet_socket_get_address(target_socket, &target) < 0 || target.port == 0) {
+		wake_pending.store(false); // Not bound yet (client before connecting), the wait will time out instead
+		return;
 	}
-	
-	if (!peer) { // Check that the external peer is valid
+
+	// A host bound to any address is reached through loopback
+	static const uint8_t ANY_IPV4_MAPPED[16] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF, 0, 0, 0, 0 };
+	static const uint8_t ANY_IPV6[16] = { 0 };
+	if (std::memcmp(&target.host, ANY_IPV6, 16) == 0 || std::memcmp(&target.host, ANY_IPV4_MAPPED, 16) == 0) {
+		enet_address_set_host_ip(&target, "127.0.0.1");
+	}
+
+	ENetBuffer buffer;
+	buffer.data = const_cast<uint8_t*>(WAKE_MAGIC);
+	buffer.dataLength = sizeof(WAKE_MAGIC);
+	if (enet_socket_send(wake_socket, &target, &buffer, 1) < 0) {
+		wake_pending.store(false);
+	}
+}
+
+/*
+* @brief ENet intercept callback that swallows wake-up datagrams.
+* @return 1 (handled, skip) for wake-up datagrams, 0 to let ENet process everything else.
+*/
+int ENET_CALLBACK NetworkUser::intercept_wake(ENetHost* host, void* event) {
+	if (host->receivedDataLength == sizeof(WAKE_MAGIC) &&
+		std::memcmp(host->receivedData, WAKE_MAGIC, sizeof(WAKE_MAGIC)) == 0) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+* @brief Queues an ENetPacket to be sent to a peer by the networking thread.
+* @param packet The ENetPacket to send. Owned by the queue from here on, destroyed if the call fails.
+* @param peer The ENetPeer to send the packet to.
+* @param channel The channel to send on (see NetworkConstants, usually the packet's delivery().channel).
+* @return True if the packet was queued, false otherwise.
+*/
+bool NetworkUser::send_packet(ENetPacket* packet, ENetPeer* peer, uint8_t channel) {
+	SendCommand command;
+	command.packet = packet;
+	command.channel = channel;
+	if (!peer) { // Checked here, queue_send only sees a null peer as "no single peer"
 		ERROR("Cannot send packet, ENetPeer is null.");
+		if (packet) enet_packet_destroy(packet);
 		return false;
 	}
+	command.peer = peer;
+	return queue_send(command);
+}
+
+/*
+* @brief Queues one ENetPacket to be sent to several peers by the networking thread.
+* ENet reference counts the packet, so it is only encoded and stored once.
+* @param packet The ENetPacket to send. Owned by the queue from here on, destroyed if the call fails.
+* @param peers The ENetPeers to send the packet to.
+* @param channel The channel to send on.
+* @return True if the packet was queued, false otherwise.
+*/
+bool NetworkUser::send_packet(ENetPacket* packet, std::vector<ENetPeer*> peers, uint8_t channel) {
+	if (peers.size() == 1) {
+		return send_packet(packet, peers[0], channel);
+	}
+
+	for (ENetPeer* peer : peers) {
+		if (!peer) { // Check that the external peers are valid
+			ERROR("Cannot send packet, ENetPeer is null.");
+			if (packet) enet_packet_destroy(packet);
+			return false;
+		}
+	}
 
-	int result = enet_peer_send(peer, 0, packet); // Send the packet on channel 0
+	SendCommand command;
+	command.packet = packet;
+	command.peers = std::move(peers);
+	command.channel = channel;
+	return queue_send(command);
+}
 
-	if (result < 0) { // Check for send failure
-		ERROR("Failed to send packet to peer with IP address: " + NetUtils::get_ip_string(peer->address));
+/*
+* @brief Queues a send whose peers have been checked, and wakes the networking loop to carry it out.
+* @param command The send. Its packet is destroyed if the send cannot be queued.
+* @return True if the send was queued, false otherwise.
+*/
+bool NetworkUser::queue_send(SendCommand& command) {
+	if (!command.packet) {
+		ERROR("Cannot send packet, ENetPacket is null.");
 		return false;
 	}
+
+	if (!host) { // Check that the local host is valid
+		ERROR("Cannot send packet, ENetHost is null.");
+		enet_packet_destroy(command.packet);
+		return false;
+	}
+
+	send_queue.push(std::move(command));
+	wake(); // Let the networking loop send it now rather than after its wait
 	return true;
+}
+
+/*
+* @brief Queues a disconnect of a peer, carried out after every send queued before it.
+* @param peer The ENetPeer to disconnect.
+* @param mode How to disconnect the peer.
+*/
+void NetworkUser::queue_disconnect(ENetPeer* peer, DisconnectMode mode) {
+	if (!peer) return;
+
+	SendCommand command;
+	command.peer = peer;
+	command.disconnect_mode = mode;
+	send_queue.push(std::move(command));
+
+	wake();
+}
+
+/*
+* @brief Carries out every queued send and disconnect in order, then flushes the host.
+* State packets go through the conflator, which sends the newest of each stream once the peer has room.
+* Must only be called from the networking thread (or while it is not running).
+*/
+void NetworkUser::flush_send_queue() {
+	if (!host) return;
+
+	SendCommand command;
+	while (send_queue.pop(command)) {
+		if (!command.packet) {
+			command.for_each_peer([this, &command](ENetPeer* peer) {
+				conflator.drop(peer); // Nothing held is worth sending to a peer being disconnected
+				switch (command.disconnect_mode) {
+				case DisconnectMode::GRACEFUL: enet_peer_disconnect(peer, 0); break;
+				case DisconnectMode::LATER: enet_peer_disconnect_later(peer, 0); break;
+				case DisconnectMode::NOW: enet_peer_disconnect_now(peer, 0); break;
+				}
+			});
+			continue;
+		}
+
+		bool conflate = NetworkConstants::CONFLATE_STATE_PACKETS && PacketConflator::is_conflatable(command.packet);
+		command.for_each_peer([this, &command, conflate](ENetPeer* peer) {
+			if (conflate) {
+				conflator.hold(peer, command.channel, command.packet);
+			}
+			else if (enet_peer_send(peer, command.channel, command.packet) < 0) { // Check for send failure
+				ERROR("Failed to send packet to peer with IP address: " + NetUtils::get_ip_string(peer->address));
+			}
+		});
+
+		// No peer took a reference (no target, or every send failed and the conflator held none), so ENet will never free it
+		if (command.packet->referenceCount == 0) {
+			enet_packet_destroy(command.packet);
+		}
+	}
+
+	conflator.release();
+	enet_host_flush(host);
+}
+
+/*
+* @brief Discards the state packets held for a peer, so they are not sent to whoever ENet reuses the peer for.
+* Call when ENet reports the peer disconnected. Must only be called from the networking thread.
+* @param peer The ENetPeer that disconnected.
+*/
+void NetworkUser::forget_peer(ENetPeer* peer) {
+	conflator.drop(peer);
 }
\ No newline at end of file
@@ -3,23 +3,73 @@
 #include "Networking/Packet/Packet.h"
 #include <future>
 #include "Networking/NetworkConstants.h"
+#include "Utils/MpscQueue.h"
+#include "Networking/PacketConflator.h"
+#include <vector>
+
+// How a queued disconnect is carried out, see NetworkUser::queue_disconnect
+enum class DisconnectMode : uint8_t {
+	GRACEFUL, // enet_peer_disconnect: drop anything still unsent, then disconnect
+	LATER,    // enet_peer_disconnect_later: disconnect once everything queued before it is sent
+	NOW       // enet_peer_disconnect_now: reset the peer at once, its notice is never resent and no disconnect event follows
+};
+
+// A send or disconnect queued for the networking thread
+struct SendCommand {
+	ENetPacket* packet = nullptr; // Packet to send to every peer (nullptr for a disconnect)
+	ENetPeer* peer = nullptr; // The peer, for commands that apply to one (most sends), so they allocate nothing
+	std::vector<ENetPeer*> peers; // The peers, for commands that apply to several (broadcasts)
+	uint8_t channel = 0; // Channel to send on
+	DisconnectMode disconnect_mode = DisconnectMode::GRACEFUL; // How to disconnect (disconnects only)
+
+	template<class Visit>
+	void for_each_peer(Visit visit) const {
+		if (peer) visit(peer);
+		for (ENetPeer* each : peers) visit(each);
+	}
+};
 
 class NetworkUser {
 public:
 	NetworkUser();
+	virtual ~NetworkUser();
 	
 	ENetAddress address = { 0 }; // Local address
 	ENetHost* host = nullptr; // Local ENet host
 
 	void start(); // Start the networking loop
 	void stop();  // Stop the networking loop
-	bool send_packet(ENetPacket* packet, ENetPeer* peer); // Send a packet to a peer
+	// Sends are queued and carried out by the networking thread, which owns the ENetHost.
+	// The packet is owned by the queue from here on, even if the call fails.
+	bool send_packet(ENetPacket* packet, ENetPeer* peer, uint8_t channel); // Send a packet to a peer on a channel
+	bool send_packet(ENetPacket* packet, std::vector<ENetPeer*> peers, uint8_t channel); // Send one packet to several peers
+	void queue_disconnect(ENetPeer* peer, DisconnectMode mode = DisconnectMode::GRACEFUL); // Disconnect a peer after the sends queued before it
+	void wake(); // Interrupt the networking loop's wait, so work queued from another thread is handled now
+
+	static size_t current_shard(); // Shard whose networking loop is running on the calling thread, 0 on any other thread
+	static bool on_networking_thread(); // Whether a networking loop is running on the calling thread
 
 protected:
 	std::atomic<bool> is_running = false; // Is the networking loop running
 	std::future<void> loop_future; // Future for the networking loop
-	std::thread::id thread_id; // ID of the networking loop thread
+	std::atomic<std::thread::id> thread_id; // ID of the networking loop thread while it runs, read from any thread
+	size_t shard_index = 0; // Which of the server's hosts this loop services, see SERVER_SHARDS
+	bool shared_port = false; // The host shares its port with other hosts (SO_REUSEPORT), set before start()
 
 	virtual void update() = 0; // Update the networking state. This should be defined in the derived class
 	void update_loop(); // The networking loop function
+	bool queue_send(SendCommand& command); // Checks a send and queues it, frees the packet if it fails
+	void wait_for_activity(); // Block until the host receives data, wake() is called or SERVICE_TIMEOUT_MS passes
+	void flush_send_queue(); // Carry out every queued command and flush the host (networking thread only)
+	void forget_peer(ENetPeer* peer); // Discard state packets held for a disconnected peer (networking thread only)
+
+private:
+	MpscQueue<SendCommand> send_queue; // Sends and disconnects from any thread, drained by the networking thread
+	PacketConflator conflator; // Newest unsent state packet per peer and type, see CONFLATE_STATE_PACKETS
+
+	ENetSocket wake_socket = ENET_SOCKET_NULL; // Sends wake-up datagrams to the host's own socket
+	ENetSocket wake_receiver = ENET_SOCKET_NULL; // Loopback socket woken instead when the host's port is shared
+	std::atomic<bool> wake_pending = false; // A wake-up datagram was sent since the loop last ran
+
+	static int ENET_CALLBACK intercept_wake(ENetHost* host, void* event); // Drops wake-up datagrams before ENet parses them
 };
\ No newline at end of file
@@ -0,0 +1,318 @@
+#pragma once
+#include "Networking/Packet/PacketBuffer.h"
+#include <cereal/cereal.hpp>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * @brief Cereal output archive that writes a compact bit stream into a PacketBuffer.
+ *
+ * Encoding rules:
+ * - bool: 1 bit
+ * - 8-bit integers: 8 bits
+ * - wider integers, sizes and counts: varints (7 bits per group plus a continuation bit),
+ *   signed values zigzag encoded first
+ * - float/double: their raw 32/64 bits
+ * - strings and other byte data: padded to a byte boundary, then copied as-is
+ * - RangedValue: just enough bits for its range
+ *
+ * Bits are written least significant first, so a leading uint8_t (PacketHeader::type)
+ * lands in byte 0 unchanged. The last partial byte is only written by flush(), which must be
+ * called before the buffer is read (Packet's serialize helpers do).
+ */
+class BitPacketOutputArchive : public cereal::OutputArchive<BitPacketOutputArchive, cereal::AllowEmptyClassElision> {
+public:
+	BitPacketOutputArchive(PacketBuffer& _buffer)
+		: cereal::OutputArchive<BitPacketOutputArchive, cereal::AllowEmptyClassElision>(this), buffer(_buffer) {
+	}
+
+	// Writes the low count bits of value (count <= 32)
+	void write_bits(uint32_t value, unsigned count) {
+		if (count < 32) value &= (1u << count) - 1;
+		scratch |= static_cast<uint64_t>(value) << scratch_bits;
+		scratch_bits += count;
+		while (scratch_bits >= 8) {
+			buffer.push_back(static_cast<uint8_t>(scratch));
+			scratch >>= 8;
+			scratch_bits -= 8;
+		}
+	}
+
+	// Writes an unsigned varint, 8 bits per 7 bits of value
+	void write_varint(uint64_t value) {
+		while (value >= 0x80) {
+			write_bits(static_cast<uint32_t>(value & 0x7F) | 0x80, 8);
+			value >>= 7;
+		}
+		write_bits(static_cast<uint32_t>(value), 8);
+	}
+
+	// Pads with zero bits up to the next byte boundary
+	void align() {
+		if (scratch_bits > 0) {
+			buffer.push_back(static_cast<uint8_t>(scratch));
+			scratch = 0;
+			scratch_bits = 0;
+		}
+	}
+
+	// Writes the last partial byte, once everything is serialized
+	void flush() {
+		align();
+	}
+
+	// Writes raw bytes starting at the next byte boundary
+	void write_bytes(const void* data, std::size_t size) {
+		align();
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		buffer.insert(buffer.end(), bytes, bytes + size);
+	}
+
+private:
+	PacketBuffer& buffer;
+	uint64_t scratch = 0; // Bits not yet written to the buffer
+	unsigned scratch_bits = 0; // Number of valid bits in scratch (always < 8 between writes)
+};
+
+/**
+ * @brief Cereal input archive that reads the bit stream written by BitPacketOutputArchive.
+ * Reading past the end of the data throws a cereal::Exception.
+ */
+class BitPacketInputArchive : public cereal::InputArchive<BitPacketInputArchive, cereal::AllowEmptyClassElision> {
+public:
+	BitPacketInputArchive(const uint8_t* _data, std::size_t _size)
+		: cereal::InputArchive<BitPacketInputArchive, cereal::AllowEmptyClassElision>(this), data(_data), size(_size) {
+	}
+
+	// Reads count bits (count <= 32)
+	uint32_t read_bits(unsigned count) {
+		if (count > remaining_bits()) {
+			throw cereal::Exception("Failed to read " + std::to_string(count) + " bits from packet, only "
+				+ std::to_string(remaining_bits()) + " remain");
+		}
+
+		uint64_t result = 0;
+		unsigned read = 0;
+		while (read < count) {
+			unsigned take = std::min(8 - bit_offset, count - read);
+			uint64_t bits = (data[byte_offset] >> bit_offset) & ((1u << take) - 1);
+			result |= bits << read;
+			read += take;
+			bit_offset += take;
+			if (bit_offset == 8) {
+				bit_offset = 0;
+				byte_offset++;
+			}
+		}
+		return static_cast<uint32_t>(result);
+	}
+
+	// Reads an unsigned varint
+	uint64_t read_varint() {
+		uint64_t value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			uint32_t group = read_bits(8);
+			value |= static_cast<uint64_t>(group & 0x7F) << shift;
+			if (!(group & 0x80)) return value;
+		}
+		throw cereal::Exception("Malformed varint in packet");
+	}
+
+	// Skips to the next byte boundary
+	void align() {
+		if (bit_offset > 0) {
+			bit_offset = 0;
+			byte_offset++;
+		}
+	}
+
+	// Reads raw bytes starting at the next byte boundary
+	void read_bytes(void* out, std::size_t count) {
+		align();
+		if (count > size - byte_offset) {
+			throw cereal::Exception("Failed to read " + std::to_string(count) + " bytes from packet, only "
+				+ std::to_string(size - byte_offset) + " remain");
+		}
+		std::memcpy(out, data + byte_offset, count);
+		byte_offset += count;
+	}
+
+	std::size_t remaining_bits() const { return (size - byte_offset) * 8 - bit_offset; } // Number of bits left to read
+	std::size_t bytes_read() const { return byte_offset + (bit_offset > 0 ? 1 : 0); } // Bytes touched so far, including a partial one
+
+private:
+	const uint8_t* data;
+	std::size_t size;
+	std::size_t byte_offset = 0;
+	unsigned bit_offset = 0; // Bits already read from data[byte_offset]
+};
+
+/**
+ * @brief An integer or enum known to lie in [min, max].
+ * BitPacket archives write it in just enough bits to cover the range; other archives
+ * write the underlying integer. Use through make_ranged().
+ */
+template<class T>
+class RangedValue {
+public:
+	using Underlying = typename std::conditional<std::is_enum<T>::value,
+		std::underlying_type<T>, std::common_type<T>>::type::type;
+
+	RangedValue(T& _value, T _min, T _max) : value(_value), min(_min), max(_max) {}
+
+	template<class Archive>
+	void save(Archive& archive) const {
+		if constexpr (std::is_same<Archive, BitPacketOutputArchive>::value) {
+			archive.write_bits(static_cast<uint32_t>(to_underlying(value) - to_underlying(min)), bits());
+		}
+		else {
+			archive(to_underlying(value));
+		}
+	}
+
+	template<class Archive>
+	void load(Archive& archive) {
+		Underlying raw;
+		if constexpr (std::is_same<Archive, BitPacketInputArchive>::value) {
+			raw = static_cast<Underlying>(archive.read_bits(bits()) + to_underlying(min));
+		}
+		else {
+			archive(raw);
+		}
+		if (raw < to_underlying(min) || raw > to_underlying(max)) {
+			throw cereal::Exception("Ranged value " + std::to_string(raw) + " out of range");
+		}
+		value = static_cast<T>(raw);
+	}
+
+private:
+	T& value;
+	T min;
+	T max;
+
+	static Underlying to_underlying(T v) { return static_cast<Underlying>(v); }
+
+	// Number of bits needed to hold max - min
+	unsigned bits() const {
+		uint64_t range = static_cast<uint64_t>(to_underlying(max) - to_underlying(min));
+		unsigned count = 0;
+		while (range > 0) {
+			count++;
+			range >>= 1;
+		}
+		return count;
+	}
+};
+
+// Wraps an integer or enum field that always lies in [min, max]
+template<class T>
+RangedValue<T> make_ranged(T& value, T min, T max) {
+	return RangedValue<T>(value, min, max);
+}
+
+// Bools are a single bit
+inline void CEREAL_SAVE_FUNCTION_NAME(BitPacketOutputArchive& archive, bool const& b) {
+	archive.write_bits(b ? 1 : 0, 1);
+}
+
+inline void CEREAL_LOAD_FUNCTION_NAME(BitPacketInputArchive& archive, bool& b) {
+	b = archive.read_bits(1) != 0;
+}
+
+// Integers: 8-bit values as-is, wider values as (zigzag) varints
+template<class T> inline
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, void>::type
+CEREAL_SAVE_FUNCTION_NAME(BitPacketOutputArchive& archive, T const& t) {
+	if constexpr (sizeof(T) == 1) {
+		archive.write_bits(static_cast<uint8_t>(t), 8);
+	}
+	else if constexpr (std::is_unsigned<T>::value) {
+		archive.write_varint(static_cast<uint64_t>(t));
+	}
+	else {
+		int64_t v = static_cast<int64_t>(t);
+		archive.write_varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+	}
+}
+
+template<class T> inline
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, void>::type
+CEREAL_LOAD_FUNCTION_NAME(BitPacketInputArchive& archive, T& t) {
+	if constexpr (sizeof(T) == 1) {
+		t = static_cast<T>(archive.read_bits(8));
+	}
+	else if constexpr (std::is_unsigned<T>::value) {
+		t = static_cast<T>(archive.read_varint());
+	}
+	else {
+		uint64_t v = archive.read_varint();
+		t = static_cast<T>(static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1));
+	}
+}
+
+// Floating point values keep their raw bits
+template<class T> inline
+typename std::enable_if<std::is_floating_point<T>::value, void>::type
+CEREAL_SAVE_FUNCTION_NAME(BitPacketOutputArchive& archive, T const& t) {
+	uint32_t words[sizeof(T) / sizeof(uint32_t)];
+	std::memcpy(words, &t, sizeof(T));
+	for (uint32_t word : words) archive.write_bits(word, 32);
+}
+
+template<class T> inline
+typename std::enable_if<std::is_floating_point<T>::value, void>::type
+CEREAL_LOAD_FUNCTION_NAME(BitPacketInputArchive& archive, T& t) {
+	uint32_t words[sizeof(T) / sizeof(uint32_t)];
+	for (uint32_t& word : words) word = archive.read_bits(32);
+	std::memcpy(&t, words, sizeof(T));
+}
+
+// Name-value pairs carry no names on the wire
+template<class T> inline
+void CEREAL_SAVE_FUNCTION_NAME(BitPacketOutputArchive& archive, cereal::NameValuePair<T> const& t) {
+	archive(t.value);
+}
+
+template<class T> inline
+void CEREAL_LOAD_FUNCTION_NAME(BitPacketInputArchive& archive, cereal::NameValuePair<T>& t) {
+	archive(t.value);
+}
+
+// Sizes and counts are varints. Every element takes at least one bit,
+// so a size larger than the remaining data is rejected before anything is allocated.
+template<class T> inline
+void CEREAL_SAVE_FUNCTION_NAME(BitPacketOutputArchive& archive, cereal::SizeTag<T> const& t) {
+	archive.write_varint(static_cast<uint64_t>(t.size));
+}
+
+template<class T> inline
+void CEREAL_LOAD_FUNCTION_NAME(BitPacketInputArchive& archive, cereal::SizeTag<T>& t) {
+	uint64_t size = archive.read_varint();
+	if (size > archive.remaining_bits()) {
+		throw cereal::Exception("Packet size tag of " + std::to_string(size) + " exceeds remaining data");
+	}
+	t.size = static_cast<typename std::remove_reference<T>::type>(size);
+}
+
+// Byte data (strings, vectors of bytes) is copied byte-aligned. Wider element types are
+// deliberately not accepted, so cereal falls back to per-element varints for them.
+template<class T>
+struct is_bit_packet_byte_data : std::integral_constant<bool,
+	sizeof(typename std::remove_pointer<typename std::remove_reference<T>::type>::type) == 1> {};
+
+template<class T> inline
+typename std::enable_if<is_bit_packet_byte_data<T>::value, void>::type
+CEREAL_SAVE_FUNCTION_NAME(BitPacketOutputArchive& archive, cereal::BinaryData<T> const& bd) {
+	archive.write_bytes(bd.data, static_cast<std::size_t>(bd.size));
+}
+
+template<class T> inline
+typename std::enable_if<is_bit_packet_byte_data<T>::value, void>::type
+CEREAL_LOAD_FUNCTION_NAME(BitPacketInputArchive& archive, cereal::BinaryData<T>& bd) {
+	archive.read_bytes(bd.data, static_cast<std::size_t>(bd.size));
+}
+
+CEREAL_REGISTER_ARCHIVE(BitPacketOutputArchive)
+CEREAL_REGISTER_ARCHIVE(BitPacketInputArchive)
+CEREAL_SETUP_ARCHIVE_TRAITS(BitPacketInputArchive, BitPacketOutputArchive)
@@ -0,0 +1,162 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Packet/BitPacketArchive.h"
+#include <cereal/cereal.hpp>
+#include <vector>
+#include <type_traits>
+
+/**
+ * @brief Helpers for column-oriented (structure of arrays) packet layouts.
+ *
+ * Bulk update lists are written one field at a time across all rows instead of one row
+ * at a time. Fixed-size columns go out as a single byte-aligned block, so encoding and
+ * decoding them is a memcpy, and similar values sit next to each other, which general
+ * purpose compressors handle far better than interleaved structs.
+ *
+ * Rows are update structs with an `id` and a `fields` mask; a column only holds the
+ * rows whose mask includes that column's field bit.
+ */
+namespace ColumnCodec {
+
+	// Number of rows whose field mask includes bit
+	template<class Row, class Mask>
+	size_t count_rows(const std::vector<Row>& rows, Mask bit) {
+		size_t count = 0;
+		for (const Row& row : rows) {
+			if (row.fields & bit) count++;
+		}
+		return count;
+	}
+
+	// Per-thread column reused across encodes and decodes, so neither allocates once it has grown to
+	// the largest list seen. Columns that are in use at the same time must use different slots.
+	template<class T, size_t Slot = 0>
+	std::vector<T>& scratch_column() {
+		thread_local std::vector<T> column;
+		return column;
+	}
+
+	// Writes a column of fixed-size values as one contiguous little-endian block
+	template<class Archive, class T>
+	void save_block(Archive& archive, const std::vector<T>& column) {
+		static_assert(std::is_arithmetic<T>::value, "Block columns must hold arithmetic values");
+		if (column.empty()) return;
+		archive(cereal::binary_data(reinterpret_cast<const uint8_t*>(column.data()), column.size() * sizeof(T)));
+	}
+
+	// Reads a column of count fixed-size values written by save_block
+	template<class Archive, class T>
+	void load_block(Archive& archive, std::vector<T>& column, size_t count) {
+		static_assert(std::is_arithmetic<T>::value, "Block columns must hold arithmetic values");
+		column.resize(count);
+		if (count == 0) return;
+		archive(cereal::binary_data(reinterpret_cast<uint8_t*>(column.data()), count * sizeof(T)));
+	}
+
+	// Writes the id column as differences from the previous id, which are small when rows are sorted
+	template<class Archive, class Row>
+	void save_ids(Archive& archive, const std::vector<Row>& rows) {
+		uint32_t previous = 0;
+		for (const Row& row : rows) {
+			archive(static_cast<int32_t>(row.id - previous));
+			previous = row.id;
+		}
+	}
+
+	template<class Archive, class Row>
+	void load_ids(Archive& archive, std::vector<Row>& rows) {
+		uint32_t previous = 0;
+		for (Row& row : rows) {
+			int32_t delta = 0;
+			archive(delta);
+			row.id = previous + static_cast<uint32_t>(delta);
+			previous = row.id;
+		}
+	}
+
+	// Writes the field mask column, each mask in just enough bits for all_fields
+	template<class Archive, class Row>
+	void save_fields(Archive& archive, const std::vector<Row>& rows, decltype(Row::fields) all_fields) {
+		for (const Row& row : rows) {
+			auto fields = row.fields;
+			archive(make_ranged(fields, decltype(fields)(0), all_fields));
+		}
+	}
+
+	template<class Archive, class Row>
+	void load_fields(Archive& archive, std::vector<Row>& rows, decltype(Row::fields) all_fields) {
+		for (Row& row : rows) {
+			archive(make_ranged(row.fields, decltype(row.fields)(0), all_fields));
+		}
+	}
+
+	// Writes one fixed-size member of the rows carrying bit as a block column
+	template<class Archive, class Row, class Mask, class T>
+	void save_member_block(Archive& archive, const std::vector<Row>& rows, Mask bit, T Row::* member) {
+		std::vector<T>& column = scratch_column<T>();
+		column.clear();
+		for (const Row& row : rows) {
+			if (row.fields & bit) column.push_back(row.*member);
+		}
+		save_block(archive, column);
+	}
+
+	template<class Archive, class Row, class Mask, class T>
+	void load_member_block(Archive& archive, std::vector<Row>& rows, Mask bit, T Row::* member) {
+		std::vector<T>& column = scratch_column<T>();
+		load_block(archive, column, count_rows(rows, bit));
+		size_t next = 0;
+		for (Row& row : rows) {
+			if (row.fields & bit) row.*member = column[next++];
+		}
+	}
+
+	// Writes one member of the rows carrying bit value by value, for members that are
+	// variable-sized or compress better as varints/bits (timestamps, flags, lists)
+	template<class Archive, class Row, class Mask, class T>
+	void save_member_values(Archive& archive, const std::vector<Row>& rows, Mask bit, T Row::* member) {
+		for (const Row& row : rows) {
+			if (row.fields & bit) archive(row.*member);
+		}
+	}
+
+	template<class Archive, class Row, class Mask, class T>
+	void load_member_values(Archive& archive, std::vector<Row>& rows, Mask bit, T Row::* member) {
+		for (Row& row : rows) {
+			if (row.fields & bit) archive(row.*member);
+		}
+	}
+
+	/**
+	 * @brief Serialization wrapper that writes a list of rows in column layout.
+	 * The row count goes first, then Row::save_columns writes the columns.
+	 * Use as archive(make_columns(rows)).
+	 */
+	template<class Row>
+	class Columns {
+	public:
+		explicit Columns(std::vector<Row>& _rows) : rows(_rows) {}
+
+		template<class Archive>
+		void save(Archive& archive) const {
+			archive(cereal::make_size_tag(static_cast<cereal::size_type>(rows.size())));
+			Row::save_columns(archive, rows);
+		}
+
+		template<class Archive>
+		void load(Archive& archive) {
+			cereal::size_type count = 0;
+			archive(cereal::make_size_tag(count));
+			rows.resize(static_cast<size_t>(count));
+			Row::load_columns(archive, rows);
+		}
+
+	private:
+		std::vector<Row>& rows;
+	};
+
+	template<class Row>
+	Columns<Row> make_columns(std::vector<Row>& rows) {
+		return Columns<Row>(rows);
+	}
+}
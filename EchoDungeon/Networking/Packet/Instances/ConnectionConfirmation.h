@@ -11,6 +11,8 @@
  */
 class ConnectionConfirmationPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 3; // ID in ECHO_PACKET_LIST
+
 	uint16_t client_assigned_id = 0; // Unique server-side ID assigned to the client
 
 	// The idea is that a ConnectionConfirmationPacket will be sent alongside a
@@ -18,20 +20,20 @@ public:
 
 	// Default constructor
 	ConnectionConfirmationPacket()
-		: Packet(3, true), client_assigned_id(0) {
+		: Packet(TYPE), client_assigned_id(0) {
 	}
 
 	// Constructor with data
 	ConnectionConfirmationPacket(uint16_t _client_assigned_id)
-		: Packet(3, true), client_assigned_id(_client_assigned_id) {
+		: Packet(TYPE), client_assigned_id(_client_assigned_id) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ConnectionConfirmationPacket)
-	PACKET_TO_ENET(ConnectionConfirmationPacket)
+	PACKET_DESERIALIZE_BITPACKED(ConnectionConfirmationPacket)
+	PACKET_TO_ENET_BITPACKED(ConnectionConfirmationPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, client_assigned_id);
+		archive(header, client_assigned_id);
 	}
 };
@@ -9,22 +9,24 @@
  */
 class ConnectionInitiationPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 1; // ID in ECHO_PACKET_LIST
+
 	std::string client_preferred_username;
 
 	// Default constructor
 	ConnectionInitiationPacket() 
-		: Packet(1, true), client_preferred_username("") {}
+		: Packet(TYPE), client_preferred_username("") {}
 	
 	// Constructor with username
 	ConnectionInitiationPacket(const std::string& username)
-		: Packet(1, true), client_preferred_username(username) {}
+		: Packet(TYPE), client_preferred_username(username) {}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ConnectionInitiationPacket)
-	PACKET_TO_ENET(ConnectionInitiationPacket)
+	PACKET_DESERIALIZE_BITPACKED(ConnectionInitiationPacket)
+	PACKET_TO_ENET_BITPACKED(ConnectionInitiationPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, client_preferred_username);
+		archive(header, client_preferred_username);
 	}
 };
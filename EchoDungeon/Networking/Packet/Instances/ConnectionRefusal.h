@@ -9,24 +9,26 @@
  */
 class ConnectionRefusalPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 2; // ID in ECHO_PACKET_LIST
+
 	std::string refusal_reason = "Connection refused: No further information provided";
 
 	// Default constructor
 	ConnectionRefusalPacket()
-		: Packet(2, true), refusal_reason("") {
+		: Packet(TYPE), refusal_reason("") {
 	}
 
 	// Constructor with username
 	ConnectionRefusalPacket(const std::string& _refusal_reason)
-		: Packet(2, true), refusal_reason(_refusal_reason) {
+		: Packet(TYPE), refusal_reason(_refusal_reason) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ConnectionRefusalPacket)
-	PACKET_TO_ENET(ConnectionRefusalPacket)
+	PACKET_DESERIALIZE_BITPACKED(ConnectionRefusalPacket)
+	PACKET_TO_ENET_BITPACKED(ConnectionRefusalPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, refusal_reason);
+		archive(header, refusal_reason);
 	}
 };
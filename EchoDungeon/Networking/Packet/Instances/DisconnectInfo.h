@@ -9,24 +9,26 @@
  */
 class DisconnectInfoPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 4; // ID in ECHO_PACKET_LIST
+
 	std::string disconnect_reason = "Disconnection requested: No further information provided";
 
 	// Default constructor
 	DisconnectInfoPacket()
-		: Packet(4, true), disconnect_reason("") {
+		: Packet(TYPE), disconnect_reason("") {
 	}
 
 	// Constructor with username
 	DisconnectInfoPacket(const std::string& _disconnect_reason)
-		: Packet(4, true), disconnect_reason(_disconnect_reason) {
+		: Packet(TYPE), disconnect_reason(_disconnect_reason) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(DisconnectInfoPacket)
-	PACKET_TO_ENET(DisconnectInfoPacket)
+	PACKET_DESERIALIZE_BITPACKED(DisconnectInfoPacket)
+	PACKET_TO_ENET_BITPACKED(DisconnectInfoPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, disconnect_reason);
+		archive(header, disconnect_reason);
 	}
 };
@@ -9,24 +9,26 @@
  */
 class DisconnectKickPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 5; // ID in ECHO_PACKET_LIST
+
 	std::string disconnect_reason = "Disconnection requested: No further information provided";
 
 	// Default constructor
 	DisconnectKickPacket()
-		: Packet(5, true), disconnect_reason("") {
+		: Packet(TYPE), disconnect_reason("") {
 	}
 
 	// Constructor with username
 	DisconnectKickPacket(const std::string& _disconnect_reason)
-		: Packet(5, true), disconnect_reason(_disconnect_reason) {
+		: Packet(TYPE), disconnect_reason(_disconnect_reason) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(DisconnectKickPacket)
-	PACKET_TO_ENET(DisconnectKickPacket)
+	PACKET_DESERIALIZE_BITPACKED(DisconnectKickPacket)
+	PACKET_TO_ENET_BITPACKED(DisconnectKickPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, disconnect_reason);
+		archive(header, disconnect_reason);
 	}
 };
@@ -10,24 +10,26 @@
  */
 class EnemyDestroyPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 19; // ID in ECHO_PACKET_LIST
+
 	uint32_t id = 0;  // Enemy ID to destroy
 
 	// Default constructor
 	EnemyDestroyPacket()
-		: Packet(19, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	EnemyDestroyPacket(uint32_t _id)
-		: Packet(19, true), id(_id) {
+		: Packet(TYPE), id(_id) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(EnemyDestroyPacket)
-	PACKET_TO_ENET(EnemyDestroyPacket)
+	PACKET_DESERIALIZE_BITPACKED(EnemyDestroyPacket)
+	PACKET_TO_ENET_BITPACKED(EnemyDestroyPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, id);
+		archive(header, id);
 	}
 };
@@ -13,6 +13,8 @@
  */
 class EnemySpawnPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 17; // ID in ECHO_PACKET_LIST
+
 	uint32_t id = 0;                    // Enemy ID
 	ObjectTransform transform;          // Initial transform
 	float health = 100.0f;              // Current health
@@ -24,7 +26,7 @@ public:
 
 	// Default constructor
 	EnemySpawnPacket()
-		: Packet(17, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
@@ -32,17 +34,17 @@ public:
 		float _health, float _max_health, float _damage, float _speed,
 		bool _spawns_items = true,
 		const std::string& _asset_id = "zombie")
-		: Packet(17, true), id(_id), transform(_transform),
+		: Packet(TYPE), id(_id), transform(_transform),
 		health(_health), max_health(_max_health), damage(_damage),
 		speed(_speed), spawns_items(_spawns_items), asset_id(_asset_id) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(EnemySpawnPacket)
-	PACKET_TO_ENET(EnemySpawnPacket)
+	PACKET_DESERIALIZE_BITPACKED(EnemySpawnPacket)
+	PACKET_TO_ENET_BITPACKED(EnemySpawnPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, id, transform, health, max_health, damage, speed, spawns_items, asset_id);
+		archive(header, id, transform, health, max_health, damage, speed, spawns_items, asset_id);
 	}
 };
@@ -1,5 +1,7 @@
 #pragma once
 #include "Networking/Packet/Packet.h"
+#include "Networking/Packet/TransformCodec.h"
+#include "Networking/Packet/ColumnCodec.h"
 #include "Game/World/Entities/ObjectTransform.h"
 #include <cereal/types/vector.hpp>
 
@@ -8,40 +10,79 @@
 
 /**
  * @brief Lightweight enemy update packet for frequent state synchronization.
- * Sent frequently (every tick) from server to all clients.
- * Contains only the data that changes frequently.
+ * Sent frequently (every tick) from server to each client.
+ * Each entry is a field-level delta against the client's acknowledged baseline:
+ * only the fields set in `fields` are written, and unchanged enemies are left out.
+ * The list is written in column layout, see ColumnCodec.
  */
 struct EnemyUpdateData {
+	// Field bits for delta encoding
+	static constexpr uint8_t FIELD_TRANSFORM = 1 << 0;
+	static constexpr uint8_t FIELD_HEALTH = 1 << 1;
+	static constexpr uint8_t ALL_FIELDS = FIELD_TRANSFORM | FIELD_HEALTH;
+
 	uint32_t id = 0;                    // Enemy ID
-	ObjectTransform transform;          // Current transform
+	uint8_t fields = ALL_FIELDS;        // Which fields below are present on the wire
+	ObjectTransform transform;          // Current transform (position and yaw only on the wire)
 	float health = 100.0f;              // Current health
 
+	// Returns the fields of this update that differ from baseline
+	uint8_t changed_fields(const EnemyUpdateData& baseline) const {
+		uint8_t changed = 0;
+		if (transform != baseline.transform) changed |= FIELD_TRANSFORM;
+		if (health != baseline.health) changed |= FIELD_HEALTH;
+		return changed;
+	}
+
+	// Copies the fields present in delta onto this (full) update
+	void apply_delta(const EnemyUpdateData& delta) {
+		if (delta.fields & FIELD_TRANSFORM) transform = delta.transform;
+		if (delta.fields & FIELD_HEALTH) health = delta.health;
+	}
+
+	// Column layout: ids, field masks, quantized transforms, healths
 	template<class Archive>
-	void serialize(Archive& archive) {
-		archive(id, transform, health);
+	static void save_columns(Archive& archive, const std::vector<EnemyUpdateData>& rows) {
+		ColumnCodec::save_ids(archive, rows);
+		ColumnCodec::save_fields(archive, rows, ALL_FIELDS);
+		TransformCodec::save_columns(archive, rows, FIELD_TRANSFORM);
+		ColumnCodec::save_member_block(archive, rows, FIELD_HEALTH, &EnemyUpdateData::health);
+	}
+
+	template<class Archive>
+	static void load_columns(Archive& archive, std::vector<EnemyUpdateData>& rows) {
+		ColumnCodec::load_ids(archive, rows);
+		ColumnCodec::load_fields(archive, rows, ALL_FIELDS);
+		TransformCodec::load_columns(archive, rows, FIELD_TRANSFORM);
+		ColumnCodec::load_member_block(archive, rows, FIELD_HEALTH, &EnemyUpdateData::health);
 	}
 };
 
 class EnemyUpdatePacket : public Packet {
 public:
-	std::vector<EnemyUpdateData> updates; // List of enemy updates
+	static constexpr uint8_t TYPE = 18; // ID in ECHO_PACKET_LIST
+
+	uint32_t sequence = 0; // Server replication tick this update describes
+	uint32_t baseline_sequence = 0; // Acknowledged tick the deltas are relative to (0 = no baseline, full state)
+	std::vector<EnemyUpdateData> updates; // Changed enemies since the baseline
+	std::vector<uint32_t> removed; // Enemies in the baseline that no longer exist
 
-	// Default constructor (reliable for now, but can be made unreliable for performance)
+	// Default constructor
 	EnemyUpdatePacket()
-		: Packet(18, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
-	EnemyUpdatePacket(const std::vector<EnemyUpdateData>& _updates)
-		: Packet(18, true), updates(_updates) {
+	EnemyUpdatePacket(uint32_t _sequence, uint32_t _baseline_sequence)
+		: Packet(TYPE), sequence(_sequence), baseline_sequence(_baseline_sequence) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(EnemyUpdatePacket)
-	PACKET_TO_ENET(EnemyUpdatePacket)
+	PACKET_DESERIALIZE_BITPACKED(EnemyUpdatePacket)
+	PACKET_TO_ENET_BITPACKED(EnemyUpdatePacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, updates);
+		archive(header, sequence, baseline_sequence, ColumnCodec::make_columns(updates), removed);
 	}
 };
@@ -12,24 +12,26 @@
  */
 class GeneralInformationUpdatePacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 8; // ID in ECHO_PACKET_LIST
+
 	std::string current_state; // Name of the current state the client is on
 
 	// Default constructor
 	GeneralInformationUpdatePacket()
-		: Packet(8, true), current_state("") {
+		: Packet(TYPE), current_state("") {
 	}
 
 	// Constructor with data
 	GeneralInformationUpdatePacket(const std::string& _current_state)
-		: Packet(8, true), current_state(_current_state) {
+		: Packet(TYPE), current_state(_current_state) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(GeneralInformationUpdatePacket)
-		PACKET_TO_ENET(GeneralInformationUpdatePacket)
+	PACKET_DESERIALIZE_BITPACKED(GeneralInformationUpdatePacket)
+		PACKET_TO_ENET_BITPACKED(GeneralInformationUpdatePacket)
 
 		template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, current_state);
+		archive(header, current_state);
 	}
 };
@@ -8,24 +8,26 @@
 
 class ItemDiscardPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 24; // ID in ECHO_PACKET_LIST
+
 	uint32_t item_id = 0;  // ID of item to discard
 
 	// Default constructor
 	ItemDiscardPacket()
-		: Packet(24, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	ItemDiscardPacket(uint32_t _item_id)
-		: Packet(24, true), item_id(_item_id) {
+		: Packet(TYPE), item_id(_item_id) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ItemDiscardPacket)
-	PACKET_TO_ENET(ItemDiscardPacket)
+	PACKET_DESERIALIZE_BITPACKED(ItemDiscardPacket)
+	PACKET_TO_ENET_BITPACKED(ItemDiscardPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, item_id);
+		archive(header, item_id);
 	}
 };
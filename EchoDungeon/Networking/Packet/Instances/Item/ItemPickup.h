@@ -9,25 +9,27 @@
 
 class ItemPickupPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 23; // ID in ECHO_PACKET_LIST
+
 	uint32_t player_id = 0;  // Which player received the item
 	Item item;  // Full item data
 
 	// Default constructor
 	ItemPickupPacket()
-		: Packet(23, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	ItemPickupPacket(uint32_t _player_id, const Item& _item)
-		: Packet(23, true), player_id(_player_id), item(_item) {
+		: Packet(TYPE), player_id(_player_id), item(_item) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ItemPickupPacket)
-	PACKET_TO_ENET(ItemPickupPacket)
+	PACKET_DESERIALIZE_BITPACKED(ItemPickupPacket)
+	PACKET_TO_ENET_BITPACKED(ItemPickupPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, player_id, item);
+		archive(header, player_id, item);
 	}
 };
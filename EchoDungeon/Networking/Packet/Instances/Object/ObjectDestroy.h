@@ -10,24 +10,26 @@
  */
 class ObjectDestroyPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 21; // ID in ECHO_PACKET_LIST
+
 	uint32_t id = 0;  // Object ID to destroy
 
 	// Default constructor
 	ObjectDestroyPacket()
-		: Packet(21, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	ObjectDestroyPacket(uint32_t _id)
-		: Packet(21, true), id(_id) {
+		: Packet(TYPE), id(_id) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ObjectDestroyPacket)
-	PACKET_TO_ENET(ObjectDestroyPacket)
+	PACKET_DESERIALIZE_BITPACKED(ObjectDestroyPacket)
+	PACKET_TO_ENET_BITPACKED(ObjectDestroyPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, id);
+		archive(header, id);
 	}
 };
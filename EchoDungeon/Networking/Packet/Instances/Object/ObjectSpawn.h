@@ -15,6 +15,8 @@
  */
 class ObjectSpawnPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 20; // ID in ECHO_PACKET_LIST
+
 	uint32_t id = 0;                         // Object ID
 	std::string asset_id = "";               // Asset reference
 	ObjectType object_type = ObjectType::MODEL;  // Type of object (MODEL or IMAGE_MODEL)
@@ -23,24 +25,22 @@ public:
 
 	// Default constructor
 	ObjectSpawnPacket()
-		: Packet(20, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	ObjectSpawnPacket(uint32_t _id, const std::string& _asset_id,
 		ObjectType _object_type, const ObjectTransform& _transform, raylib::Color _color = raylib::Color::White())
-		: Packet(20, true), id(_id), asset_id(_asset_id),
+		: Packet(TYPE), id(_id), asset_id(_asset_id),
 		object_type(_object_type), transform(_transform), color(_color) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ObjectSpawnPacket)
-	PACKET_TO_ENET(ObjectSpawnPacket)
+	PACKET_DESERIALIZE_BITPACKED(ObjectSpawnPacket)
+	PACKET_TO_ENET_BITPACKED(ObjectSpawnPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		uint8_t type_value = static_cast<uint8_t>(object_type);
-		archive(header, is_reliable, id, asset_id, type_value, transform, color);
-		object_type = static_cast<ObjectType>(type_value);
+		archive(header, id, asset_id, make_ranged(object_type, ObjectType::MODEL, ObjectType::IMAGE_MODEL), transform, color);
 	}
 };
@@ -9,20 +9,22 @@
  */
 class PlayerAttackPacket : public Packet {
 public:
+    static constexpr uint8_t TYPE = 22; // ID in ECHO_PACKET_LIST
+
     uint32_t player_id;
 
-    PlayerAttackPacket() : Packet(22, true), player_id(0) {}
+    PlayerAttackPacket() : Packet(TYPE), player_id(0) {}
 
     PlayerAttackPacket(uint32_t _player_id)
-        : Packet(22, true),
+        : Packet(TYPE),
         player_id(_player_id){
     }
 
     template<class Archive>
     void serialize(Archive& archive) {
-        archive(header, is_reliable, player_id);
+        archive(header, player_id);
     }
 
-    PACKET_TO_ENET(PlayerAttackPacket)
-    PACKET_DESERIALIZE(PlayerAttackPacket)
+    PACKET_TO_ENET_BITPACKED(PlayerAttackPacket)
+    PACKET_DESERIALIZE_BITPACKED(PlayerAttackPacket)
 };
\ No newline at end of file
@@ -10,24 +10,26 @@
  */
 class PlayerDestroyPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 16; // ID in ECHO_PACKET_LIST
+
 	uint32_t id = 0;  // Player ID to destroy
 
 	// Default constructor
 	PlayerDestroyPacket()
-		: Packet(16, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	PlayerDestroyPacket(uint32_t _id)
-		: Packet(16, true), id(_id) {
+		: Packet(TYPE), id(_id) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(PlayerDestroyPacket)
-	PACKET_TO_ENET(PlayerDestroyPacket)
+	PACKET_DESERIALIZE_BITPACKED(PlayerDestroyPacket)
+	PACKET_TO_ENET_BITPACKED(PlayerDestroyPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, id);
+		archive(header, id);
 	}
 };
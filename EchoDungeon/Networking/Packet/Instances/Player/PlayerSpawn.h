@@ -14,6 +14,8 @@
  */
 class PlayerSpawnPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 14; // ID in ECHO_PACKET_LIST
+
 	uint32_t id = 0;                    // Player ID (peer_id)
 	std::string name = "Unknown";       // Player name
 	ObjectTransform transform;          // Initial transform
@@ -30,7 +32,7 @@ public:
 
 	// Default constructor
 	PlayerSpawnPacket()
-		: Packet(14, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
@@ -39,7 +41,7 @@ public:
 		float _range = 2.0f, float _speed = 2.0f, uint64_t _attack_cooldown = 500,
 		uint64_t _last_attack_time = 0, const std::string& _asset_id = "player",
 		const Inventory& _inventory = Inventory())
-		: Packet(14, true), id(_id), name(_name), transform(_transform),
+		: Packet(TYPE), id(_id), name(_name), transform(_transform),
 		health(_health), max_health(_max_health), damage(_damage),
 		range(_range), speed(_speed), attack_cooldown(_attack_cooldown),
 		last_attack_time(_last_attack_time), asset_id(_asset_id), 
@@ -47,11 +49,11 @@ public:
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(PlayerSpawnPacket)
-	PACKET_TO_ENET(PlayerSpawnPacket)
+	PACKET_DESERIALIZE_BITPACKED(PlayerSpawnPacket)
+	PACKET_TO_ENET_BITPACKED(PlayerSpawnPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, id, name, transform, health, max_health, damage, range, speed, attack_cooldown, last_attack_time, asset_id, inventory);
+		archive(header, id, name, transform, health, max_health, damage, range, speed, attack_cooldown, last_attack_time, asset_id, inventory);
 	}
 };
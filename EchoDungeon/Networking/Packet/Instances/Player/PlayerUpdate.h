@@ -1,5 +1,7 @@
 #pragma once
 #include "Networking/Packet/Packet.h"
+#include "Networking/Packet/TransformCodec.h"
+#include "Networking/Packet/ColumnCodec.h"
 #include "Game/World/Entities/ObjectTransform.h"
 #include "Game/World/Entities/Inventory.h"
 #include <cereal/types/vector.hpp>
@@ -9,12 +11,28 @@
 
 /**
  * @brief Lightweight player update packet for frequent state synchronization.
- * Sent frequently (every tick) from server to all clients.
- * Contains only the data that changes frequently.
+ * Sent frequently (every tick) from server to each client.
+ * Each entry is a field-level delta against the client's acknowledged baseline:
+ * only the fields set in `fields` are written, and unchanged players are left out.
+ * The list is written in column layout, see ColumnCodec.
  */
 struct PlayerUpdateData {
+	// Field bits for delta encoding
+	static constexpr uint16_t FIELD_TRANSFORM = 1 << 0;
+	static constexpr uint16_t FIELD_HEALTH = 1 << 1;
+	static constexpr uint16_t FIELD_DAMAGE = 1 << 2;
+	static constexpr uint16_t FIELD_MAX_HEALTH = 1 << 3;
+	static constexpr uint16_t FIELD_RANGE = 1 << 4;
+	static constexpr uint16_t FIELD_SPEED = 1 << 5;
+	static constexpr uint16_t FIELD_ATTACK_COOLDOWN = 1 << 6;
+	static constexpr uint16_t FIELD_LAST_ATTACK_TIME = 1 << 7;
+	static constexpr uint16_t FIELD_ATTACKING = 1 << 8;
+	static constexpr uint16_t FIELD_INVENTORY = 1 << 9;
+	static constexpr uint16_t ALL_FIELDS = (1 << 10) - 1;
+
 	uint32_t id = 0;                    // Player ID
-	ObjectTransform transform;          // Current transform
+	uint16_t fields = ALL_FIELDS;       // Which fields below are present on the wire
+	ObjectTransform transform;          // Current transform (position and yaw only on the wire)
 	float health = 100.0f; // Player health
 	float damage = 10.0f; // Damage dealt by the player
 	float max_health = 100.0f; // Maximum health
@@ -26,32 +44,96 @@ struct PlayerUpdateData {
 	bool attacking = false; // Is the player currently attacking?
 	Inventory inventory;  // Player inventory
 
+	// Returns the fields of this update that differ from baseline
+	uint16_t changed_fields(const PlayerUpdateData& baseline) const {
+		uint16_t changed = 0;
+		if (transform != baseline.transform) changed |= FIELD_TRANSFORM;
+		if (health != baseline.health) changed |= FIELD_HEALTH;
+		if (damage != baseline.damage) changed |= FIELD_DAMAGE;
+		if (max_health != baseline.max_health) changed |= FIELD_MAX_HEALTH;
+		if (range != baseline.range) changed |= FIELD_RANGE;
+		if (speed != baseline.speed) changed |= FIELD_SPEED;
+		if (attack_cooldown != baseline.attack_cooldown) changed |= FIELD_ATTACK_COOLDOWN;
+		if (last_attack_time != baseline.last_attack_time) changed |= FIELD_LAST_ATTACK_TIME;
+		if (attacking != baseline.attacking) changed |= FIELD_ATTACKING;
+		if (inventory != baseline.inventory) changed |= FIELD_INVENTORY;
+		return changed;
+	}
+
+	// Copies the fields present in delta onto this (full) update
+	void apply_delta(const PlayerUpdateData& delta) {
+		if (delta.fields & FIELD_TRANSFORM) transform = delta.transform;
+		if (delta.fields & FIELD_HEALTH) health = delta.health;
+		if (delta.fields & FIELD_DAMAGE) damage = delta.damage;
+		if (delta.fields & FIELD_MAX_HEALTH) max_health = delta.max_health;
+		if (delta.fields & FIELD_RANGE) range = delta.range;
+		if (delta.fields & FIELD_SPEED) speed = delta.speed;
+		if (delta.fields & FIELD_ATTACK_COOLDOWN) attack_cooldown = delta.attack_cooldown;
+		if (delta.fields & FIELD_LAST_ATTACK_TIME) last_attack_time = delta.last_attack_time;
+		if (delta.fields & FIELD_ATTACKING) attacking = delta.attacking;
+		if (delta.fields & FIELD_INVENTORY) inventory = delta.inventory;
+	}
+
+	// Column layout: ids, field masks, quantized transforms, float stat blocks,
+	// then the timestamps, flags and inventories value by value
 	template<class Archive>
-	void serialize(Archive& archive) {
-		archive(id, transform, health, damage, max_health, range, speed, attack_cooldown, last_attack_time, attacking, inventory);
+	static void save_columns(Archive& archive, const std::vector<PlayerUpdateData>& rows) {
+		ColumnCodec::save_ids(archive, rows);
+		ColumnCodec::save_fields(archive, rows, ALL_FIELDS);
+		TransformCodec::save_columns(archive, rows, FIELD_TRANSFORM);
+		ColumnCodec::save_member_block(archive, rows, FIELD_HEALTH, &PlayerUpdateData::health);
+		ColumnCodec::save_member_block(archive, rows, FIELD_DAMAGE, &PlayerUpdateData::damage);
+		ColumnCodec::save_member_block(archive, rows, FIELD_MAX_HEALTH, &PlayerUpdateData::max_health);
+		ColumnCodec::save_member_block(archive, rows, FIELD_RANGE, &PlayerUpdateData::range);
+		ColumnCodec::save_member_block(archive, rows, FIELD_SPEED, &PlayerUpdateData::speed);
+		ColumnCodec::save_member_values(archive, rows, FIELD_ATTACK_COOLDOWN, &PlayerUpdateData::attack_cooldown);
+		ColumnCodec::save_member_values(archive, rows, FIELD_LAST_ATTACK_TIME, &PlayerUpdateData::last_attack_time);
+		ColumnCodec::save_member_values(archive, rows, FIELD_ATTACKING, &PlayerUpdateData::attacking);
+		ColumnCodec::save_member_values(archive, rows, FIELD_INVENTORY, &PlayerUpdateData::inventory);
+	}
+
+	template<class Archive>
+	static void load_columns(Archive& archive, std::vector<PlayerUpdateData>& rows) {
+		ColumnCodec::load_ids(archive, rows);
+		ColumnCodec::load_fields(archive, rows, ALL_FIELDS);
+		TransformCodec::load_columns(archive, rows, FIELD_TRANSFORM);
+		ColumnCodec::load_member_block(archive, rows, FIELD_HEALTH, &PlayerUpdateData::health);
+		ColumnCodec::load_member_block(archive, rows, FIELD_DAMAGE, &PlayerUpdateData::damage);
+		ColumnCodec::load_member_block(archive, rows, FIELD_MAX_HEALTH, &PlayerUpdateData::max_health);
+		ColumnCodec::load_member_block(archive, rows, FIELD_RANGE, &PlayerUpdateData::range);
+		ColumnCodec::load_member_block(archive, rows, FIELD_SPEED, &PlayerUpdateData::speed);
+		ColumnCodec::load_member_values(archive, rows, FIELD_ATTACK_COOLDOWN, &PlayerUpdateData::attack_cooldown);
+		ColumnCodec::load_member_values(archive, rows, FIELD_LAST_ATTACK_TIME, &PlayerUpdateData::last_attack_time);
+		ColumnCodec::load_member_values(archive, rows, FIELD_ATTACKING, &PlayerUpdateData::attacking);
+		ColumnCodec::load_member_values(archive, rows, FIELD_INVENTORY, &PlayerUpdateData::inventory);
 	}
 };
 
 class PlayerUpdatePacket : public Packet {
 public:
-	std::vector<PlayerUpdateData> updates; // List of player updates
+	static constexpr uint8_t TYPE = 15; // ID in ECHO_PACKET_LIST
+
+	uint32_t sequence = 0; // Server replication tick this update describes
+	uint32_t baseline_sequence = 0; // Acknowledged tick the deltas are relative to (0 = no baseline, full state)
+	std::vector<PlayerUpdateData> updates; // Changed players since the baseline
+	std::vector<uint32_t> removed; // Players in the baseline that no longer exist
 
-	// Default constructor (reliable for now, but can be made unreliable for performance)
+	// Default constructor
 	PlayerUpdatePacket()
-		: Packet(15, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
-	PlayerUpdatePacket(const std::vector<PlayerUpdateData>& _updates)
-		: Packet(15, true), updates(_updates) {
+	PlayerUpdatePacket(uint32_t _sequence, uint32_t _baseline_sequence)
+		: Packet(TYPE), sequence(_sequence), baseline_sequence(_baseline_sequence) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(PlayerUpdatePacket)
-	PACKET_TO_ENET(PlayerUpdatePacket)
+	PACKET_DESERIALIZE_BITPACKED(PlayerUpdatePacket)
+	PACKET_TO_ENET_BITPACKED(PlayerUpdatePacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, updates);
+		archive(header, sequence, baseline_sequence, ColumnCodec::make_columns(updates), removed);
 	}
 };
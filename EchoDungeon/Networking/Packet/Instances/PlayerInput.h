@@ -1,5 +1,6 @@
 #pragma once
 #include "Networking/Packet/Packet.h"
+#include "Networking/Packet/TransformCodec.h"
 #include "Game/World/Entities/ObjectTransform.h"
 
 // Packet type: 9
@@ -7,29 +8,31 @@
 
 /**
  * @brief Client sends player transform to server.
- * Sent frequently (every frame or when input changes) with unreliable delivery.
+ * Sent frequently (every frame or when input changes) on the unreliable state channel.
  * Server validates and broadcasts the result via PlayerUpdatePacket.
  */
 class PlayerInputPacket : public Packet {
 public:
-	ObjectTransform transform;  // Player's desired transform
+	static constexpr uint8_t TYPE = 9; // ID in ECHO_PACKET_LIST
 
-	// Default constructor (unreliable for performance)
+	ObjectTransform transform;  // Player's desired transform (position and yaw only on the wire)
+
+	// Default constructor
 	PlayerInputPacket()
-		: Packet(9, false) {  // false = unreliable
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
 	PlayerInputPacket(const ObjectTransform& _transform)
-		: Packet(9, false), transform(_transform) {
+		: Packet(TYPE), transform(_transform) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(PlayerInputPacket)
-	PACKET_TO_ENET(PlayerInputPacket)
+	PACKET_DESERIALIZE_BITPACKED(PlayerInputPacket)
+	PACKET_TO_ENET_BITPACKED(PlayerInputPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, transform);
+		archive(header, QuantizedTransform(transform));
 	}
 };
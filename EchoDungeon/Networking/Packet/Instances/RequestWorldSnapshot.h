@@ -11,19 +11,20 @@
  */
 class RequestWorldSnapshotPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 10; // ID in ECHO_PACKET_LIST
 
 	// Default constructor
 	RequestWorldSnapshotPacket()
-		: Packet(10, true) {
+		: Packet(TYPE) {
 	}
 
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(RequestWorldSnapshotPacket)
-	PACKET_TO_ENET(RequestWorldSnapshotPacket)
+	PACKET_DESERIALIZE_BITPACKED(RequestWorldSnapshotPacket)
+	PACKET_TO_ENET_BITPACKED(RequestWorldSnapshotPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable);
+		archive(header);
 	}
 };
@@ -12,25 +12,27 @@
  */
 class ServerDataUpdatePacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 6; // ID in ECHO_PACKET_LIST
+
 	std::unordered_map<uint16_t, UserData> current_peers; // Current list of connected peers
 	OpenServer server_info; // Information about the running server.
 
 	// Default constructor
 	ServerDataUpdatePacket()
-		: Packet(6, true), current_peers({}), server_info() {
+		: Packet(TYPE), current_peers({}), server_info() {
 	}
 
 	// Constructor with data
 	ServerDataUpdatePacket(const std::unordered_map<uint16_t, UserData>& _current_peers, const OpenServer& _server_info)
-		: Packet(6, true), current_peers(_current_peers), server_info(_server_info) {
+		: Packet(TYPE), current_peers(_current_peers), server_info(_server_info) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(ServerDataUpdatePacket)
-	PACKET_TO_ENET(ServerDataUpdatePacket)
+	PACKET_DESERIALIZE_BITPACKED(ServerDataUpdatePacket)
+	PACKET_TO_ENET_BITPACKED(ServerDataUpdatePacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, current_peers, server_info);
+		archive(header, current_peers, server_info);
 	}
 };
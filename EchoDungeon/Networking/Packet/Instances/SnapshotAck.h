@@ -0,0 +1,35 @@
+#pragma once
+#include "Networking/Packet/Packet.h"
+
+// Packet type: 25
+// Packet name: SnapshotAck
+// Direction: Client -> Server
+// Purpose: Acknowledge the newest player/enemy update the client has reconstructed,
+// so the server can delta-encode further updates against it
+
+class SnapshotAckPacket : public Packet {
+public:
+	static constexpr uint8_t TYPE = 25; // ID in ECHO_PACKET_LIST
+
+	uint32_t player_sequence = 0; // Newest PlayerUpdate sequence applied (0 = request full state)
+	uint32_t enemy_sequence = 0;  // Newest EnemyUpdate sequence applied (0 = request full state)
+
+	// Default constructor
+	SnapshotAckPacket()
+		: Packet(TYPE) {
+	}
+
+	// Constructor with data
+	SnapshotAckPacket(uint32_t _player_sequence, uint32_t _enemy_sequence)
+		: Packet(TYPE), player_sequence(_player_sequence), enemy_sequence(_enemy_sequence) {
+	}
+
+	// Macros for serialization
+	PACKET_DESERIALIZE_BITPACKED(SnapshotAckPacket)
+	PACKET_TO_ENET_BITPACKED(SnapshotAckPacket)
+
+	template<class Archive>
+	void serialize(Archive& archive) {
+		archive(header, player_sequence, enemy_sequence);
+	}
+};
@@ -12,24 +12,26 @@
  */
 class StateChangePacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 7; // ID in ECHO_PACKET_LIST
+
 	std::string new_state; // Name of the new state to change to
 
 	// Default constructor
 	StateChangePacket()
-		: Packet(7, true), new_state("") {
+		: Packet(TYPE), new_state("") {
 	}
 
 	// Constructor with data
 	StateChangePacket(const std::string& _new_state)
-		: Packet(7, true), new_state(_new_state) {
+		: Packet(TYPE), new_state(_new_state) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(StateChangePacket)
-		PACKET_TO_ENET(StateChangePacket)
+	PACKET_DESERIALIZE_BITPACKED(StateChangePacket)
+		PACKET_TO_ENET_BITPACKED(StateChangePacket)
 
 		template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, new_state);
+		archive(header, new_state);
 	}
 };
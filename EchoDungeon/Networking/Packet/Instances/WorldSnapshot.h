@@ -15,13 +15,15 @@
  */
 class WorldSnapshotPacket : public Packet {
 public:
+	static constexpr uint8_t TYPE = 11; // ID in ECHO_PACKET_LIST
+
 	std::unordered_map<uint32_t, Player> players; // All players in the world
 	std::unordered_map<uint32_t, Object> objects; // All objects in the world (keyed by object ID)
 	std::unordered_map<uint32_t, Enemy> enemies; // All enemies in the world (keyed by enemy ID)
 
 	// Default constructor
 	WorldSnapshotPacket()
-		: Packet(11, true) {
+		: Packet(TYPE) {
 	}
 
 	// Constructor with data
@@ -30,15 +32,15 @@ public:
 		const std::unordered_map<uint32_t, Object>& _objects,
 		const std::unordered_map<uint32_t, Enemy>& _enemies
 	)
-		: Packet(11, true), players(_players), objects(_objects), enemies(_enemies) {
+		: Packet(TYPE), players(_players), objects(_objects), enemies(_enemies) {
 	}
 
 	// Macros for serialization
-	PACKET_DESERIALIZE(WorldSnapshotPacket)
-	PACKET_TO_ENET(WorldSnapshotPacket)
+	PACKET_DESERIALIZE_BITPACKED(WorldSnapshotPacket)
+	PACKET_TO_ENET_BITPACKED(WorldSnapshotPacket)
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable, players, objects, enemies);
+		archive(header, players, objects, enemies);
 	}
 };
@@ -1,16 +1,23 @@
 #include "Packet.h"
+#include "PacketTypes.h"
 
 /**
  * @brief Constructs a Packet with a specific type.
  * @param type The packet type ID.
- * @param reliable Whether the packet should be sent reliably.
  */
-Packet::Packet(uint8_t type, bool reliable) 
-	: is_reliable(reliable) {
+Packet::Packet(uint8_t type) {
 	header.type = type;
 	header.timestamp = 0;
 }
 
+/**
+ * @brief Looks up the channel and delivery mode declared for this packet's type.
+ * @return The declared delivery info, or reliable delivery on the events channel if the type is unknown.
+ */
+PacketDeliveryInfo Packet::delivery() const {
+	return PacketTypes::info(header.type).delivery;
+}
+
 /**
  * @brief Converts the base packet to an ENetPacket.
  * Derived classes should override this using PACKET_TO_ENET macro.
@@ -18,4 +25,13 @@ Packet::Packet(uint8_t type, bool reliable)
  */
 ENetPacket* Packet::to_enet_packet() {
 	return serialize_to_enet<Packet>();
+}
+
+/**
+ * @brief Encodes the base packet onto the end of a buffer.
+ * Derived classes should override this using PACKET_TO_ENET macro.
+ * @param buffer The buffer to append the encoded packet to.
+ */
+void Packet::to_buffer(PacketBuffer& buffer) {
+	serialize_to_buffer<Packet>(buffer);
 }
\ No newline at end of file
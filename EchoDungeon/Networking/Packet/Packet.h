@@ -1,15 +1,18 @@
 #pragma once
 #include "Imports/common.h"
 #include "Utils/NetUtils.h"
-#include <cereal/archives/binary.hpp>
+#include "Networking/Packet/PacketArchive.h"
+#include "Networking/Packet/BitPacketArchive.h"
+#include "Networking/Packet/PacketDelivery.h"
 #include <cereal/types/string.hpp>
-#include <sstream>
 
 /**
  * @brief Packet header structure
  *
  * This structure defines the header of a packet, which includes the type
- * and timestamp of the packet.
+ * and timestamp of the packet. The type must stay the first field: the registry
+ * reads it straight from the first byte of received data to pick a decoder.
+ * Types are below 128, the top bit of that byte marks compressed payloads (see PacketCompression).
  */
 struct PacketHeader {
 	uint8_t type = 0; // Type of packet
@@ -25,56 +28,94 @@ struct PacketHeader {
  * @brief Base Packet class
  *
  * Derived packets should:
- * 1. Call Packet(type) in their constructor
+ * 1. Declare their ID as static constexpr uint8_t TYPE (checked against ECHO_PACKET_LIST
+ *    when the registry is built) and call Packet(TYPE) in their constructor
  * 2. Add their own data members
- * 3. Implement serialize() that archives all fields (header, is_reliable, then custom fields)
- * 4. Implement to_enet_packet() using the PACKET_TO_ENET macro
+ * 3. Implement serialize() that archives all fields (header, then custom fields)
+ * 4. Implement to_enet_packet() and to_buffer() using the PACKET_TO_ENET macro
+ *    (or PACKET_TO_ENET_BITPACKED, together with PACKET_DESERIALIZE_BITPACKED,
+ *    to use the compact BitPacketArchive encoding)
+ *
+ * Channel and reliability are per packet type, declared with the type in
+ * ECHO_PACKET_LIST (see PacketTypes.h and delivery()), and are not part of the wire format.
  */
 class Packet {
 public:
 	PacketHeader header; // Header of the packet
-	bool is_reliable = true; // Flag indicating if the packet is reliable (handled by ENet)
 
 	Packet() = default;
-	Packet(uint8_t type, bool reliable = true);
+	Packet(uint8_t type);
 	virtual ~Packet() = default;
 
+	// Channel and delivery mode this packet's type was declared with
+	PacketDeliveryInfo delivery() const;
+
 	// Converts this packet to an ENetPacket for sending
 	virtual ENetPacket* to_enet_packet();
 
+	// Encodes this packet onto the end of a buffer (eg a shared broadcast payload)
+	virtual void to_buffer(PacketBuffer& buffer);
+
 	// Default serialize for base packet
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(header, is_reliable);
+		archive(header);
 	}
 protected:
 	// Helper template for derived classes to use in their to_enet_packet()
-	template<typename Derived>
+	// Encodes straight into a pooled buffer which ENet then sends without copying.
+	template<typename Derived, typename Archive = PacketOutputArchive>
 	ENetPacket* serialize_to_enet() {
-		std::ostringstream os;
-		cereal::BinaryOutputArchive archive(os);
-		archive(static_cast<Derived&>(*this));
-		std::string serialized = os.str();
-		return enet_packet_create(
-			serialized.c_str(),
-			serialized.size(),
-			is_reliable ? ENET_PACKET_FLAG_RELIABLE : 0
+		std::unique_ptr<PacketBuffer> buffer = PacketBufferPool::acquire();
+		{
+			Archive archive(*buffer);
+			archive(static_cast<Derived&>(*this));
+			archive.flush();
+		}
+		return PacketBufferPool::to_enet_packet(
+			std::move(buffer),
+			delivery().enet_flags()
 		);
 	}
+
+	// Helper template for derived classes to use in their to_buffer()
+	template<typename Derived, typename Archive = PacketOutputArchive>
+	void serialize_to_buffer(PacketBuffer& buffer) {
+		Archive archive(buffer);
+		archive(static_cast<Derived&>(*this));
+		archive.flush();
+	}
 };
 
-// Macro for easy to_enet_packet() implementation in derived classes
+// Macro for easy to_enet_packet() and to_buffer() implementation in derived classes
 #define PACKET_TO_ENET(ClassName) \
 	ENetPacket* to_enet_packet() override { \
 		return serialize_to_enet<ClassName>(); \
+	} \
+	void to_buffer(PacketBuffer& buffer) override { \
+		serialize_to_buffer<ClassName>(buffer); \
+	}
+
+// Bit-packed variant of PACKET_TO_ENET, see BitPacketOutputArchive
+#define PACKET_TO_ENET_BITPACKED(ClassName) \
+	ENetPacket* to_enet_packet() override { \
+		return serialize_to_enet<ClassName, BitPacketOutputArchive>(); \
+	} \
+	void to_buffer(PacketBuffer& buffer) override { \
+		serialize_to_buffer<ClassName, BitPacketOutputArchive>(buffer); \
 	}
 
 // Macro for easy deserialize() implementation in derived classes
+// Decodes into a caller-provided packet, reading straight from the received data.
 #define PACKET_DESERIALIZE(ClassName) \
-	static ClassName deserialize(const std::string& raw_data) { \
-		ClassName packet; \
-		std::istringstream is(raw_data); \
-		cereal::BinaryInputArchive archive(is); \
+	static void deserialize(ClassName& packet, PacketInputArchive& archive) { \
 		archive(packet); \
-		return packet; \
+	}
+
+// Bit-packed variant of PACKET_DESERIALIZE, for packets using PACKET_TO_ENET_BITPACKED
+#define PACKET_DESERIALIZE_BITPACKED(ClassName) \
+	static void deserialize(ClassName& packet, PacketInputArchive& archive) { \
+		BitPacketInputArchive bit_archive(archive.current(), archive.remaining()); \
+		bit_archive(packet); \
+		archive.skip(bit_archive.bytes_read()); \
 	}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+#include "Networking/Packet/PacketBuffer.h"
+#include <cereal/cereal.hpp>
+#include <cstring>
+
+/**
+ * @brief Cereal output archive that writes directly into a PacketBuffer.
+ *
+ * The wire format is identical to cereal::BinaryOutputArchive (raw little-endian
+ * values, 64-bit size tags), but there is no std::ostream or std::string in between:
+ * every byte is written exactly once, into the buffer that ENet will send.
+ */
+class PacketOutputArchive : public cereal::OutputArchive<PacketOutputArchive, cereal::AllowEmptyClassElision> {
+public:
+	PacketOutputArchive(PacketBuffer& _buffer)
+		: cereal::OutputArchive<PacketOutputArchive, cereal::AllowEmptyClassElision>(this), buffer(_buffer) {
+	}
+
+	// Appends raw bytes to the end of the buffer
+	void saveBinary(const void* data, std::size_t size) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		buffer.insert(buffer.end(), bytes, bytes + size);
+	}
+
+	// Every byte is already in the buffer, there for the same calls as BitPacketOutputArchive::flush()
+	void flush() {}
+
+private:
+	PacketBuffer& buffer;
+};
+
+// Saving for arithmetic types
+template<class T> inline
+typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+CEREAL_SAVE_FUNCTION_NAME(PacketOutputArchive& archive, T const& t) {
+	archive.saveBinary(std::addressof(t), sizeof(t));
+}
+
+// Name-value pairs carry no names on the wire
+template<class T> inline
+void CEREAL_SAVE_FUNCTION_NAME(PacketOutputArchive& archive, cereal::NameValuePair<T> const& t) {
+	archive(t.value);
+}
+
+// Size tags are written as their raw size type
+template<class T> inline
+void CEREAL_SAVE_FUNCTION_NAME(PacketOutputArchive& archive, cereal::SizeTag<T> const& t) {
+	archive(t.size);
+}
+
+// Contiguous binary data (strings, vectors of arithmetic types)
+template<class T> inline
+void CEREAL_SAVE_FUNCTION_NAME(PacketOutputArchive& archive, cereal::BinaryData<T> const& bd) {
+	archive.saveBinary(bd.data, static_cast<std::size_t>(bd.size));
+}
+
+/**
+ * @brief Cereal input archive that reads directly from a received packet's memory.
+ *
+ * Reads the format written by PacketOutputArchive (and cereal::BinaryOutputArchive)
+ * straight out of ENetPacket::data, without copying it into a string or stream first.
+ * Reading past the end of the data throws a cereal::Exception.
+ */
+class PacketInputArchive : public cereal::InputArchive<PacketInputArchive, cereal::AllowEmptyClassElision> {
+public:
+	PacketInputArchive(const uint8_t* _data, std::size_t _size)
+		: cereal::InputArchive<PacketInputArchive, cereal::AllowEmptyClassElision>(this), data(_data), size(_size) {
+	}
+
+	// Copies the next size bytes out of the packet
+	void loadBinary(void* out, std::size_t count) {
+		if (count > remaining()) {
+			throw cereal::Exception("Failed to read " + std::to_string(count) + " bytes from packet, only "
+				+ std::to_string(remaining()) + " remain");
+		}
+		std::memcpy(out, data + offset, count);
+		offset += count;
+	}
+
+	// Skips over count bytes (eg after another archive decoded them from current())
+	void skip(std::size_t count) {
+		if (count > remaining()) {
+			throw cereal::Exception("Failed to skip " + std::to_string(count) + " bytes in packet, only "
+				+ std::to_string(remaining()) + " remain");
+		}
+		offset += count;
+	}
+
+	std::size_t position() const { return offset; } // Number of bytes read so far
+	std::size_t remaining() const { return size - offset; } // Number of bytes left to read
+	const uint8_t* current() const { return data + offset; } // Next unread byte
+
+private:
+	const uint8_t* data;
+	std::size_t size;
+	std::size_t offset = 0;
+};
+
+// Loading for arithmetic types
+template<class T> inline
+typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+CEREAL_LOAD_FUNCTION_NAME(PacketInputArchive& archive, T& t) {
+	archive.loadBinary(std::addressof(t), sizeof(t));
+}
+
+// Name-value pairs carry no names on the wire
+template<class T> inline
+void CEREAL_LOAD_FUNCTION_NAME(PacketInputArchive& archive, cereal::NameValuePair<T>& t) {
+	archive(t.value);
+}
+
+// Size tags are read as their raw size type. Every element takes at least one byte,
+// so a size larger than the remaining data is rejected before anything is allocated.
+template<class T> inline
+void CEREAL_LOAD_FUNCTION_NAME(PacketInputArchive& archive, cereal::SizeTag<T>& t) {
+	archive(t.size);
+	if (static_cast<uint64_t>(t.size) > archive.remaining()) {
+		throw cereal::Exception("Packet size tag of " + std::to_string(t.size) + " exceeds remaining data");
+	}
+}
+
+// Contiguous binary data (strings, vectors of arithmetic types)
+template<class T> inline
+void CEREAL_LOAD_FUNCTION_NAME(PacketInputArchive& archive, cereal::BinaryData<T>& bd) {
+	archive.loadBinary(bd.data, static_cast<std::size_t>(bd.size));
+}
+
+CEREAL_REGISTER_ARCHIVE(PacketOutputArchive)
+CEREAL_REGISTER_ARCHIVE(PacketInputArchive)
+CEREAL_SETUP_ARCHIVE_TRAITS(PacketInputArchive, PacketOutputArchive)
@@ -0,0 +1,77 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Packet/PacketBuffer.h"
+
+// Packet type: 26
+// Packet name: PacketBatch
+// Direction: Server -> Client (unpacked by the PacketRegistry, not in ECHO_PACKET_LIST)
+// Purpose: Carry several encoded packets in a single ENet packet
+
+/**
+ * @brief Wire format of a batch container.
+ *
+ * The type byte, then for every message its length as a varint followed by its encoded
+ * bytes (each message starts with its own PacketHeader). Messages are unpacked and
+ * dispatched in the order they were appended. Batches never contain other batches.
+ */
+class PacketBatch {
+public:
+	static constexpr uint8_t TYPE = 26;
+
+	// Starts an empty batch in buffer
+	static void begin(PacketBuffer& batch) {
+		batch.push_back(TYPE);
+	}
+
+	// Number of bytes a message of size bytes takes in a batch, including its length prefix
+	static size_t encoded_size(size_t size) {
+		size_t prefix = 1;
+		for (size_t rest = size >> 7; rest > 0; rest >>= 7) prefix++;
+		return prefix + size;
+	}
+
+	// Appends one encoded message to a batch started with begin()
+	static void append(PacketBuffer& batch, const uint8_t* message, size_t size) {
+		size_t length = size;
+		while (length >= 0x80) {
+			batch.push_back(static_cast<uint8_t>((length & 0x7F) | 0x80));
+			length >>= 7;
+		}
+		batch.push_back(static_cast<uint8_t>(length));
+		batch.insert(batch.end(), message, message + size);
+	}
+
+	/**
+	 * @brief Calls handler(message, size) for every message in a received batch, in order.
+	 * @param data The batch data, starting with the TYPE byte.
+	 * @param size The size of the batch data.
+	 * @param handler Called with each message's data and size.
+	 * @return false if the batch is malformed. Messages before the malformed part are still handled.
+	 */
+	template<class Handler>
+	static bool unpack(const uint8_t* data, size_t size, Handler&& handler) {
+		if (size == 0 || data[0] != TYPE) return false;
+
+		size_t offset = 1;
+		while (offset < size) {
+			// Message length varint
+			size_t length = 0;
+			unsigned shift = 0;
+			bool more = true;
+			while (more) {
+				if (offset >= size || shift > 28) return false;
+				uint8_t group = data[offset++];
+				length |= static_cast<size_t>(group & 0x7F) << shift;
+				more = (group & 0x80) != 0;
+				shift += 7;
+			}
+
+			if (length == 0 || length > size - offset) return false;
+			if (data[offset] == TYPE) return false; // Nested batches are not allowed
+
+			handler(data + offset, length);
+			offset += length;
+		}
+		return true;
+	}
+};
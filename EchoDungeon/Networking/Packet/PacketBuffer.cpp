@@ -0,0 +1,72 @@
+#include "PacketBuffer.h"
+#include "PacketCompression.h"
+
+std::mutex PacketBufferPool::pool_mutex;
+std::vector<std::unique_ptr<PacketBuffer>> PacketBufferPool::pool;
+
+/**
+ * @brief Gets an empty buffer from the pool, or allocates a new one if the pool is empty.
+ * @return A unique pointer to an empty buffer with some capacity reserved.
+ */
+std::unique_ptr<PacketBuffer> PacketBufferPool::acquire() {
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		if (!pool.empty()) {
+			std::unique_ptr<PacketBuffer> buffer = std::move(pool.back());
+			pool.pop_back();
+			return buffer;
+		}
+	}
+
+	auto buffer = std::make_unique<PacketBuffer>();
+	buffer->reserve(INITIAL_CAPACITY);
+	return buffer;
+}
+
+/**
+ * @brief Returns a buffer to the pool so its capacity can be reused.
+ * Oversized buffers, or buffers beyond the pool limit, are freed instead.
+ * @param buffer The buffer to release.
+ */
+void PacketBufferPool::release(std::unique_ptr<PacketBuffer> buffer) {
+	if (!buffer || buffer->capacity() > MAX_POOLED_CAPACITY) return;
+
+	buffer->clear();
+
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	if (pool.size() < MAX_POOLED_BUFFERS) {
+		pool.push_back(std::move(buffer));
+	}
+}
+
+/**
+ * @brief Wraps an encoded buffer in an ENetPacket without copying the data.
+ * Every outgoing packet passes through here, so this is also where large payloads are compressed.
+ * @param buffer The encoded packet data. Ownership passes to the ENetPacket.
+ * @param flags The ENet packet flags (eg ENET_PACKET_FLAG_RELIABLE).
+ * @return The created ENetPacket, or nullptr on failure.
+ */
+ENetPacket* PacketBufferPool::to_enet_packet(std::unique_ptr<PacketBuffer> buffer, enet_uint32 flags) {
+	PacketCompression::compress_payload(buffer);
+
+	ENetPacket* packet = enet_packet_create(buffer->data(), buffer->size(), flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+	if (!packet) {
+		ERROR("Failed to create ENetPacket of size " + std::to_string(buffer->size()));
+		release(std::move(buffer));
+		return nullptr;
+	}
+
+	packet->userData = buffer.release(); // Owned by the packet until free_callback
+	packet->freeCallback = &PacketBufferPool::free_callback;
+	return packet;
+}
+
+/**
+ * @brief Called by ENet when a packet created by to_enet_packet() is destroyed.
+ * @param packet The ENetPacket being destroyed.
+ */
+void ENET_CALLBACK PacketBufferPool::free_callback(void* packet) {
+	ENetPacket* enet_packet = static_cast<ENetPacket*>(packet);
+	release(std::unique_ptr<PacketBuffer>(static_cast<PacketBuffer*>(enet_packet->userData)));
+	enet_packet->userData = nullptr;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Imports/common.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+
+// Byte buffer that outgoing packets are encoded into
+using PacketBuffer = std::vector<uint8_t>;
+
+/**
+ * @brief Pool of reusable buffers for outgoing packet data.
+ *
+ * Packets are encoded straight into a pooled buffer, which is then handed to ENet
+ * with ENET_PACKET_FLAG_NO_ALLOCATE so the encoded bytes are never copied again.
+ * ENet calls the packet's freeCallback once every peer is done with it, which
+ * returns the buffer (and its capacity) to the pool for the next packet.
+ */
+class PacketBufferPool {
+public:
+	static std::unique_ptr<PacketBuffer> acquire(); // Get an empty buffer, reusing pooled capacity when available
+	static void release(std::unique_ptr<PacketBuffer> buffer); // Return a buffer to the pool
+
+	// Wrap a buffer in an ENetPacket without copying. The buffer is returned to the pool when ENet frees the packet.
+	static ENetPacket* to_enet_packet(std::unique_ptr<PacketBuffer> buffer, enet_uint32 flags);
+
+private:
+	static constexpr size_t INITIAL_CAPACITY = 256; // Capacity reserved for freshly allocated buffers
+	static constexpr size_t MAX_POOLED_BUFFERS = 256; // Buffers beyond this are freed instead of pooled
+	static constexpr size_t MAX_POOLED_CAPACITY = 64 * 1024; // Very large buffers (eg snapshots) are not kept around
+
+	static std::mutex pool_mutex; // Buffers are released from the networking thread
+	static std::vector<std::unique_ptr<PacketBuffer>> pool;
+
+	static void ENET_CALLBACK free_callback(void* packet); // Called by ENet when a packet is destroyed
+};
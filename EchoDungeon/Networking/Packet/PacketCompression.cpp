@@ -0,0 +1,247 @@
+#include "PacketCompression.h"
+#include <array>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	// Reads 4 bytes for the match finder (unaligned)
+	uint32_t read32(const uint8_t* data) {
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	// Scratch buffers for the ENet host compressor, owned by the host
+	struct HostCompressorContext {
+		PacketBuffer input;
+		PacketBuffer output;
+	};
+
+	size_t ENET_CALLBACK host_compress(void* context, const ENetBuffer* in_buffers, size_t in_buffer_count,
+		size_t in_limit, enet_uint8* out_data, size_t out_limit) {
+		HostCompressorContext* scratch = static_cast<HostCompressorContext*>(context);
+
+		scratch->input.clear();
+		for (size_t i = 0; i < in_buffer_count; i++) {
+			const uint8_t* bytes = static_cast<const uint8_t*>(in_buffers[i].data);
+			scratch->input.insert(scratch->input.end(), bytes, bytes + in_buffers[i].dataLength);
+		}
+
+		scratch->output.clear();
+		LzCodec::compress(scratch->input.data(), std::min(in_limit, scratch->input.size()), scratch->output);
+		if (scratch->output.size() > out_limit || scratch->output.size() >= in_limit) {
+			return 0; // Not worth it, ENet sends the datagram uncompressed
+		}
+
+		std::memcpy(out_data, scratch->output.data(), scratch->output.size());
+		return scratch->output.size();
+	}
+
+	size_t ENET_CALLBACK host_decompress(void* context, const enet_uint8* in_data, size_t in_limit,
+		enet_uint8* out_data, size_t out_limit) {
+		return LzCodec::decompress(in_data, in_limit, out_data, out_limit);
+	}
+
+	void ENET_CALLBACK host_destroy(void* context) {
+		delete static_cast<HostCompressorContext*>(context);
+	}
+}
+
+// ============================================================================
+// LZ CODEC
+// ============================================================================
+
+/**
+ * @brief Compresses a block of bytes.
+ * Matches are found through a hash table of the last position each 4-byte sequence was seen at,
+ * which trades some ratio for a single pass over the input.
+ * @param input The data to compress.
+ * @param size The size of the data.
+ * @param output The buffer to append the compressed data to.
+ */
+void LzCodec::compress(const uint8_t* input, size_t size, PacketBuffer& output) {
+	std::array<uint32_t, 1 << HASH_BITS> table; // Position + 1 each sequence hash was last seen at, 0 = never
+	table.fill(0);
+
+	size_t anchor = 0; // Start of the literals not yet written
+	size_t position = 0;
+	while (position + MIN_MATCH <= size) {
+		uint32_t sequence = read32(input + position);
+		uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+		size_t candidate = table[hash];
+		table[hash] = static_cast<uint32_t>(position + 1);
+
+		if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(input + candidate - 1) != sequence) {
+			position++;
+			continue;
+		}
+
+		candidate--;
+		size_t length = MIN_MATCH;
+		while (position + length < size && input[candidate + length] == input[position + length]) {
+			length++;
+		}
+
+		write_sequence(output, input + anchor, position - anchor, position - candidate, length);
+		position += length;
+		anchor = position;
+	}
+
+	// Whatever is left goes out as literals
+	write_sequence(output, input + anchor, size - anchor, 0, 0);
+}
+
+/**
+ * @brief Decompresses a block written by compress().
+ * Every read and write is bounds checked, so malformed input fails instead of overrunning.
+ * @param input The compressed data.
+ * @param size The size of the compressed data.
+ * @param output Where to write the decompressed data.
+ * @param capacity The size of output.
+ * @return The decompressed size, or 0 if the input is malformed or does not fit in capacity.
+ */
+size_t LzCodec::decompress(const uint8_t* input, size_t size, uint8_t* output, size_t capacity) {
+	size_t in = 0;
+	size_t out = 0;
+
+	// Reads the extra bytes of a length whose nibble was 15
+	auto read_length = [&](size_t& length) {
+		uint8_t byte = 255;
+		while (byte == 255) {
+			if (in >= size || length > capacity) return false;
+			byte = input[in++];
+			length += byte;
+		}
+		return true;
+	};
+
+	while (in < size) {
+		uint8_t token = input[in++];
+
+		size_t literal_count = token >> 4;
+		if (literal_count == 15 && !read_length(literal_count)) return 0;
+		if (literal_count > size - in || literal_count > capacity - out) return 0;
+		if (literal_count > 0) std::memcpy(output + out, input + in, literal_count);
+		in += literal_count;
+		out += literal_count;
+
+		if (in == size) break; // Last sequence, no match
+
+		if (size - in < 2) return 0;
+		size_t offset = input[in] | (static_cast<size_t>(input[in + 1]) << 8);
+		in += 2;
+		if (offset == 0 || offset > out) return 0;
+
+		size_t match_length = token & 0x0F;
+		if (match_length == 15 && !read_length(match_length)) return 0;
+		match_length += MIN_MATCH;
+		if (match_length > capacity - out) return 0;
+
+		// Byte by byte, the match may overlap the bytes it is producing
+		const uint8_t* match = output + out - offset;
+		for (size_t i = 0; i < match_length; i++) {
+			output[out + i] = match[i];
+		}
+		out += match_length;
+	}
+
+	return out;
+}
+
+void LzCodec::write_sequence(PacketBuffer& output, const uint8_t* literals, size_t literal_count, size_t offset, size_t match_length) {
+	size_t match_code = match_length > 0 ? match_length - MIN_MATCH : 0;
+	uint8_t token = static_cast<uint8_t>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15));
+	output.push_back(token);
+
+	if (literal_count >= 15) write_length(output, literal_count - 15);
+	output.insert(output.end(), literals, literals + literal_count);
+
+	if (match_length == 0) return;
+	output.push_back(static_cast<uint8_t>(offset & 0xFF));
+	output.push_back(static_cast<uint8_t>(offset >> 8));
+	if (match_code >= 15) write_length(output, match_code - 15);
+}
+
+void LzCodec::write_length(PacketBuffer& output, size_t length) {
+	while (length >= 255) {
+		output.push_back(255);
+		length -= 255;
+	}
+	output.push_back(static_cast<uint8_t>(length));
+}
+
+// ============================================================================
+// PACKET COMPRESSION
+// ============================================================================
+
+/**
+ * @brief Installs LzCodec as the host's ENet compressor when COMPRESSION_MODE is HOST.
+ * @param host The ENet host to configure.
+ */
+void PacketCompression::configure_host(ENetHost* host) {
+	if (!host || NetworkConstants::COMPRESSION_MODE != NetworkConstants::CompressionMode::HOST) return;
+
+	ENetCompressor compressor;
+	compressor.context = new HostCompressorContext();
+	compressor.compress = &host_compress;
+	compressor.decompress = &host_decompress;
+	compressor.destroy = &host_destroy;
+	enet_host_compress(host, &compressor); // The host owns the context from here on
+}
+
+/**
+ * @brief Compresses an encoded packet in PER_PACKET mode if it is at least COMPRESSION_THRESHOLD bytes.
+ * The compressed payload is the type byte with COMPRESSED_FLAG set, the original size as a
+ * varint, then everything after the type byte compressed with LzCodec. Packets that do not
+ * shrink are left as they are.
+ * @param buffer The encoded packet. Replaced by the compressed payload when that is smaller.
+ */
+void PacketCompression::compress_payload(std::unique_ptr<PacketBuffer>& buffer) {
+	if (NetworkConstants::COMPRESSION_MODE != NetworkConstants::CompressionMode::PER_PACKET) return;
+	if (buffer->size() < NetworkConstants::COMPRESSION_THRESHOLD) return;
+
+	std::unique_ptr<PacketBuffer> compressed = PacketBufferPool::acquire();
+	compressed->push_back((*buffer)[0] | COMPRESSED_FLAG);
+
+	size_t original_size = buffer->size();
+	while (original_size >= 0x80) {
+		compressed->push_back(static_cast<uint8_t>((original_size & 0x7F) | 0x80));
+		original_size >>= 7;
+	}
+	compressed->push_back(static_cast<uint8_t>(original_size));
+
+	LzCodec::compress(buffer->data() + 1, buffer->size() - 1, *compressed);
+
+	if (compressed->size() < buffer->size()) {
+		std::swap(buffer, compressed);
+	}
+	PacketBufferPool::release(std::move(compressed));
+}
+
+/**
+ * @brief Restores an encoded packet from a payload written by compress_payload().
+ * @param data The received payload.
+ * @param size The size of the received payload.
+ * @param output Filled with the original encoded packet.
+ * @return false if the payload is malformed.
+ */
+bool PacketCompression::decompress_payload(const uint8_t* data, size_t size, PacketBuffer& output) {
+	if (!is_compressed(data, size)) return false;
+
+	size_t offset = 1;
+	size_t original_size = 0;
+	for (unsigned shift = 0; ; shift += 7) {
+		if (offset >= size || shift > 28) return false;
+		uint8_t group = data[offset++];
+		original_size |= static_cast<size_t>(group & 0x7F) << shift;
+		if (!(group & 0x80)) break;
+	}
+
+	// Reject sizes ENet itself would never deliver before allocating anything
+	if (original_size < 1 || original_size > ENET_HOST_DEFAULT_MAXIMUM_PACKET_SIZE) return false;
+
+	output.resize(original_size);
+	output[0] = data[0] & ~COMPRESSED_FLAG;
+	size_t decompressed = LzCodec::decompress(data + offset, size - offset, output.data() + 1, original_size - 1);
+	return decompressed == original_size - 1;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Packet/PacketBuffer.h"
+#include "Networking/NetworkConstants.h"
+
+/**
+ * @brief Small LZ77-style byte codec (the LZ4 block format), fast enough to run on every large packet.
+ *
+ * The output is a series of sequences: a token byte (literal count in the high nibble, match
+ * length - 4 in the low nibble, 15 meaning more length bytes follow), the literal bytes, then a
+ * 2-byte offset back into the output to copy the match from. The last sequence has no match.
+ */
+class LzCodec {
+public:
+	// Appends the compressed form of size bytes of input to output
+	static void compress(const uint8_t* input, size_t size, PacketBuffer& output);
+
+	// Decompresses into output (at most capacity bytes). Returns the decompressed size, or 0 if the input is malformed.
+	static size_t decompress(const uint8_t* input, size_t size, uint8_t* output, size_t capacity);
+
+private:
+	static constexpr size_t MIN_MATCH = 4; // Shortest match worth encoding
+	static constexpr size_t MAX_OFFSET = 65535; // Furthest back a match can start
+	static constexpr unsigned HASH_BITS = 12; // Size of the match finder's hash table (4096 entries)
+
+	static void write_sequence(PacketBuffer& output, const uint8_t* literals, size_t literal_count, size_t offset, size_t match_length);
+	static void write_length(PacketBuffer& output, size_t length);
+};
+
+/**
+ * @brief Optional compression of outgoing packets, see NetworkConstants::COMPRESSION_MODE.
+ *
+ * HOST mode installs LzCodec as the ENet host compressor, so ENet compresses every datagram.
+ * PER_PACKET mode only compresses encoded packets of at least COMPRESSION_THRESHOLD bytes (eg
+ * world snapshots), marked by COMPRESSED_FLAG in their type byte. Compressed packets are
+ * decompressed by the PacketRegistry before dispatch, so packet classes never see either mode.
+ */
+class PacketCompression {
+public:
+	static constexpr uint8_t COMPRESSED_FLAG = 0x80; // Set in the first (type) byte of a per-packet compressed payload
+
+	// Installs the host compressor when COMPRESSION_MODE is HOST. Both ends must use the same mode.
+	static void configure_host(ENetHost* host);
+
+	// In PER_PACKET mode, replaces a large encoded payload with its compressed form (if that is smaller)
+	static void compress_payload(std::unique_ptr<PacketBuffer>& buffer);
+
+	// Whether received data is a per-packet compressed payload
+	static bool is_compressed(const uint8_t* data, size_t size) {
+		return size > 0 && (data[0] & COMPRESSED_FLAG) != 0;
+	}
+
+	// Restores the original encoded packet from a compressed payload. Returns false if the payload is malformed.
+	static bool decompress_payload(const uint8_t* data, size_t size, PacketBuffer& output);
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/NetworkConstants.h"
+
+/**
+ * @brief How ENet delivers a packet type.
+ *
+ * - RELIABLE_ORDERED: retransmitted until acknowledged, delivered in order within its channel.
+ * - UNRELIABLE_SEQUENCED: never retransmitted, packets older than one already delivered
+ *   on the same channel are dropped. For state where only the newest value matters.
+ * - UNRELIABLE_UNSEQUENCED: never retransmitted and delivered in whatever order it arrives.
+ */
+enum class PacketDelivery : uint8_t {
+	RELIABLE_ORDERED,
+	UNRELIABLE_SEQUENCED,
+	UNRELIABLE_UNSEQUENCED
+};
+
+/**
+ * @brief Channel and delivery mode of a packet type, declared with it in ECHO_PACKET_LIST.
+ * Reliable packets only wait behind other reliable packets on their own channel, so a lost
+ * state update never holds up gameplay events and vice versa.
+ */
+struct PacketDeliveryInfo {
+	PacketDelivery delivery = PacketDelivery::RELIABLE_ORDERED;
+	uint8_t channel = NetworkConstants::CHANNEL_EVENTS;
+
+	// ENet packet flags for this delivery mode
+	constexpr enet_uint32 enet_flags() const {
+		switch (delivery) {
+		case PacketDelivery::RELIABLE_ORDERED:
+			return ENET_PACKET_FLAG_RELIABLE;
+		case PacketDelivery::UNRELIABLE_SEQUENCED:
+			// Large updates are split into unreliable fragments too, otherwise ENet would
+			// silently send them reliably and reintroduce the stalls this mode avoids
+			return ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
+		case PacketDelivery::UNRELIABLE_UNSEQUENCED:
+			return ENET_PACKET_FLAG_UNSEQUENCED | ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
+		}
+		return ENET_PACKET_FLAG_RELIABLE;
+	}
+
+	constexpr bool operator==(const PacketDeliveryInfo& other) const {
+		return delivery == other.delivery && channel == other.channel;
+	}
+
+	constexpr bool operator!=(const PacketDeliveryInfo& other) const {
+		return !(*this == other);
+	}
+};
+
+namespace PacketDeliveries {
+	// Gameplay and session events (spawns, destroys, items, connection handling)
+	constexpr PacketDeliveryInfo RELIABLE_EVENT{ PacketDelivery::RELIABLE_ORDERED, NetworkConstants::CHANNEL_EVENTS };
+
+	// High-rate state streams where a newer packet supersedes any older one
+	constexpr PacketDeliveryInfo SEQUENCED_STATE{ PacketDelivery::UNRELIABLE_SEQUENCED, NetworkConstants::CHANNEL_STATE };
+
+	// Small standalone messages where any arrival order is fine
+	constexpr PacketDeliveryInfo UNSEQUENCED_STATE{ PacketDelivery::UNRELIABLE_UNSEQUENCED, NetworkConstants::CHANNEL_STATE };
+}
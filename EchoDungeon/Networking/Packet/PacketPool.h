@@ -0,0 +1,90 @@
+#pragma once
+#include "Imports/common.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Per-type pool of decoded packets, so receiving a packet does not allocate one.
+ *
+ * acquire() hands out a reference-counted Handle to a packet that is decoded into in place.
+ * Copying a Handle only bumps the count, so event data, deferred calls and inbound queue
+ * messages can all keep the same decoded packet alive without copying it. The packet goes
+ * back to the pool when the last Handle is gone, keeping its containers' capacity.
+ *
+ * Reused packets are not reset: decoding must overwrite every field the receiver reads.
+ * Delta packets only write the fields flagged in each entry, and receivers only read those.
+ */
+template <typename PacketType>
+class PacketPool {
+	struct Node {
+		PacketType packet;
+		std::atomic<uint32_t> references{ 0 };
+	};
+
+public:
+	static constexpr size_t MAX_POOLED = 32; // Packets kept per type once released, the rest are freed
+
+	class Handle {
+	public:
+		Handle() = default;
+		Handle(const Handle& other) : node(other.node) { retain(); }
+		Handle(Handle&& other) noexcept : node(other.node) { other.node = nullptr; }
+		~Handle() { reset(); }
+
+		Handle& operator=(Handle other) noexcept {
+			std::swap(node, other.node);
+			return *this;
+		}
+
+		PacketType& operator*() const { return node->packet; }
+		PacketType* operator->() const { return &node->packet; }
+		PacketType* get() const { return node ? &node->packet : nullptr; }
+		explicit operator bool() const { return node != nullptr; }
+
+		// Drops this reference, returning the packet to the pool if it was the last
+		void reset() {
+			if (node && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				PacketPool::release(node);
+			}
+			node = nullptr;
+		}
+
+	private:
+		friend class PacketPool;
+		explicit Handle(Node* _node) : node(_node) { retain(); }
+
+		void retain() {
+			if (node) node->references.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		Node* node = nullptr;
+	};
+
+	// Takes a pooled packet (or makes one if the pool is empty). Safe to call from any thread.
+	static Handle acquire() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!free_nodes.empty()) {
+				Node* node = free_nodes.back().release();
+				free_nodes.pop_back();
+				return Handle(node);
+			}
+		}
+		return Handle(new Node());
+	}
+
+private:
+	static void release(Node* node) {
+		std::unique_ptr<Node> owned(node);
+		std::lock_guard<std::mutex> lock(mutex);
+		if (free_nodes.size() < MAX_POOLED) {
+			if (free_nodes.capacity() < MAX_POOLED) free_nodes.reserve(MAX_POOLED);
+			free_nodes.push_back(std::move(owned));
+		}
+	}
+
+	static inline std::mutex mutex; // Guards free_nodes
+	static inline std::vector<std::unique_ptr<Node>> free_nodes; // Released packets ready for reuse
+};
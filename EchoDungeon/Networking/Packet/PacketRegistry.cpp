@@ -1,26 +1,6 @@
 #include "PacketRegistry.h"
-#include <cereal/archives/binary.hpp>
-#include <sstream>
-
-std::unordered_map<uint8_t, PacketEntry> PacketRegistry::registry;
-
-/**
- * @brief Registers a packet type with its ID, name, converter, and event triggers.
- * @param id The unique packet type ID.
- * @param name The human-readable name of the packet.
- * @param converter The function to convert raw data to the specific derived type.
- * @param server_trigger The function to trigger server-side event for this packet.
- * @param client_trigger The function to trigger client-side event for this packet.
- */
-void PacketRegistry::registerPacket(
-    uint8_t id, 
-    const std::string& name, 
-    std::function<std::unique_ptr<Packet>(const std::string&)> converter,
-    ServerEventTrigger server_trigger,
-    ClientEventTrigger client_trigger
-) {
-    registry[id] = {name, converter, server_trigger, client_trigger};
-}
+#include "PacketBatch.h"
+#include "PacketCompression.h"
 
 /**
  * @brief Converts an ENetPacket to a specific Packet derived type.
@@ -30,73 +10,126 @@ void PacketRegistry::registerPacket(
 std::unique_ptr<Packet> PacketRegistry::deserialize(ENetPacket* packet) {
     if (!packet || packet->dataLength == 0) return nullptr;
 
-    // Get raw data as string
-    std::string raw_data((char*)packet->data, packet->dataLength);
-    
-    // Check packet type by looking at header
-    std::istringstream is(raw_data);
-    cereal::BinaryInputArchive archive(is);
-    PacketHeader header;
-    archive(header);
-
-    // Find the converter for this packet type
-    auto it = registry.find(header.type);
-    if (it == registry.end()) return nullptr;
-
-    // Use the converter to create the specific packet type
-    return it->second.converter(raw_data);
+    const uint8_t* data = packet->data;
+    size_t size = packet->dataLength;
+    std::unique_ptr<PacketBuffer> storage;
+    if (!unwrap(data, size, storage)) return nullptr;
+
+    // The first encoded byte is always PacketHeader::type
+    std::unique_ptr<Packet> result;
+    PacketConverter converter = registry[data[0]].converter;
+    if (converter) {
+        result = converter(data, size);
+    }
+
+    PacketBufferPool::release(std::move(storage));
+    return result;
 }
 
 /**
- * @brief Deserializes a packet and triggers the server-side event.
+ * @brief Points data/size at the original encoded packet, decompressing per-packet compressed payloads first.
+ * @param data The received data. Redirected to the decompressed copy if it was compressed.
+ * @param size The size of the received data. Updated to the decompressed size.
+ * @param storage Holds the decompressed copy; release it once data is no longer used.
+ * @returns false if the payload is malformed.
+ */
+bool PacketRegistry::unwrap(const uint8_t*& data, size_t& size, std::unique_ptr<PacketBuffer>& storage) {
+    if (!PacketCompression::is_compressed(data, size)) return true;
+
+    storage = PacketBufferPool::acquire();
+    if (!PacketCompression::decompress_payload(data, size, *storage)) {
+        WARNING("Failed to decompress packet of type " + std::to_string(data[0] & ~PacketCompression::COMPRESSED_FLAG));
+        PacketBufferPool::release(std::move(storage));
+        return false;
+    }
+
+    data = storage->data();
+    size = storage->size();
+    return true;
+}
+
+/**
+ * @brief Decompresses a received packet if needed, then deserializes it (or every packet in it, for a batch)
+ * and triggers the server-side events.
  * @param peer The peer that sent the packet.
  * @param enet_packet The raw ENetPacket.
  */
 void PacketRegistry::handleServerPacket(ENetPeer* peer, ENetPacket* enet_packet) {
-    auto packet = deserialize(enet_packet);
-    if (!packet) {
-        WARNING("Failed to deserialize packet");
+    if (!enet_packet || enet_packet->dataLength == 0) {
+        WARNING("Received empty packet");
         return;
     }
 
-    auto it = registry.find(packet->header.type);
-    if (it == registry.end() || !it->second.server_event_trigger) {
-        WARNING("No server event trigger for packet type: " + std::to_string(packet->header.type));
-        return;
+    const uint8_t* data = enet_packet->data;
+    size_t size = enet_packet->dataLength;
+    std::unique_ptr<PacketBuffer> storage;
+    if (!unwrap(data, size, storage)) return;
+
+    if (data[0] == PacketBatch::TYPE) {
+        bool valid = PacketBatch::unpack(data, size,
+            [peer](const uint8_t* message, size_t message_size) { handleServerMessage(peer, message, message_size); });
+        if (!valid) WARNING("Received malformed packet batch");
+    }
+    else {
+        handleServerMessage(peer, data, size);
     }
 
-    TRACE("Triggering server event for packet: " + it->second.name);
-    it->second.server_event_trigger(*packet, peer);
+    PacketBufferPool::release(std::move(storage));
 }
 
 /**
- * @brief Deserializes a packet and triggers the client-side event.
+ * @brief Decompresses a received packet if needed, then deserializes it (or every packet in it, for a batch)
+ * and triggers the client-side events.
  * @param enet_packet The raw ENetPacket.
  */
 void PacketRegistry::handleClientPacket(ENetPacket* enet_packet) {
-    auto packet = deserialize(enet_packet);
-    if (!packet) {
-        WARNING("Failed to deserialize packet");
+    if (!enet_packet || enet_packet->dataLength == 0) {
+        WARNING("Received empty packet");
         return;
     }
 
-    auto it = registry.find(packet->header.type);
-    if (it == registry.end() || !it->second.client_event_trigger) {
-        WARNING("No client event trigger for packet type: " + std::to_string(packet->header.type));
-        return;
+    const uint8_t* data = enet_packet->data;
+    size_t size = enet_packet->dataLength;
+    std::unique_ptr<PacketBuffer> storage;
+    if (!unwrap(data, size, storage)) return;
+
+    if (data[0] == PacketBatch::TYPE) {
+        bool valid = PacketBatch::unpack(data, size,
+            [](const uint8_t* message, size_t message_size) { handleClientMessage(message, message_size); });
+        if (!valid) WARNING("Received malformed packet batch");
+    }
+    else {
+        handleClientMessage(data, size);
     }
 
-    TRACE("Triggering client event for packet: " + it->second.name);
-    it->second.client_event_trigger(*packet);
+    PacketBufferPool::release(std::move(storage));
 }
 
 /**
- * @brief Fetches the human-readable name of a packet type by its ID.
- * @param id The unique packet type ID.
- * @returns The name of the packet type, or "Unknown" if not registered.
+ * @brief Decodes a single encoded packet and triggers the server-side event, through the packet type's dispatcher.
+ * @param peer The peer that sent the packet.
+ * @param data The encoded packet, starting with its PacketHeader.
+ * @param size The size of the encoded packet.
  */
-std::string PacketRegistry::getPacketName(uint8_t id) {
-    auto it = registry.find(id);
-    if (it == registry.end()) return "Unknown";
-    return it->second.name;
-}
\ No newline at end of file
+void PacketRegistry::handleServerMessage(ENetPeer* peer, const uint8_t* data, size_t size) {
+    ServerPacketDispatcher dispatcher = registry[data[0]].server_dispatcher;
+    if (!dispatcher) {
+        WARNING("No server event trigger for packet type: " + std::to_string(data[0]));
+        return;
+    }
+    dispatcher(peer, data, size);
+}
+
+/**
+ * @brief Decodes a single encoded packet and triggers the client-side event, through the packet type's dispatcher.
+ * @param data The encoded packet, starting with its PacketHeader.
+ * @param size The size of the encoded packet.
+ */
+void PacketRegistry::handleClientMessage(const uint8_t* data, size_t size) {
+    ClientPacketDispatcher dispatcher = registry[data[0]].client_dispatcher;
+    if (!dispatcher) {
+        WARNING("No client event trigger for packet type: " + std::to_string(data[0]));
+        return;
+    }
+    dispatcher(data, size);
+}
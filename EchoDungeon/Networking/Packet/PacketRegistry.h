@@ -1,48 +1,58 @@
 #pragma once
 
 #include "Packet.h"
+#include "PacketTypes.h"
 #include <memory>
-#include <unordered_map>
 #include <string>
-#include <functional>
+#include <string_view>
 
-// Trigger function types - these trigger events for the appropriate packet type
-using ServerEventTrigger = std::function<void(Packet&, ENetPeer*)>;
-using ClientEventTrigger = std::function<void(Packet&)>;
+// Decode + dispatch function types, one of each per packet type (nullptr if it does not go that way)
+using ServerPacketDispatcher = void(*)(ENetPeer* peer, const uint8_t* data, size_t size);
+using ClientPacketDispatcher = void(*)(const uint8_t* data, size_t size);
+
+// Converter function type - decodes an encoded packet into the matching derived type
+using PacketConverter = std::unique_ptr<Packet>(*)(const uint8_t* data, size_t size);
 
 struct PacketEntry {
-    std::string name;
-    std::function<std::unique_ptr<Packet>(const std::string&)> converter;
-    ServerEventTrigger server_event_trigger;
-    ClientEventTrigger client_event_trigger;
+    PacketConverter converter = nullptr;
+    ServerPacketDispatcher server_dispatcher = nullptr;
+    ClientPacketDispatcher client_dispatcher = nullptr;
 };
 
+/**
+ * @brief Decodes received packets and triggers their events.
+ * The packet types come from ECHO_PACKET_LIST (see PacketTypes.h), which generates a flat
+ * 256-entry table of plain function pointers at compile time, so dispatching a packet is
+ * one indexed load and one direct call.
+ */
 class PacketRegistry {
 public:
-    // Register a packet type with event triggers
-    static void registerPacket(
-        uint8_t id, 
-        const std::string& name, 
-        std::function<std::unique_ptr<Packet>(const std::string&)> converter,
-        ServerEventTrigger server_trigger = nullptr,
-        ClientEventTrigger client_trigger = nullptr
-    );
-    
-    // Initialize all packet types (call once at startup)
-    static void initializeRegistry();
-    
-    // Deserialize and trigger server event for packet
+    // Deserialize and trigger server event for packet (or for each packet in a PacketBatch)
     static void handleServerPacket(ENetPeer* peer, ENetPacket* enet_packet);
     
-    // Deserialize and trigger client event for packet
+    // Deserialize and trigger client event for packet (or for each packet in a PacketBatch)
     static void handleClientPacket(ENetPacket* enet_packet);
     
     // Deserialize an ENetPacket to the appropriate derived packet type
     static std::unique_ptr<Packet> deserialize(ENetPacket* packet);
     
-    // Get the human-readable name of a packet type
-    static std::string getPacketName(uint8_t id);
+    // Get the human-readable name of a packet type, a view of the name in PacketTypes::ALL
+    static constexpr std::string_view getPacketName(uint8_t id) {
+        return PacketTypes::info(id).name;
+    }
+
+    // Get the channel and delivery mode a packet type is sent with
+    static constexpr PacketDeliveryInfo getDelivery(uint8_t id) {
+        return PacketTypes::info(id).delivery;
+    }
 
 private:
-    static std::unordered_map<uint8_t, PacketEntry> registry;
-};
\ No newline at end of file
+    static const std::array<PacketEntry, 256> registry;
+
+    // Point data/size at the original packet, decompressing into storage if it was compressed
+    static bool unwrap(const uint8_t*& data, size_t& size, std::unique_ptr<PacketBuffer>& storage);
+
+    // Decode and dispatch one packet (a whole ENetPacket, or one message of a PacketBatch)
+    static void handleServerMessage(ENetPeer* peer, const uint8_t* data, size_t size);
+    static void handleClientMessage(const uint8_t* data, size_t size);
+};
@@ -1,96 +1,73 @@
 #include "PacketRegistry.h"
-#include "Networking/Packet/Instances/ConnectionInitiation.h"
-#include "Networking/Packet/Instances/ConnectionRefusal.h"
-#include "Networking/Packet/Instances/ConnectionConfirmation.h"
-#include "Networking/Packet/Instances/DisconnectInfo.h"
-#include "Networking/Packet/Instances/DisconnectKick.h"
-#include "Networking/Packet/Instances/ServerDataUpdate.h"
-#include "Networking/Packet/Instances/GeneralInformationUpdate.h"
-#include "Networking/Packet/Instances/StateChange.h"
-#include "Networking/Packet/Instances/WorldSnapshot.h"
-#include "Networking/Packet/Instances/Player/PlayerSpawn.h"
-#include "Networking/Packet/Instances/Player/PlayerUpdate.h"
-#include "Networking/Packet/Instances/Player/PlayerDestroy.h"
-#include "Networking/Packet/Instances/Enemy/EnemySpawn.h"
-#include "Networking/Packet/Instances/Enemy/EnemyUpdate.h"
-#include "Networking/Packet/Instances/Enemy/EnemyDestroy.h"
-#include "Networking/Packet/Instances/Object/ObjectSpawn.h"
-#include "Networking/Packet/Instances/Object/ObjectDestroy.h"
-#include "Networking/Packet/Instances/PlayerInput.h"
-#include "Networking/Packet/Instances/RequestWorldSnapshot.h"
-#include "Networking/Packet/Instances/Player/PlayerAttack.h"
-#include "Networking/Packet/Instances/Item/ItemPickup.h"
-#include "Networking/Packet/Instances/Item/ItemDiscard.h"
+#include "PacketBatch.h"
+#include "PacketCompression.h"
+#include "Game/Events/EventList.h" // Includes every packet class
 
-#include "Game/Events/EventList.h"
+static_assert(PacketTypes::RESERVED_FLAG == PacketCompression::COMPRESSED_FLAG, "Packet IDs must leave the compression flag free");
+static_assert(!PacketTypes::is_known(PacketBatch::TYPE), "PacketBatch's type is reserved for the batch container");
 
-#define CLIENT_SIDE_EVENT_HANDLER(BaseName) \
-    [](Packet& packet) { \
-        auto& typed_packet = static_cast<BaseName##Packet&>(packet); \
-        ClientEvents::BaseName##EventData data(typed_packet); \
-        ClientEvents::BaseName##Event::trigger(data); \
+namespace {
+    // Decodes an encoded packet into packet, reading straight from the received data
+    template <typename PacketType>
+    bool decode_into(PacketType& packet, const uint8_t* data, size_t size) {
+        try {
+            PacketInputArchive archive(data, size);
+            PacketType::deserialize(packet, archive);
+            return true;
+        }
+        catch (const std::exception& e) {
+            WARNING("Failed to decode packet " + std::string(PacketRegistry::getPacketName(data[0])) + ": " + e.what());
+            return false;
+        }
     }
 
-#define SERVER_SIDE_EVENT_HANDLER(BaseName) \
-    [](Packet& packet, ENetPeer* peer) { \
-        auto& typed_packet = static_cast<BaseName##Packet&>(packet); \
-        ServerEvents::BaseName##EventData data(typed_packet, peer); \
-        ServerEvents::BaseName##Event::trigger(data); \
+    template <typename PacketType>
+    std::unique_ptr<Packet> convert(const uint8_t* data, size_t size) {
+        auto packet = std::make_unique<PacketType>();
+        if (!decode_into(*packet, data, size)) return nullptr;
+        return packet;
     }
 
-#define PACKET_CONVERTER(BaseName) \
-    [](const std::string& raw_data) { \
-        return std::make_unique<BaseName##Packet>(BaseName##Packet::deserialize(raw_data)); \
+    // Decodes into a pooled packet and triggers the packet's server event, which shares it
+    template <typename PacketType, typename EventData>
+    void dispatch_to_server(ENetPeer* peer, const uint8_t* data, size_t size) {
+        typename PacketPool<PacketType>::Handle packet = PacketPool<PacketType>::acquire();
+        if (!decode_into(*packet, data, size)) return;
+
+        TRACE("Triggering server event for packet: " + std::string(PacketRegistry::getPacketName(data[0])));
+        EventData event_data(std::move(packet), peer);
+        Event<EventData>::trigger(event_data);
     }
 
-// Macro for server-only packets (Client -> Server)
-#define REGISTER_SERVER_PACKET(Type, BaseName) \
-    registerPacket(Type, #BaseName, PACKET_CONVERTER(BaseName), SERVER_SIDE_EVENT_HANDLER(BaseName), nullptr)
+    // Decodes into a pooled packet and triggers the packet's client event, which shares it
+    template <typename PacketType, typename EventData>
+    void dispatch_to_client(const uint8_t* data, size_t size) {
+        typename PacketPool<PacketType>::Handle packet = PacketPool<PacketType>::acquire();
+        if (!decode_into(*packet, data, size)) return;
 
-// Macro for client-only packets (Server -> Client)
-#define REGISTER_CLIENT_PACKET(Type, BaseName) \
-    registerPacket(Type, #BaseName, PACKET_CONVERTER(BaseName), nullptr, CLIENT_SIDE_EVENT_HANDLER(BaseName))
+        TRACE("Triggering client event for packet: " + std::string(PacketRegistry::getPacketName(data[0])));
+        EventData event_data(std::move(packet));
+        Event<EventData>::trigger(event_data);
+    }
+}
 
-// Macro for bidirectional packets (both directions)
-#define REGISTER_BIDIRECTIONAL_PACKET(Type, BaseName) \
-    registerPacket(Type, #BaseName, PACKET_CONVERTER(BaseName), SERVER_SIDE_EVENT_HANDLER(BaseName), CLIENT_SIDE_EVENT_HANDLER(BaseName))
+// A packet type only gets the dispatchers for the direction it is declared with
+#define SERVER_DISPATCHER_TO_SERVER(BaseName) &dispatch_to_server<BaseName##Packet, ServerEvents::BaseName##EventData>
+#define SERVER_DISPATCHER_TO_CLIENT(BaseName) nullptr
+#define SERVER_DISPATCHER_BOTH(BaseName) SERVER_DISPATCHER_TO_SERVER(BaseName)
+#define CLIENT_DISPATCHER_TO_SERVER(BaseName) nullptr
+#define CLIENT_DISPATCHER_TO_CLIENT(BaseName) &dispatch_to_client<BaseName##Packet, ClientEvents::BaseName##EventData>
+#define CLIENT_DISPATCHER_BOTH(BaseName) CLIENT_DISPATCHER_TO_CLIENT(BaseName)
 
-/**
- * @brief Initializes all packet types in the registry.
- * Call this once at application startup before any networking operations.
- */
-void PacketRegistry::initializeRegistry() {
-    // Client -> Server packets
-    REGISTER_SERVER_PACKET(1, ConnectionInitiation);
-    REGISTER_SERVER_PACKET(4, DisconnectInfo);
-	REGISTER_SERVER_PACKET(8, GeneralInformationUpdate);
-	REGISTER_SERVER_PACKET(9, PlayerInput);
-    REGISTER_SERVER_PACKET(10, RequestWorldSnapshot);
-    REGISTER_SERVER_PACKET(22, PlayerAttack);
-    REGISTER_SERVER_PACKET(24, ItemDiscard);
+#define PACKET_ENTRY(Id, BaseName, Direction, Delivery) \
+    static_assert(BaseName##Packet::TYPE == Id, #BaseName "Packet::TYPE differs from its ID in ECHO_PACKET_LIST"); \
+    table[Id] = { &convert<BaseName##Packet>, SERVER_DISPATCHER_##Direction(BaseName), CLIENT_DISPATCHER_##Direction(BaseName) };
 
-    // Server -> Client packets
-    REGISTER_CLIENT_PACKET(2, ConnectionRefusal);
-    REGISTER_CLIENT_PACKET(3, ConnectionConfirmation);
-    REGISTER_CLIENT_PACKET(5, DisconnectKick);
-    REGISTER_CLIENT_PACKET(6, ServerDataUpdate);
-	REGISTER_CLIENT_PACKET(7, StateChange);
-	REGISTER_CLIENT_PACKET(11, WorldSnapshot);
-	
-	// Player packets (Server -> Client)
-	REGISTER_CLIENT_PACKET(14, PlayerSpawn);
-	REGISTER_CLIENT_PACKET(15, PlayerUpdate);
-	REGISTER_CLIENT_PACKET(16, PlayerDestroy);
-	
-	// Enemy packets (Server -> Client)
-	REGISTER_CLIENT_PACKET(17, EnemySpawn);
-	REGISTER_CLIENT_PACKET(18, EnemyUpdate);
-	REGISTER_CLIENT_PACKET(19, EnemyDestroy);
-	
-	// Object packets (Server -> Client)
-	REGISTER_CLIENT_PACKET(20, ObjectSpawn);
-	REGISTER_CLIENT_PACKET(21, ObjectDestroy);
-	
-	// Item packets (Server -> Client)
-	REGISTER_CLIENT_PACKET(23, ItemPickup);
+static constexpr std::array<PacketEntry, 256> make_registry() {
+    std::array<PacketEntry, 256> table{};
+    ECHO_PACKET_LIST(PACKET_ENTRY)
+    return table;
 }
+
+// Built at compile time, unknown types have no converter or dispatchers
+constinit const std::array<PacketEntry, 256> PacketRegistry::registry = make_registry();
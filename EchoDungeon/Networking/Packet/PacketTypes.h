@@ -0,0 +1,137 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Packet/PacketDelivery.h"
+#include <array>
+#include <string_view>
+
+/**
+ * @brief Which side receives (and dispatches) a packet type.
+ */
+enum class PacketDirection : uint8_t {
+	NONE,      // Not a packet type
+	TO_SERVER, // Client -> Server, triggers ServerEvents
+	TO_CLIENT, // Server -> Client, triggers ClientEvents
+	BOTH       // Either way, triggers both
+};
+
+/**
+ * @brief Every packet type, declared once as X(Id, BaseName, Direction, Delivery).
+ *
+ * BaseName##Packet is the packet class, Direction is a PacketDirection and Delivery is one of
+ * PacketDeliveries. The list generates the constexpr type table below, the events in
+ * EventList.h and the PacketRegistry's dispatch table, so adding a packet type is one line here.
+ * The class's own TYPE must repeat the ID; building the dispatch table static_asserts that it does.
+ *
+ * Events are reliable on the events channel. Entity updates and input are a stream of
+ * whole (or delta-acknowledged) states, so they go unreliable on the state channel:
+ * a lost update is replaced by the next one instead of stalling everything behind it.
+ * 26 is PacketBatch, which the PacketRegistry unpacks itself.
+ */
+#define ECHO_PACKET_LIST(X) \
+	/* Client -> Server */ \
+	X(1, ConnectionInitiation, TO_SERVER, RELIABLE_EVENT) \
+	X(4, DisconnectInfo, TO_SERVER, RELIABLE_EVENT) \
+	X(8, GeneralInformationUpdate, TO_SERVER, RELIABLE_EVENT) \
+	X(9, PlayerInput, TO_SERVER, SEQUENCED_STATE) \
+	X(10, RequestWorldSnapshot, TO_SERVER, RELIABLE_EVENT) \
+	X(22, PlayerAttack, TO_SERVER, RELIABLE_EVENT) \
+	X(24, ItemDiscard, TO_SERVER, RELIABLE_EVENT) \
+	X(25, SnapshotAck, TO_SERVER, UNSEQUENCED_STATE) \
+	/* Server -> Client */ \
+	X(2, ConnectionRefusal, TO_CLIENT, RELIABLE_EVENT) \
+	X(3, ConnectionConfirmation, TO_CLIENT, RELIABLE_EVENT) \
+	X(5, DisconnectKick, TO_CLIENT, RELIABLE_EVENT) \
+	X(6, ServerDataUpdate, TO_CLIENT, RELIABLE_EVENT) \
+	X(7, StateChange, TO_CLIENT, RELIABLE_EVENT) \
+	X(11, WorldSnapshot, TO_CLIENT, RELIABLE_EVENT) \
+	/* Player packets (Server -> Client) */ \
+	X(14, PlayerSpawn, TO_CLIENT, RELIABLE_EVENT) \
+	X(15, PlayerUpdate, TO_CLIENT, SEQUENCED_STATE) \
+	X(16, PlayerDestroy, TO_CLIENT, RELIABLE_EVENT) \
+	/* Enemy packets (Server -> Client) */ \
+	X(17, EnemySpawn, TO_CLIENT, RELIABLE_EVENT) \
+	X(18, EnemyUpdate, TO_CLIENT, SEQUENCED_STATE) \
+	X(19, EnemyDestroy, TO_CLIENT, RELIABLE_EVENT) \
+	/* Object packets (Server -> Client) */ \
+	X(20, ObjectSpawn, TO_CLIENT, RELIABLE_EVENT) \
+	X(21, ObjectDestroy, TO_CLIENT, RELIABLE_EVENT) \
+	/* Item packets (Server -> Client) */ \
+	X(23, ItemPickup, TO_CLIENT, RELIABLE_EVENT)
+
+/**
+ * @brief Compile-time description of one packet type.
+ */
+struct PacketTypeInfo {
+	uint8_t id = 0;
+	std::string_view name = "Unknown";
+	PacketDirection direction = PacketDirection::NONE;
+	PacketDeliveryInfo delivery = PacketDeliveries::RELIABLE_EVENT; // Unknown types are sent reliably
+};
+
+namespace PacketTypes {
+	constexpr uint8_t RESERVED_FLAG = 0x80; // Top bit of the type byte, marks compressed payloads (see PacketCompression)
+
+	// Every declared packet type, in list order
+#define PACKET_TYPE_INFO(Id, BaseName, Direction, Delivery) \
+	PacketTypeInfo{ Id, #BaseName, PacketDirection::Direction, PacketDeliveries::Delivery },
+	constexpr PacketTypeInfo ALL[] = { ECHO_PACKET_LIST(PACKET_TYPE_INFO) };
+#undef PACKET_TYPE_INFO
+
+	constexpr bool ids_unique() {
+		for (size_t i = 0; i < std::size(ALL); i++)
+			for (size_t j = i + 1; j < std::size(ALL); j++)
+				if (ALL[i].id == ALL[j].id) return false;
+		return true;
+	}
+
+	constexpr bool names_unique() {
+		for (size_t i = 0; i < std::size(ALL); i++)
+			for (size_t j = i + 1; j < std::size(ALL); j++)
+				if (ALL[i].name == ALL[j].name) return false;
+		return true;
+	}
+
+	constexpr bool ids_valid() {
+		for (const PacketTypeInfo& info : ALL)
+			if (info.id == 0 || (info.id & RESERVED_FLAG)) return false;
+		return true;
+	}
+
+	constexpr bool channels_allocated() {
+		for (const PacketTypeInfo& info : ALL)
+			if (info.delivery.channel >= NetworkConstants::MAX_CHANNELS) return false;
+		return true;
+	}
+
+	constexpr bool directions_set() {
+		for (const PacketTypeInfo& info : ALL)
+			if (info.direction == PacketDirection::NONE) return false;
+		return true;
+	}
+
+	static_assert(ids_unique(), "Two packet types share an ID");
+	static_assert(names_unique(), "A packet type is declared twice");
+	static_assert(ids_valid(), "Packet IDs must be between 1 and 127");
+	static_assert(channels_allocated(), "A packet type is sent on a channel the host does not allocate");
+	static_assert(directions_set(), "Every packet type needs a direction");
+
+	// Type table indexed by the type byte, unknown types keep the defaults
+	constexpr std::array<PacketTypeInfo, 256> make_table() {
+		std::array<PacketTypeInfo, 256> table{};
+		for (const PacketTypeInfo& info : ALL) table[info.id] = info;
+		return table;
+	}
+	constexpr std::array<PacketTypeInfo, 256> TABLE = make_table();
+
+	constexpr const PacketTypeInfo& info(uint8_t id) { return TABLE[id]; }
+
+	constexpr bool is_known(uint8_t id) { return info(id).direction != PacketDirection::NONE; }
+
+	constexpr bool reaches_server(uint8_t id) {
+		return info(id).direction == PacketDirection::TO_SERVER || info(id).direction == PacketDirection::BOTH;
+	}
+
+	constexpr bool reaches_client(uint8_t id) {
+		return info(id).direction == PacketDirection::TO_CLIENT || info(id).direction == PacketDirection::BOTH;
+	}
+}
@@ -0,0 +1,232 @@
+#pragma once
+#include "Imports/common.h"
+#include "Game/World/Entities/ObjectTransform.h"
+#include "Game/World/Systems/LevelGenerator.h"
+#include "Networking/Packet/ColumnCodec.h"
+#include <cmath>
+#include <algorithm>
+
+/**
+ * @brief Compact wire codec for ObjectTransform in frequent state packets.
+ *
+ * Positions are written as 16-bit fixed-point values inside the level bounds, and rotation
+ * as a 16-bit yaw (the game is top-down, pitch and roll are never replicated). Scale and the
+ * collision/static flags never change after spawn, so they are only sent by the spawn and
+ * snapshot packets, which still use the full ObjectTransform serialization.
+ *
+ * 8 bytes per transform, instead of 38. Bulk update lists use the column form
+ * (save_columns/load_columns), single transforms use QuantizedTransform.
+ */
+class TransformCodec {
+public:
+	// Position bounds, a 64 unit square around the level. Positions outside the bounds are clamped.
+	static constexpr float MIN_X = -32.0f;
+	static constexpr float MIN_Y = -8.0f;
+	static constexpr float MIN_Z = -32.0f;
+	static constexpr float POSITION_STEP = 1.0f / 1024.0f; // Fixed-point resolution, max error is half of this
+	static constexpr float YAW_STEP = 360.0f / 65536.0f; // Degrees per yaw step, max error is half of this
+
+	static constexpr float MAX_X = MIN_X + POSITION_STEP * 65535.0f;
+	static constexpr float MAX_Y = MIN_Y + POSITION_STEP * 65535.0f;
+	static constexpr float MAX_Z = MIN_Z + POSITION_STEP * 65535.0f;
+
+	// Growing the level past the bounds must move them (or coarsen POSITION_STEP), not clamp the outer walls
+	static_assert(MAX_X >= LevelGenerator::OUTER_EXTENT && MIN_X <= -LevelGenerator::OUTER_EXTENT, "Position bounds must cover the level on X");
+	static_assert(MAX_Z >= LevelGenerator::OUTER_EXTENT && MIN_Z <= -LevelGenerator::OUTER_EXTENT, "Position bounds must cover the level on Z");
+
+	// Quantize one position component to a fixed-point step index.
+	// NaN maps to the lower bound and infinities clamp like any other out of bounds value.
+	// Branch-free (the NaN check is a select), so the batch versions below vectorize.
+	static uint16_t quantize_position(float value, float min) {
+		float steps = (value - min) * (1.0f / POSITION_STEP) + 0.5f;
+		steps = (steps >= 0.0f) ? steps : 0.0f; // False for NaN too
+		steps = (std::min)(steps, 65535.0f);
+		return static_cast<uint16_t>(static_cast<int32_t>(steps));
+	}
+
+	static float dequantize_position(uint16_t value, float min) {
+		return min + static_cast<float>(value) * POSITION_STEP;
+	}
+
+	// Quantize a yaw in degrees (any finite value) to a 16-bit angle, NaN and infinities map to 0
+	static uint16_t quantize_yaw(float degrees) {
+		degrees = std::isfinite(degrees) ? degrees : 0.0f;
+		float turns = degrees * (1.0f / 360.0f);
+		turns -= std::floor(turns); // Wrap to [0, 1)
+		return static_cast<uint16_t>(static_cast<int32_t>(turns * 65536.0f + 0.5f) & 0xFFFF);
+	}
+
+	// Dequantize a 16-bit angle to degrees in [0, 360)
+	static float dequantize_yaw(uint16_t value) {
+		return static_cast<float>(value) * YAW_STEP;
+	}
+
+	// Batch versions over contiguous columns
+	static void quantize_positions(const float* values, uint16_t* out, size_t count, float min) {
+		for (size_t i = 0; i < count; i++) out[i] = quantize_position(values[i], min);
+	}
+
+	static void dequantize_positions(const uint16_t* values, float* out, size_t count, float min) {
+		for (size_t i = 0; i < count; i++) out[i] = dequantize_position(values[i], min);
+	}
+
+	static void quantize_yaws(const float* values, uint16_t* out, size_t count) {
+		for (size_t i = 0; i < count; i++) out[i] = quantize_yaw(values[i]);
+	}
+
+	static void dequantize_yaws(const uint16_t* values, float* out, size_t count) {
+		for (size_t i = 0; i < count; i++) out[i] = dequantize_yaw(values[i]);
+	}
+
+	/**
+	 * @brief Writes the transforms of the rows whose fields include bit as quantized columns:
+	 * all x, then all y, all z and all yaw values, each as one contiguous block.
+	 * @param archive The archive to write to.
+	 * @param rows Update rows with `fields` and `transform` members.
+	 * @param bit The field bit marking rows that carry a transform.
+	 */
+	template<class Archive, class Row, class Mask>
+	static void save_columns(Archive& archive, const std::vector<Row>& rows, Mask bit) {
+		size_t count = ColumnCodec::count_rows(rows, bit);
+
+		// Gather into float columns first, so quantizing runs over contiguous arrays. Scratch columns,
+		// so encoding every client's updates on every replication tick does not allocate.
+		std::vector<float>& x = ColumnCodec::scratch_column<float, 0>();
+		std::vector<float>& y = ColumnCodec::scratch_column<float, 1>();
+		std::vector<float>& z = ColumnCodec::scratch_column<float, 2>();
+		std::vector<float>& yaw = ColumnCodec::scratch_column<float, 3>();
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+		yaw.resize(count);
+		size_t next = 0;
+		for (const Row& row : rows) {
+			if (!(row.fields & bit)) continue;
+			raylib::Vector3 position = row.transform.get_position();
+			x[next] = position.x;
+			y[next] = position.y;
+			z[next] = position.z;
+			yaw[next] = row.transform.get_rotation().y;
+			next++;
+		}
+
+		std::vector<uint16_t>& qx = ColumnCodec::scratch_column<uint16_t, 0>();
+		std::vector<uint16_t>& qy = ColumnCodec::scratch_column<uint16_t, 1>();
+		std::vector<uint16_t>& qz = ColumnCodec::scratch_column<uint16_t, 2>();
+		std::vector<uint16_t>& qyaw = ColumnCodec::scratch_column<uint16_t, 3>();
+		qx.resize(count);
+		qy.resize(count);
+		qz.resize(count);
+		qyaw.resize(count);
+		quantize_positions(x.data(), qx.data(), count, MIN_X);
+		quantize_positions(y.data(), qy.data(), count, MIN_Y);
+		quantize_positions(z.data(), qz.data(), count, MIN_Z);
+		quantize_yaws(yaw.data(), qyaw.data(), count);
+
+		ColumnCodec::save_block(archive, qx);
+		ColumnCodec::save_block(archive, qy);
+		ColumnCodec::save_block(archive, qz);
+		ColumnCodec::save_block(archive, qyaw);
+	}
+
+	/**
+	 * @brief Reads the columns written by save_columns into the rows whose fields include bit.
+	 * Only position and yaw are set, like QuantizedTransform.
+	 * @param archive The archive to read from.
+	 * @param rows Update rows with their `fields` already loaded.
+	 * @param bit The field bit marking rows that carry a transform.
+	 */
+	template<class Archive, class Row, class Mask>
+	static void load_columns(Archive& archive, std::vector<Row>& rows, Mask bit) {
+		size_t count = ColumnCodec::count_rows(rows, bit);
+
+		// Scratch columns, so decoding every tick's updates does not allocate
+		std::vector<uint16_t>& qx = ColumnCodec::scratch_column<uint16_t, 0>();
+		std::vector<uint16_t>& qy = ColumnCodec::scratch_column<uint16_t, 1>();
+		std::vector<uint16_t>& qz = ColumnCodec::scratch_column<uint16_t, 2>();
+		std::vector<uint16_t>& qyaw = ColumnCodec::scratch_column<uint16_t, 3>();
+		ColumnCodec::load_block(archive, qx, count);
+		ColumnCodec::load_block(archive, qy, count);
+		ColumnCodec::load_block(archive, qz, count);
+		ColumnCodec::load_block(archive, qyaw, count);
+
+		std::vector<float>& x = ColumnCodec::scratch_column<float, 0>();
+		std::vector<float>& y = ColumnCodec::scratch_column<float, 1>();
+		std::vector<float>& z = ColumnCodec::scratch_column<float, 2>();
+		std::vector<float>& yaw = ColumnCodec::scratch_column<float, 3>();
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+		yaw.resize(count);
+		dequantize_positions(qx.data(), x.data(), count, MIN_X);
+		dequantize_positions(qy.data(), y.data(), count, MIN_Y);
+		dequantize_positions(qz.data(), z.data(), count, MIN_Z);
+		dequantize_yaws(qyaw.data(), yaw.data(), count);
+
+		size_t next = 0;
+		for (Row& row : rows) {
+			if (!(row.fields & bit)) continue;
+			row.transform.set_position({ x[next], y[next], z[next] });
+			raylib::Vector3 rotation = row.transform.get_rotation();
+			rotation.y = yaw[next];
+			row.transform.set_rotation(rotation);
+			next++;
+		}
+	}
+
+	/**
+	 * @brief Copies the replicated parts of a transform (position and yaw) onto target,
+	 * keeping target's scale, pitch, roll and flags from spawn.
+	 * @param target The transform to update.
+	 * @param replicated A transform decoded with QuantizedTransform.
+	 */
+	static void apply_replicated(ObjectTransform& target, const ObjectTransform& replicated) {
+		target.set_position(replicated.get_position());
+		raylib::Vector3 rotation = target.get_rotation();
+		rotation.y = replicated.get_rotation().y;
+		target.set_rotation(rotation);
+	}
+};
+
+/**
+ * @brief Serialization wrapper that writes an ObjectTransform with TransformCodec.
+ * Use as archive(QuantizedTransform(transform)). On load only position and yaw are
+ * set, everything else in the transform is left untouched.
+ */
+class QuantizedTransform {
+public:
+	explicit QuantizedTransform(ObjectTransform& _transform) : transform(_transform) {}
+
+	template<class Archive>
+	void save(Archive& archive) const {
+		raylib::Vector3 position = transform.get_position();
+		uint16_t x = TransformCodec::quantize_position(position.x, TransformCodec::MIN_X);
+		uint16_t y = TransformCodec::quantize_position(position.y, TransformCodec::MIN_Y);
+		uint16_t z = TransformCodec::quantize_position(position.z, TransformCodec::MIN_Z);
+		uint16_t yaw = TransformCodec::quantize_yaw(transform.get_rotation().y);
+		archive(full_range(x), full_range(y), full_range(z), full_range(yaw));
+	}
+
+	template<class Archive>
+	void load(Archive& archive) {
+		uint16_t x = 0, y = 0, z = 0, yaw = 0;
+		archive(full_range(x), full_range(y), full_range(z), full_range(yaw));
+
+		transform.set_position({
+			TransformCodec::dequantize_position(x, TransformCodec::MIN_X),
+			TransformCodec::dequantize_position(y, TransformCodec::MIN_Y),
+			TransformCodec::dequantize_position(z, TransformCodec::MIN_Z)
+		});
+		raylib::Vector3 rotation = transform.get_rotation();
+		rotation.y = TransformCodec::dequantize_yaw(yaw);
+		transform.set_rotation(rotation);
+	}
+
+private:
+	ObjectTransform& transform;
+
+	// Quantized values use their whole 16 bits, so they are written as fixed 16 bits rather than varints
+	static RangedValue<uint16_t> full_range(uint16_t& value) {
+		return make_ranged(value, uint16_t(0), uint16_t(65535));
+	}
+};
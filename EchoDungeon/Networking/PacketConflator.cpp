@@ -0,0 +1,136 @@
+#include "PacketConflator.h"
+#include "Networking/Packet/PacketTypes.h"
+#include "Utils/NetUtils.h"
+#include <algorithm>
+
+PacketConflator::~PacketConflator() {
+	clear();
+}
+
+/**
+ * @brief Checks whether a packet belongs to a state stream where a newer packet supersedes it.
+ * That is every known packet type declared with UNRELIABLE_SEQUENCED delivery, compressed or not.
+ * @param packet The encoded packet.
+ * @return true if the packet may be held and replaced.
+ */
+bool PacketConflator::is_conflatable(const ENetPacket* packet) {
+	if (packet == nullptr || packet->dataLength == 0) return false;
+
+	uint8_t type = packet->data[0] & ~PacketTypes::RESERVED_FLAG;
+	return PacketTypes::is_known(type)
+		&& PacketTypes::info(type).delivery.delivery == PacketDelivery::UNRELIABLE_SEQUENCED;
+}
+
+/**
+ * @brief Holds a conflatable packet for a peer until release() finds room for it.
+ * An older packet of the same type still held for the peer is discarded unsent.
+ * @param peer The peer to send the packet to.
+ * @param channel The channel to send on.
+ * @param packet The packet. The conflator takes a reference to it.
+ */
+void PacketConflator::hold(ENetPeer* peer, uint8_t channel, ENetPacket* packet) {
+	uint8_t type = packet->data[0] & ~PacketTypes::RESERVED_FLAG;
+	packet->referenceCount++;
+
+	std::vector<HeldPacket>& packets = held[peer];
+	auto it = std::find_if(packets.begin(), packets.end(),
+		[type](const HeldPacket& entry) { return entry.type == type; });
+
+	if (it == packets.end()) {
+		packets.push_back({ type, channel, packet });
+		return;
+	}
+
+	unreference(it->packet); // Superseded before it was sent
+	it->channel = channel;
+	it->packet = packet;
+}
+
+/**
+ * @brief Hands each held packet to ENet if its peer has room for it, the rest stay held.
+ * Packets held for a peer that is no longer connected are discarded, ENet would refuse them.
+ * Call after queueing a round of sends and before flushing the host.
+ */
+void PacketConflator::release() {
+	for (auto peer_it = held.begin(); peer_it != held.end(); ) {
+		ENetPeer* peer = peer_it->first;
+		bool connected = peer->state == ENET_PEER_STATE_CONNECTED;
+		if (connected && !has_room(peer)) {
+			++peer_it;
+			continue;
+		}
+
+		for (const HeldPacket& entry : peer_it->second) {
+			if (connected && enet_peer_send(peer, entry.channel, entry.packet) < 0) {
+				ERROR("Failed to send packet to peer with IP address: " + NetUtils::get_ip_string(peer->address));
+			}
+			unreference(entry.packet);
+		}
+		peer_it = held.erase(peer_it);
+	}
+}
+
+/**
+ * @brief Discards a peer's held packets without sending them (eg when it disconnects).
+ * ENet reuses peers for new connections, so a disconnected peer's packets must not linger.
+ * @param peer The peer to forget.
+ */
+void PacketConflator::drop(ENetPeer* peer) {
+	auto it = held.find(peer);
+	if (it == held.end()) return;
+
+	for (const HeldPacket& entry : it->second) {
+		unreference(entry.packet);
+	}
+	held.erase(it);
+}
+
+/**
+ * @brief Discards every held packet without sending it.
+ */
+void PacketConflator::clear() {
+	for (auto& [peer, packets] : held) {
+		for (const HeldPacket& entry : packets) {
+			unreference(entry.packet);
+		}
+	}
+	held.clear();
+}
+
+/**
+ * @brief Counts the packets currently held.
+ * @return The number of held packets, across all peers.
+ */
+size_t PacketConflator::held_count() const {
+	size_t count = 0;
+	for (const auto& [peer, packets] : held) {
+		count += packets.size();
+	}
+	return count;
+}
+
+/**
+ * @brief Checks whether a peer's link can take another state packet.
+ * ENet still holding unreliable packets it has not sent means the last state packets are still
+ * waiting, and a newer packet would only queue behind them. Reliable packets queued for the peer
+ * are skipped: ENet already sends state alongside a reliable backlog, throttled to what the link takes.
+ * Both of ENet's outgoing lists are searched, as an unreliable packet too large for one datagram
+ * is queued with the reliable commands when it is not sent as unreliable fragments.
+ * @param peer The peer to check.
+ * @return true if held packets for the peer should be sent now.
+ */
+bool PacketConflator::has_room(const ENetPeer* peer) {
+	for (const ENetList* commands : { &peer->outgoingCommands, &peer->outgoingSendReliableCommands }) {
+		for (ENetListIterator it = enet_list_begin(commands); it != enet_list_end(commands); it = enet_list_next(it)) {
+			const ENetPacket* packet = reinterpret_cast<const ENetOutgoingCommand*>(it)->packet;
+			if (packet != nullptr && !(packet->flags & ENET_PACKET_FLAG_RELIABLE)) return false; // An unsent unreliable packet, not a ping or reliable data
+		}
+	}
+	return true;
+}
+
+void PacketConflator::unreference(ENetPacket* packet) {
+	if (--packet->referenceCount == 0) {
+		enet_packet_destroy(packet);
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Imports/common.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Holds at most one unsent state packet per peer and packet type, replacing older ones.
+ *
+ * Packet types declared with UNRELIABLE_SEQUENCED delivery are streams where only the newest
+ * packet matters (entity updates, player input). Instead of handing every one of them to ENet,
+ * the networking thread holds them here and release() passes the held packet on only once ENet
+ * has sent every unreliable packet queued for the peer before it. A newer packet arriving while
+ * one is held (eg several updates queued while the networking thread was busy) replaces it, so
+ * a backed up peer costs one packet per stream instead of a backlog.
+ *
+ * Reliable and unsequenced packets, PacketBatch containers and unknown types are never held.
+ * Networking thread only, like the ENetHost itself.
+ */
+class PacketConflator {
+public:
+	PacketConflator() = default;
+	~PacketConflator();
+
+	PacketConflator(const PacketConflator&) = delete;
+	PacketConflator& operator=(const PacketConflator&) = delete;
+
+	static bool is_conflatable(const ENetPacket* packet); // Whether packet is a state packet a newer one supersedes
+
+	void hold(ENetPeer* peer, uint8_t channel, ENetPacket* packet); // Hold a conflatable packet for peer, replacing the older one of its type
+	void release(); // Send every held packet whose peer has room for it
+	void drop(ENetPeer* peer); // Discard a (disconnecting) peer's held packets
+	void clear(); // Discard every held packet
+
+	size_t held_count() const; // Number of packets currently held
+
+private:
+	struct HeldPacket {
+		uint8_t type; // Packet type, the stream the packet belongs to
+		uint8_t channel; // Channel to send on
+		ENetPacket* packet; // Referenced by the conflator while held
+	};
+
+	std::unordered_map<ENetPeer*, std::vector<HeldPacket>> held; // Only peers with packets held
+
+	static bool has_room(const ENetPeer* peer); // Whether the peer's link can take another state packet now
+	static void unreference(ENetPacket* packet); // Drop the conflator's reference, destroying the packet if it was the last
+};
@@ -0,0 +1,162 @@
+#include "PacketBatcher.h"
+#include "Networking/Packet/PacketBatch.h"
+#include <algorithm>
+
+/**
+ * @brief Constructs a PacketBatcher.
+ * @param send Sends a finished ENetPacket to a peer on a channel (eg NetworkUser::send_packet), taking ownership of it.
+ */
+PacketBatcher::PacketBatcher(SendFunction send) : send(std::move(send)) {}
+
+/**
+ * @brief Appends an encoded message to the peer's open batch for its delivery mode.
+ * If the message does not fit the open batch, the batch is sent first. Messages too large
+ * to ever fit a batch are sent on their own straight away, after the open batch.
+ * @param peer The peer to send the message to.
+ * @param delivery The channel and delivery mode of the message's packet type.
+ * @param message The encoded message, starting with its PacketHeader.
+ * @param size The size of the encoded message.
+ * @return false if a batch or message had to be sent now and sending failed.
+ */
+bool PacketBatcher::queue(ENetPeer* peer, const PacketDeliveryInfo& delivery, const uint8_t* message, size_t size) {
+    if (peer == nullptr || size == 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<OpenBatch>& batches = open_batches[peer];
+    auto it = std::find_if(batches.begin(), batches.end(),
+        [&delivery](const OpenBatch& batch) { return batch.delivery == delivery; });
+
+    bool sent = true;
+    size_t encoded_size = PacketBatch::encoded_size(size);
+
+    // Keep the order of messages: anything already batched goes out before this one
+    if (it != batches.end() && it->buffer->size() + encoded_size > MAX_BATCH_SIZE) {
+        sent = send_batch(peer, *it);
+        batches.erase(it);
+        it = batches.end();
+    }
+
+    if (1 + encoded_size > MAX_BATCH_SIZE) {
+        std::unique_ptr<PacketBuffer> buffer = PacketBufferPool::acquire();
+        buffer->insert(buffer->end(), message, message + size);
+        return send_buffer(peer, delivery, std::move(buffer)) && sent;
+    }
+
+    if (it == batches.end()) {
+        batches.push_back({ delivery, PacketBufferPool::acquire(), 0 });
+        it = std::prev(batches.end());
+        PacketBatch::begin(*it->buffer);
+    }
+
+    PacketBatch::append(*it->buffer, message, size);
+    it->message_count++;
+    return sent;
+}
+
+/**
+ * @brief Sends the peer's open batch for a delivery mode, if there is one.
+ * Call before sending a packet to the peer directly on the same channel, so it cannot overtake queued messages.
+ * @param peer The peer to flush.
+ * @param delivery The delivery mode whose batch to send.
+ * @return false if sending failed.
+ */
+bool PacketBatcher::flush(ENetPeer* peer, const PacketDeliveryInfo& delivery) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto peer_it = open_batches.find(peer);
+    if (peer_it == open_batches.end()) return true;
+
+    std::vector<OpenBatch>& batches = peer_it->second;
+    auto it = std::find_if(batches.begin(), batches.end(),
+        [&delivery](const OpenBatch& batch) { return batch.delivery == delivery; });
+    if (it == batches.end()) return true;
+
+    bool sent = send_batch(peer, *it);
+    batches.erase(it);
+    if (batches.empty()) open_batches.erase(peer_it);
+    return sent;
+}
+
+/**
+ * @brief Sends every open batch of every peer.
+ * @return false if any batch failed to send.
+ */
+bool PacketBatcher::flush_all() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool all_sent = true;
+    for (auto& [peer, batches] : open_batches) {
+        for (OpenBatch& batch : batches) {
+            if (!send_batch(peer, batch)) all_sent = false;
+        }
+    }
+    open_batches.clear();
+    return all_sent;
+}
+
+/**
+ * @brief Sends every open batch of one peer, leaving other peers' batches open.
+ * @param peer The peer whose batches to send.
+ * @return false if any batch failed to send.
+ */
+bool PacketBatcher::flush_peer(ENetPeer* peer) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto peer_it = open_batches.find(peer);
+    if (peer_it == open_batches.end()) return true;
+
+    bool all_sent = true;
+    for (OpenBatch& batch : peer_it->second) {
+        if (!send_batch(peer, batch)) all_sent = false;
+    }
+    open_batches.erase(peer_it);
+    return all_sent;
+}
+
+/**
+ * @brief Discards a peer's open batches without sending them (eg after it disconnected).
+ * @param peer The peer to forget.
+ */
+void PacketBatcher::drop(ENetPeer* peer) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = open_batches.find(peer);
+    if (it == open_batches.end()) return;
+
+    for (OpenBatch& batch : it->second) {
+        PacketBufferPool::release(std::move(batch.buffer));
+    }
+    open_batches.erase(it);
+}
+
+/**
+ * @brief Sends one open batch. A batch holding a single message is sent as that message alone.
+ * @param peer The peer to send to.
+ * @param batch The batch to send. Its buffer is consumed.
+ * @return false if sending failed.
+ */
+bool PacketBatcher::send_batch(ENetPeer* peer, OpenBatch& batch) {
+    if (batch.message_count == 1) {
+        // Strip the type byte and the length prefix, whose last byte has the high bit clear
+        size_t prefix = 1;
+        while ((*batch.buffer)[prefix] & 0x80) prefix++;
+        batch.buffer->erase(batch.buffer->begin(), batch.buffer->begin() + prefix + 1);
+    }
+
+    return send_buffer(peer, batch.delivery, std::move(batch.buffer));
+}
+
+/**
+ * @brief Wraps an encoded buffer in an ENetPacket and sends it.
+ * @param peer The peer to send to.
+ * @param delivery The channel and delivery mode to send with.
+ * @param buffer The encoded data. Ownership passes to the ENetPacket.
+ * @return false if sending failed.
+ */
+bool PacketBatcher::send_buffer(ENetPeer* peer, const PacketDeliveryInfo& delivery, std::unique_ptr<PacketBuffer> buffer) {
+    ENetPacket* packet = PacketBufferPool::to_enet_packet(std::move(buffer), delivery.enet_flags());
+    if (packet == nullptr) return false;
+
+    return send(packet, peer, delivery.channel); // The send function owns the packet, even on failure
+}
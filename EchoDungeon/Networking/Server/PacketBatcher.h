@@ -0,0 +1,47 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/Packet/PacketBuffer.h"
+#include "Networking/Packet/PacketDelivery.h"
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+
+/**
+ * @brief Coalesces outgoing messages per peer into PacketBatch containers.
+ *
+ * Queued messages are appended to the peer's open batch for their delivery mode (one
+ * per channel and reliability), and flush_all() sends every open batch, normally once at
+ * the end of a server tick. A batch that would grow past MAX_BATCH_SIZE is sent early, and
+ * a batch holding just one message is sent as that message alone, without the container.
+ */
+class PacketBatcher {
+public:
+    using SendFunction = std::function<bool(ENetPacket* packet, ENetPeer* peer, uint8_t channel)>;
+
+    // Batches stay inside one ENet fragment at the default MTU (ENET_HOST_DEFAULT_MTU is 1392,
+    // minus protocol and command headers), so a batch is never split across datagrams
+    static constexpr size_t MAX_BATCH_SIZE = 1200;
+
+    explicit PacketBatcher(SendFunction send);
+
+    bool queue(ENetPeer* peer, const PacketDeliveryInfo& delivery, const uint8_t* message, size_t size); // Add an encoded message to the peer's batch
+    bool flush(ENetPeer* peer, const PacketDeliveryInfo& delivery); // Send the peer's open batch for a delivery mode now
+    bool flush_all(); // Send every open batch
+    bool flush_peer(ENetPeer* peer); // Send every open batch of one peer
+    void drop(ENetPeer* peer); // Discard a (disconnected) peer's open batches
+
+private:
+    struct OpenBatch {
+        PacketDeliveryInfo delivery;
+        std::unique_ptr<PacketBuffer> buffer;
+        size_t message_count = 0;
+    };
+
+    SendFunction send;
+    std::mutex mutex;
+    std::unordered_map<ENetPeer*, std::vector<OpenBatch>> open_batches; // Only batches with messages in them
+
+    bool send_batch(ENetPeer* peer, OpenBatch& batch); // Caller must hold mutex
+    bool send_buffer(ENetPeer* peer, const PacketDeliveryInfo& delivery, std::unique_ptr<PacketBuffer> buffer);
+};
@@ -1,5 +1,6 @@
 #include "Server.h"
 #include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/PacketCompression.h"
 #include "Networking/Packet/Instances/ConnectionInitiation.h"
 #include "Networking/Packet/Instances/ConnectionConfirmation.h"
 #include "Networking/Packet/Instances/ConnectionRefusal.h"
@@ -7,16 +8,40 @@
 #include "Game/Events/EventList.h"
 #include "Networking/Packet/Instances/DisconnectInfo.h"
 #include "Networking/Packet/Instances/DisconnectKick.h"
+#include <algorithm>
 
 // Timeout for pending connections (1 minute)
 constexpr auto PENDING_CONNECTION_TIMEOUT = std::chrono::seconds(60);
 
+/**
+ * @brief Creates and configures one of the server's ENet hosts.
+ * @param address The address to bind the host to.
+ * @param shared Whether the host shares its port with the server's other hosts (SO_REUSEPORT).
+ * @return The host, or nullptr if it could not be created.
+ */
+static ENetHost* create_server_host(const ENetAddress& address, bool shared) {
+    auto create = shared ? &enet_host_create_shared : &enet_host_create;
+    ENetHost* host = create(&address, NetworkConstants::MAX_SIMULTANEOUS_CONNECTIONS,
+        NetworkConstants::MAX_CHANNELS, NetworkConstants::BANDWIDTH_LIMIT, NetworkConstants::BANDWIDTH_LIMIT);
+    if (host == nullptr) {
+        return nullptr;
+    }
+    PacketCompression::configure_host(host);
+
+    if (NetworkConstants::SOCKET_BATCH_SIZE > 0 &&
+        enet_host_batch_socket_io(host, NetworkConstants::SOCKET_BATCH_SIZE, NetworkConstants::UDP_SEGMENT_OFFLOAD) < 0) {
+        INFO("Batched socket I/O is not available on this platform, using one system call per datagram");
+    }
+    return host;
+}
+
 /**
  * @brief Constructs a Server instance and initializes the ENet host.
  * @param address The address to bind the server to.
  * @param port The port to bind the server to.
  */
-Server::Server(const std::string& address, int port) : NetworkUser(), peers(ServerPeerlist()) {
+Server::Server(const std::string& address, int port) : NetworkUser(), peers(ServerPeerlist()),
+    batcher([this](ENetPacket* packet, ENetPeer* peer, uint8_t channel) { return send_enet_packet(packet, peer, channel); }) {
     // Set server info
     server_info.address = address;
     server_info.port = port;
@@ -30,14 +55,39 @@ Server::Server(const std::string& address, int port) : NetworkUser(), peers(Serv
     }
     this->address.port = port;
 
-    // Create server host with the specified address, allowing multiple peers
-    host = enet_host_create(&this->address, NetworkConstants::MAX_SIMULTANEOUS_CONNECTIONS, 
-        NetworkConstants::MAX_CHANNELS, NetworkConstants::BANDWIDTH_LIMIT, NetworkConstants::BANDWIDTH_LIMIT);
+    // Create server host with the specified address, allowing multiple peers.
+    // A sharded server binds one host per shard to the same port, see ServerShard
+    bool sharded = NetworkConstants::SERVER_SHARDS > 1;
+    host = create_server_host(this->address, sharded);
+    if (host == nullptr && sharded) {
+        WARNING("Failed to share the server port (SO_REUSEPORT), serving from a single host");
+        sharded = false;
+        host = create_server_host(this->address, false);
+    }
     if (host == nullptr) {
         ERROR("Failed to create ENet server host");
         return;
     }
 
+    if (sharded) {
+        shared_port = true;
+        // With port 0 the system picked the first host's port, the shards have to join it there
+        if (this->address.port == 0) {
+            ENetAddress bound{};
+            if (enet_socket_get_address(host->socket, &bound) == 0) {
+                this->address.port = bound.port;
+            }
+        }
+        for (size_t index = 1; index < NetworkConstants::SERVER_SHARDS; index++) {
+            ENetHost* shard_host = create_server_host(this->address, true);
+            if (shard_host == nullptr) {
+                WARNING("Failed to create server shard " + std::to_string(index) + ", serving from " + std::to_string(index) + " hosts");
+                break;
+            }
+            shards.push_back(std::make_unique<ServerShard>(*this, index, shard_host));
+        }
+    }
+
     // Register event callback for ConnectionInitiation packets
     on_connection_initiation_callback = ServerEvents::ConnectionInitiationEvent::register_callback(
         [this](const ServerEvents::ConnectionInitiationEventData& data) {
@@ -71,6 +121,9 @@ Server::~Server() {
         stop();
     }
 
+    // Shards destroy their own hosts
+    shards.clear();
+
     // Destroy ENet host
     if (host) {
         enet_host_destroy(host);
@@ -101,9 +154,10 @@ std::future<bool> Server::disconnect_peer(uint16_t peer_id, const std::string& r
         auto packet = DisconnectKickPacket(reason);
         send_packet(packet, peer_id);
 
-        // Disconnect a peer
-        enet_peer_disconnect(peer_data->peer, 0);
-        peers.remove_peer(peer_id);
+        // Disconnect the peer once the kick packet has gone out
+        owner_of(peer_data->peer).queue_disconnect(peer_data->peer, DisconnectMode::LATER);
+        peers.remove_peer(peer_id); // First, so no sender can find the peer and batch for it again
+        batcher.drop(peer_data->peer);
 
         INFO("Peer " + std::to_string(peer_id) + " kicked for reason: " + reason);
         return true;
@@ -134,6 +188,7 @@ std::future<bool> Server::disconnect_all(const std::string& reason) {
 
         // Clear remaining data after disconnections
         peers.clear();
+        std::lock_guard<std::mutex> lock(connection_mutex);
         pending_connections.clear();
 
         INFO("All peers disconnected");
@@ -152,7 +207,7 @@ std::future<bool> Server::disconnect_all(const std::string& reason) {
  * @return true if the packet was sent successfully, false otherwise.
  */
 bool Server::send_packet(Packet& packet, uint16_t peer_id) {
-    TRACE("Sending packet " + PacketRegistry::getPacketName(packet.header.type) + " to peer " + std::to_string(peer_id));
+    TRACE("Sending packet " + std::string(PacketRegistry::getPacketName(packet.header.type)) + " to peer " + std::to_string(peer_id));
 
     std::optional<PeerEntry> opt_target_peer = peers.get_peer_by_id(peer_id);
     if (!opt_target_peer.has_value()) {
@@ -165,7 +220,8 @@ bool Server::send_packet(Packet& packet, uint16_t peer_id) {
         return false;
     }
 
-    return NetworkUser::send_packet(packet.to_enet_packet(), opt_target_peer->peer);
+    batcher.flush(opt_target_peer->peer, packet.delivery()); // Queued packets go first
+    return send_enet_packet(packet.to_enet_packet(), opt_target_peer->peer, packet.delivery().channel);
 }
 
 /**
@@ -175,38 +231,143 @@ bool Server::send_packet(Packet& packet, uint16_t peer_id) {
  * @return true if the packet was sent successfully, false otherwise.
  */
 bool Server::send_packet_to_peer(Packet& packet, ENetPeer* peer) {
-    TRACE("Sending packet " + PacketRegistry::getPacketName(packet.header.type) + " to ENetPeer");
+    TRACE("Sending packet " + std::string(PacketRegistry::getPacketName(packet.header.type)) + " to ENetPeer");
     
     if (peer == nullptr) {
         ERROR("Cannot send packet to null peer");
         return false;
     }
 
-    return NetworkUser::send_packet(packet.to_enet_packet(), peer);
+    batcher.flush(peer, packet.delivery()); // Queued packets go first
+    return send_enet_packet(packet.to_enet_packet(), peer, packet.delivery().channel);
 }
 
 /**
  * @brief Broadcasts a packet to all connected peers, optionally excluding one.
+ * The packet is encoded once and the same ENetPacket is queued for every peer on a host;
+ * ENet reference counts it and frees it after the last peer has sent it. ENet's reference
+ * counts are not atomic, so on a sharded server each further host gets its own copy.
  * @param packet The packet to broadcast.
  * @param exclude_peer_id Optional peer ID to exclude from the broadcast.
+ * @param room_id Optional room to limit the broadcast to.
  * @return true if the packet was broadcast successfully, false otherwise.
  */
-bool Server::broadcast_packet(Packet& packet, const std::optional<uint16_t>& exclude_peer_id) {
-    TRACE("Broadcasting packet " + PacketRegistry::getPacketName(packet.header.type) + " to all peers" + 
+bool Server::broadcast_packet(Packet& packet, const std::optional<uint16_t>& exclude_peer_id, const std::optional<RoomId>& room_id) {
+    TRACE("Broadcasting packet " + std::string(PacketRegistry::getPacketName(packet.header.type)) + " to all peers" + 
           (exclude_peer_id.has_value() ? " (excluding peer " + std::to_string(exclude_peer_id.value()) + ")" : ""));
 
-    bool all_sent = true;
-    for (const auto& peer_data : peers.get_all_peers()) {
+    ENetPacket* enet_packet = packet.to_enet_packet();
+    if (enet_packet == nullptr) {
+        ERROR("Failed to encode packet " + std::string(PacketRegistry::getPacketName(packet.header.type)) + " for broadcast");
+        return false;
+    }
+
+    PacketDeliveryInfo delivery = packet.delivery();
+    std::vector<std::pair<NetworkUser*, std::vector<ENetPeer*>>> recipients; // Grouped by the host they are connected to
+    for (const auto& peer_data : get_recipients(room_id)) {
         if (exclude_peer_id.has_value() && peer_data.data.server_side_id == exclude_peer_id.value()) {
             continue;
         }
 
-        if (!send_packet(packet, peer_data.data.server_side_id)) {
-            all_sent = false;
-            ERROR("Failed to send packet to peer " + std::to_string(peer_data.data.server_side_id));
+        batcher.flush(peer_data.peer, delivery); // Queued packets go first
+        NetworkUser* owner = &owner_of(peer_data.peer);
+        auto group = std::find_if(recipients.begin(), recipients.end(),
+            [owner](const auto& entry) { return entry.first == owner; });
+        if (group == recipients.end()) {
+            group = recipients.emplace(recipients.end(), owner, std::vector<ENetPeer*>());
+        }
+        group->second.push_back(peer_data.peer);
+    }
+
+    if (recipients.empty()) {
+        enet_packet_destroy(enet_packet);
+        return true;
+    }
+
+    // One command per host for all of its recipients. The original goes last, once every copy is made,
+    // since its host's networking thread may send and free it as soon as it is queued
+    bool all_queued = true;
+    for (size_t i = recipients.size(); i-- > 0; ) {
+        ENetPacket* host_packet = i == 0 ? enet_packet
+            : enet_packet_create(enet_packet->data, enet_packet->dataLength, enet_packet->flags & ~ENET_PACKET_FLAG_NO_ALLOCATE);
+        if (!recipients[i].first->send_packet(host_packet, std::move(recipients[i].second), delivery.channel)) {
+            ERROR("Failed to queue broadcast of packet " + std::string(PacketRegistry::getPacketName(packet.header.type)));
+            all_queued = false;
         }
     }
+    return all_queued;
+}
+
+/**
+ * @brief Queues a packet for a peer, to be sent in that peer's next batch.
+ * Packets queued for a peer arrive in the order they were queued, and before any packet
+ * sent to it directly on the same channel afterwards.
+ * @param packet The packet to queue.
+ * @param peer_id The server-side ID of the peer to send the packet to.
+ * @return true if the packet was queued, false otherwise.
+ */
+bool Server::queue_packet(Packet& packet, uint16_t peer_id) {
+    TRACE("Queueing packet " + std::string(PacketRegistry::getPacketName(packet.header.type)) + " for peer " + std::to_string(peer_id));
+
+    std::optional<PeerEntry> opt_target_peer = peers.get_peer_by_id(peer_id);
+    if (!opt_target_peer.has_value() || opt_target_peer->peer == nullptr) {
+        ERROR("Peer with ID " + std::to_string(peer_id) + " not found in peerlist");
+        return false;
+    }
 
+    std::unique_ptr<PacketBuffer> buffer = PacketBufferPool::acquire();
+    packet.to_buffer(*buffer);
+    bool queued = batcher.queue(opt_target_peer->peer, packet.delivery(), buffer->data(), buffer->size());
+    PacketBufferPool::release(std::move(buffer));
+    return queued;
+}
+
+/**
+ * @brief Queues a packet for all connected peers, optionally excluding one.
+ * The packet is encoded once and appended to every recipient's batch.
+ * @param packet The packet to queue.
+ * @param exclude_peer_id Optional peer ID to exclude from the broadcast.
+ * @param room_id Optional room to limit the broadcast to.
+ * @return true if the packet was queued for every recipient, false otherwise.
+ */
+bool Server::queue_broadcast(Packet& packet, const std::optional<uint16_t>& exclude_peer_id, const std::optional<RoomId>& room_id) {
+    TRACE("Queueing broadcast of packet " + std::string(PacketRegistry::getPacketName(packet.header.type)));
+
+    std::unique_ptr<PacketBuffer> buffer = PacketBufferPool::acquire();
+    packet.to_buffer(*buffer);
+    PacketDeliveryInfo delivery = packet.delivery();
+
+    bool all_queued = true;
+    for (const auto& peer_data : get_recipients(room_id)) {
+        if (exclude_peer_id.has_value() && peer_data.data.server_side_id == exclude_peer_id.value()) {
+            continue;
+        }
+
+        if (!batcher.queue(peer_data.peer, delivery, buffer->data(), buffer->size())) {
+            all_queued = false;
+            ERROR("Failed to queue packet for peer " + std::to_string(peer_data.data.server_side_id));
+        }
+    }
+
+    PacketBufferPool::release(std::move(buffer));
+    return all_queued;
+}
+
+/**
+ * @brief Sends every peer's batch of queued packets. Call once at the end of each server tick.
+ * A room's tick only sends its own peers' batches, other rooms tick on their own schedule.
+ * @param room_id Optional room whose peers' batches to send.
+ * @return true if every batch was sent successfully, false otherwise.
+ */
+bool Server::flush_batches(const std::optional<RoomId>& room_id) {
+    if (!room_id.has_value()) {
+        return batcher.flush_all();
+    }
+
+    bool all_sent = true;
+    for (const auto& peer_data : peers.get_room_peers(room_id.value())) {
+        if (!batcher.flush_peer(peer_data.peer)) all_sent = false;
+    }
     return all_sent;
 }
 
@@ -223,13 +384,16 @@ void Server::start() {
         return;
     }
 
-    if (thread_id == std::this_thread::get_id()) {
+    if (thread_id.load() == std::this_thread::get_id()) {
         WARNING("Server update loop already exists in this thread, cannot start");
         return;
     }
 
     NetworkUser::start();
-    INFO("Server networking loop started");
+    for (auto& shard : shards) {
+        shard->start();
+    }
+    INFO("Server networking loop started" + (shards.empty() ? std::string() : " on " + std::to_string(shards.size() + 1) + " hosts"));
 }
 
 /**
@@ -246,95 +410,125 @@ std::future<void> Server::stop() {
         disconnect_all("Server shutting down").get();
 
         NetworkUser::stop();
+        for (auto& shard : shards) {
+            shard->stop();
+        }
         INFO("Server networking loop stopped");
     });
 }
 
 /**
  * @brief Executes a single update cycle for the server, processing incoming events and packets.
+ * Shards service their own hosts the same way on their own threads, see ServerShard::update().
  */
 void Server::update() {
     // Check for timed out pending connections
     check_pending_connection_timeouts();
-    
+
     ENetEvent event;
     while (enet_host_service(host, &event, 0) > 0) {
-		auto peer_info = peers.get_peer_by_enet(event.peer);
-        switch (event.type) {
-            case ENET_EVENT_TYPE_CONNECT: {
-                INFO("A new client connected from " + NetUtils::get_ip_string(event.peer->address));
-                
-                // Add to pending connections - waiting for ConnectionInitiation packet
+        if (event.type == ENET_EVENT_TYPE_DISCONNECT || event.type == ENET_EVENT_TYPE_DISCONNECT_TIMEOUT) {
+            forget_peer(event.peer);
+        }
+        handle_event(event);
+    }
+}
+
+/**
+ * @brief Handles one event of the server's host or of a shard's host.
+ * Runs on the networking thread of the host the event came from, so several may run at once
+ * on a sharded server: connects and disconnects take connection_mutex.
+ * @param event The event returned by enet_host_service().
+ */
+void Server::handle_event(ENetEvent& event) {
+	auto peer_info = peers.get_peer_by_enet(event.peer);
+    switch (event.type) {
+        case ENET_EVENT_TYPE_CONNECT: {
+            INFO("A new client connected from " + NetUtils::get_ip_string(event.peer->address));
+            
+            // Add to pending connections - waiting for ConnectionInitiation packet
+            {
+                std::lock_guard<std::mutex> lock(connection_mutex);
                 pending_connections[event.peer] = {
                     event.peer,
                     std::chrono::steady_clock::now()
                 };
-                
-                // Trigger event for external listeners
-                ServerEvents::ConnectionEventData data(event);
-                ServerEvents::ConnectionEvent::trigger(data);
-                break;
             }
+            
+            // Trigger event for external listeners
+            ServerEvents::ConnectionEventData data(event);
+            ServerEvents::ConnectionEvent::trigger(data);
+            break;
+        }
 
-            case ENET_EVENT_TYPE_RECEIVE:
-                // Deserialize and trigger packet event
-                PacketRegistry::handleServerPacket(event.peer, event.packet);
-                enet_packet_destroy(event.packet);
-                break;
+        case ENET_EVENT_TYPE_RECEIVE:
+            // Deserialize and trigger packet event
+            PacketRegistry::handleServerPacket(event.peer, event.packet);
+            enet_packet_destroy(event.packet);
+            break;
 
-            case ENET_EVENT_TYPE_DISCONNECT: {
-                if (peer_info.has_value()) {
-					INFO("Client disconnected: " + peer_info->data.username + 
-                        " (ID " + std::to_string(peer_info->data.server_side_id) + ")");
-                }
-                else {
-					INFO("An unknown client disconnected");
-                }
-                
-                // Trigger event
-                ServerEvents::DisconnectEventData data(event);
-                ServerEvents::DisconnectEvent::trigger(data);
-                
-                // Remove from pending connections if applicable
+        case ENET_EVENT_TYPE_DISCONNECT: {
+            if (peer_info.has_value()) {
+				INFO("Client disconnected: " + peer_info->data.username + 
+                    " (ID " + std::to_string(peer_info->data.server_side_id) + ")");
+            }
+            else {
+				INFO("An unknown client disconnected");
+            }
+            
+            // Trigger event
+            ServerEvents::DisconnectEventData data(event);
+            ServerEvents::DisconnectEvent::trigger(data);
+            
+            // Remove from pending connections if applicable
+            {
+                std::lock_guard<std::mutex> lock(connection_mutex);
                 pending_connections.erase(event.peer);
-                
-                // Remove from peerlist if applicable
-                peers.remove_peer(event.peer);
-
-				// Broadcast ServerDataUpdate to all remaining peers
-				auto update_packet = ServerDataUpdatePacket(get_peers_map(), server_info);
-				broadcast_packet(update_packet);
-                break;
             }
+            
+            // Remove from peerlist if applicable, before dropping its batch so no sender can open another
+            // for the dead ENetPeer, which ENet hands to the next connection
+            peers.remove_peer(event.peer);
+            batcher.drop(event.peer);
+
+			// Broadcast ServerDataUpdate to all remaining peers
+			auto update_packet = ServerDataUpdatePacket(get_peers_map(), server_info);
+			broadcast_packet(update_packet);
+            break;
+        }
 
-            case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT: {
-                if (peer_info.has_value()) {
-                    INFO("Client disconnected due to timeout: " + peer_info->data.username + 
-                        " (ID " + std::to_string(peer_info->data.server_side_id) + ")");
-                }
-                else {
-                    INFO("An unknown client disconnected due to timeout");
-                }
-                
-                // Trigger event
-                ServerEvents::DisconnectTimeoutEventData data(event);
-                ServerEvents::DisconnectTimeoutEvent::trigger(data);
-                
-                // Remove from pending connections if applicable
+        case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT: {
+            if (peer_info.has_value()) {
+                INFO("Client disconnected due to timeout: " + peer_info->data.username + 
+                    " (ID " + std::to_string(peer_info->data.server_side_id) + ")");
+            }
+            else {
+                INFO("An unknown client disconnected due to timeout");
+            }
+            
+            // Trigger event
+            ServerEvents::DisconnectTimeoutEventData data(event);
+            ServerEvents::DisconnectTimeoutEvent::trigger(data);
+            
+            // Remove from pending connections if applicable
+            {
+                std::lock_guard<std::mutex> lock(connection_mutex);
                 pending_connections.erase(event.peer);
-                
-                // Remove from peerlist if applicable
-                peers.remove_peer(event.peer);
-
-                // Broadcast ServerDataUpdate to all remaining peers
-                auto update_packet = ServerDataUpdatePacket(get_peers_map(), server_info);
-                broadcast_packet(update_packet);
-                break;
             }
-
-            default:
-                break;
+            
+            // Remove from peerlist if applicable, before dropping its batch so no sender can open another
+            // for the dead ENetPeer, which ENet hands to the next connection
+            peers.remove_peer(event.peer);
+            batcher.drop(event.peer);
+
+            // Broadcast ServerDataUpdate to all remaining peers
+            auto update_packet = ServerDataUpdatePacket(get_peers_map(), server_info);
+            broadcast_packet(update_packet);
+            break;
         }
+
+        default:
+            break;
     }
 }
 
@@ -349,6 +543,9 @@ void Server::update() {
  */
 void Server::handle_connection_initiation(ENetPeer* peer, const std::string& requested_username) {
     INFO("Received ConnectionInitiation from peer, requested username: " + requested_username);
+
+    // Peers on other shards may be joining at the same time, they must not get the same ID or username
+    std::lock_guard<std::mutex> lock(connection_mutex);
     
     // Check if this peer is in pending connections
     auto pending_it = pending_connections.find(peer);
@@ -365,7 +562,7 @@ void Server::handle_connection_initiation(ENetPeer* peer, const std::string& req
         INFO("Rejecting connection: server is full or not accepting new connections");
         auto refusal_packet = ConnectionRefusalPacket("Server is full or not accepting new connections");
         send_packet_to_peer(refusal_packet, peer);
-        enet_peer_disconnect_later(peer, 0);
+        owner_of(peer).queue_disconnect(peer, DisconnectMode::LATER); // After the refusal has been sent
         return;
     }
     
@@ -415,6 +612,7 @@ void Server::check_pending_connection_timeouts() {
     auto now = std::chrono::steady_clock::now();
     
     std::vector<ENetPeer*> timed_out_peers;
+    std::lock_guard<std::mutex> lock(connection_mutex);
     
     for (const auto& [peer, pending] : pending_connections) {
         if (now - pending.connect_time > PENDING_CONNECTION_TIMEOUT) {
@@ -425,8 +623,46 @@ void Server::check_pending_connection_timeouts() {
     for (ENetPeer* peer : timed_out_peers) {
         WARNING("Pending connection timed out - no ConnectionInitiation received within 60 seconds");
         pending_connections.erase(peer);
-        enet_peer_disconnect_now(peer, 0);
+        owner_of(peer).queue_disconnect(peer, DisconnectMode::NOW); // The peer may be on a shard's host
+    }
+}
+
+/**
+ * @brief Lists the recipients of a broadcast.
+ * @param room_id Optional room to limit the recipients to.
+ * @return Every peer, or the peers in room_id if one is given.
+ */
+std::vector<PeerEntry> Server::get_recipients(const std::optional<RoomId>& room_id) const {
+    return room_id.has_value() ? peers.get_room_peers(room_id.value()) : peers.get_all_peers();
+}
+
+/**
+ * @brief Finds the networking loop that owns a peer: the server itself, or the shard whose host the peer connected to.
+ * Only that loop's thread may touch the peer, so every send and disconnect goes through it.
+ * @param peer The peer.
+ * @return The server or the peer's shard.
+ */
+NetworkUser& Server::owner_of(ENetPeer* peer) {
+    for (auto& shard : shards) {
+        if (peer->host == shard->host) {
+            return *shard;
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Queues an ENetPacket for a peer on the networking loop that owns the peer.
+ * @param packet The packet. Owned by the queue from here on, destroyed if the call fails.
+ * @param peer The peer to send it to.
+ * @param channel The channel to send on.
+ * @return true if the packet was queued, false otherwise.
+ */
+bool Server::send_enet_packet(ENetPacket* packet, ENetPeer* peer, uint8_t channel) {
+    if (peer == nullptr) {
+        return NetworkUser::send_packet(packet, peer, channel); // Reports and frees it
     }
+    return owner_of(peer).send_packet(packet, peer, channel);
 }
 
 /**
@@ -3,9 +3,13 @@
 #include "Networking/Packet/Packet.h"
 #include "Networking/NetworkUser.h"
 #include "Networking/Server/ServerPeerlist.h"
+#include "Networking/Server/PacketBatcher.h"
+#include "Networking/Server/ServerShard.h"
 #include <future>
 #include <optional>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include "OpenServer.h"
 #include "Game/Events/EventList.h"
 
@@ -31,7 +35,15 @@ public:
 
 	bool send_packet(Packet& packet, uint16_t peer_id);
 	bool send_packet_to_peer(Packet& packet, ENetPeer* peer); // Send to ENetPeer directly (for pending connections)
-	bool broadcast_packet(Packet& packet, const std::optional<uint16_t>& exclude_peer_id = std::nullopt);
+	// Broadcasts reach every peer, or only the peers in room_id if one is given
+	bool broadcast_packet(Packet& packet, const std::optional<uint16_t>& exclude_peer_id = std::nullopt,
+		const std::optional<RoomId>& room_id = std::nullopt);
+
+	// Batched sending: queued packets are coalesced per peer and sent by flush_batches() (once per tick)
+	bool queue_packet(Packet& packet, uint16_t peer_id);
+	bool queue_broadcast(Packet& packet, const std::optional<uint16_t>& exclude_peer_id = std::nullopt,
+		const std::optional<RoomId>& room_id = std::nullopt);
+	bool flush_batches(const std::optional<RoomId>& room_id = std::nullopt);
 
 	void start(); // Start the server networking loop
 	std::future<void> stop();  // Stop the server networking loop
@@ -43,16 +55,25 @@ public:
 	// Misc packet handlers
 	void handle_general_information_update(ENetPeer* peer, const GeneralInformationUpdatePacket& packet);
 private:
+	friend class ServerShard;
+
 	// Pending connections awaiting ConnectionInitiation packet
 	std::unordered_map<ENetPeer*, PendingConnection> pending_connections;
 	uint16_t next_peer_id = 1; // Counter for assigning unique peer IDs
+	std::mutex connection_mutex; // Guards pending_connections and next_peer_id, peers join and leave on every shard's thread
+	PacketBatcher batcher; // Per-peer batches of queued packets
+	std::vector<std::unique_ptr<ServerShard>> shards; // Hosts sharing host's port, each on its own thread (see SERVER_SHARDS)
 
 	// Event callback IDs for cleanup
 	int on_connection_initiation_callback = -1;
 	int on_general_information_update_callback = -1;
 
 	// Helper methods
+	void handle_event(ENetEvent& event); // Handle an event of host or of a shard's host, on that host's thread
+	NetworkUser& owner_of(ENetPeer* peer); // This server or the shard whose host the peer is connected to
+	bool send_enet_packet(ENetPacket* packet, ENetPeer* peer, uint8_t channel); // Queue a send on the peer's own host
 	void check_pending_connection_timeouts();
+	std::vector<PeerEntry> get_recipients(const std::optional<RoomId>& room_id) const; // Every peer, or the peers in room_id
 	std::string get_unique_username(const std::string& requested_username);
 	bool can_accept_new_connection() const;
 	std::unordered_map<uint16_t, UserData> get_peers_map() const;
@@ -6,6 +6,7 @@
  * @brief Clears the peerlist, removing all peers.
  */
 void ServerPeerlist::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
     peers.clear();
 }
 
@@ -15,6 +16,7 @@ void ServerPeerlist::clear() {
  * @param user The UserData of the peer.
  */
 void ServerPeerlist::add_peer(ENetPeer* peer, UserData user) {
+    std::lock_guard<std::mutex> lock(mutex);
     peers[user.server_side_id] = {peer, user};
 }
 
@@ -23,6 +25,7 @@ void ServerPeerlist::add_peer(ENetPeer* peer, UserData user) {
  * @param peer The ENetPeer to remove.
  */ 
 void ServerPeerlist::remove_peer(ENetPeer* peer) {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = std::find_if(peers.begin(), peers.end(), [&](const auto& pair) {
         return pair.second.peer == peer;
     });
@@ -36,6 +39,7 @@ void ServerPeerlist::remove_peer(ENetPeer* peer) {
  * @param server_side_id The server-side ID of the peer to remove.
  */
 void ServerPeerlist::remove_peer(uint32_t server_side_id) {
+    std::lock_guard<std::mutex> lock(mutex);
     peers.erase(server_side_id);
 }
 
@@ -44,6 +48,7 @@ void ServerPeerlist::remove_peer(uint32_t server_side_id) {
  * @param username The username of the peer to remove.
  */
 void ServerPeerlist::remove_peer(const std::string& username) {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = std::find_if(peers.begin(), peers.end(), [&](const auto& pair) {
         return pair.second.data.username == username;
     });
@@ -57,18 +62,33 @@ void ServerPeerlist::remove_peer(const std::string& username) {
  * @param user The updated UserData of the peer.
  */
 void ServerPeerlist::update_peer(const UserData& user) {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = peers.find(user.server_side_id);
     if (it != peers.end()) {
         it->second.data = user;
     }
 }
 
+/**
+ * @brief Moves a peer to a room. Packets scoped to a room only reach the peers in it.
+ * @param server_side_id The server-side ID of the peer.
+ * @param room_id The room to move the peer to.
+ */
+void ServerPeerlist::set_room(uint32_t server_side_id, RoomId room_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = peers.find(server_side_id);
+    if (it != peers.end()) {
+        it->second.room_id = room_id;
+    }
+}
+
 /**
  * @brief Gets a pointer to a peer's PeerEntry by ENetPeer.
  * @param peer The ENetPeer to find.
  * @return A pointer to the PeerEntry, or nullptr if not found.
  */
 PeerEntry* ServerPeerlist::get_peer_data(ENetPeer* peer) {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = std::find_if(peers.begin(), peers.end(), [&](const auto& pair) {
         return pair.second.peer == peer;
     });
@@ -83,6 +103,7 @@ PeerEntry* ServerPeerlist::get_peer_data(ENetPeer* peer) {
  * @return A vector containing all PeerEntry in the peerlist.
  */
 std::vector<PeerEntry> ServerPeerlist::get_all_peers() const {
+    std::lock_guard<std::mutex> lock(mutex);
     std::vector<PeerEntry> all_peers;
     for (const auto& pair : peers) {
         all_peers.push_back(pair.second);
@@ -90,12 +111,29 @@ std::vector<PeerEntry> ServerPeerlist::get_all_peers() const {
     return all_peers;
 }
 
+/**
+ * @brief Gets a list of the peers in a room.
+ * @param room_id The room to list.
+ * @return A vector containing the PeerEntry of every peer in the room.
+ */
+std::vector<PeerEntry> ServerPeerlist::get_room_peers(RoomId room_id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<PeerEntry> room_peers;
+    for (const auto& pair : peers) {
+        if (pair.second.room_id == room_id) {
+            room_peers.push_back(pair.second);
+        }
+    }
+    return room_peers;
+}
+
 /**
  * @brief Gets a peer by server-side ID.
  * @param server_side_id The server-side ID of the peer.
  * @return An optional containing the PeerEntry if found, or empty otherwise.
  */
 std::optional<PeerEntry> ServerPeerlist::get_peer_by_id(uint32_t server_side_id) const {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = peers.find(server_side_id);
     if (it != peers.end()) {
         return it->second;
@@ -109,6 +147,7 @@ std::optional<PeerEntry> ServerPeerlist::get_peer_by_id(uint32_t server_side_id)
  * @return An optional containing the PeerEntry if found, or empty otherwise.
  */
 std::optional<PeerEntry> ServerPeerlist::get_peer_by_username(const std::string& username) const {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = std::find_if(peers.begin(), peers.end(), [&](const auto& pair) {
         return pair.second.data.username == username;
     });
@@ -125,6 +164,7 @@ std::optional<PeerEntry> ServerPeerlist::get_peer_by_username(const std::string&
  * @return An optional containing the PeerEntry if found, or empty otherwise.
  */
 std::optional<PeerEntry> ServerPeerlist::get_peer_by_enet(ENetPeer* peer) const {
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = std::find_if(peers.begin(), peers.end(), [&](const auto& pair) {
         return pair.second.peer == peer;
     });
@@ -1,10 +1,16 @@
 #pragma once
 #include "Imports/common.h"
 #include "Networking/User/UserData.h"
+#include <mutex>
+#include <optional>
+
+using RoomId = uint32_t; // Identifies a game room on the server
+constexpr RoomId DEFAULT_ROOM = 0; // Room every peer joins in (the lobby, or the only game when hosting from the client)
 
 struct PeerEntry {
     ENetPeer* peer;
     UserData data;
+    RoomId room_id = DEFAULT_ROOM; // Room the peer plays in, server-side only
 };
 
 class ServerPeerlist {
@@ -20,9 +26,11 @@ public:
     void remove_peer(const std::string& username); // Remove a peer from the peerlist by username
 
     void update_peer(const UserData& user); // Update a peer's data in the peerlist
-    PeerEntry* get_peer_data(ENetPeer* peer); // Get a pointer to a peer's UserData by ENetPeer
+    void set_room(uint32_t server_side_id, RoomId room_id); // Move a peer to a room
+    PeerEntry* get_peer_data(ENetPeer* peer); // Get a pointer to a peer's UserData by ENetPeer (unguarded once returned)
 
     std::vector<PeerEntry> get_all_peers() const; // Get a list of all peers
+    std::vector<PeerEntry> get_room_peers(RoomId room_id) const; // Get a list of the peers in a room
 
     std::optional<PeerEntry> get_peer_by_id(uint32_t server_side_id) const; // Get a peer by server-side ID
     std::optional<PeerEntry> get_peer_by_username(const std::string& username) const; // Get a peer by username
@@ -30,4 +38,5 @@ public:
 private:
     std::unordered_map<uint32_t, PeerEntry> peers; 
     // Map of server-side ID to PeerEntry (containing ENetPeer* and UserData)
+    mutable std::mutex mutex; // Every shard's networking thread and the game thread use the list
 };
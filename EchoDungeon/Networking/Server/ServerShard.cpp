@@ -0,0 +1,41 @@
+#include "ServerShard.h"
+#include "Server.h"
+
+/**
+ * @brief Constructs a shard servicing an already bound host.
+ * @param server The server to hand the host's events to.
+ * @param index The shard's index, 1 and up (0 is the server's own host).
+ * @param host The host, created with enet_host_create_shared(). Destroyed with the shard.
+ */
+ServerShard::ServerShard(Server& server, size_t index, ENetHost* host) : NetworkUser(), server(server) {
+    this->host = host;
+    shard_index = index;
+    shared_port = true;
+}
+
+/**
+ * @brief Destructor for ServerShard, stops the networking loop and destroys the host.
+ */
+ServerShard::~ServerShard() {
+    if (is_running.load()) {
+        stop();
+    }
+
+    if (host) {
+        enet_host_destroy(host);
+        host = nullptr;
+    }
+}
+
+/**
+ * @brief Executes a single update cycle for the shard, handing every event of its host to the server.
+ */
+void ServerShard::update() {
+    ENetEvent event;
+    while (enet_host_service(host, &event, 0) > 0) {
+        if (event.type == ENET_EVENT_TYPE_DISCONNECT || event.type == ENET_EVENT_TYPE_DISCONNECT_TIMEOUT) {
+            forget_peer(event.peer);
+        }
+        server.handle_event(event);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/NetworkUser.h"
+
+class Server;
+
+/**
+ * @brief One of the extra ENet hosts a sharded server binds to its port, see SERVER_SHARDS.
+ *
+ * Each shard services its own host on its own networking thread, and hands every event to the
+ * Server, which handles them exactly like those of its own host. A peer belongs to the host the
+ * kernel delivered its connection to, so its packets are decoded, and its sends carried out, by
+ * that shard's thread only (see Server::owner_of()).
+ */
+class ServerShard : public NetworkUser {
+public:
+    ServerShard(Server& server, size_t index, ENetHost* host); // Takes ownership of host
+    ~ServerShard();
+
+protected:
+    void update() override; // Service the shard's host, passing its events to the server
+
+private:
+    Server& server; // Server the shard's peers are connected to
+};
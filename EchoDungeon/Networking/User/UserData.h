@@ -2,6 +2,7 @@
 #include "Imports/common.h"
 #include <cereal/archives/binary.hpp>
 #include <cereal/types/string.hpp>
+#include "Networking/Packet/BitPacketArchive.h"
 #include <sstream>
 
 enum class UserStatus : uint8_t {
@@ -22,6 +23,7 @@ std::string username = "Unknown"; // Username of the user
 
 	template<class Archive>
 	void serialize(Archive& archive) {
-		archive(server_side_id, username, is_host, ip_address, connected_at, last_packet_time, status, current_state);
+		archive(server_side_id, username, is_host, ip_address, connected_at, last_packet_time,
+			make_ranged(status, UserStatus::DISCONNECTED, UserStatus::CONNECTED), current_state);
 	}
 };
\ No newline at end of file
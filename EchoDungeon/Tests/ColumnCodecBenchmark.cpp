@@ -0,0 +1,192 @@
+#include "Imports/common.h"
+#include "Networking/Packet/Instances/Enemy/EnemyUpdate.h"
+#include "Networking/Packet/PacketArchive.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Times encoding and decoding EnemyUpdate lists of 1k to 10k enemies in the column layout,
+ * next to the same rows written one row at a time (id, fields, QuantizedTransform, health), and
+ * counts the allocations each encode and decode makes once the scratch columns have grown.
+ * A third layout writes the rows with the full ObjectTransform through the fixed width
+ * PacketOutputArchive, the way updates were sent before the codec, so the bytes per enemy
+ * show what the quantized columns save over it.
+ *
+ * Two update shapes: every field of every enemy (a full update), and a delta where only every
+ * other enemy moved.
+ *
+ * Usage: ColumnCodecBenchmark [rounds]
+ */
+
+namespace {
+	std::atomic<bool> counting{ false }; // Only count while timing
+	std::atomic<size_t> allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+	if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	using namespace TestSupport;
+
+	// The same rows in the layout the lists had before columns, one row after another
+	struct RowLayout {
+		std::vector<EnemyUpdateData>& rows;
+
+		template<class Archive>
+		void save(Archive& archive) const {
+			archive(cereal::make_size_tag(static_cast<cereal::size_type>(rows.size())));
+			for (EnemyUpdateData& row : rows) {
+				archive(row.id, make_ranged(row.fields, uint8_t(0), EnemyUpdateData::ALL_FIELDS));
+				if (row.fields & EnemyUpdateData::FIELD_TRANSFORM) archive(QuantizedTransform(row.transform));
+				if (row.fields & EnemyUpdateData::FIELD_HEALTH) archive(row.health);
+			}
+		}
+
+		template<class Archive>
+		void load(Archive& archive) {
+			cereal::size_type count = 0;
+			archive(cereal::make_size_tag(count));
+			rows.resize(static_cast<size_t>(count));
+			for (EnemyUpdateData& row : rows) {
+				archive(row.id, make_ranged(row.fields, uint8_t(0), EnemyUpdateData::ALL_FIELDS));
+				if (row.fields & EnemyUpdateData::FIELD_TRANSFORM) archive(QuantizedTransform(row.transform));
+				if (row.fields & EnemyUpdateData::FIELD_HEALTH) archive(row.health);
+			}
+		}
+	};
+
+	// The same rows with the full ObjectTransform, 38 bytes of floats and flags, instead of QuantizedTransform
+	struct FullTransformRows {
+		std::vector<EnemyUpdateData>& rows;
+
+		template<class Archive>
+		void save(Archive& archive) const {
+			archive(cereal::make_size_tag(static_cast<cereal::size_type>(rows.size())));
+			for (EnemyUpdateData& row : rows) {
+				archive(row.id, make_ranged(row.fields, uint8_t(0), EnemyUpdateData::ALL_FIELDS));
+				if (row.fields & EnemyUpdateData::FIELD_TRANSFORM) archive(row.transform);
+				if (row.fields & EnemyUpdateData::FIELD_HEALTH) archive(row.health);
+			}
+		}
+
+		template<class Archive>
+		void load(Archive& archive) {
+			cereal::size_type count = 0;
+			archive(cereal::make_size_tag(count));
+			rows.resize(static_cast<size_t>(count));
+			for (EnemyUpdateData& row : rows) {
+				archive(row.id, make_ranged(row.fields, uint8_t(0), EnemyUpdateData::ALL_FIELDS));
+				if (row.fields & EnemyUpdateData::FIELD_TRANSFORM) archive(row.transform);
+				if (row.fields & EnemyUpdateData::FIELD_HEALTH) archive(row.health);
+			}
+		}
+	};
+
+	struct Result {
+		double encode_ns = 0.0; // Per enemy
+		double decode_ns = 0.0; // Per enemy
+		double bytes = 0.0; // Per enemy
+		double encode_allocations = 0.0; // Per encode
+		double decode_allocations = 0.0; // Per decode
+	};
+
+	std::vector<EnemyUpdateData> make_rows(size_t count, bool delta) {
+		std::mt19937 random(static_cast<uint32_t>(count));
+		std::uniform_real_distribution<float> coordinate(-25.0f, 25.0f);
+		std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+		std::vector<EnemyUpdateData> rows(count);
+		for (size_t i = 0; i < count; i++) {
+			EnemyUpdateData& row = rows[i];
+			row.id = static_cast<uint32_t>(i * 3 + 1); // Sorted, with gaps like despawned enemies leave
+			row.fields = delta ? (i % 2 == 0 ? EnemyUpdateData::FIELD_TRANSFORM : EnemyUpdateData::FIELD_HEALTH)
+				: EnemyUpdateData::ALL_FIELDS;
+			row.transform.set_position({ coordinate(random), 0.5f, coordinate(random) });
+			row.transform.set_rotation({ 0.0f, angle(random), 0.0f });
+			row.health = static_cast<float>(i % 100);
+		}
+		return rows;
+	}
+
+	// Encodes into one reused buffer and decodes into one reused list, like the send and receive paths
+	template<class Layout, class OutputArchive = BitPacketOutputArchive, class InputArchive = BitPacketInputArchive>
+	Result run(std::vector<EnemyUpdateData>& rows, size_t rounds) {
+		PacketBuffer buffer;
+		std::vector<EnemyUpdateData> decoded;
+		Result result;
+
+		auto encode = [&]() {
+			buffer.clear();
+			OutputArchive archive(buffer);
+			archive(Layout{ rows });
+			archive.flush();
+		};
+		auto decode = [&]() {
+			InputArchive archive(buffer.data(), buffer.size());
+			Layout layout{ decoded };
+			archive(layout);
+		};
+
+		encode(); // Warm up, growing the buffer and scratch columns
+		decode();
+
+		allocations.store(0);
+		counting.store(true);
+		auto start = Clock::now();
+		for (size_t i = 0; i < rounds; i++) encode();
+		result.encode_ns = elapsed_ns(start) / (rounds * rows.size());
+		counting.store(false);
+		result.encode_allocations = static_cast<double>(allocations.load()) / rounds;
+
+		allocations.store(0);
+		counting.store(true);
+		start = Clock::now();
+		for (size_t i = 0; i < rounds; i++) decode();
+		result.decode_ns = elapsed_ns(start) / (rounds * rows.size());
+		counting.store(false);
+		result.decode_allocations = static_cast<double>(allocations.load()) / rounds;
+
+		result.bytes = static_cast<double>(buffer.size()) / rows.size();
+		return result;
+	}
+
+	void print(const char* layout, const Result& result) {
+		std::printf("  %-10s encode %7.1f ns, decode %7.1f ns, %5.2f bytes per enemy, %.1f / %.1f allocations per encode / decode\n",
+			layout, result.encode_ns, result.decode_ns, result.bytes, result.encode_allocations, result.decode_allocations);
+	}
+}
+
+int main(int argc, char** argv) {
+	long requested = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	size_t rounds = requested > 0 ? static_cast<size_t>(requested) : 200;
+
+	for (bool delta : { false, true }) {
+		for (size_t count : { 1000, 2500, 5000, 10000 }) {
+			std::vector<EnemyUpdateData> rows = make_rows(count, delta);
+			std::printf("%zu enemies, %s, %zu rounds\n", count, delta ? "half moved, half damaged" : "every field", rounds);
+			print("columns", run<ColumnCodec::Columns<EnemyUpdateData>>(rows, rounds));
+			print("rows", run<RowLayout>(rows, rounds));
+			print("full rows", run<FullTransformRows, PacketOutputArchive, PacketInputArchive>(rows, rounds));
+		}
+	}
+	return 0;
+}
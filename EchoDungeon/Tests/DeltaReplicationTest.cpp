@@ -0,0 +1,148 @@
+#include "Imports/common.h"
+#include "Game/World/Systems/DeltaReplication.h"
+#include "Networking/Packet/Instances/Enemy/EnemyUpdate.h"
+#include "TestCheck.h"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checks that snapshots decoded from deltas match the server's state over many ticks of
+ * spawns, deaths, movement and damage, with clients acknowledging late, that building or
+ * decoding a snapshot never changes the one it started from, and that a decoded snapshot shares
+ * every shard its delta did not touch with its baseline.
+ */
+
+namespace {
+	using Replication = DeltaReplication<EnemyUpdateData>;
+	using Snapshot = EntitySnapshot<EnemyUpdateData>;
+	using Table = EntityTable<EnemyUpdateData>;
+
+	EnemyUpdateData make_enemy(uint32_t id, float x, float health) {
+		EnemyUpdateData enemy;
+		enemy.id = id;
+		enemy.transform.set_position({ x, 0.5f, 0.0f });
+		enemy.health = health;
+		return enemy;
+	}
+
+	// Plain copy of a table's contents, to compare against after the table was shared
+	std::map<uint32_t, EnemyUpdateData> contents(const Table& table) {
+		std::map<uint32_t, EnemyUpdateData> copy;
+		for (const auto& [id, state] : table) copy.emplace(id, state);
+		return copy;
+	}
+
+	bool same(const std::map<uint32_t, EnemyUpdateData>& expected, const Table& table) {
+		if (expected.size() != table.size()) return false;
+		for (const auto& [id, state] : expected) {
+			const EnemyUpdateData* found = table.find(id);
+			if (!found || found->changed_fields(state) != 0) return false;
+		}
+		return true;
+	}
+
+	// The server's side of a replication tick: the previous snapshot with what changed written over it
+	std::shared_ptr<Snapshot> take_snapshot(const Snapshot* previous, uint32_t sequence, const std::map<uint32_t, EnemyUpdateData>& world) {
+		auto snapshot = std::make_shared<Snapshot>();
+		snapshot->sequence = sequence;
+		if (previous) snapshot->entities = previous->entities;
+		for (const auto& [id, state] : world) snapshot->entities.update(state);
+		snapshot->entities.erase_if([&](uint32_t id, const EnemyUpdateData&) { return world.find(id) == world.end(); });
+		return snapshot;
+	}
+
+	void test_random_ticks() {
+		std::mt19937 random(7);
+		std::map<uint32_t, EnemyUpdateData> world;
+		uint32_t next_id = 1;
+		for (int i = 0; i < 300; i++, next_id++) world[next_id] = make_enemy(next_id, static_cast<float>(i), 100.0f);
+
+		SnapshotHistory<EnemyUpdateData> server_history;
+		SnapshotHistory<EnemyUpdateData> client_history;
+		std::shared_ptr<const Snapshot> acked; // Client's newest snapshot the server has heard about
+
+		for (uint32_t sequence = 1; sequence <= 300; sequence++) {
+			// A few enemies move, take damage, die or spawn, most stand still
+			for (auto& [id, enemy] : world) {
+				int roll = static_cast<int>(random() % 100);
+				if (roll < 5) enemy.transform.set_position({ static_cast<float>(random() % 1000), 0.5f, 1.0f });
+				else if (roll < 7) enemy.health -= 1.0f;
+			}
+			if (random() % 4 == 0 && !world.empty()) world.erase(std::next(world.begin(), random() % world.size()));
+			if (random() % 4 == 0) {
+				world[next_id] = make_enemy(next_id, 0.0f, 100.0f);
+				next_id++;
+			}
+
+			auto previous = server_history.latest();
+			auto before = previous ? contents(previous->entities) : std::map<uint32_t, EnemyUpdateData>();
+			auto current = take_snapshot(previous.get(), sequence, world);
+			server_history.push(current);
+			CHECK_MESSAGE(!previous || same(before, previous->entities), "snapshot " + std::to_string(sequence) + " changed the previous one");
+			CHECK_MESSAGE(same(world, current->entities), "server snapshot " + std::to_string(sequence));
+
+			// Encode against the acknowledged baseline, as its client knows it
+			std::vector<EnemyUpdateData> updates;
+			std::vector<uint32_t> removed;
+			auto server_baseline = acked ? server_history.find(acked->sequence) : nullptr;
+			Replication::encode(server_baseline.get(), *current, updates, removed);
+
+			auto client_baseline = acked ? client_history.find(acked->sequence) : nullptr;
+			auto baseline_before = client_baseline ? contents(client_baseline->entities) : std::map<uint32_t, EnemyUpdateData>();
+			auto decoded = Replication::decode(client_baseline.get(), sequence, updates, removed);
+			client_history.push(decoded);
+
+			CHECK_MESSAGE(same(world, decoded->entities), "decoded snapshot " + std::to_string(sequence));
+			CHECK_MESSAGE(!client_baseline || same(baseline_before, client_baseline->entities),
+				"decoding " + std::to_string(sequence) + " changed its baseline");
+
+			// Acks arrive one to three ticks late
+			if (random() % 3 == 0) acked = client_history.find(sequence - (std::min)(sequence - 1, static_cast<uint32_t>(random() % 3)));
+		}
+	}
+
+	void test_untouched_shards_shared() {
+		Snapshot baseline;
+		baseline.sequence = 1;
+		for (uint32_t id = 1; id <= 500; id++) baseline.entities[id] = make_enemy(id, static_cast<float>(id), 100.0f);
+
+		// Touch one shard: move an enemy in it, remove another and spawn a third there
+		uint32_t moved = 3;
+		uint32_t gone = moved + Table::SHARD_COUNT;
+		uint32_t spawned = 1000 - (1000 % Table::SHARD_COUNT) + moved;
+		std::vector<EnemyUpdateData> updates = { make_enemy(moved, -1.0f, 100.0f), make_enemy(spawned, 0.0f, 100.0f) };
+		updates[0].fields = EnemyUpdateData::FIELD_TRANSFORM;
+		std::vector<uint32_t> removed = { gone };
+
+		auto decoded = Replication::decode(&baseline, 2, updates, removed);
+		for (size_t index = 0; index < Table::SHARD_COUNT; index++) {
+			bool touched = index == Table::shard_of(moved);
+			CHECK_MESSAGE(decoded->entities.shares_shard(baseline.entities, index) != touched, "shard " + std::to_string(index));
+		}
+		CHECK(decoded->entities.size() == 500);
+		CHECK(decoded->entities.find(gone) == nullptr);
+		CHECK(decoded->entities.find(spawned) != nullptr);
+		CHECK(baseline.entities.find(gone) != nullptr);
+		CHECK(baseline.entities.find(moved)->transform.get_position().x == static_cast<float>(moved));
+
+		// Only what changed is visited, and nothing is sent for shards still shared
+		std::vector<uint32_t> visited;
+		Replication::for_each_changed(&baseline, *decoded, [&](const EnemyUpdateData& state) { visited.push_back(state.id); });
+		CHECK(visited.size() == 2);
+
+		std::vector<EnemyUpdateData> resent;
+		std::vector<uint32_t> resent_removed;
+		Replication::encode(decoded.get(), *decoded, resent, resent_removed);
+		CHECK(resent.empty());
+		CHECK(resent_removed.empty());
+	}
+}
+
+int main() {
+	Logger::init();
+	test_random_ticks();
+	test_untouched_shards_shared();
+	return TestCheck::result();
+}
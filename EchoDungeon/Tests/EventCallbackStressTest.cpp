@@ -0,0 +1,185 @@
+#include "Imports/common.h"
+#include "Game/Events/Event.h"
+#include "TestCheck.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Registers and unregisters callbacks on several threads while others trigger the event,
+ * and checks the guarantees Event gives: a trigger that starts after register_callback returned
+ * calls the callback, and once unregister_callback returned the callback is never called again.
+ * Each round destroys its callback's state as soon as unregister_callback returns, like
+ * World::on_deactivate does with the managers its callbacks use, so a late call would touch freed memory.
+ * Runs once with INLINE dispatch and once with POOL dispatch, where calls queued before the
+ * unregister must be dropped.
+ */
+
+namespace {
+	constexpr size_t TRIGGER_THREADS = 3;
+	constexpr size_t CHURN_THREADS = 3;
+	constexpr size_t TRIGGERS_PER_THREAD = 20000;
+	constexpr size_t CHURN_ROUNDS = 2000;
+	constexpr size_t TRIGGERS_PER_ROUND = 4; // Churn threads trigger too, to check their own callback is live
+	constexpr size_t STABLE_CALLBACKS = 4; // Registered for the whole test, so must see every trigger
+	constexpr size_t MAX_BACKLOG = 1000; // Triggers whose pooled calls may be queued at once, so churn rounds are not stuck behind them
+	constexpr auto WAIT_LIMIT = std::chrono::seconds(10); // For POOL calls to run, a hang fails instead of blocking ctest
+
+	class StressEventData : public BaseEventData {
+	public:
+		size_t source; // Thread that triggered
+	};
+
+	using StressEvent = Event<StressEventData>;
+
+	// One churn round's callback state, deleted as soon as the round's unregister_callback returns
+	struct ChurnState {
+		std::atomic<size_t> own_calls{ 0 }; // Calls from this churn thread's own triggers
+	};
+
+	std::atomic<size_t> stable_calls[STABLE_CALLBACKS];
+	std::atomic<size_t> total_triggers{ 0 };
+	std::atomic<size_t> late_calls{ 0 }; // Calls to a callback after its unregister_callback returned
+	std::atomic<bool> churn_done{ false };
+
+	template <typename Predicate>
+	bool wait_until(Predicate done) {
+		auto deadline = std::chrono::steady_clock::now() + WAIT_LIMIT;
+		while (!done()) {
+			if (std::chrono::steady_clock::now() > deadline) return false;
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	void trigger_from(size_t source) {
+		StressEventData data;
+		data.source = source;
+		StressEvent::trigger(data);
+		total_triggers.fetch_add(1);
+	}
+
+	void trigger_loop(size_t source) {
+		for (size_t i = 0; i < TRIGGERS_PER_THREAD || !churn_done.load(); i++) {
+			while (stable_calls[0].load() + MAX_BACKLOG < total_triggers.load()) std::this_thread::yield();
+			trigger_from(source);
+		}
+	}
+
+	void churn_loop(size_t source, std::vector<std::atomic<bool>>& retired, size_t& lost, size_t& stale) {
+		for (size_t round = 0; round < CHURN_ROUNDS; round++) {
+			ChurnState* state = new ChurnState();
+			std::atomic<bool>* round_retired = &retired[round];
+
+			StressEvent::CallbackID id = StressEvent::register_callback([state, round_retired, source](const StressEventData& data) {
+				if (round_retired->load()) {
+					late_calls.fetch_add(1); // state is already deleted
+					return;
+				}
+				if (data.source == source) state->own_calls.fetch_add(1);
+			});
+
+			for (size_t i = 0; i < TRIGGERS_PER_ROUND; i++) {
+				trigger_from(source);
+			}
+			if (!wait_until([state]() { return state->own_calls.load() >= TRIGGERS_PER_ROUND; })) lost++;
+
+			StressEvent::unregister_callback(id);
+			round_retired->store(true);
+			delete state;
+			if (StressEvent::is_callback_registered(id)) stale++;
+
+			trigger_from(source); // Must not reach the deleted state
+		}
+	}
+
+	void test_concurrent_register_and_trigger(DispatchPolicy policy) {
+		StressEvent::set_dispatch_policy(policy);
+		total_triggers.store(0);
+		late_calls.store(0);
+		churn_done.store(false);
+		for (std::atomic<size_t>& calls : stable_calls) calls.store(0);
+
+		std::vector<StressEvent::CallbackID> stable_ids;
+		for (size_t i = 0; i < STABLE_CALLBACKS; i++) {
+			stable_ids.push_back(StressEvent::register_callback([i](const StressEventData&) { stable_calls[i].fetch_add(1); }));
+		}
+
+		std::vector<std::vector<std::atomic<bool>>> retired;
+		for (size_t i = 0; i < CHURN_THREADS; i++) retired.emplace_back(CHURN_ROUNDS);
+		std::vector<size_t> lost(CHURN_THREADS, 0); // Counted per thread, CHECK is not thread safe
+		std::vector<size_t> stale(CHURN_THREADS, 0);
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < TRIGGER_THREADS; i++) {
+			threads.emplace_back(trigger_loop, i);
+		}
+		std::vector<std::thread> churners;
+		for (size_t i = 0; i < CHURN_THREADS; i++) {
+			churners.emplace_back(churn_loop, TRIGGER_THREADS + i, std::ref(retired[i]), std::ref(lost[i]), std::ref(stale[i]));
+		}
+
+		for (std::thread& churner : churners) churner.join();
+		churn_done.store(true);
+		for (std::thread& thread : threads) thread.join();
+
+		// Pooled calls may still be queued, the stable callbacks seeing every trigger means they have all been taken
+		size_t triggers = total_triggers.load();
+		for (size_t i = 0; i < STABLE_CALLBACKS; i++) {
+			bool complete = wait_until([i, triggers]() { return stable_calls[i].load() >= triggers; });
+			CHECK_MESSAGE(complete && stable_calls[i].load() == triggers,
+				std::to_string(stable_calls[i].load()) + " calls for " + std::to_string(triggers) + " triggers");
+		}
+
+		for (size_t i = 0; i < CHURN_THREADS; i++) {
+			CHECK_MESSAGE(lost[i] == 0, std::to_string(lost[i]) + " rounds missed calls");
+			CHECK_MESSAGE(stale[i] == 0, std::to_string(stale[i]) + " rounds still registered after unregistering");
+		}
+		CHECK_MESSAGE(late_calls.load() == 0, std::to_string(late_calls.load()) + " calls after unregister_callback returned");
+
+		// Only the stable callbacks are left, in registration order
+		std::shared_ptr<const StressEvent::CallbackList> remaining = StressEvent::callbacks.load();
+		CHECK(remaining->size() == STABLE_CALLBACKS);
+		for (size_t i = 0; i < remaining->size() && i < STABLE_CALLBACKS; i++) {
+			CHECK((*remaining)[i].id == stable_ids[i]);
+		}
+
+		for (StressEvent::CallbackID id : stable_ids) {
+			StressEvent::unregister_callback(id);
+		}
+		CHECK(StressEvent::callbacks.load()->empty());
+		StressEvent::set_dispatch_policy(DispatchPolicy::INLINE);
+	}
+
+	// A callback unregistering itself (or another) mid-trigger must not wait on its own trigger, nor disturb its other callbacks
+	void test_unregister_from_callback() {
+		std::atomic<size_t> first_calls{ 0 };
+		std::atomic<size_t> second_calls{ 0 };
+		StressEvent::CallbackID second = -1;
+
+		StressEvent::CallbackID first = StressEvent::register_callback([&](const StressEventData&) {
+			first_calls.fetch_add(1);
+			StressEvent::unregister_callback(second);
+		});
+		second = StressEvent::register_callback([&](const StressEventData&) { second_calls.fetch_add(1); });
+
+		trigger_from(0); // Runs on the snapshot taken before first unregistered second
+		trigger_from(0);
+		CHECK(first_calls.load() == 2);
+		CHECK(second_calls.load() == 1);
+
+		StressEvent::unregister_callback(first);
+		CHECK(StressEvent::callbacks.load()->empty());
+	}
+}
+
+int main() {
+	Logger::init();
+
+	test_concurrent_register_and_trigger(DispatchPolicy::INLINE);
+	test_concurrent_register_and_trigger(DispatchPolicy::POOL);
+	test_unregister_from_callback();
+
+	return TestCheck::result();
+}
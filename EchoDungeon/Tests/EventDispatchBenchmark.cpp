@@ -0,0 +1,103 @@
+#include "Imports/common.h"
+#include "Game/Events/Event.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Times Event::trigger under each dispatch policy, next to what trigger did before
+ * policies: one std::async(std::launch::async) per callback, whose discarded future waits for
+ * the thread it started.
+ *
+ * The callbacks only count their calls, so the numbers are the cost of dispatching. For each
+ * policy the table shows the time trigger takes on the calling thread, and the time until every
+ * call has run: for DEFERRED that includes EventDispatch::run_deferred() on the main thread, for
+ * POOL waiting for the workers to finish.
+ *
+ * Usage: EventDispatchBenchmark [triggers]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	class BenchmarkEventData : public BaseEventData {
+	public:
+		uint32_t value = 0;
+	};
+
+	using BenchmarkEvent = Event<BenchmarkEventData>;
+
+	std::atomic<size_t> calls{ 0 };
+
+	void wait_for_calls(size_t expected) {
+		while (calls.load() < expected) std::this_thread::yield();
+	}
+
+	void print(const char* policy, double trigger_ns, double done_ns) {
+		std::printf("  %-10s trigger %9.0f ns, all calls run %9.0f ns per trigger\n", policy, trigger_ns, done_ns);
+	}
+
+	void run_policy(const char* name, DispatchPolicy policy, size_t triggers, size_t callbacks) {
+		BenchmarkEvent::set_dispatch_policy(policy);
+		BenchmarkEventData data;
+		calls.store(0);
+
+		auto start = Clock::now();
+		for (size_t i = 0; i < triggers; i++) {
+			data.value = static_cast<uint32_t>(i);
+			BenchmarkEvent::trigger(data);
+		}
+		double trigger_ns = elapsed_ns(start) / triggers;
+
+		if (policy == DispatchPolicy::DEFERRED) EventDispatch::run_deferred();
+		wait_for_calls(triggers * callbacks);
+		print(name, trigger_ns, elapsed_ns(start) / triggers);
+	}
+
+	// The dispatch trigger used before policies existed
+	void run_async(size_t triggers, size_t callbacks) {
+		std::vector<BenchmarkEvent::Callback> list;
+		for (const auto& entry : *BenchmarkEvent::callbacks.load()) list.push_back(entry.callback);
+		BenchmarkEventData data;
+		calls.store(0);
+
+		auto start = Clock::now();
+		for (size_t i = 0; i < triggers; i++) {
+			data.value = static_cast<uint32_t>(i);
+			for (const auto& callback : list) {
+				std::future<void> pending = std::async(std::launch::async, callback, data); // Waits here, like the discarded future did
+			}
+		}
+		double trigger_ns = elapsed_ns(start) / triggers;
+		wait_for_calls(triggers * callbacks);
+		print("std::async", trigger_ns, elapsed_ns(start) / triggers);
+	}
+}
+
+int main(int argc, char** argv) {
+	long requested = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	size_t triggers = requested > 0 ? static_cast<size_t>(requested) : 20000;
+
+	Logger::init();
+
+	std::vector<BenchmarkEvent::CallbackID> registered;
+	for (size_t callbacks : { 1, 4 }) {
+		while (registered.size() < callbacks) {
+			registered.push_back(BenchmarkEvent::register_callback([](const BenchmarkEventData&) { calls.fetch_add(1); }));
+		}
+
+		std::printf("%zu callback%s, %zu triggers\n", callbacks, callbacks == 1 ? "" : "s", triggers);
+		run_policy("INLINE", DispatchPolicy::INLINE, triggers, callbacks);
+		run_policy("DEFERRED", DispatchPolicy::DEFERRED, triggers, callbacks);
+		run_policy("POOL", DispatchPolicy::POOL, triggers, callbacks);
+		run_async(triggers / 10 > 0 ? triggers / 10 : 1, callbacks); // A thread per call, so fewer rounds
+	}
+
+	for (BenchmarkEvent::CallbackID id : registered) BenchmarkEvent::unregister_callback(id);
+	return 0;
+}
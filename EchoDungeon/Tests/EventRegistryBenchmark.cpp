@@ -0,0 +1,122 @@
+#include "Imports/common.h"
+#include "Game/Events/Event.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Times Event::trigger (INLINE) against the number of registered callbacks, next to what
+ * the registry did before: copy the whole std::unordered_map of callbacks on every trigger and
+ * loop over the copy. Also times a register/unregister pair on each, since unregister now
+ * publishes a new list and waits for triggers in flight.
+ *
+ * The callbacks only count their calls, so the numbers are the cost of the registry. Only one
+ * thread triggers: the old map was not safe to change while another thread triggered.
+ *
+ * Usage: EventRegistryBenchmark [triggers]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	class BenchmarkEventData : public BaseEventData {
+	public:
+		uint32_t value = 0;
+	};
+
+	using BenchmarkEvent = Event<BenchmarkEventData>;
+
+	std::atomic<size_t> calls{ 0 };
+
+	// The registry Event used before callbacks were kept in a copy-on-write list
+	class MapCopyRegistry {
+	public:
+		BenchmarkEvent::CallbackID register_callback(BenchmarkEvent::Callback callback) {
+			BenchmarkEvent::CallbackID callback_id = next_callback_id++;
+			callbacks[callback_id] = callback;
+			return callback_id;
+		}
+
+		void unregister_callback(BenchmarkEvent::CallbackID callback_id) {
+			auto it = callbacks.find(callback_id);
+			if (it != callbacks.end()) {
+				callbacks.erase(it);
+			}
+		}
+
+		void trigger(const BenchmarkEventData& data) {
+			auto callbacks_copy = callbacks;
+			for (const auto& [id, callback] : callbacks_copy) {
+				if (!callback) continue;
+				EventDispatch::invoke([&callback, &data]() { callback(data); });
+			}
+		}
+
+	private:
+		BenchmarkEvent::CallbackID next_callback_id = 0;
+		std::unordered_map<BenchmarkEvent::CallbackID, BenchmarkEvent::Callback> callbacks;
+	};
+
+	template <typename Trigger>
+	double time_triggers(size_t triggers, Trigger trigger) {
+		BenchmarkEventData data;
+		auto start = Clock::now();
+		for (size_t i = 0; i < triggers; i++) {
+			data.value = static_cast<uint32_t>(i);
+			trigger(data);
+		}
+		return elapsed_ns(start) / triggers;
+	}
+
+	template <typename Register, typename Unregister>
+	double time_churn(size_t rounds, Register register_callback, Unregister unregister_callback) {
+		auto start = Clock::now();
+		for (size_t i = 0; i < rounds; i++) {
+			unregister_callback(register_callback([](const BenchmarkEventData&) { calls.fetch_add(1); }));
+		}
+		return elapsed_ns(start) / rounds;
+	}
+}
+
+int main(int argc, char** argv) {
+	long requested = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	size_t triggers = requested > 0 ? static_cast<size_t>(requested) : 200000;
+
+	Logger::init();
+
+	MapCopyRegistry map_copy;
+	std::vector<BenchmarkEvent::CallbackID> registered;
+	std::printf("%zu triggers per row, ns per trigger and per register+unregister pair\n", triggers);
+	std::printf("  %-9s %12s %12s %14s %14s\n", "callbacks", "map copy", "snapshot", "map copy pair", "snapshot pair");
+
+	for (size_t callbacks : { 1, 8, 32 }) {
+		while (registered.size() < callbacks) {
+			registered.push_back(BenchmarkEvent::register_callback([](const BenchmarkEventData&) { calls.fetch_add(1); }));
+			map_copy.register_callback([](const BenchmarkEventData&) { calls.fetch_add(1); });
+		}
+
+		calls.store(0);
+		double old_ns = time_triggers(triggers, [&map_copy](const BenchmarkEventData& data) { map_copy.trigger(data); });
+		double new_ns = time_triggers(triggers, [](const BenchmarkEventData& data) { BenchmarkEvent::trigger(data); });
+		if (calls.load() != 2 * triggers * callbacks) {
+			std::printf("  lost calls: %zu of %zu\n", calls.load(), 2 * triggers * callbacks);
+		}
+
+		size_t rounds = triggers / 10 > 0 ? triggers / 10 : 1;
+		double old_pair_ns = time_churn(rounds,
+			[&map_copy](BenchmarkEvent::Callback callback) { return map_copy.register_callback(std::move(callback)); },
+			[&map_copy](BenchmarkEvent::CallbackID id) { map_copy.unregister_callback(id); });
+		double new_pair_ns = time_churn(rounds,
+			[](BenchmarkEvent::Callback callback) { return BenchmarkEvent::register_callback(std::move(callback)); },
+			[](BenchmarkEvent::CallbackID id) { BenchmarkEvent::unregister_callback(id); });
+
+		std::printf("  %-9zu %12.1f %12.1f %14.1f %14.1f\n", callbacks, old_ns, new_ns, old_pair_ns, new_pair_ns);
+	}
+
+	for (BenchmarkEvent::CallbackID id : registered) BenchmarkEvent::unregister_callback(id);
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include "Imports/common.h"
+#include "Game/World/Systems/InboundQueue.h"
+#include "Networking/NetworkUser.h"
+#include "TestCheck.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Posts to an InboundQueue from a networking loop and from plain threads at once while
+ * the test thread drains it, like packet handlers and DEFERRED or POOL event callbacks feeding one
+ * world manager. Every message must run exactly once, on the draining thread, in the order its
+ * thread posted it. Posts from plain threads must not share the networking loop's ring, which
+ * only takes one producer.
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr uint32_t LOOP_MESSAGES = 2000;
+	constexpr uint32_t LOOP_BATCH = 100; // Posted per loop update, well under the ring's capacity
+	constexpr size_t PLAIN_THREADS = 4;
+	constexpr uint32_t PLAIN_MESSAGES = 20000; // Per plain thread
+	constexpr size_t LOOP_SOURCE = PLAIN_THREADS; // Index of the networking loop's messages in received
+
+	// A networking loop without a host, posting numbered messages from its update
+	class PostingUser : public NetworkUser {
+	public:
+		PostingUser(InboundQueue& _queue, std::vector<std::vector<uint32_t>>& _received)
+			: queue(_queue), received(_received) {}
+
+		~PostingUser() override {
+			if (is_running.load()) stop();
+		}
+
+		std::atomic<bool> saw_loop_thread{ false };
+
+	protected:
+		void update() override {
+			if (on_networking_thread()) saw_loop_thread.store(true);
+			for (uint32_t i = 0; i < LOOP_BATCH && posted < LOOP_MESSAGES; i++, posted++) {
+				queue.post([this, sequence = posted]() { received[LOOP_SOURCE].push_back(sequence); });
+			}
+		}
+
+	private:
+		InboundQueue& queue;
+		std::vector<std::vector<uint32_t>>& received;
+		uint32_t posted = 0; // Networking thread only
+	};
+
+	void test_posts_from_every_thread() {
+		InboundQueue queue;
+		std::vector<std::vector<uint32_t>> received(PLAIN_THREADS + 1); // Only written by drain(), on this thread
+		std::thread::id drain_thread = std::this_thread::get_id();
+		std::atomic<size_t> off_thread_runs{ 0 };
+
+		CHECK(!NetworkUser::on_networking_thread());
+
+		PostingUser user(queue, received);
+		user.start();
+		std::vector<std::thread> threads;
+		for (size_t source = 0; source < PLAIN_THREADS; source++) {
+			threads.emplace_back([&, source]() {
+				for (uint32_t sequence = 0; sequence < PLAIN_MESSAGES; sequence++) {
+					queue.post([&, source, sequence]() {
+						if (std::this_thread::get_id() != drain_thread) off_thread_runs.fetch_add(1);
+						received[source].push_back(sequence);
+					});
+				}
+			});
+		}
+
+		size_t expected = LOOP_MESSAGES + PLAIN_THREADS * PLAIN_MESSAGES;
+		size_t ran = 0;
+		auto deadline = Clock::now() + std::chrono::seconds(10);
+		while (ran < expected && Clock::now() < deadline) {
+			ran += queue.drain();
+			std::this_thread::yield();
+		}
+		for (std::thread& thread : threads) thread.join();
+		user.stop();
+		ran += queue.drain();
+
+		CHECK_MESSAGE(ran == expected, std::to_string(ran) + " of " + std::to_string(expected) + " messages ran");
+		CHECK(off_thread_runs.load() == 0);
+		CHECK(user.saw_loop_thread.load());
+		for (size_t source = 0; source < received.size(); source++) {
+			uint32_t count = source == LOOP_SOURCE ? LOOP_MESSAGES : PLAIN_MESSAGES;
+			CHECK_MESSAGE(received[source].size() == count,
+				std::to_string(received[source].size()) + " messages from source " + std::to_string(source));
+			bool in_order = true;
+			for (size_t i = 0; i < received[source].size(); i++) {
+				if (received[source][i] != i) in_order = false;
+			}
+			CHECK_MESSAGE(in_order, "source " + std::to_string(source) + " out of order");
+		}
+	}
+
+	// A message posting another (eg an event it triggers) runs the new one on the next drain, not this one
+	void test_post_while_draining() {
+		InboundQueue queue;
+		size_t inner_runs = 0;
+		queue.post([&]() { queue.post([&]() { inner_runs++; }); });
+
+		CHECK(queue.drain() == 1);
+		CHECK(inner_runs == 0);
+		CHECK(queue.drain() == 1);
+		CHECK(inner_runs == 1);
+		CHECK(queue.drain() == 0);
+	}
+}
+
+int main() {
+	Logger::init();
+	test_posts_from_every_thread();
+	test_post_while_draining();
+	return TestCheck::result();
+}
@@ -0,0 +1,201 @@
+#include "Imports/common.h"
+#include "Game/World/Managers/ServerWorldManager.h"
+#include "Networking/Server/Server.h"
+#include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/Instances/ConnectionInitiation.h"
+#include "Utils/JobSystem.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Times the server tick phases that run on the JobSystem (ServerWorldManager's enemy AI,
+ * PhysicsManager::update's broadphase and DeltaReplication::encode for every client through
+ * send_entity_updates) with 1, 2, 4 and 8 threads: JobSystem(0), (1), (3) and (7) plus the
+ * ticking thread, whatever the hardware has.
+ *
+ * A real ServerWorldManager ticks a world of enemies around its players, one per client connected
+ * over loopback. The clients never acknowledge, so every replication tick encodes the full state
+ * for each of them, the worst case (a client that just joined, or lost its acks). Enemies spawn
+ * far enough from the players that physics destroys none while the benchmark runs. Each phase's
+ * time is the scheduler's per-system stats, averaged over the runs after a warm-up.
+ *
+ * Rows with more threads than the machine has show the cost of oversubscribing.
+ *
+ * Usage: JobSystemBenchmark [enemies] [ticks] [clients]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr size_t WARMUP_TICKS = 30; // Sends the spawns and lets every system run before timing
+	constexpr float PLAYER_RADIUS = 20.0f; // Players stand on a circle around the origin
+	constexpr float ENEMY_MIN_RADIUS = 60.0f; // Enemies spawn between these, well out of the players' reach
+	constexpr float ENEMY_MAX_RADIUS = 150.0f;
+
+	struct Timings {
+		double ai_ms = 0.0; // Per run of each system
+		double physics_ms = 0.0;
+		double replication_ms = 0.0;
+		double tick_ms = 0.0; // Per update(), every system included
+
+		double phases_ms() const { return ai_ms + physics_ms + replication_ms; }
+	};
+
+	// Loopback clients, serviced on their own thread so the server's sends are taken off the wire
+	class Clients {
+	public:
+		Clients(const ENetAddress& server_address, size_t count) : hosts(count), peers(count) {
+			for (size_t i = 0; i < count; i++) {
+				hosts[i] = enet_host_create(nullptr, 1, NetworkConstants::MAX_CHANNELS, 0, 0);
+				peers[i] = enet_host_connect(hosts[i], &server_address, NetworkConstants::MAX_CHANNELS, 0);
+			}
+			thread = std::thread(&Clients::service, this);
+		}
+
+		~Clients() {
+			running.store(false);
+			thread.join();
+			for (ENetHost* host : hosts) enet_host_destroy(host);
+		}
+
+	private:
+		std::vector<ENetHost*> hosts;
+		std::vector<ENetPeer*> peers;
+		std::atomic<bool> running{ true };
+		std::thread thread;
+
+		void service() {
+			std::vector<bool> initiated(hosts.size(), false);
+			while (running.load()) {
+				for (size_t i = 0; i < hosts.size(); i++) {
+					ENetEvent event;
+					while (enet_host_service(hosts[i], &event, 0) > 0) {
+						if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+					}
+					if (!initiated[i] && peers[i]->state == ENET_PEER_STATE_CONNECTED) {
+						ConnectionInitiationPacket initiation("Player" + std::to_string(i));
+						enet_peer_send(peers[i], initiation.delivery().channel, initiation.to_enet_packet());
+						enet_host_flush(hosts[i]);
+						initiated[i] = true;
+					}
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+	};
+
+	const SystemStats* find_stats(const std::vector<SystemStats>& stats, const std::string& name) {
+		for (const SystemStats& system : stats) {
+			if (system.name == name) return &system;
+		}
+		return nullptr;
+	}
+
+	// Mean ms per run of a system between two reads of the scheduler's stats
+	double mean_run_ms(const std::vector<SystemStats>& before, const std::vector<SystemStats>& after, const std::string& name) {
+		const SystemStats* start = find_stats(before, name);
+		const SystemStats* end = find_stats(after, name);
+		if (!start || !end || end->runs == start->runs) return 0.0;
+		return (end->total_ms - start->total_ms) / static_cast<double>(end->runs - start->runs);
+	}
+
+	Timings run(std::shared_ptr<Server> server, size_t workers, size_t enemy_count, size_t ticks) {
+		JobSystem jobs(workers);
+		ServerWorldManager world(server, DEFAULT_ROOM);
+		world.set_job_system(jobs);
+
+		std::vector<PeerEntry> peers = server->peers.get_room_peers(DEFAULT_ROOM);
+		for (size_t i = 0; i < peers.size(); i++) {
+			uint32_t peer_id = peers[i].data.server_side_id;
+			world.add_player(peer_id, peers[i].data.username);
+			float angle = 2.0f * PI * static_cast<float>(i) / static_cast<float>(peers.size());
+			world.get_player(peer_id)->transform.set_position({ PLAYER_RADIUS * std::cos(angle), 1.0f, PLAYER_RADIUS * std::sin(angle) });
+		}
+
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> angle(0.0f, 2.0f * PI);
+		std::uniform_real_distribution<float> radius(ENEMY_MIN_RADIUS, ENEMY_MAX_RADIUS);
+		for (size_t i = 0; i < enemy_count; i++) {
+			float a = angle(random), r = radius(random);
+			world.spawn_enemy(50.0f, 1.0f, 5.0f, raylib::Vector3{ r * std::cos(a), 1.0f, r * std::sin(a) });
+		}
+
+		for (size_t tick = 0; tick < WARMUP_TICKS; tick++) world.update();
+		std::vector<SystemStats> before = world.get_system_stats();
+
+		auto start = Clock::now();
+		for (size_t tick = 0; tick < ticks; tick++) world.update();
+		double total_ms = elapsed_ms(start);
+		std::vector<SystemStats> after = world.get_system_stats();
+
+		if (world.get_all_enemies().size() != enemy_count) {
+			std::printf("  %zu of %zu enemies left, physics destroyed some\n", world.get_all_enemies().size(), enemy_count);
+		}
+
+		Timings timings;
+		timings.ai_ms = mean_run_ms(before, after, "enemy_ai");
+		timings.physics_ms = mean_run_ms(before, after, "physics");
+		timings.replication_ms = mean_run_ms(before, after, "replication");
+		timings.tick_ms = total_ms / static_cast<double>(ticks);
+		return timings;
+	}
+
+	size_t argument(int argc, char** argv, int index, size_t fallback) {
+		if (argc <= index) return fallback;
+		long value = std::strtol(argv[index], nullptr, 10);
+		return value > 0 ? static_cast<size_t>(value) : fallback;
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t enemy_count = argument(argc, argv, 1, 5000);
+	size_t ticks = argument(argc, argv, 2, 150);
+	size_t client_count = argument(argc, argv, 3, 8);
+
+	Logger::init();
+	spdlog::set_level(spdlog::level::warn); // Every spawn is logged at info
+	enet_initialize();
+
+	auto server = std::make_shared<Server>("::1", 0);
+	if (!server->host) {
+		std::printf("Could not start the server on loopback\n");
+		return 1;
+	}
+	server->server_info.max_players = static_cast<uint8_t>(client_count);
+	ENetAddress address = address_of(server->host);
+	server->start();
+
+	{
+		Clients clients(address, client_count);
+		auto deadline = Clock::now() + std::chrono::seconds(10);
+		while (server->peers.get_room_peers(DEFAULT_ROOM).size() < client_count && Clock::now() < deadline) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		size_t joined = server->peers.get_room_peers(DEFAULT_ROOM).size();
+
+		std::printf("%zu enemies, %zu of %zu clients joined, %zu ticks, %u hardware threads, ms per run\n",
+			enemy_count, joined, client_count, ticks, std::thread::hardware_concurrency());
+
+		double single_thread_ms = 0.0;
+		for (size_t workers : { 0, 1, 3, 7 }) {
+			Timings timings = run(server, workers, enemy_count, ticks);
+			if (workers == 0) single_thread_ms = timings.phases_ms();
+
+			std::printf("%zu threads: ai %7.3f, physics %7.3f, replication %7.3f, phases %7.3f (%.2fx), whole tick %7.3f\n",
+				workers + 1, timings.ai_ms, timings.physics_ms, timings.replication_ms, timings.phases_ms(),
+				single_thread_ms / timings.phases_ms(), timings.tick_ms);
+		}
+	}
+
+	server->stop().get();
+	enet_deinitialize();
+	return 0;
+}
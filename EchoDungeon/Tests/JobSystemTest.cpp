@@ -0,0 +1,122 @@
+#include "Imports/common.h"
+#include "Utils/JobSystem.h"
+#include "TestCheck.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Checks that parallel_for runs every item exactly once, with and without workers and
+ * when called from inside a job, that a throwing chunk is logged and contained the same way
+ * whether it runs inline or on a worker, and that a caller waiting on its own chunks never runs
+ * another caller's (like one room's tick running another room's AI).
+ */
+
+namespace {
+	void test_every_item_once(JobSystem& jobs, size_t count, size_t grain) {
+		std::vector<std::atomic<int>> runs(count);
+		jobs.parallel_for(count, grain, [&runs](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) runs[i].fetch_add(1);
+		});
+
+		size_t wrong = 0;
+		for (const std::atomic<int>& item : runs) {
+			if (item.load() != 1) wrong++;
+		}
+		CHECK_MESSAGE(wrong == 0, std::to_string(wrong) + " of " + std::to_string(count) + " items not run once, grain "
+			+ std::to_string(grain) + ", " + std::to_string(jobs.get_worker_count()) + " workers");
+	}
+
+	void test_nested(JobSystem& jobs) {
+		std::atomic<size_t> items{ 0 };
+		jobs.parallel_for(8, 1, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				jobs.parallel_for(100, 10, [&](size_t inner_begin, size_t inner_end) { items.fetch_add(inner_end - inner_begin); });
+			}
+		});
+		CHECK(items.load() == 800);
+	}
+
+	// A chunk that throws ends only itself, parallel_for still returns once the rest have run
+	void test_exceptions_contained(JobSystem& jobs) {
+		bool propagated = false;
+		try {
+			// A single chunk, run inline on the calling thread
+			jobs.parallel_for(10, 100, [](size_t, size_t) { throw std::runtime_error("inline chunk"); });
+		}
+		catch (const std::exception&) {
+			propagated = true;
+		}
+		CHECK(!propagated);
+
+		std::atomic<size_t> items{ 0 };
+		try {
+			// Several chunks, the one holding item 50 throwing. Without workers the whole range is one inline chunk.
+			jobs.parallel_for(100, 10, [&items](size_t begin, size_t end) {
+				if (begin <= 50 && 50 < end) throw std::runtime_error("chunk with item 50");
+				items.fetch_add(end - begin);
+			});
+		}
+		catch (const std::exception&) {
+			propagated = true;
+		}
+		CHECK(!propagated);
+		CHECK(items.load() == (jobs.get_worker_count() > 0 ? 90u : 0u));
+	}
+
+	// Thread A waits on its chunk running on the only worker while the main thread's chunks are queued
+	void test_caller_runs_only_its_own_chunks() {
+		JobSystem jobs(1);
+		std::atomic<bool> worker_started{ false };
+		std::atomic<bool> released{ false };
+		std::thread::id waiting_caller;
+
+		std::thread caller([&]() {
+			waiting_caller = std::this_thread::get_id();
+			jobs.parallel_for(2, 1, [&](size_t, size_t) {
+				if (std::this_thread::get_id() == waiting_caller) {
+					// Let the worker claim the other chunk, so this caller is left waiting on it
+					while (!worker_started.load()) std::this_thread::yield();
+					return;
+				}
+				worker_started.store(true);
+				while (!released.load()) std::this_thread::yield();
+			});
+		});
+		while (!worker_started.load()) std::this_thread::yield();
+
+		std::atomic<size_t> run_by_waiting_caller{ 0 };
+		std::atomic<size_t> items{ 0 };
+		jobs.parallel_for(8, 1, [&](size_t begin, size_t end) {
+			if (std::this_thread::get_id() == waiting_caller) run_by_waiting_caller.fetch_add(1);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Long enough for a helping caller to take some
+			items.fetch_add(end - begin);
+		});
+		released.store(true);
+		caller.join();
+
+		CHECK(items.load() == 8);
+		CHECK_MESSAGE(run_by_waiting_caller.load() == 0,
+			std::to_string(run_by_waiting_caller.load()) + " chunks run by a caller waiting on its own call");
+	}
+}
+
+int main() {
+	Logger::init();
+
+	for (size_t workers : { 0, 1, 3 }) {
+		JobSystem jobs(workers);
+		test_every_item_once(jobs, 0, 16);
+		test_every_item_once(jobs, 1, 16);
+		test_every_item_once(jobs, 1000, 1);
+		test_every_item_once(jobs, 10000, 256);
+		test_every_item_once(jobs, 257, 256);
+		test_nested(jobs);
+		test_exceptions_contained(jobs);
+	}
+	test_caller_runs_only_its_own_chunks();
+
+	return TestCheck::result();
+}
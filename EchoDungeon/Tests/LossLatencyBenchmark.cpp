@@ -0,0 +1,251 @@
+#include "Imports/common.h"
+#include "Networking/Packet/PacketDelivery.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Measures how long state updates and gameplay events take to arrive over a link that
+ * drops a share of its datagrams, with everything sent reliably on one channel as before, and
+ * with state sent SEQUENCED_STATE and events RELIABLE_EVENT as the packet types declare now.
+ *
+ * A server host sends a 1 KB state update at 30 Hz and a small event 5 times a second to a client
+ * host, through a relay on loopback that drops datagrams in both directions and delays the rest.
+ * Each packet carries its send time, and the client records how long it took to arrive. Lost
+ * unreliable updates are counted, not timed: the next update supersedes them.
+ *
+ * It runs in real time, so the numbers depend on the OS scheduler.
+ *
+ * Usage: LossLatencyBenchmark [loss percent] [one-way delay ms] [seconds]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr uint8_t STATE = 1; // First byte of each test packet
+	constexpr uint8_t EVENT = 2;
+	constexpr size_t STATE_SIZE = 1024;
+	constexpr size_t EVENT_SIZE = 32;
+
+	int64_t now_us() {
+		return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * @brief Forwards datagrams between one client and the server, dropping some and delaying the rest.
+	 * The client sends to client_side, which the relay forwards from server_side to the server.
+	 */
+	class LossyRelay {
+	public:
+		ENetSocket client_side = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+		ENetSocket server_side = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+
+		LossyRelay(ENetAddress _server, int _loss_percent, int _delay_ms)
+			: server(_server), loss_percent(_loss_percent), delay_us(static_cast<int64_t>(_delay_ms) * 1000) {
+			ENetAddress any = loopback(0);
+			enet_socket_bind(client_side, &any);
+			enet_socket_bind(server_side, &any);
+			enet_socket_set_option(client_side, ENET_SOCKOPT_NONBLOCK, 1);
+			enet_socket_set_option(server_side, ENET_SOCKOPT_NONBLOCK, 1);
+			running.store(true);
+			thread = std::thread([this]() { run(); });
+		}
+
+		~LossyRelay() {
+			running.store(false);
+			thread.join();
+			enet_socket_destroy(client_side);
+			enet_socket_destroy(server_side);
+		}
+
+	private:
+		struct Datagram {
+			int64_t release_us = 0;
+			bool to_server = false;
+			std::vector<uint8_t> data;
+		};
+
+		ENetAddress server;
+		ENetAddress client{};
+		int loss_percent;
+		int64_t delay_us;
+		std::mt19937 random{ 5 };
+		std::deque<Datagram> in_flight; // Constant delay, so release times are in order
+		std::atomic<bool> running{ false };
+		std::thread thread;
+
+		void receive(ENetSocket socket, bool to_server) {
+			uint8_t data[ENET_PROTOCOL_MAXIMUM_MTU];
+			ENetBuffer buffer{};
+			buffer.data = data;
+			buffer.dataLength = sizeof(data);
+			ENetAddress from{};
+			int length;
+			while ((length = enet_socket_receive(socket, &from, &buffer, 1)) > 0) {
+				if (to_server) client = from;
+				if (static_cast<int>(random() % 100) < loss_percent) continue;
+				in_flight.push_back({ now_us() + delay_us, to_server, std::vector<uint8_t>(data, data + length) });
+			}
+		}
+
+		void run() {
+			while (running.load()) {
+				ENetSocketSet readable;
+				ENET_SOCKETSET_EMPTY(readable);
+				ENET_SOCKETSET_ADD(readable, client_side);
+				ENET_SOCKETSET_ADD(readable, server_side);
+				enet_socketset_select((std::max)(client_side, server_side), &readable, nullptr, 1);
+				receive(client_side, true);
+				receive(server_side, false);
+
+				while (!in_flight.empty() && in_flight.front().release_us <= now_us()) {
+					Datagram& datagram = in_flight.front();
+					ENetBuffer buffer{};
+					buffer.data = datagram.data.data();
+					buffer.dataLength = datagram.data.size();
+					if (datagram.to_server) enet_socket_send(server_side, &server, &buffer, 1);
+					else enet_socket_send(client_side, &client, &buffer, 1);
+					in_flight.pop_front();
+				}
+			}
+		}
+	};
+
+	struct Result {
+		std::vector<double> state_ms;
+		std::vector<double> event_ms;
+		size_t states_sent = 0;
+		size_t events_sent = 0;
+	};
+
+	ENetPacket* make_packet(uint8_t kind, size_t size, enet_uint32 flags) {
+		std::vector<uint8_t> data(size, 0);
+		data[0] = kind;
+		int64_t sent = now_us();
+		std::memcpy(data.data() + 1, &sent, sizeof(sent));
+		return enet_packet_create(data.data(), data.size(), flags);
+	}
+
+	void record(Result& result, const ENetPacket* packet) {
+		int64_t sent = 0;
+		std::memcpy(&sent, packet->data + 1, sizeof(sent));
+		double ms = (now_us() - sent) / 1000.0;
+		if (packet->data[0] == STATE) result.state_ms.push_back(ms);
+		else result.event_ms.push_back(ms);
+	}
+
+	Result run(PacketDeliveryInfo state, PacketDeliveryInfo event, int loss_percent, int delay_ms, int seconds) {
+		Result result;
+		ENetAddress any = loopback(0);
+		ENetHost* server = enet_host_create(&any, 1, NetworkConstants::MAX_CHANNELS, 0, 0);
+		ENetHost* client = enet_host_create(&any, 1, NetworkConstants::MAX_CHANNELS, 0, 0);
+		ENetAddress server_address = address_of(server->socket);
+		LossyRelay relay(server_address, loss_percent, delay_ms);
+
+		ENetAddress relay_address = address_of(relay.client_side);
+		enet_host_connect(client, &relay_address, NetworkConstants::MAX_CHANNELS, 0);
+
+		ENetPeer* peer = nullptr; // The client, as the server sees it
+		bool connected = false;
+		ENetEvent received;
+		auto service = [&]() {
+			while (enet_host_service(server, &received, 0) > 0) {
+				if (received.type == ENET_EVENT_TYPE_CONNECT) peer = received.peer;
+			}
+			while (enet_host_service(client, &received, 0) > 0) {
+				if (received.type == ENET_EVENT_TYPE_CONNECT) connected = true;
+				if (received.type == ENET_EVENT_TYPE_RECEIVE) {
+					if (peer) record(result, received.packet);
+					enet_packet_destroy(received.packet);
+				}
+			}
+		};
+
+		auto deadline = Clock::now() + std::chrono::seconds(10);
+		while ((!peer || !connected) && Clock::now() < deadline) {
+			service();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		if (!peer || !connected) {
+			std::printf("  failed to connect\n");
+		}
+		else {
+			auto start = Clock::now();
+			auto next_state = start;
+			auto next_event = start;
+			while (Clock::now() - start < std::chrono::seconds(seconds)) {
+				if (Clock::now() >= next_state) {
+					enet_peer_send(peer, state.channel, make_packet(STATE, STATE_SIZE, state.enet_flags()));
+					result.states_sent++;
+					next_state += std::chrono::microseconds(1000000 / 30);
+				}
+				if (Clock::now() >= next_event) {
+					enet_peer_send(peer, event.channel, make_packet(EVENT, EVENT_SIZE, event.enet_flags()));
+					result.events_sent++;
+					next_event += std::chrono::milliseconds(200);
+				}
+				service();
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			// Let what is still in flight arrive
+			auto drain = Clock::now();
+			while (Clock::now() - drain < std::chrono::milliseconds(delay_ms * 4 + 500)) {
+				service();
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		enet_host_destroy(client);
+		enet_host_destroy(server);
+		return result;
+	}
+
+	void print_distribution(const char* what, std::vector<double> values, size_t sent) {
+		if (values.empty()) {
+			std::printf("  %s: none of %zu arrived\n", what, sent);
+			return;
+		}
+		std::sort(values.begin(), values.end());
+		double sum = 0.0;
+		for (double value : values) sum += value;
+		std::printf("  %s: mean %.1f ms, p50 %.1f ms, p99 %.1f ms, max %.1f ms, %zu of %zu arrived\n", what,
+			sum / values.size(), values[values.size() / 2], values[values.size() * 99 / 100], values.back(), values.size(), sent);
+	}
+}
+
+int main(int argc, char** argv) {
+	long loss_argument = argc > 1 ? std::strtol(argv[1], nullptr, 10) : -1;
+	long delay_argument = argc > 2 ? std::strtol(argv[2], nullptr, 10) : -1;
+	long seconds_argument = argc > 3 ? std::strtol(argv[3], nullptr, 10) : 0;
+	int loss_percent = loss_argument >= 0 && loss_argument < 100 ? static_cast<int>(loss_argument) : 5;
+	int delay_ms = delay_argument >= 0 ? static_cast<int>(delay_argument) : 25;
+	int seconds = seconds_argument > 0 ? static_cast<int>(seconds_argument) : 20;
+
+	Logger::init();
+	enet_initialize();
+
+	std::printf("%d%% loss each way, %d ms one-way delay, %d s\n", loss_percent, delay_ms, seconds);
+
+	std::printf("Everything reliable on the events channel\n");
+	Result reliable = run(PacketDeliveries::RELIABLE_EVENT, PacketDeliveries::RELIABLE_EVENT, loss_percent, delay_ms, seconds);
+	print_distribution("state", reliable.state_ms, reliable.states_sent);
+	print_distribution("events", reliable.event_ms, reliable.events_sent);
+
+	std::printf("State SEQUENCED_STATE, events RELIABLE_EVENT\n");
+	Result split = run(PacketDeliveries::SEQUENCED_STATE, PacketDeliveries::RELIABLE_EVENT, loss_percent, delay_ms, seconds);
+	print_distribution("state", split.state_ms, split.states_sent);
+	print_distribution("events", split.event_ms, split.events_sent);
+
+	enet_deinitialize();
+	return 0;
+}
@@ -0,0 +1,265 @@
+#include "Imports/common.h"
+#include "Networking/NetworkUser.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Measures the networking loop's receive-to-dispatch latency and idle CPU use, next to a
+ * stand-in for the loop it replaced (enet_host_service with no timeout, then a 1 ms sleep).
+ *
+ * A plain ENet host on the main thread connects to the loop's host over loopback and sends
+ * timestamped packets at an uneven interval, so arrivals fall anywhere within the old loop's
+ * sleep. The loop records how long each packet took from enet_host_flush on the sender to its
+ * update() handling it. Idle CPU is the process's CPU time while both are connected and nothing
+ * is sent, so only ENet's pings and the loops' own wake-ups run. For the loop, the time from
+ * send_packet on the main thread until the packet reaches the sender is measured too, which
+ * covers wake() interrupting the wait.
+ *
+ * The numbers depend on the OS timer and scheduler of the machine it runs on.
+ *
+ * Usage: NetworkLoopBenchmark [packets] [idle seconds]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	int64_t now_ns() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	// Records each received packet's latency from the timestamp it carries, on whichever thread services the host
+	struct Recorder {
+		std::vector<double> latencies_us;
+		std::atomic<ENetPeer*> peer{ nullptr };
+		std::atomic<size_t> received{ 0 };
+
+		void service(ENetHost* host) {
+			ENetEvent event;
+			while (enet_host_service(host, &event, 0) > 0) {
+				if (event.type == ENET_EVENT_TYPE_CONNECT) {
+					peer.store(event.peer);
+				}
+				else if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+					int64_t sent = 0;
+					std::memcpy(&sent, event.packet->data, sizeof(sent));
+					latencies_us.push_back((now_ns() - sent) / 1000.0);
+					received.fetch_add(1);
+					enet_packet_destroy(event.packet);
+				}
+			}
+		}
+	};
+
+	// The networking loop under test
+	class LoopReceiver : public NetworkUser {
+	public:
+		Recorder recorder;
+
+		LoopReceiver() { host = create_host(); }
+
+		~LoopReceiver() override {
+			if (is_running.load()) stop();
+			if (host) enet_host_destroy(host);
+		}
+
+	protected:
+		void update() override { recorder.service(host); }
+	};
+
+	// What NetworkUser::update_loop did before: poll, then sleep for LOOP_SLEEP_DURATION_MS
+	class PollingReceiver {
+	public:
+		Recorder recorder;
+		ENetHost* host = create_host();
+
+		~PollingReceiver() {
+			stop();
+			if (host) enet_host_destroy(host);
+		}
+
+		void start() {
+			running.store(true);
+			thread = std::thread([this]() {
+				while (running.load()) {
+					recorder.service(host);
+					std::this_thread::sleep_for(std::chrono::milliseconds(NetworkConstants::LOOP_SLEEP_DURATION_MS));
+				}
+			});
+		}
+
+		void stop() {
+			running.store(false);
+			if (thread.joinable()) thread.join();
+		}
+
+	private:
+		std::atomic<bool> running{ false };
+		std::thread thread;
+	};
+
+	struct Result {
+		std::vector<double> latencies_us;
+		double idle_cpu_percent = 0.0;
+		std::vector<double> queued_send_us; // send_packet to arrival, the loop only
+	};
+
+	void print_distribution(const char* what, std::vector<double> values) {
+		if (values.empty()) {
+			std::printf("  %s: none\n", what);
+			return;
+		}
+		std::sort(values.begin(), values.end());
+		double sum = 0.0;
+		for (double value : values) sum += value;
+		std::printf("  %s: mean %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us (%zu packets)\n", what,
+			sum / values.size(), values[values.size() / 2], values[values.size() * 99 / 100], values.back(), values.size());
+	}
+
+	// Connects a sender to the receiver's host, whose loop must already be running
+	ENetPeer* connect(ENetHost* sender, ENetHost* receiver_host, Recorder& recorder) {
+		ENetAddress address = address_of(receiver_host);
+		ENetPeer* peer = enet_host_connect(sender, &address, NetworkConstants::MAX_CHANNELS, 0);
+		ENetEvent event;
+		for (int i = 0; i < 500; i++) {
+			if (enet_host_service(sender, &event, 10) > 0 && event.type == ENET_EVENT_TYPE_CONNECT && recorder.peer.load()) return peer;
+			if (peer->state == ENET_PEER_STATE_CONNECTED && recorder.peer.load()) return peer;
+		}
+		return nullptr;
+	}
+
+	void send_timestamped(ENetHost* sender, ENetPeer* peer, size_t packets) {
+		ENetEvent event;
+		for (size_t i = 0; i < packets; i++) {
+			// Uneven gaps, so arrivals land anywhere in a polling loop's sleep
+			std::this_thread::sleep_for(std::chrono::microseconds(2000 + (i * 7919) % 3000));
+			while (enet_host_service(sender, &event, 0) > 0) {
+				if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+			}
+
+			uint8_t data[64] = {};
+			int64_t sent = now_ns();
+			std::memcpy(data, &sent, sizeof(sent));
+			enet_peer_send(peer, NetworkConstants::CHANNEL_EVENTS, enet_packet_create(data, sizeof(data), ENET_PACKET_FLAG_RELIABLE));
+			enet_host_flush(sender);
+		}
+	}
+
+	// Process CPU time used while the receiver sits connected with nothing to do
+	double idle_cpu_percent(ENetHost* sender, int idle_seconds) {
+		std::clock_t cpu_start = std::clock();
+		auto wall_start = Clock::now();
+		ENetEvent event;
+		while (Clock::now() - wall_start < std::chrono::seconds(idle_seconds)) {
+			enet_host_service(sender, &event, 100); // Keeps the sender answering pings, blocked in between
+		}
+		double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+		double wall_seconds = elapsed_s(wall_start);
+		return cpu_seconds / wall_seconds * 100.0;
+	}
+
+	template<class Receiver>
+	void wait_for(Receiver& receiver, ENetHost* sender, size_t packets) {
+		ENetEvent event;
+		for (int i = 0; i < 200 && receiver.recorder.received.load() < packets; i++) {
+			enet_host_service(sender, &event, 10);
+		}
+	}
+
+	Result run_loop(size_t packets, int idle_seconds) {
+		Result result;
+		LoopReceiver receiver;
+		ENetHost* sender = create_host();
+		receiver.start();
+
+		ENetPeer* peer = connect(sender, receiver.host, receiver.recorder);
+		if (!peer) {
+			std::printf("  failed to connect\n");
+			enet_host_destroy(sender);
+			return result;
+		}
+
+		send_timestamped(sender, peer, packets);
+		wait_for(receiver, sender, packets);
+		result.idle_cpu_percent = idle_cpu_percent(sender, idle_seconds);
+
+		// Queued sends from this thread, which the loop only sees when wake() interrupts its wait
+		ENetEvent event;
+		for (size_t i = 0; i < packets; i++) {
+			std::this_thread::sleep_for(std::chrono::microseconds(2000 + (i * 7919) % 3000));
+			uint8_t data[64] = {};
+			int64_t queued = now_ns();
+			receiver.send_packet(enet_packet_create(data, sizeof(data), ENET_PACKET_FLAG_RELIABLE), receiver.recorder.peer.load(),
+				NetworkConstants::CHANNEL_EVENTS);
+			for (int attempt = 0; attempt < 100; attempt++) {
+				if (enet_host_service(sender, &event, 10) > 0 && event.type == ENET_EVENT_TYPE_RECEIVE) {
+					result.queued_send_us.push_back((now_ns() - queued) / 1000.0);
+					enet_packet_destroy(event.packet);
+					break;
+				}
+			}
+		}
+
+		receiver.stop();
+		result.latencies_us = receiver.recorder.latencies_us;
+		enet_peer_disconnect_now(peer, 0);
+		enet_host_destroy(sender);
+		return result;
+	}
+
+	Result run_polling(size_t packets, int idle_seconds) {
+		Result result;
+		PollingReceiver receiver;
+		ENetHost* sender = create_host();
+		receiver.start();
+
+		ENetPeer* peer = connect(sender, receiver.host, receiver.recorder);
+		if (!peer) {
+			std::printf("  failed to connect\n");
+			enet_host_destroy(sender);
+			return result;
+		}
+
+		send_timestamped(sender, peer, packets);
+		wait_for(receiver, sender, packets);
+		result.idle_cpu_percent = idle_cpu_percent(sender, idle_seconds);
+
+		receiver.stop();
+		result.latencies_us = receiver.recorder.latencies_us;
+		enet_peer_disconnect_now(peer, 0);
+		enet_host_destroy(sender);
+		return result;
+	}
+}
+
+int main(int argc, char** argv) {
+	long packets_argument = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	long idle_argument = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 0;
+	size_t packets = packets_argument > 0 ? static_cast<size_t>(packets_argument) : 500;
+	int idle_seconds = idle_argument > 0 ? static_cast<int>(idle_argument) : 5;
+
+	Logger::init();
+	enet_initialize();
+
+	std::printf("Networking loop (%s, %ums timeout)\n", NetworkConstants::BLOCKING_SERVICE ? "blocking" : "polling",
+		static_cast<unsigned>(NetworkConstants::SERVICE_TIMEOUT_MS));
+	Result loop = run_loop(packets, idle_seconds);
+	print_distribution("receive to dispatch", loop.latencies_us);
+	print_distribution("send_packet to arrival", loop.queued_send_us);
+	std::printf("  idle CPU: %.2f%% of one core\n", loop.idle_cpu_percent);
+
+	std::printf("Polling stand-in (service, then %ldms sleep)\n", NetworkConstants::LOOP_SLEEP_DURATION_MS);
+	Result polling = run_polling(packets, idle_seconds);
+	print_distribution("receive to dispatch", polling.latencies_us);
+	std::printf("  idle CPU: %.2f%% of one core\n", polling.idle_cpu_percent);
+
+	enet_deinitialize();
+	return 0;
+}
@@ -0,0 +1,172 @@
+#include "Imports/common.h"
+#include "Networking/PacketConflator.h"
+#include "Networking/NetworkConstants.h"
+#include "Networking/Packet/PacketTypes.h"
+#include "TestCheck.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Sends two state streams and a reliable event stream from one ENet host to another over
+ * loopback, through a PacketConflator, with the receiver advertising little bandwidth so the
+ * sender backs up. The conflator must never hold more than one packet per stream, every
+ * reliable event must arrive in order (including one large enough to back up the reliable
+ * queue), state must keep flowing meanwhile, and each stream must arrive oldest to newest.
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr uint8_t PLAYER_STATE = 15; // PlayerUpdate, SEQUENCED_STATE
+	constexpr uint8_t ENEMY_STATE = 18; // EnemyUpdate, SEQUENCED_STATE
+	constexpr uint8_t EVENT = 14; // PlayerSpawn, RELIABLE_EVENT
+	constexpr size_t STREAMS = 2;
+
+	constexpr uint32_t TICKS = 300;
+	constexpr auto TICK_LENGTH = std::chrono::milliseconds(5);
+	constexpr auto RECEIVER_INTERVAL = std::chrono::milliseconds(20); // The receiver only services its host this often
+	constexpr enet_uint32 RECEIVER_BANDWIDTH = 24000; // Bytes per second, far less than the streams need
+	constexpr size_t STATE_SIZE = 600;
+	constexpr uint32_t EVENT_INTERVAL = 10; // Ticks between reliable events
+	constexpr uint32_t LARGE_EVENT_TICK = 100; // Sends a 40 KB event here, backing up the reliable queue
+
+	size_t superseded = 0; // State packets freed without ever being sent
+
+	void ENET_CALLBACK on_free(void* freed) {
+		ENetPacket* packet = static_cast<ENetPacket*>(freed);
+		if (packet->data[0] != EVENT && !(packet->flags & ENET_PACKET_FLAG_SENT)) superseded++;
+	}
+
+	// A packet of a real packet type's ID with a sequence number after it, padded to size
+	ENetPacket* make_packet(uint8_t type, uint32_t sequence, size_t size) {
+		std::vector<uint8_t> data(size, 0xAB);
+		data[0] = type;
+		std::memcpy(&data[1], &sequence, sizeof(sequence));
+
+		ENetPacket* packet = enet_packet_create(data.data(), data.size(), PacketTypes::info(type).delivery.enet_flags());
+		packet->freeCallback = on_free;
+		return packet;
+	}
+
+	uint32_t sequence_of(const ENetPacket* packet) {
+		uint32_t sequence;
+		std::memcpy(&sequence, &packet->data[1], sizeof(sequence));
+		return sequence;
+	}
+
+	struct Received {
+		uint32_t events = 0;
+		uint32_t next_event = 0; // Sequence the next event must have
+		bool events_in_order = true;
+		size_t states[STREAMS] = {};
+		uint32_t last_state[STREAMS] = {};
+		bool states_in_order = true;
+		size_t states_during_backlog = 0; // State received while the large event was still in flight
+	};
+
+	void receive(ENetHost* host, Received& received, bool large_event_pending) {
+		ENetEvent event;
+		while (enet_host_service(host, &event, 0) > 0) {
+			if (event.type != ENET_EVENT_TYPE_RECEIVE) continue;
+
+			uint8_t type = event.packet->data[0];
+			uint32_t sequence = sequence_of(event.packet);
+			if (type == EVENT) {
+				received.events_in_order &= sequence == received.next_event;
+				received.next_event = sequence + EVENT_INTERVAL;
+				received.events++;
+			}
+			else {
+				size_t stream = type == PLAYER_STATE ? 0 : 1;
+				received.states_in_order &= received.states[stream] == 0 || sequence > received.last_state[stream];
+				received.last_state[stream] = sequence;
+				received.states[stream]++;
+				if (large_event_pending) received.states_during_backlog++;
+			}
+			enet_packet_destroy(event.packet);
+		}
+	}
+
+	void test_backed_up_link() {
+		ENetHost* sender = create_host();
+		ENetHost* receiver = enet_host_create(nullptr, 1, NetworkConstants::MAX_CHANNELS, RECEIVER_BANDWIDTH, 0);
+		CHECK(sender != nullptr && receiver != nullptr);
+		if (!sender || !receiver) return;
+		ENetAddress address = address_of(sender);
+
+		enet_host_connect(receiver, &address, NetworkConstants::MAX_CHANNELS, 0);
+		ENetPeer* peer = nullptr;
+		ENetEvent event;
+		for (int i = 0; i < 500 && !peer; i++) {
+			enet_host_service(receiver, &event, 1);
+			if (enet_host_service(sender, &event, 1) > 0 && event.type == ENET_EVENT_TYPE_CONNECT) peer = event.peer;
+		}
+		CHECK(peer != nullptr);
+		if (!peer) return;
+		enet_host_service(receiver, &event, 5); // Let the receiver see the connection complete
+
+		PacketConflator conflator;
+		Received received;
+		uint32_t events_sent = 0;
+		size_t max_held = 0;
+		auto last_receive = std::chrono::steady_clock::now();
+
+		for (uint32_t tick = 0; tick < TICKS; tick++) {
+			conflator.hold(peer, NetworkConstants::CHANNEL_STATE, make_packet(PLAYER_STATE, tick, STATE_SIZE));
+			conflator.hold(peer, NetworkConstants::CHANNEL_STATE, make_packet(ENEMY_STATE, tick, STATE_SIZE));
+			max_held = (std::max)(max_held, conflator.held_count());
+
+			if (tick % EVENT_INTERVAL == 0) {
+				ENetPacket* packet = make_packet(EVENT, tick, tick == LARGE_EVENT_TICK ? 40000 : 1000);
+				CHECK(enet_peer_send(peer, NetworkConstants::CHANNEL_EVENTS, packet) == 0);
+				events_sent++;
+			}
+
+			conflator.release();
+			max_held = (std::max)(max_held, conflator.held_count());
+			while (enet_host_service(sender, &event, 0) > 0) {}
+
+			auto now = std::chrono::steady_clock::now();
+			if (now - last_receive >= RECEIVER_INTERVAL) {
+				last_receive = now;
+				receive(receiver, received, tick >= LARGE_EVENT_TICK && received.next_event <= LARGE_EVENT_TICK);
+			}
+			std::this_thread::sleep_for(TICK_LENGTH);
+		}
+
+		// Drain: whatever is still held goes out as room appears, then every reliable event must arrive
+		for (int i = 0; i < 2000 && received.events < events_sent; i++) {
+			conflator.release();
+			max_held = (std::max)(max_held, conflator.held_count());
+			enet_host_service(sender, &event, 1);
+			receive(receiver, received, false);
+		}
+
+		CHECK_MESSAGE(max_held <= STREAMS, std::to_string(max_held) + " packets held");
+		CHECK_MESSAGE(received.events == events_sent,
+			std::to_string(received.events) + " of " + std::to_string(events_sent) + " events delivered");
+		CHECK(received.events_in_order);
+		CHECK(received.states_in_order);
+		CHECK(received.states[0] > 0 && received.states[1] > 0);
+		CHECK_MESSAGE(received.states_during_backlog > 0, "state stalled behind the reliable backlog");
+		CHECK_MESSAGE(superseded > 0, "the link never backed up, nothing was conflated");
+
+		conflator.clear();
+		enet_peer_disconnect_now(peer, 0);
+		enet_host_destroy(receiver);
+		enet_host_destroy(sender);
+	}
+}
+
+int main() {
+	Logger::init();
+	enet_initialize();
+
+	test_backed_up_link();
+
+	enet_deinitialize();
+	return TestCheck::result();
+}
@@ -0,0 +1,195 @@
+#include "Imports/common.h"
+#include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/PacketBatch.h"
+#include "Networking/Packet/PacketCompression.h"
+#include "Game/Events/EventList.h" // Includes every packet class
+#include "TestCheck.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Checks that receiving the per-tick state packets does not allocate once the pools are warm.
+ *
+ * Every operator new in the process is counted. After a few warm-up rounds have filled the
+ * PacketPools, the PacketBufferPool and the decoded packets' containers, the same packets
+ * (plain, batched and per-packet compressed) are decoded and dispatched through
+ * handleServerPacket/handleClientPacket to inline callbacks many more times, and no allocation
+ * may happen. Packets with strings or maps (eg WorldSnapshot) are not covered, their nodes are
+ * still allocated per entry.
+ */
+
+namespace {
+	std::atomic<bool> counting{ false }; // Only count while dispatching the measured rounds
+	std::atomic<size_t> allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+	if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	constexpr size_t WARMUP_ROUNDS = 4;
+	constexpr size_t MEASURED_ROUNDS = 1000;
+
+	// Every packet type received, so a packet dropped by a decode failure is noticed
+	size_t player_updates = 0;
+	size_t enemy_updates = 0;
+	size_t player_inputs = 0;
+	size_t snapshot_acks = 0;
+	size_t touched = 0; // Fields read by the callbacks, so the decoded packets are really used
+
+	ObjectTransform make_transform(float x, float yaw) {
+		ObjectTransform transform;
+		transform.set_position({ x, 0.5f, -x });
+		transform.set_rotation({ 0.0f, yaw, 0.0f });
+		return transform;
+	}
+
+	PlayerUpdatePacket make_player_update() {
+		PlayerUpdatePacket packet(500, 498);
+		for (uint32_t id = 1; id <= 4; id++) {
+			PlayerUpdateData update;
+			update.id = id;
+			update.fields = PlayerUpdateData::FIELD_TRANSFORM | PlayerUpdateData::FIELD_HEALTH | PlayerUpdateData::FIELD_INVENTORY;
+			update.transform = make_transform(static_cast<float>(id), 90.0f * id);
+			update.health = 100.0f - id;
+			update.inventory = Inventory({ id, id + 100 });
+			packet.updates.push_back(update);
+		}
+		packet.removed = { 7 };
+		return packet;
+	}
+
+	EnemyUpdatePacket make_enemy_update() {
+		EnemyUpdatePacket packet(500, 0);
+		for (uint32_t id = 1; id <= 32; id++) {
+			EnemyUpdateData update;
+			update.id = id;
+			update.fields = EnemyUpdateData::ALL_FIELDS;
+			update.transform = make_transform(-static_cast<float>(id) / 2.0f, 10.0f * id);
+			update.health = 20.0f;
+			packet.updates.push_back(update);
+		}
+		return packet;
+	}
+
+	PacketBuffer encode(Packet&& packet) {
+		PacketBuffer buffer;
+		packet.to_buffer(buffer);
+		return buffer;
+	}
+
+	PacketBuffer batch_of(std::initializer_list<const PacketBuffer*> messages) {
+		PacketBuffer batch;
+		PacketBatch::begin(batch);
+		for (const PacketBuffer* message : messages) {
+			PacketBatch::append(batch, message->data(), message->size());
+		}
+		return batch;
+	}
+
+	// The per-packet compressed form compress_payload sends, whatever COMPRESSION_MODE is set to
+	PacketBuffer compressed(const PacketBuffer& encoded) {
+		PacketBuffer payload;
+		payload.push_back(encoded[0] | PacketCompression::COMPRESSED_FLAG);
+		size_t original_size = encoded.size();
+		while (original_size >= 0x80) {
+			payload.push_back(static_cast<uint8_t>((original_size & 0x7F) | 0x80));
+			original_size >>= 7;
+		}
+		payload.push_back(static_cast<uint8_t>(original_size));
+		LzCodec::compress(encoded.data() + 1, encoded.size() - 1, payload);
+		return payload;
+	}
+
+	ENetPacket* to_enet(const PacketBuffer& buffer) {
+		return enet_packet_create(buffer.data(), buffer.size(), 0);
+	}
+
+	void register_callbacks() {
+		ClientEvents::PlayerUpdateEvent::register_callback([](const ClientEvents::PlayerUpdateEventData& data) {
+			player_updates++;
+			for (const PlayerUpdateData& update : data.packet.updates) touched += update.inventory.item_ids.size();
+		});
+		ClientEvents::EnemyUpdateEvent::register_callback([](const ClientEvents::EnemyUpdateEventData& data) {
+			enemy_updates++;
+			touched += data.packet.updates.size();
+		});
+		ServerEvents::PlayerInputEvent::register_callback([](const ServerEvents::PlayerInputEventData& data) {
+			player_inputs++;
+			touched += data.peer == nullptr ? 1 : 0;
+		});
+		ServerEvents::SnapshotAckEvent::register_callback([](const ServerEvents::SnapshotAckEventData& data) {
+			snapshot_acks++;
+			touched += data.packet.player_sequence > 0 ? 1 : 0;
+		});
+	}
+
+	void test_steady_state_dispatch_does_not_allocate() {
+		register_callbacks();
+
+		PacketBuffer player_update = encode(make_player_update());
+		PacketBuffer enemy_update = encode(make_enemy_update());
+		PacketBuffer player_input = encode(PlayerInputPacket(make_transform(3.0f, 45.0f)));
+		PacketBuffer snapshot_ack = encode(SnapshotAckPacket(500, 499));
+
+		// ENet packets are made up front, the networking thread gets them from enet_host_service
+		std::vector<ENetPacket*> client_packets = {
+			to_enet(player_update),
+			to_enet(enemy_update),
+			to_enet(batch_of({ &player_update, &enemy_update })),
+			to_enet(compressed(enemy_update)),
+		};
+		std::vector<ENetPacket*> server_packets = {
+			to_enet(player_input),
+			to_enet(snapshot_ack),
+			to_enet(batch_of({ &player_input, &snapshot_ack, &player_input })),
+		};
+
+		auto dispatch_round = [&]() {
+			for (ENetPacket* packet : client_packets) PacketRegistry::handleClientPacket(packet);
+			for (ENetPacket* packet : server_packets) PacketRegistry::handleServerPacket(nullptr, packet);
+		};
+
+		for (size_t i = 0; i < WARMUP_ROUNDS; i++) dispatch_round();
+
+		counting.store(true);
+		for (size_t i = 0; i < MEASURED_ROUNDS; i++) dispatch_round();
+		counting.store(false);
+
+		CHECK_MESSAGE(allocations.load() == 0, std::to_string(allocations.load()) + " allocations in "
+			+ std::to_string(MEASURED_ROUNDS) + " rounds");
+
+		size_t rounds = WARMUP_ROUNDS + MEASURED_ROUNDS;
+		CHECK(player_updates == 2 * rounds);
+		CHECK(enemy_updates == 3 * rounds);
+		CHECK(player_inputs == 3 * rounds);
+		CHECK(snapshot_acks == 2 * rounds);
+		CHECK(touched > 0);
+
+		for (ENetPacket* packet : client_packets) enet_packet_destroy(packet);
+		for (ENetPacket* packet : server_packets) enet_packet_destroy(packet);
+	}
+}
+
+int main() {
+	Logger::init();
+	enet_initialize();
+
+	test_steady_state_dispatch_does_not_allocate();
+
+	enet_deinitialize();
+	return TestCheck::result();
+}
@@ -0,0 +1,148 @@
+#include "Imports/common.h"
+#include "Networking/Packet/Instances/Enemy/EnemyUpdate.h"
+#include "Networking/Packet/PacketArchive.h"
+#include "TestSupport.h"
+#include <cereal/archives/binary.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief Times turning a 500-enemy EnemyUpdatePacket into an ENetPacket, the way sends did before
+ * pooled buffers and the ways they do now, and counts the allocations each makes.
+ *
+ * Before: cereal::BinaryOutputArchive into a std::ostringstream, os.str(), then enet_packet_create
+ * copying the string. Pooled: the same bytes written by PacketOutputArchive straight into a
+ * PacketBufferPool buffer that ENet sends without copying. Sent now: to_enet_packet(), bit-packed
+ * and passed through PacketBufferPool::to_enet_packet, which also compresses payloads above
+ * COMPRESSION_THRESHOLD when COMPRESSION_MODE asks for it, so its time includes that.
+ * Allocations are counted through operator new; ENet's own packet struct comes from malloc on
+ * every path and is not counted.
+ *
+ * Usage: PacketEncodeBenchmark [enemies] [rounds]
+ */
+
+namespace {
+	std::atomic<bool> counting{ false }; // Only count while timing
+	std::atomic<size_t> allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+	if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	using namespace TestSupport;
+
+	// Exposes the encoders a packet class can pick between
+	class BenchmarkPacket : public EnemyUpdatePacket {
+	public:
+		// The send path before pooled buffers
+		ENetPacket* to_enet_packet_through_string() {
+			std::ostringstream os;
+			{
+				cereal::BinaryOutputArchive archive(os);
+				archive(static_cast<EnemyUpdatePacket&>(*this));
+			}
+			std::string serialized = os.str();
+			return enet_packet_create(serialized.c_str(), serialized.size(), delivery().enet_flags());
+		}
+
+		// Pooled buffer, byte-for-byte what the path above writes, handed to ENet without compressing it
+		ENetPacket* to_enet_packet_pooled() {
+			std::unique_ptr<PacketBuffer> buffer = PacketBufferPool::acquire();
+			{
+				PacketOutputArchive archive(*buffer);
+				archive(static_cast<EnemyUpdatePacket&>(*this));
+			}
+			ENetPacket* packet = enet_packet_create(buffer->data(), buffer->size(), delivery().enet_flags() | ENET_PACKET_FLAG_NO_ALLOCATE);
+			packet->userData = buffer.release();
+			packet->freeCallback = &release_buffer;
+			return packet;
+		}
+
+	private:
+		static void ENET_CALLBACK release_buffer(void* packet) {
+			PacketBufferPool::release(std::unique_ptr<PacketBuffer>(static_cast<PacketBuffer*>(static_cast<ENetPacket*>(packet)->userData)));
+		}
+	};
+
+	struct Result {
+		double ns = 0.0; // Per packet
+		double allocations = 0.0; // Per packet
+		size_t bytes = 0; // Sent size of one packet
+	};
+
+	void fill(BenchmarkPacket& packet, size_t enemies) {
+		std::mt19937 random(static_cast<uint32_t>(enemies));
+		std::uniform_real_distribution<float> coordinate(-25.0f, 25.0f);
+		std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+		packet.sequence = 100;
+		packet.updates.resize(enemies);
+		for (size_t i = 0; i < enemies; i++) {
+			EnemyUpdateData& update = packet.updates[i];
+			update.id = static_cast<uint32_t>(i + 1);
+			update.transform.set_position({ coordinate(random), 0.5f, coordinate(random) });
+			update.transform.set_rotation({ 0.0f, angle(random), 0.0f });
+			update.health = static_cast<float>(i % 100);
+		}
+	}
+
+	template<class Encode>
+	Result run(Encode encode, size_t rounds) {
+		Result result;
+		for (int i = 0; i < 3; i++) enet_packet_destroy(encode()); // Warm up the pool and scratch columns
+
+		allocations.store(0);
+		counting.store(true);
+		auto start = Clock::now();
+		for (size_t i = 0; i < rounds; i++) {
+			ENetPacket* packet = encode();
+			if (i == 0) result.bytes = packet->dataLength;
+			enet_packet_destroy(packet);
+		}
+		result.ns = elapsed_ns(start) / rounds;
+		counting.store(false);
+		result.allocations = static_cast<double>(allocations.load()) / rounds;
+		return result;
+	}
+
+	void print(const char* path, const Result& result) {
+		std::printf("  %-36s %9.0f ns, %6zu bytes, %5.1f allocations per packet\n", path, result.ns, result.bytes, result.allocations);
+	}
+}
+
+int main(int argc, char** argv) {
+	long enemies_argument = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	long rounds_argument = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 0;
+	size_t enemies = enemies_argument > 0 ? static_cast<size_t>(enemies_argument) : 500;
+	size_t rounds = rounds_argument > 0 ? static_cast<size_t>(rounds_argument) : 2000;
+
+	Logger::init();
+
+	BenchmarkPacket packet;
+	fill(packet, enemies);
+
+	std::printf("EnemyUpdatePacket with %zu enemies, %zu rounds\n", enemies, rounds);
+	print("ostringstream, str(), copy", run([&]() { return packet.to_enet_packet_through_string(); }, rounds));
+	print("pooled buffer, same bytes", run([&]() { return packet.to_enet_packet_pooled(); }, rounds));
+	print("bit-packed, to_enet_packet (sent now)", run([&]() { return packet.to_enet_packet(); }, rounds));
+	return 0;
+}
@@ -0,0 +1,603 @@
+#include "Imports/common.h"
+#include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/TransformCodec.h"
+#include "Game/Events/EventList.h" // Includes every packet class
+#include "TestCheck.h"
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Round-trips a sample of every packet type in ECHO_PACKET_LIST through its own encoder and
+ * PacketRegistry::deserialize, the path every received packet takes.
+ *
+ * The decoded packet must re-encode to the same bytes and match the sample field by field,
+ * including bit-packed bools, ranged enums, varints, quantized transforms and column lists.
+ * Every packet cut one byte short must be rejected. A packet type without a sample and a
+ * check_fields overload below does not compile, so a new type cannot be left out.
+ *
+ * Each sample is also encoded with the fixed-width PacketOutputArchive that packets used before
+ * they were bit-packed, and the bytes each type saves are printed as a table.
+ */
+
+namespace {
+	constexpr uint64_t SAMPLE_TIMESTAMP = 1760000000123ull; // Wide enough to need a long varint
+	constexpr float MAX_POSITION_ERROR = TransformCodec::POSITION_STEP / 2.0f + 1e-5f;
+	constexpr float MAX_YAW_ERROR = TransformCodec::YAW_STEP / 2.0f + 1e-4f;
+
+	template<class PacketType>
+	PacketType make_sample() {
+		static_assert(sizeof(PacketType) == 0, "Add a sample (and a check_fields overload) for the new packet type");
+	}
+
+	ObjectTransform sample_transform(float x, float yaw) {
+		ObjectTransform transform;
+		transform.set_position({ x, 0.75f, -x / 2.0f });
+		transform.set_rotation({ 12.0f, yaw, -3.5f });
+		transform.set_scale({ 1.5f, 2.0f, 0.5f });
+		transform.set_has_collision(false);
+		transform.set_is_static(true);
+		return transform;
+	}
+
+	Inventory sample_inventory() {
+		return Inventory({ 1, 200, 70000 });
+	}
+
+	// Quantized transforms only carry position and yaw, within the codec's error bounds
+	bool replicated_matches(const ObjectTransform& sent, const ObjectTransform& received) {
+		raylib::Vector3 a = sent.get_position();
+		raylib::Vector3 b = received.get_position();
+		float yaw_error = std::fmod(std::fabs(sent.get_rotation().y - received.get_rotation().y), 360.0f);
+		yaw_error = (std::min)(yaw_error, 360.0f - yaw_error);
+
+		return std::fabs(a.x - b.x) <= MAX_POSITION_ERROR && std::fabs(a.y - b.y) <= MAX_POSITION_ERROR
+			&& std::fabs(a.z - b.z) <= MAX_POSITION_ERROR && yaw_error <= MAX_YAW_ERROR;
+	}
+
+	// Client -> Server
+
+	template<> ConnectionInitiationPacket make_sample<ConnectionInitiationPacket>() {
+		return ConnectionInitiationPacket("Dungeon Crawler \xC3\x84\xC3\x96"); // Non-ASCII UTF-8 bytes too
+	}
+
+	void check_fields(const ConnectionInitiationPacket& sent, const ConnectionInitiationPacket& received) {
+		CHECK(received.client_preferred_username == sent.client_preferred_username);
+	}
+
+	template<> DisconnectInfoPacket make_sample<DisconnectInfoPacket>() {
+		return DisconnectInfoPacket("Closed the game");
+	}
+
+	void check_fields(const DisconnectInfoPacket& sent, const DisconnectInfoPacket& received) {
+		CHECK(received.disconnect_reason == sent.disconnect_reason);
+	}
+
+	template<> GeneralInformationUpdatePacket make_sample<GeneralInformationUpdatePacket>() {
+		return GeneralInformationUpdatePacket("World");
+	}
+
+	void check_fields(const GeneralInformationUpdatePacket& sent, const GeneralInformationUpdatePacket& received) {
+		CHECK(received.current_state == sent.current_state);
+	}
+
+	template<> PlayerInputPacket make_sample<PlayerInputPacket>() {
+		return PlayerInputPacket(sample_transform(3.25f, 271.5f));
+	}
+
+	void check_fields(const PlayerInputPacket& sent, const PlayerInputPacket& received) {
+		CHECK(replicated_matches(sent.transform, received.transform));
+	}
+
+	template<> RequestWorldSnapshotPacket make_sample<RequestWorldSnapshotPacket>() {
+		return RequestWorldSnapshotPacket();
+	}
+
+	void check_fields(const RequestWorldSnapshotPacket&, const RequestWorldSnapshotPacket&) {
+		// Header only
+	}
+
+	template<> PlayerAttackPacket make_sample<PlayerAttackPacket>() {
+		return PlayerAttackPacket(70000);
+	}
+
+	void check_fields(const PlayerAttackPacket& sent, const PlayerAttackPacket& received) {
+		CHECK(received.player_id == sent.player_id);
+	}
+
+	template<> ItemDiscardPacket make_sample<ItemDiscardPacket>() {
+		return ItemDiscardPacket(300);
+	}
+
+	void check_fields(const ItemDiscardPacket& sent, const ItemDiscardPacket& received) {
+		CHECK(received.item_id == sent.item_id);
+	}
+
+	template<> SnapshotAckPacket make_sample<SnapshotAckPacket>() {
+		return SnapshotAckPacket(123456, 0xFFFFFFFFu); // Largest varint
+	}
+
+	void check_fields(const SnapshotAckPacket& sent, const SnapshotAckPacket& received) {
+		CHECK(received.player_sequence == sent.player_sequence);
+		CHECK(received.enemy_sequence == sent.enemy_sequence);
+	}
+
+	// Server -> Client
+
+	template<> ConnectionRefusalPacket make_sample<ConnectionRefusalPacket>() {
+		return ConnectionRefusalPacket("Server full");
+	}
+
+	void check_fields(const ConnectionRefusalPacket& sent, const ConnectionRefusalPacket& received) {
+		CHECK(received.refusal_reason == sent.refusal_reason);
+	}
+
+	template<> ConnectionConfirmationPacket make_sample<ConnectionConfirmationPacket>() {
+		return ConnectionConfirmationPacket(65535);
+	}
+
+	void check_fields(const ConnectionConfirmationPacket& sent, const ConnectionConfirmationPacket& received) {
+		CHECK(received.client_assigned_id == sent.client_assigned_id);
+	}
+
+	template<> DisconnectKickPacket make_sample<DisconnectKickPacket>() {
+		return DisconnectKickPacket(""); // Empty strings still need their size
+	}
+
+	void check_fields(const DisconnectKickPacket& sent, const DisconnectKickPacket& received) {
+		CHECK(received.disconnect_reason == sent.disconnect_reason);
+	}
+
+	template<> ServerDataUpdatePacket make_sample<ServerDataUpdatePacket>() {
+		UserData host;
+		host.server_side_id = 1;
+		host.username = "Host";
+		host.is_host = true;
+		host.ip_address = "127.0.0.1";
+		host.connected_at = SAMPLE_TIMESTAMP;
+		host.last_packet_time = SAMPLE_TIMESTAMP + 5;
+		host.status = UserStatus::CONNECTED;
+		host.current_state = "Lobby";
+
+		UserData joining = host;
+		joining.server_side_id = 300;
+		joining.username = "Joining";
+		joining.is_host = false;
+		joining.status = UserStatus::CONNECTING;
+
+		OpenServer server_info;
+		server_info.address = "0.0.0.0";
+		server_info.external_address = "203.0.113.7";
+		server_info.port = 7777;
+		server_info.closed = true;
+		server_info.lobby_name = "Test Lobby";
+		server_info.max_players = 255;
+
+		return ServerDataUpdatePacket({ { 1, host }, { 300, joining } }, server_info);
+	}
+
+	void check_fields(const ServerDataUpdatePacket& sent, const ServerDataUpdatePacket& received) {
+		CHECK(received.current_peers.size() == sent.current_peers.size());
+		for (const auto& [peer_id, user] : sent.current_peers) {
+			auto it = received.current_peers.find(peer_id);
+			CHECK_MESSAGE(it != received.current_peers.end(), "peer " + std::to_string(peer_id));
+			if (it == received.current_peers.end()) continue;
+
+			const UserData& decoded = it->second;
+			CHECK(decoded.server_side_id == user.server_side_id);
+			CHECK(decoded.username == user.username);
+			CHECK(decoded.is_host == user.is_host);
+			CHECK(decoded.ip_address == user.ip_address);
+			CHECK(decoded.connected_at == user.connected_at);
+			CHECK(decoded.last_packet_time == user.last_packet_time);
+			CHECK(decoded.status == user.status);
+			CHECK(decoded.current_state == user.current_state);
+		}
+
+		CHECK(received.server_info.address == sent.server_info.address);
+		CHECK(received.server_info.external_address == sent.server_info.external_address);
+		CHECK(received.server_info.port == sent.server_info.port);
+		CHECK(received.server_info.closed == sent.server_info.closed);
+		CHECK(received.server_info.lobby_name == sent.server_info.lobby_name);
+		CHECK(received.server_info.max_players == sent.server_info.max_players);
+	}
+
+	template<> StateChangePacket make_sample<StateChangePacket>() {
+		return StateChangePacket("World");
+	}
+
+	void check_fields(const StateChangePacket& sent, const StateChangePacket& received) {
+		CHECK(received.new_state == sent.new_state);
+	}
+
+	template<> WorldSnapshotPacket make_sample<WorldSnapshotPacket>() {
+		std::unordered_map<uint32_t, Player> players;
+		for (uint32_t id : { 1u, 2u }) {
+			Player player(id, false, "Player " + std::to_string(id));
+			player.transform = sample_transform(static_cast<float>(id), 90.0f * id);
+			player.health = 55.5f;
+			player.damage = 12.0f;
+			player.max_health = 120.0f;
+			player.range = 2.5f;
+			player.speed = 3.0f;
+			player.attack_cooldown = 450;
+			player.base_attack_cooldown = 600;
+			player.inventory = sample_inventory();
+			players.emplace(id, player);
+		}
+
+		std::unordered_map<uint32_t, Object> objects;
+		objects.emplace(7, Object(7, "wall", ObjectType::MODEL));
+		objects.emplace(8, Object(8, "torch", ObjectType::IMAGE_MODEL));
+		objects.at(8).transform = sample_transform(-4.0f, 45.0f);
+		objects.at(8).color = raylib::Color(10, 20, 30, 40);
+
+		std::unordered_map<uint32_t, Enemy> enemies;
+		enemies.emplace(100000, Enemy(100000, 80.0f, 1.5f, 7.0f, "skeleton"));
+		enemies.at(100000).health = 33.0f;
+		enemies.at(100000).transform = sample_transform(20.0f, 359.0f);
+
+		return WorldSnapshotPacket(players, objects, enemies);
+	}
+
+	void check_fields(const WorldSnapshotPacket& sent, const WorldSnapshotPacket& received) {
+		CHECK(received.players.size() == sent.players.size());
+		for (const auto& [id, player] : sent.players) {
+			auto it = received.players.find(id);
+			CHECK_MESSAGE(it != received.players.end(), "player " + std::to_string(id));
+			if (it == received.players.end()) continue;
+
+			const Player& decoded = it->second;
+			CHECK(decoded.id == player.id);
+			CHECK(decoded.is_local == player.is_local);
+			CHECK(decoded.name == player.name);
+			CHECK(decoded.transform == player.transform); // Snapshots keep the full transform
+			CHECK(decoded.health == player.health);
+			CHECK(decoded.asset_id == player.asset_id);
+			CHECK(decoded.damage == player.damage);
+			CHECK(decoded.max_health == player.max_health);
+			CHECK(decoded.range == player.range);
+			CHECK(decoded.speed == player.speed);
+			CHECK(decoded.attack_cooldown == player.attack_cooldown);
+			CHECK(decoded.base_attack_cooldown == player.base_attack_cooldown);
+			CHECK(decoded.inventory == player.inventory);
+		}
+
+		CHECK(received.objects.size() == sent.objects.size());
+		for (const auto& [id, object] : sent.objects) {
+			auto it = received.objects.find(id);
+			CHECK_MESSAGE(it != received.objects.end(), "object " + std::to_string(id));
+			if (it == received.objects.end()) continue;
+
+			const Object& decoded = it->second;
+			CHECK(decoded.id == object.id);
+			CHECK(decoded.asset_id == object.asset_id);
+			CHECK(decoded.GetType() == object.GetType());
+			CHECK(decoded.transform == object.transform);
+			CHECK(decoded.color.r == object.color.r && decoded.color.g == object.color.g
+				&& decoded.color.b == object.color.b && decoded.color.a == object.color.a);
+		}
+
+		CHECK(received.enemies.size() == sent.enemies.size());
+		for (const auto& [id, enemy] : sent.enemies) {
+			auto it = received.enemies.find(id);
+			CHECK_MESSAGE(it != received.enemies.end(), "enemy " + std::to_string(id));
+			if (it == received.enemies.end()) continue;
+
+			const Enemy& decoded = it->second;
+			CHECK(decoded.id == enemy.id);
+			CHECK(decoded.max_health == enemy.max_health);
+			CHECK(decoded.health == enemy.health);
+			CHECK(decoded.speed == enemy.speed);
+			CHECK(decoded.damage == enemy.damage);
+			CHECK(decoded.transform == enemy.transform);
+			CHECK(decoded.asset_id == enemy.asset_id);
+		}
+	}
+
+	// Player packets
+
+	template<> PlayerSpawnPacket make_sample<PlayerSpawnPacket>() {
+		return PlayerSpawnPacket(4, "Spawned", sample_transform(-12.5f, 180.0f), 90.0f, 110.0f, 11.0f,
+			2.25f, 2.75f, 400, SAMPLE_TIMESTAMP, "knight", sample_inventory());
+	}
+
+	void check_fields(const PlayerSpawnPacket& sent, const PlayerSpawnPacket& received) {
+		CHECK(received.id == sent.id);
+		CHECK(received.name == sent.name);
+		CHECK(received.transform == sent.transform);
+		CHECK(received.health == sent.health);
+		CHECK(received.max_health == sent.max_health);
+		CHECK(received.damage == sent.damage);
+		CHECK(received.range == sent.range);
+		CHECK(received.speed == sent.speed);
+		CHECK(received.attack_cooldown == sent.attack_cooldown);
+		CHECK(received.last_attack_time == sent.last_attack_time);
+		CHECK(received.asset_id == sent.asset_id);
+		CHECK(received.inventory == sent.inventory);
+	}
+
+	template<> PlayerUpdatePacket make_sample<PlayerUpdatePacket>() {
+		PlayerUpdatePacket packet(1000, 998);
+
+		PlayerUpdateData full;
+		full.id = 1;
+		full.fields = PlayerUpdateData::ALL_FIELDS;
+		full.transform = sample_transform(5.5f, 30.0f);
+		full.health = 42.0f;
+		full.damage = 13.0f;
+		full.max_health = 130.0f;
+		full.range = 3.0f;
+		full.speed = 4.0f;
+		full.attack_cooldown = 350;
+		full.last_attack_time = SAMPLE_TIMESTAMP;
+		full.attacking = true;
+		full.inventory = sample_inventory();
+		packet.updates.push_back(full);
+
+		PlayerUpdateData moved;
+		moved.id = 2;
+		moved.fields = PlayerUpdateData::FIELD_TRANSFORM;
+		moved.transform = sample_transform(-25.5f, -45.0f);
+		packet.updates.push_back(moved);
+
+		PlayerUpdateData attacked;
+		attacked.id = 70000;
+		attacked.fields = PlayerUpdateData::FIELD_HEALTH | PlayerUpdateData::FIELD_ATTACKING | PlayerUpdateData::FIELD_INVENTORY;
+		attacked.health = 0.0f;
+		attacked.attacking = true;
+		attacked.inventory = Inventory({ 9 });
+		packet.updates.push_back(attacked);
+
+		packet.removed = { 5, 700000 };
+		return packet;
+	}
+
+	void check_fields(const PlayerUpdatePacket& sent, const PlayerUpdatePacket& received) {
+		CHECK(received.sequence == sent.sequence);
+		CHECK(received.baseline_sequence == sent.baseline_sequence);
+		CHECK(received.removed == sent.removed);
+		CHECK(received.updates.size() == sent.updates.size());
+		if (received.updates.size() != sent.updates.size()) return;
+
+		for (size_t i = 0; i < sent.updates.size(); i++) {
+			const PlayerUpdateData& row = sent.updates[i];
+			const PlayerUpdateData& decoded = received.updates[i];
+			CHECK(decoded.id == row.id);
+			CHECK(decoded.fields == row.fields);
+			if (row.fields & PlayerUpdateData::FIELD_TRANSFORM) CHECK(replicated_matches(row.transform, decoded.transform));
+			if (row.fields & PlayerUpdateData::FIELD_HEALTH) CHECK(decoded.health == row.health);
+			if (row.fields & PlayerUpdateData::FIELD_DAMAGE) CHECK(decoded.damage == row.damage);
+			if (row.fields & PlayerUpdateData::FIELD_MAX_HEALTH) CHECK(decoded.max_health == row.max_health);
+			if (row.fields & PlayerUpdateData::FIELD_RANGE) CHECK(decoded.range == row.range);
+			if (row.fields & PlayerUpdateData::FIELD_SPEED) CHECK(decoded.speed == row.speed);
+			if (row.fields & PlayerUpdateData::FIELD_ATTACK_COOLDOWN) CHECK(decoded.attack_cooldown == row.attack_cooldown);
+			if (row.fields & PlayerUpdateData::FIELD_LAST_ATTACK_TIME) CHECK(decoded.last_attack_time == row.last_attack_time);
+			if (row.fields & PlayerUpdateData::FIELD_ATTACKING) CHECK(decoded.attacking == row.attacking);
+			if (row.fields & PlayerUpdateData::FIELD_INVENTORY) CHECK(decoded.inventory == row.inventory);
+		}
+	}
+
+	template<> PlayerDestroyPacket make_sample<PlayerDestroyPacket>() {
+		return PlayerDestroyPacket(9);
+	}
+
+	void check_fields(const PlayerDestroyPacket& sent, const PlayerDestroyPacket& received) {
+		CHECK(received.id == sent.id);
+	}
+
+	// Enemy packets
+
+	template<> EnemySpawnPacket make_sample<EnemySpawnPacket>() {
+		return EnemySpawnPacket(100001, sample_transform(8.0f, 10.0f), 75.0f, 80.0f, 6.5f, 1.25f, false, "skeleton");
+	}
+
+	void check_fields(const EnemySpawnPacket& sent, const EnemySpawnPacket& received) {
+		CHECK(received.id == sent.id);
+		CHECK(received.transform == sent.transform);
+		CHECK(received.health == sent.health);
+		CHECK(received.max_health == sent.max_health);
+		CHECK(received.damage == sent.damage);
+		CHECK(received.speed == sent.speed);
+		CHECK(received.spawns_items == sent.spawns_items);
+		CHECK(received.asset_id == sent.asset_id);
+	}
+
+	template<> EnemyUpdatePacket make_sample<EnemyUpdatePacket>() {
+		EnemyUpdatePacket packet(1000, 0);
+
+		EnemyUpdateData full;
+		full.id = 100000;
+		full.fields = EnemyUpdateData::ALL_FIELDS;
+		full.transform = sample_transform(31.0f, 123.4f);
+		full.health = 12.5f;
+		packet.updates.push_back(full);
+
+		EnemyUpdateData moved;
+		moved.id = 3;
+		moved.fields = EnemyUpdateData::FIELD_TRANSFORM;
+		moved.transform = sample_transform(-31.0f, 0.0f);
+		packet.updates.push_back(moved);
+
+		EnemyUpdateData hurt;
+		hurt.id = 4;
+		hurt.fields = EnemyUpdateData::FIELD_HEALTH;
+		hurt.health = 1.0f;
+		packet.updates.push_back(hurt);
+
+		packet.removed = { 6 };
+		return packet;
+	}
+
+	void check_fields(const EnemyUpdatePacket& sent, const EnemyUpdatePacket& received) {
+		CHECK(received.sequence == sent.sequence);
+		CHECK(received.baseline_sequence == sent.baseline_sequence);
+		CHECK(received.removed == sent.removed);
+		CHECK(received.updates.size() == sent.updates.size());
+		if (received.updates.size() != sent.updates.size()) return;
+
+		for (size_t i = 0; i < sent.updates.size(); i++) {
+			const EnemyUpdateData& row = sent.updates[i];
+			const EnemyUpdateData& decoded = received.updates[i];
+			CHECK(decoded.id == row.id);
+			CHECK(decoded.fields == row.fields);
+			if (row.fields & EnemyUpdateData::FIELD_TRANSFORM) CHECK(replicated_matches(row.transform, decoded.transform));
+			if (row.fields & EnemyUpdateData::FIELD_HEALTH) CHECK(decoded.health == row.health);
+		}
+	}
+
+	template<> EnemyDestroyPacket make_sample<EnemyDestroyPacket>() {
+		return EnemyDestroyPacket(100000);
+	}
+
+	void check_fields(const EnemyDestroyPacket& sent, const EnemyDestroyPacket& received) {
+		CHECK(received.id == sent.id);
+	}
+
+	// Object packets
+
+	template<> ObjectSpawnPacket make_sample<ObjectSpawnPacket>() {
+		return ObjectSpawnPacket(12, "crate", ObjectType::IMAGE_MODEL, sample_transform(1.0f, 2.0f), raylib::Color(200, 100, 50, 25));
+	}
+
+	void check_fields(const ObjectSpawnPacket& sent, const ObjectSpawnPacket& received) {
+		CHECK(received.id == sent.id);
+		CHECK(received.asset_id == sent.asset_id);
+		CHECK(received.object_type == sent.object_type);
+		CHECK(received.transform == sent.transform);
+		CHECK(received.color.r == sent.color.r && received.color.g == sent.color.g
+			&& received.color.b == sent.color.b && received.color.a == sent.color.a);
+	}
+
+	template<> ObjectDestroyPacket make_sample<ObjectDestroyPacket>() {
+		return ObjectDestroyPacket(12);
+	}
+
+	void check_fields(const ObjectDestroyPacket& sent, const ObjectDestroyPacket& received) {
+		CHECK(received.id == sent.id);
+	}
+
+	// Item packets
+
+	template<> ItemPickupPacket make_sample<ItemPickupPacket>() {
+		ItemEffects effects;
+		effects.healing = 25;
+		effects.max_health_boost = -10; // Negative ints are zigzag varints
+		effects.damage_percentage_boost = 0.15f;
+		effects.speed_boost = 0.5f;
+		effects.atk_cooldown_reduction = 50;
+		effects.atk_cooldown_percent_reduction = 0.1f;
+		return ItemPickupPacket(3, Item(77, "ring", "Ring of Speed", effects));
+	}
+
+	void check_fields(const ItemPickupPacket& sent, const ItemPickupPacket& received) {
+		CHECK(received.player_id == sent.player_id);
+		CHECK(received.item.id == sent.item.id);
+		CHECK(received.item.asset_id == sent.item.asset_id);
+		CHECK(received.item.item_name == sent.item.item_name);
+
+		const ItemEffects& a = sent.item.effects;
+		const ItemEffects& b = received.item.effects;
+		CHECK(b.healing == a.healing && b.healing_percentage == a.healing_percentage);
+		CHECK(b.max_health_boost == a.max_health_boost && b.max_health_percentage_boost == a.max_health_percentage_boost);
+		CHECK(b.damage_boost == a.damage_boost && b.damage_percentage_boost == a.damage_percentage_boost);
+		CHECK(b.speed_boost == a.speed_boost && b.speed_percentage_boost == a.speed_percentage_boost);
+		CHECK(b.range_boost == a.range_boost && b.range_percentage_boost == a.range_percentage_boost);
+		CHECK(b.atk_cooldown_reduction == a.atk_cooldown_reduction);
+		CHECK(b.atk_cooldown_percent_reduction == a.atk_cooldown_percent_reduction);
+	}
+
+	struct EncodedSizes {
+		std::string name;
+		size_t fixed_width = 0; // PacketOutputArchive
+		size_t encoded = 0; // The packet's own encoder
+	};
+	std::vector<EncodedSizes> sizes;
+
+	void print_sizes() {
+		size_t total_fixed = 0;
+		size_t total_encoded = 0;
+		std::printf("%-28s %12s %12s %8s\n", "Packet (sample)", "fixed width", "bit-packed", "saved");
+		for (const EncodedSizes& entry : sizes) {
+			std::printf("%-28s %12zu %12zu %7.0f%%\n", entry.name.c_str(), entry.fixed_width, entry.encoded,
+				100.0 * (1.0 - static_cast<double>(entry.encoded) / static_cast<double>(entry.fixed_width)));
+			total_fixed += entry.fixed_width;
+			total_encoded += entry.encoded;
+		}
+		std::printf("%-28s %12zu %12zu %7.0f%%\n", "All samples", total_fixed, total_encoded,
+			100.0 * (1.0 - static_cast<double>(total_encoded) / static_cast<double>(total_fixed)));
+	}
+
+	// Decodes data through the registry, as a received ENet packet
+	std::unique_ptr<Packet> decode(const uint8_t* data, size_t size) {
+		ENetPacket* enet_packet = enet_packet_create(data, size, 0);
+		std::unique_ptr<Packet> packet = PacketRegistry::deserialize(enet_packet);
+		enet_packet_destroy(enet_packet);
+		return packet;
+	}
+
+	// Names come straight from the type table, so they can be looked up at compile time
+	static_assert(PacketRegistry::getPacketName(0xFF) == "Unknown");
+
+	template<class PacketType>
+	void test_round_trip(uint8_t id, const std::string& name) {
+		PacketType sent = make_sample<PacketType>();
+		sent.header.timestamp = SAMPLE_TIMESTAMP;
+		CHECK_MESSAGE(sent.header.type == id, name);
+		CHECK_MESSAGE(PacketRegistry::getPacketName(id) == name, name);
+
+		PacketBuffer encoded;
+		sent.to_buffer(encoded);
+		CHECK_MESSAGE(!encoded.empty() && encoded[0] == id, name);
+
+		PacketBuffer fixed_width;
+		PacketOutputArchive fixed_width_archive(fixed_width);
+		fixed_width_archive(sent);
+		fixed_width_archive.flush();
+		sizes.push_back({ name, fixed_width.size(), encoded.size() });
+
+		std::unique_ptr<Packet> decoded = decode(encoded.data(), encoded.size());
+		PacketType* received = dynamic_cast<PacketType*>(decoded.get());
+		CHECK_MESSAGE(received != nullptr, name + " did not decode to its own class");
+		if (!received) return;
+
+		CHECK_MESSAGE(received->header.type == id, name);
+		CHECK_MESSAGE(received->header.timestamp == SAMPLE_TIMESTAMP, name);
+		check_fields(sent, *received);
+
+		// Maps come back in an unspecified order, so only their encoded size has to match
+		PacketBuffer reencoded;
+		received->to_buffer(reencoded);
+		constexpr bool has_unordered_fields = std::is_same<PacketType, WorldSnapshotPacket>::value
+			|| std::is_same<PacketType, ServerDataUpdatePacket>::value;
+		if (has_unordered_fields) {
+			CHECK_MESSAGE(reencoded.size() == encoded.size(), name);
+		}
+		else {
+			CHECK_MESSAGE(reencoded == encoded, name + " re-encoded differently");
+		}
+
+		// A truncated packet is rejected, never half decoded
+		std::unique_ptr<Packet> truncated = decode(encoded.data(), encoded.size() - 1);
+		CHECK_MESSAGE(truncated == nullptr, name + " decoded with its last byte missing");
+	}
+}
+
+int main() {
+	Logger::init();
+	enet_initialize();
+
+	size_t tested = 0;
+#define TEST_PACKET_ROUND_TRIP(Id, BaseName, Direction, Delivery) \
+	test_round_trip<BaseName##Packet>(Id, #BaseName); \
+	tested++;
+	ECHO_PACKET_LIST(TEST_PACKET_ROUND_TRIP)
+#undef TEST_PACKET_ROUND_TRIP
+
+	CHECK(tested == std::size(PacketTypes::ALL));
+	print_sizes();
+
+	enet_deinitialize();
+	return TestCheck::result();
+}
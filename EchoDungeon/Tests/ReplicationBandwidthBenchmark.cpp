@@ -0,0 +1,156 @@
+#include "Imports/common.h"
+#include "Game/World/Systems/DeltaReplication.h"
+#include "Networking/Packet/Instances/Enemy/EnemyUpdate.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Measures the bandwidth one client's EnemyUpdatePackets take with hundreds of zombies
+ * that mostly stand still, sent as full state every tick and as deltas against the snapshot
+ * the client acknowledged, and what decoding a delta costs the client.
+ *
+ * Every replication tick a share of the zombies moves, a few take damage and now and then one
+ * dies and another spawns. The server builds its snapshot over the previous one and encodes
+ * against the client's acknowledged baseline, which lags a few ticks behind like acks crossing
+ * a real connection. Bytes are the packets' payloads as to_enet_packet() produces them, ENet
+ * and UDP headers not included. Decoding is timed with the shared shards DeltaReplication::decode
+ * uses, next to copying the whole baseline into a new map first as it used to.
+ *
+ * Usage: ReplicationBandwidthBenchmark [zombies] [percent moving per tick] [ack delay in ticks]
+ */
+
+namespace {
+	using Replication = DeltaReplication<EnemyUpdateData>;
+	using Snapshot = EntitySnapshot<EnemyUpdateData>;
+	using namespace TestSupport;
+
+	constexpr uint32_t REPLICATION_RATE = 30; // ServerWorldManager::REPLICATION_RATE
+	constexpr uint32_t TICKS = 30 * 20; // 20 seconds of replication
+
+	struct Result {
+		double bytes_per_second = 0.0;
+		double decode_us = 0.0; // Per tick, sharing shards with the baseline
+		double copying_decode_us = 0.0; // Per tick, copying the baseline first
+	};
+
+	// What decoding did before snapshots shared shards
+	std::unordered_map<uint32_t, EnemyUpdateData> copying_decode(const Snapshot* baseline,
+		const std::vector<EnemyUpdateData>& updates, const std::vector<uint32_t>& removed) {
+		std::unordered_map<uint32_t, EnemyUpdateData> entities;
+		if (baseline) {
+			for (const auto& [id, state] : baseline->entities) entities.emplace(id, state);
+		}
+		for (uint32_t id : removed) entities.erase(id);
+		for (const EnemyUpdateData& delta : updates) {
+			auto it = entities.find(delta.id);
+			if (it == entities.end()) it = entities.emplace(delta.id, delta).first;
+			else it->second.apply_delta(delta);
+			it->second.fields = EnemyUpdateData::ALL_FIELDS;
+		}
+		return entities;
+	}
+
+	Result run(size_t zombies, uint32_t percent_moving, uint32_t ack_delay, bool deltas) {
+		std::mt19937 random(11);
+		std::uniform_real_distribution<float> coordinate(-25.0f, 25.0f);
+		std::map<uint32_t, EnemyUpdateData> world;
+		uint32_t next_id = 1;
+		auto spawn = [&]() {
+			EnemyUpdateData& zombie = world[next_id];
+			zombie.id = next_id++;
+			zombie.transform.set_position({ coordinate(random), 0.5f, coordinate(random) });
+			zombie.health = 100.0f;
+		};
+		for (size_t i = 0; i < zombies; i++) spawn();
+
+		SnapshotHistory<EnemyUpdateData> server_history;
+		SnapshotHistory<EnemyUpdateData> client_history;
+		size_t bytes = 0;
+		double decode_us = 0.0;
+		double copying_decode_us = 0.0;
+
+		for (uint32_t sequence = 1; sequence <= TICKS; sequence++) {
+			for (auto& [id, zombie] : world) {
+				uint32_t roll = random() % 100;
+				if (roll < percent_moving) {
+					raylib::Vector3 position = zombie.transform.get_position();
+					zombie.transform.set_position({ position.x + 0.1f, position.y, position.z });
+				}
+				else if (roll == 99 && random() % 4 == 0) {
+					zombie.health -= 10.0f;
+				}
+			}
+			if (sequence % REPLICATION_RATE == 0) {
+				world.erase(std::next(world.begin(), random() % world.size()));
+				spawn();
+			}
+
+			auto snapshot = std::make_shared<Snapshot>();
+			snapshot->sequence = sequence;
+			if (auto previous = server_history.latest()) snapshot->entities = previous->entities;
+			for (const auto& [id, zombie] : world) snapshot->entities.update(zombie);
+			snapshot->entities.erase_if([&](uint32_t id, const EnemyUpdateData&) { return world.find(id) == world.end(); });
+			server_history.push(snapshot);
+
+			// The client has acknowledged the snapshot from ack_delay ticks ago
+			std::shared_ptr<const Snapshot> server_baseline;
+			std::shared_ptr<const Snapshot> client_baseline;
+			if (deltas && sequence > ack_delay) {
+				server_baseline = server_history.find(sequence - ack_delay);
+				client_baseline = client_history.find(sequence - ack_delay);
+			}
+
+			EnemyUpdatePacket packet(sequence, server_baseline ? server_baseline->sequence : 0);
+			Replication::encode(server_baseline.get(), *snapshot, packet.updates, packet.removed);
+			if (!packet.updates.empty() || !packet.removed.empty()) {
+				ENetPacket* enet_packet = packet.to_enet_packet();
+				bytes += enet_packet->dataLength;
+				enet_packet_destroy(enet_packet);
+			}
+
+			auto start = Clock::now();
+			auto decoded = Replication::decode(client_baseline.get(), sequence, packet.updates, packet.removed);
+			decode_us += elapsed_us(start);
+			client_history.push(decoded);
+
+			start = Clock::now();
+			auto copied = copying_decode(client_baseline.get(), packet.updates, packet.removed);
+			copying_decode_us += elapsed_us(start);
+			if (copied.size() != decoded->entities.size()) std::printf("  decoders disagree at tick %u\n", sequence);
+		}
+
+		Result result;
+		result.bytes_per_second = static_cast<double>(bytes) / TICKS * REPLICATION_RATE;
+		result.decode_us = decode_us / TICKS;
+		result.copying_decode_us = copying_decode_us / TICKS;
+		return result;
+	}
+
+	void print(const char* mode, const Result& result) {
+		std::printf("  %-6s %8.1f KB/s, decode %7.1f us per tick (copying the baseline: %7.1f us)\n",
+			mode, result.bytes_per_second / 1024.0, result.decode_us, result.copying_decode_us);
+	}
+}
+
+int main(int argc, char** argv) {
+	long zombies_argument = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	long moving_argument = argc > 2 ? std::strtol(argv[2], nullptr, 10) : -1;
+	long delay_argument = argc > 3 ? std::strtol(argv[3], nullptr, 10) : -1;
+	size_t zombies = zombies_argument > 0 ? static_cast<size_t>(zombies_argument) : 300;
+	uint32_t percent_moving = moving_argument >= 0 && moving_argument <= 100 ? static_cast<uint32_t>(moving_argument) : 5;
+	uint32_t ack_delay = delay_argument >= 1 ? static_cast<uint32_t>(delay_argument) : 3;
+
+	Logger::init();
+
+	std::printf("%zu zombies, %u%% moving per tick, acks %u ticks behind, %u Hz, one client\n",
+		zombies, percent_moving, ack_delay, REPLICATION_RATE);
+	print("full", run(zombies, percent_moving, ack_delay, false));
+	print("delta", run(zombies, percent_moving, ack_delay, true));
+	return 0;
+}
@@ -0,0 +1,226 @@
+#include "Imports/common.h"
+#include "Game/Room.h"
+#include "Networking/Packet/PacketBatch.h"
+#include "Networking/Packet/PacketCompression.h"
+#include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/Instances/ConnectionConfirmation.h"
+#include "Networking/Packet/Instances/ConnectionInitiation.h"
+#include "Networking/Packet/Instances/RequestWorldSnapshot.h"
+#include "Networking/Packet/Instances/StateChange.h"
+#include "Networking/Packet/Instances/WorldSnapshot.h"
+#include "TestCheck.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs two rooms in one process, as the dedicated server does, with clients connected over
+ * loopback: two play in each room and one stays in the lobby. Only a room's players must be sent
+ * its state change, a snapshot request must be answered by the world of the sender's room with
+ * exactly that room's players, and packets from the lobby must reach no world. Once one room's
+ * players leave, that room must be empty and end while the other keeps ticking and answering.
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr int TICK_RATE = 30;
+
+	struct TestClient {
+		std::string name;
+		ENetHost* host = nullptr;
+		ENetPeer* peer = nullptr; // The server, as the client sees it
+		uint16_t id = 0; // Server-side ID, from ConnectionConfirmation
+		std::vector<std::string> state_changes;
+		std::vector<std::set<uint32_t>> snapshots; // Player IDs in each WorldSnapshot received
+	};
+
+	// Decodes one received message, unpacking batches and decompressing compressed payloads
+	void handle_message(TestClient& client, const uint8_t* data, size_t size) {
+		PacketBuffer decompressed;
+		if (PacketCompression::is_compressed(data, size)) {
+			if (!PacketCompression::decompress_payload(data, size, decompressed)) return;
+			data = decompressed.data();
+			size = decompressed.size();
+		}
+		if (size == 0) return;
+
+		if (data[0] == PacketBatch::TYPE) {
+			PacketBatch::unpack(data, size, [&](const uint8_t* message, size_t length) { handle_message(client, message, length); });
+			return;
+		}
+
+		PacketInputArchive archive(data, size);
+		if (data[0] == ConnectionConfirmationPacket().header.type) {
+			ConnectionConfirmationPacket packet;
+			ConnectionConfirmationPacket::deserialize(packet, archive);
+			client.id = packet.client_assigned_id;
+		}
+		else if (data[0] == StateChangePacket().header.type) {
+			StateChangePacket packet;
+			StateChangePacket::deserialize(packet, archive);
+			client.state_changes.push_back(packet.new_state);
+		}
+		else if (data[0] == WorldSnapshotPacket().header.type) {
+			WorldSnapshotPacket packet;
+			WorldSnapshotPacket::deserialize(packet, archive);
+			std::set<uint32_t> ids;
+			for (const auto& [id, player] : packet.players) ids.insert(id);
+			client.snapshots.push_back(ids);
+		}
+	}
+
+	// Services every client for a while, and runs the event callbacks deferred to this thread
+	void pump(std::vector<TestClient>& clients, std::chrono::milliseconds duration) {
+		auto end = Clock::now() + duration;
+		while (Clock::now() < end) {
+			EventDispatch::run_deferred();
+			for (TestClient& client : clients) {
+				ENetEvent event;
+				while (enet_host_service(client.host, &event, 0) > 0) {
+					if (event.type != ENET_EVENT_TYPE_RECEIVE) continue;
+					handle_message(client, event.packet->data, event.packet->dataLength);
+					enet_packet_destroy(event.packet);
+				}
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	template <typename Done>
+	bool pump_until(std::vector<TestClient>& clients, Done done) {
+		auto deadline = Clock::now() + std::chrono::seconds(10);
+		while (!done() && Clock::now() < deadline) pump(clients, std::chrono::milliseconds(5));
+		return done();
+	}
+
+	void send(TestClient& client, Packet& packet) {
+		enet_peer_send(client.peer, packet.delivery().channel, packet.to_enet_packet());
+		enet_host_flush(client.host);
+	}
+
+	std::vector<PeerEntry> peers_of(Server& server, const std::vector<TestClient*>& clients) {
+		std::vector<PeerEntry> entries;
+		for (TestClient* client : clients) {
+			auto entry = server.peers.get_peer_by_id(client->id);
+			if (entry.has_value()) entries.push_back(entry.value());
+		}
+		return entries;
+	}
+
+	std::set<uint32_t> ids_of(const std::vector<TestClient*>& clients) {
+		std::set<uint32_t> ids;
+		for (TestClient* client : clients) ids.insert(client->id);
+		return ids;
+	}
+
+	void test_two_rooms() {
+		auto server = std::make_shared<Server>("::1", 0);
+		CHECK(server->host != nullptr);
+		if (!server->host) return;
+		server->server_info.max_players = 8;
+		ENetAddress address = address_of(server->host);
+
+		SimulationPool simulations(2);
+		ServerWorldEvents world_events(*server);
+		server->start();
+
+		// Five clients join the lobby
+		std::vector<TestClient> clients(5);
+		for (size_t i = 0; i < clients.size(); i++) {
+			clients[i].name = "Player" + std::to_string(i);
+			clients[i].host = enet_host_create(nullptr, 1, NetworkConstants::MAX_CHANNELS, 0, 0);
+			clients[i].peer = enet_host_connect(clients[i].host, &address, NetworkConstants::MAX_CHANNELS, 0);
+		}
+		for (TestClient& client : clients) {
+			CHECK(pump_until(clients, [&]() { return client.peer->state == ENET_PEER_STATE_CONNECTED; }));
+			ConnectionInitiationPacket initiation(client.name);
+			send(client, initiation);
+		}
+		bool joined = pump_until(clients, [&]() {
+			for (const TestClient& client : clients) if (client.id == 0) return false;
+			return true;
+		});
+		CHECK(joined);
+		if (!joined) return;
+
+		std::vector<TestClient*> first = { &clients[0], &clients[1] };
+		std::vector<TestClient*> second = { &clients[2], &clients[3] };
+		TestClient& waiting = clients[4];
+
+		auto room_one = std::make_unique<Room>(1, server, world_events, simulations, TICK_RATE, peers_of(*server, first));
+		auto room_two = std::make_unique<Room>(2, server, world_events, simulations, TICK_RATE, peers_of(*server, second));
+		CHECK(room_one->player_count() == 2);
+		CHECK(room_two->player_count() == 2);
+		CHECK(server->peers.get_room_peers(DEFAULT_ROOM).size() == 1);
+
+		// Only the players of a room are told to change state
+		CHECK(pump_until(clients, [&]() {
+			for (size_t i = 0; i < 4; i++) if (clients[i].state_changes.empty()) return false;
+			return true;
+		}));
+		for (size_t i = 0; i < 4; i++) {
+			CHECK(clients[i].state_changes.size() == 1);
+			CHECK(!clients[i].state_changes.empty() && clients[i].state_changes[0] == "World");
+		}
+
+		// Every snapshot request is answered by the sender's own room
+		for (TestClient& client : clients) {
+			RequestWorldSnapshotPacket request;
+			send(client, request);
+		}
+		CHECK(pump_until(clients, [&]() {
+			for (size_t i = 0; i < 4; i++) if (clients[i].snapshots.empty()) return false;
+			return true;
+		}));
+		pump(clients, std::chrono::milliseconds(200)); // Give the lobby's request time to (not) be answered
+		for (TestClient* client : first) {
+			CHECK(client->snapshots.size() == 1);
+			CHECK(!client->snapshots.empty() && client->snapshots[0] == ids_of(first));
+		}
+		for (TestClient* client : second) {
+			CHECK(client->snapshots.size() == 1);
+			CHECK(!client->snapshots.empty() && client->snapshots[0] == ids_of(second));
+		}
+		CHECK(waiting.state_changes.empty());
+		CHECK(waiting.snapshots.empty());
+
+		// Both rooms tick, on a pool shared between them
+		CHECK(room_one->get_stats().ticks > 0);
+		CHECK(room_two->get_stats().ticks > 0);
+
+		// The first room's players leave, it empties and ends while the second plays on
+		for (TestClient* client : first) enet_peer_disconnect(client->peer, 0);
+		CHECK(pump_until(clients, [&]() { return room_one->player_count() == 0; }));
+		CHECK(room_two->player_count() == 2);
+		room_one.reset();
+
+		uint64_t ticks = room_two->get_stats().ticks;
+		RequestWorldSnapshotPacket request;
+		send(*second[0], request);
+		CHECK(pump_until(clients, [&]() { return second[0]->snapshots.size() == 2; }));
+		CHECK(second[0]->snapshots.size() == 2 && second[0]->snapshots[1] == ids_of(second));
+		CHECK(room_two->get_stats().ticks > ticks);
+
+		// Everyone else leaves too, so stopping the server has no one left to wait for
+		room_two.reset();
+		for (TestClient* client : second) enet_peer_disconnect(client->peer, 0);
+		enet_peer_disconnect(waiting.peer, 0);
+		CHECK(pump_until(clients, [&]() { return server->peers.get_all_peers().empty(); }));
+		server->stop().get();
+		for (TestClient& client : clients) enet_host_destroy(client.host);
+	}
+}
+
+int main() {
+	Logger::init();
+	enet_initialize();
+
+	test_two_rooms();
+
+	enet_deinitialize();
+	return TestCheck::result();
+}
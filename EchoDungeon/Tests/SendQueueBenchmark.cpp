@@ -0,0 +1,221 @@
+#include "Imports/common.h"
+#include "Networking/NetworkUser.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Times what a send costs the thread that makes it, and the send queue itself.
+ *
+ * Sends: a NetworkUser with a connected loopback peer is handed packets through send_packet (a
+ * queue push and a wake-up), next to the old way, where the calling thread sent and flushed on
+ * the host itself. The old way raced the networking thread, so the stand-in takes a lock the
+ * servicing thread also holds, which is what making it correct would have cost.
+ *
+ * Queue: 1, 2 and 4 producer threads push into an MpscQueue while one thread pops, next to a
+ * std::deque behind a std::mutex.
+ *
+ * Usage: SendQueueBenchmark [sends] [items per producer]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	ENetPacket* make_packet() {
+		uint8_t data[64] = { 0xEE }; // Not a packet type, so nothing is conflated
+		return enet_packet_create(data, sizeof(data), ENET_PACKET_FLAG_RELIABLE);
+	}
+
+	class Sender : public NetworkUser {
+	public:
+		std::atomic<ENetPeer*> peer{ nullptr };
+
+		Sender() { host = create_host(); }
+
+		~Sender() override {
+			if (is_running.load()) stop();
+			if (host) enet_host_destroy(host);
+		}
+
+	protected:
+		void update() override {
+			ENetEvent event;
+			while (enet_host_service(host, &event, 0) > 0) {
+				if (event.type == ENET_EVENT_TYPE_CONNECT) peer.store(event.peer);
+				if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+			}
+		}
+	};
+
+	// Thread standing in for whoever receives, so acknowledgements flow and ENet's queues drain
+	class Receiver {
+	public:
+		ENetHost* host = create_host();
+
+		void start() {
+			running.store(true);
+			thread = std::thread([this]() {
+				ENetEvent event;
+				while (running.load()) {
+					while (enet_host_service(host, &event, 1) > 0) {
+						if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+					}
+				}
+			});
+		}
+
+		~Receiver() {
+			running.store(false);
+			if (thread.joinable()) thread.join();
+			enet_host_destroy(host);
+		}
+
+	private:
+		std::atomic<bool> running{ false };
+		std::thread thread;
+	};
+
+	double time_queued_sends(size_t sends) {
+		Sender sender;
+		Receiver receiver;
+		receiver.start();
+		sender.start();
+
+		ENetAddress address = address_of(sender.host);
+		enet_host_connect(receiver.host, &address, NetworkConstants::MAX_CHANNELS, 0);
+		for (int i = 0; i < 1000 && !sender.peer.load(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		ENetPeer* peer = sender.peer.load();
+		if (!peer) return 0.0;
+
+		auto start = Clock::now();
+		for (size_t i = 0; i < sends; i++) {
+			sender.send_packet(make_packet(), peer, NetworkConstants::CHANNEL_EVENTS);
+		}
+		double per_send = elapsed_ns(start) / sends;
+
+		sender.stop();
+		return per_send;
+	}
+
+	// The old send path: the calling thread sends and flushes on the host, here under the lock the servicing thread holds
+	double time_locked_sends(size_t sends) {
+		ENetHost* host = create_host();
+		std::mutex host_mutex;
+		std::atomic<bool> running{ true };
+		std::atomic<ENetPeer*> connected{ nullptr };
+
+		std::thread service([&]() {
+			ENetEvent event;
+			while (running.load()) {
+				{
+					std::lock_guard<std::mutex> lock(host_mutex);
+					while (enet_host_service(host, &event, 0) > 0) {
+						if (event.type == ENET_EVENT_TYPE_CONNECT) connected.store(event.peer);
+						if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+					}
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(NetworkConstants::LOOP_SLEEP_DURATION_MS));
+			}
+		});
+
+		double per_send = 0.0;
+		{
+			Receiver receiver;
+			receiver.start();
+			ENetAddress address = address_of(host);
+			enet_host_connect(receiver.host, &address, NetworkConstants::MAX_CHANNELS, 0);
+			for (int i = 0; i < 1000 && !connected.load(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			if (ENetPeer* peer = connected.load()) {
+				auto start = Clock::now();
+				for (size_t i = 0; i < sends; i++) {
+					std::lock_guard<std::mutex> lock(host_mutex);
+					enet_peer_send(peer, NetworkConstants::CHANNEL_EVENTS, make_packet());
+					enet_host_flush(host);
+				}
+				per_send = elapsed_ns(start) / sends;
+			}
+
+			running.store(false);
+			service.join();
+		}
+		enet_host_destroy(host);
+		return per_send;
+	}
+
+	class LockedQueue {
+	public:
+		void push(uint64_t value) {
+			std::lock_guard<std::mutex> lock(mutex);
+			items.push_back(value);
+		}
+
+		bool pop(uint64_t& out) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (items.empty()) return false;
+			out = items.front();
+			items.pop_front();
+			return true;
+		}
+
+	private:
+		std::mutex mutex;
+		std::deque<uint64_t> items;
+	};
+
+	// Nanoseconds per item for producers pushing while one consumer pops everything
+	template<class Queue>
+	double time_queue(size_t producers, size_t items_per_producer) {
+		Queue queue;
+		std::atomic<bool> go{ false };
+		std::vector<std::thread> threads;
+		for (size_t producer = 0; producer < producers; producer++) {
+			threads.emplace_back([&queue, &go, items_per_producer]() {
+				while (!go.load()) std::this_thread::yield();
+				for (uint64_t i = 0; i < items_per_producer; i++) queue.push(i);
+			});
+		}
+
+		const size_t total = producers * items_per_producer;
+		size_t popped = 0;
+		uint64_t item = 0;
+		auto start = Clock::now();
+		go.store(true);
+		while (popped < total) {
+			if (queue.pop(item)) popped++;
+		}
+		double per_item = elapsed_ns(start) / total;
+
+		for (std::thread& thread : threads) thread.join();
+		return per_item;
+	}
+}
+
+int main(int argc, char** argv) {
+	long sends_argument = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	long items_argument = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 0;
+	size_t sends = sends_argument > 0 ? static_cast<size_t>(sends_argument) : 20000;
+	size_t items = items_argument > 0 ? static_cast<size_t>(items_argument) : 1000000;
+
+	Logger::init();
+	enet_initialize();
+
+	std::printf("Cost of a send on the calling thread, %zu sends\n", sends);
+	std::printf("  send_packet (queued):        %8.1f ns\n", time_queued_sends(sends));
+	std::printf("  enet_peer_send + flush, locked: %8.1f ns\n", time_locked_sends(sends));
+
+	std::printf("Queue, one consumer, %zu items per producer\n", items);
+	for (size_t producers : { 1, 2, 4 }) {
+		std::printf("  %zu producers: MpscQueue %6.1f ns per item, mutex + deque %6.1f ns per item\n", producers,
+			time_queue<MpscQueue<uint64_t>>(producers, items), time_queue<LockedQueue>(producers, items));
+	}
+
+	enet_deinitialize();
+	return 0;
+}
@@ -0,0 +1,381 @@
+#include "Imports/common.h"
+#include "Networking/NetworkUser.h"
+#include "TestCheck.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Checks NetworkUser's send queue: the MpscQueue hands every item from several producers
+ * to the consumer once and in each producer's order, sends queued from several threads reach
+ * every target peer in that order, each packet is freed exactly once (including ones no peer
+ * took and ones still queued when the NetworkUser is destroyed), each DisconnectMode
+ * disconnects the way it documents, and once the queue has reached its depth a send to one
+ * peer allocates nothing on the sending thread.
+ *
+ * The NetworkUser's host plays the server, plain ENet hosts on the main thread play clients.
+ */
+
+namespace {
+	thread_local bool counting = false; // Only the sending thread counts, the networking thread allocates for ENet
+	std::atomic<size_t> allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+	if (counting) allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr uint8_t MARKER = 0xEE; // First byte of every test packet, not a packet type, so nothing is conflated
+	constexpr size_t PRODUCERS = 4;
+	constexpr uint32_t PACKETS_PER_PRODUCER = 500;
+	constexpr auto TIMEOUT = std::chrono::seconds(10);
+
+	std::atomic<size_t> freed{ 0 };
+
+	void ENET_CALLBACK on_free(void*) {
+		freed.fetch_add(1);
+	}
+
+	struct Payload {
+		uint8_t marker = MARKER;
+		uint32_t producer = 0;
+		uint32_t sequence = 0;
+	};
+
+	ENetPacket* make_packet(uint32_t producer, uint32_t sequence) {
+		uint8_t data[1 + 2 * sizeof(uint32_t)];
+		data[0] = MARKER;
+		std::memcpy(&data[1], &producer, sizeof(producer));
+		std::memcpy(&data[1 + sizeof(producer)], &sequence, sizeof(sequence));
+
+		ENetPacket* packet = enet_packet_create(data, sizeof(data), ENET_PACKET_FLAG_RELIABLE);
+		packet->freeCallback = on_free;
+		return packet;
+	}
+
+	Payload read_packet(const ENetPacket* packet) {
+		Payload payload;
+		payload.marker = packet->data[0];
+		std::memcpy(&payload.producer, &packet->data[1], sizeof(payload.producer));
+		std::memcpy(&payload.sequence, &packet->data[1 + sizeof(uint32_t)], sizeof(payload.sequence));
+		return payload;
+	}
+
+	// The server side, its networking loop records who connected and who it saw disconnect
+	class TestUser : public NetworkUser {
+	public:
+		TestUser() { host = create_host(8); }
+
+		~TestUser() override {
+			if (is_running.load()) stop();
+			if (host) enet_host_destroy(host);
+		}
+
+		ENetPeer* peer(uint32_t client) {
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = connected.find(client);
+			return it == connected.end() ? nullptr : it->second;
+		}
+
+		bool saw_disconnect(uint32_t client) {
+			std::lock_guard<std::mutex> lock(mutex);
+			return disconnected.count(client) > 0;
+		}
+
+	protected:
+		void update() override {
+			ENetEvent event;
+			while (enet_host_service(host, &event, 0) > 0) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (event.type == ENET_EVENT_TYPE_CONNECT) {
+					connected[event.data] = event.peer; // Clients connect with their index as data
+					clients[event.peer] = event.data;
+				}
+				else if (event.type == ENET_EVENT_TYPE_DISCONNECT) {
+					disconnected[clients[event.peer]] = true;
+					forget_peer(event.peer);
+				}
+				else if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+					enet_packet_destroy(event.packet);
+				}
+			}
+		}
+
+	private:
+		std::mutex mutex; // Guards the maps, written on the networking thread
+		std::map<uint32_t, ENetPeer*> connected;
+		std::map<ENetPeer*, uint32_t> clients;
+		std::map<uint32_t, bool> disconnected;
+	};
+
+	struct Client {
+		ENetHost* host = nullptr;
+		ENetPeer* peer = nullptr; // Its peer for the server
+		std::vector<Payload> received;
+		bool disconnected = false;
+		size_t received_before_disconnect = 0;
+
+		void service() {
+			ENetEvent event;
+			while (enet_host_service(host, &event, 0) > 0) {
+				if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+					received.push_back(read_packet(event.packet));
+					enet_packet_destroy(event.packet);
+				}
+				else if (event.type == ENET_EVENT_TYPE_DISCONNECT) {
+					disconnected = true;
+					received_before_disconnect = received.size();
+				}
+			}
+		}
+	};
+
+	// Connects count clients to user, whose loop must be running
+	std::vector<Client> connect_clients(TestUser& user, uint32_t count) {
+		std::vector<Client> clients(count);
+		ENetAddress address = address_of(user.host);
+
+		for (uint32_t i = 0; i < count; i++) {
+			clients[i].host = create_host(1);
+			clients[i].peer = enet_host_connect(clients[i].host, &address, NetworkConstants::MAX_CHANNELS, i);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		bool all_connected = false;
+		while (!all_connected && std::chrono::steady_clock::now() - start < TIMEOUT) {
+			all_connected = true;
+			for (uint32_t i = 0; i < count; i++) {
+				clients[i].service();
+				all_connected &= clients[i].peer->state == ENET_PEER_STATE_CONNECTED && user.peer(i) != nullptr;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		CHECK(all_connected);
+		return clients;
+	}
+
+	// Services the clients until done() or the timeout
+	template<class Done>
+	void service_until(std::vector<Client>& clients, Done done) {
+		auto start = std::chrono::steady_clock::now();
+		while (!done() && std::chrono::steady_clock::now() - start < TIMEOUT) {
+			for (Client& client : clients) client.service();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	void destroy_clients(std::vector<Client>& clients) {
+		for (Client& client : clients) {
+			enet_peer_reset(client.peer);
+			enet_host_destroy(client.host);
+		}
+	}
+
+	// Each producer's items arrive once each and in order
+	bool in_producer_order(const std::vector<Payload>& received, size_t producers, uint32_t per_producer) {
+		std::vector<uint32_t> next(producers, 0);
+		for (const Payload& payload : received) {
+			if (payload.marker != MARKER || payload.producer >= producers || payload.sequence != next[payload.producer]) return false;
+			next[payload.producer]++;
+		}
+		for (uint32_t count : next) {
+			if (count != per_producer) return false;
+		}
+		return true;
+	}
+
+	void test_mpsc_queue() {
+		MpscQueue<Payload> queue;
+		std::atomic<bool> go{ false };
+		std::vector<std::thread> producers;
+		for (uint32_t producer = 0; producer < PRODUCERS; producer++) {
+			producers.emplace_back([&queue, &go, producer]() {
+				while (!go.load()) std::this_thread::yield();
+				for (uint32_t sequence = 0; sequence < 20000; sequence++) {
+					Payload payload;
+					payload.producer = producer;
+					payload.sequence = sequence;
+					queue.push(payload);
+				}
+			});
+		}
+
+		// Pop while the producers push, like the networking thread does
+		std::vector<Payload> popped;
+		go.store(true);
+		auto start = std::chrono::steady_clock::now();
+		Payload payload;
+		while (popped.size() < PRODUCERS * 20000 && std::chrono::steady_clock::now() - start < TIMEOUT) {
+			if (queue.pop(payload)) popped.push_back(payload);
+		}
+		for (std::thread& producer : producers) producer.join();
+		while (queue.pop(payload)) popped.push_back(payload);
+
+		CHECK(in_producer_order(popped, PRODUCERS, 20000));
+	}
+
+	void test_concurrent_sends_drain_in_order() {
+		freed.store(0);
+		{
+			TestUser user;
+			user.start();
+			std::vector<Client> clients = connect_clients(user, 2);
+			std::vector<ENetPeer*> peers = { user.peer(0), user.peer(1) };
+
+			std::vector<std::thread> producers;
+			for (uint32_t producer = 0; producer < PRODUCERS; producer++) {
+				producers.emplace_back([&user, &peers, producer]() {
+					for (uint32_t sequence = 0; sequence < PACKETS_PER_PRODUCER; sequence++) {
+						user.send_packet(make_packet(producer, sequence), peers, NetworkConstants::CHANNEL_EVENTS);
+					}
+				});
+			}
+
+			const size_t expected = PRODUCERS * PACKETS_PER_PRODUCER;
+			service_until(clients, [&]() { return clients[0].received.size() >= expected && clients[1].received.size() >= expected; });
+			for (std::thread& producer : producers) producer.join();
+
+			for (const Client& client : clients) {
+				CHECK_MESSAGE(in_producer_order(client.received, PRODUCERS, PACKETS_PER_PRODUCER),
+					std::to_string(client.received.size()) + " of " + std::to_string(expected) + " packets, in order");
+			}
+
+			user.stop();
+			destroy_clients(clients);
+		}
+		// One packet per send, shared by both peers and freed once
+		CHECK_MESSAGE(freed.load() == PRODUCERS * PACKETS_PER_PRODUCER, std::to_string(freed.load()) + " packets freed");
+	}
+
+	void test_disconnect_modes() {
+		constexpr uint32_t LATER = 0, GRACEFUL = 1, NOW = 2;
+		constexpr uint32_t BEFORE_DISCONNECT = 50;
+
+		freed.store(0);
+		size_t sent = 0;
+		{
+			TestUser user;
+			user.start();
+			std::vector<Client> clients = connect_clients(user, 3);
+
+			// LATER: everything queued before the disconnect is delivered first
+			for (uint32_t sequence = 0; sequence < BEFORE_DISCONNECT; sequence++) {
+				user.send_packet(make_packet(0, sequence), user.peer(LATER), NetworkConstants::CHANNEL_EVENTS);
+				sent++;
+			}
+			user.queue_disconnect(user.peer(LATER), DisconnectMode::LATER);
+
+			// GRACEFUL and NOW, each followed by a send that no peer can take, which must still be freed
+			user.queue_disconnect(user.peer(GRACEFUL), DisconnectMode::GRACEFUL);
+			user.send_packet(make_packet(0, 0), user.peer(GRACEFUL), NetworkConstants::CHANNEL_EVENTS);
+			sent++;
+			user.queue_disconnect(user.peer(NOW), DisconnectMode::NOW);
+			user.send_packet(make_packet(0, 0), user.peer(NOW), NetworkConstants::CHANNEL_EVENTS);
+			sent++;
+
+			service_until(clients, [&]() {
+				return clients[LATER].disconnected && clients[GRACEFUL].disconnected && user.saw_disconnect(LATER) && user.saw_disconnect(GRACEFUL);
+			});
+			std::this_thread::sleep_for(std::chrono::milliseconds(200)); // Time for a NOW disconnect event to show up, if one wrongly did
+
+			CHECK(clients[LATER].disconnected);
+			CHECK_MESSAGE(clients[LATER].received_before_disconnect == BEFORE_DISCONNECT,
+				std::to_string(clients[LATER].received_before_disconnect) + " packets before the LATER disconnect");
+			CHECK(in_producer_order(clients[LATER].received, 1, BEFORE_DISCONNECT));
+			CHECK(user.saw_disconnect(LATER));
+
+			CHECK(clients[GRACEFUL].disconnected);
+			CHECK(clients[GRACEFUL].received.empty());
+			CHECK(user.saw_disconnect(GRACEFUL));
+
+			CHECK(clients[NOW].received.empty());
+			CHECK_MESSAGE(!user.saw_disconnect(NOW), "NOW must not raise a disconnect event on the disconnecting side");
+
+			user.stop();
+			destroy_clients(clients);
+		}
+		CHECK_MESSAGE(freed.load() == sent, std::to_string(freed.load()) + " of " + std::to_string(sent) + " packets freed");
+	}
+
+	// Sends to one peer reuse the queue's nodes and keep the peer inline, so they allocate nothing
+	void test_single_peer_sends_allocate_nothing() {
+		constexpr uint32_t WARM_UP = 64; // Leaves this many nodes on the queue's free list
+		constexpr uint32_t COUNTED = 32;
+
+		TestUser user;
+		user.start();
+		std::vector<Client> clients = connect_clients(user, 1);
+		ENetPeer* peer = user.peer(0);
+
+		for (uint32_t sequence = 0; sequence < WARM_UP; sequence++) {
+			user.send_packet(make_packet(0, sequence), peer, NetworkConstants::CHANNEL_EVENTS);
+		}
+		service_until(clients, [&]() { return clients[0].received.size() >= WARM_UP; }); // Drained, so the nodes are free
+
+		std::vector<ENetPacket*> packets; // Made up front, ENet's own allocations are not the queue's
+		for (uint32_t sequence = 0; sequence < COUNTED; sequence++) packets.push_back(make_packet(0, WARM_UP + sequence));
+
+		allocations.store(0);
+		counting = true;
+		for (ENetPacket* packet : packets) {
+			user.send_packet(packet, peer, NetworkConstants::CHANNEL_EVENTS);
+		}
+		counting = false;
+		CHECK_MESSAGE(allocations.load() == 0, std::to_string(allocations.load()) + " allocations for " + std::to_string(COUNTED) + " sends");
+
+		service_until(clients, [&]() { return clients[0].received.size() >= WARM_UP + COUNTED; });
+		CHECK(in_producer_order(clients[0].received, 1, WARM_UP + COUNTED));
+
+		user.stop();
+		destroy_clients(clients);
+	}
+
+	// Sends still queued when the NetworkUser goes away are freed by its destructor
+	void test_unsent_packets_freed() {
+		freed.store(0);
+		{
+			TestUser user; // Never started, so nothing drains the queue
+			ENetPeer* peer = &user.host->peers[0];
+			for (uint32_t sequence = 0; sequence < 10; sequence++) {
+				user.send_packet(make_packet(0, sequence), peer, NetworkConstants::CHANNEL_EVENTS);
+			}
+			CHECK(freed.load() == 0);
+		}
+		CHECK(freed.load() == 10);
+	}
+}
+
+int main() {
+	Logger::init();
+	enet_initialize();
+
+	test_mpsc_queue();
+	test_concurrent_sends_drain_in_order();
+	test_disconnect_modes();
+	test_unsent_packets_freed();
+	test_single_peer_sends_allocate_nothing();
+
+	enet_deinitialize();
+	return TestCheck::result();
+}
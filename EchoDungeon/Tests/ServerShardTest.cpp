@@ -0,0 +1,250 @@
+#include "Imports/common.h"
+#include "Networking/Server/Server.h"
+#include "Networking/Packet/PacketBatch.h"
+#include "Networking/Packet/PacketCompression.h"
+#include "Networking/Packet/PacketRegistry.h"
+#include "Networking/Packet/Instances/ConnectionConfirmation.h"
+#include "Networking/Packet/Instances/ConnectionInitiation.h"
+#include "Networking/Packet/Instances/StateChange.h"
+#include "TestCheck.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Checks the SO_REUSEPORT sharding the server's ingress relies on, then the server itself
+ * with as many hosts as NetworkConstants::SERVER_SHARDS gives it.
+ *
+ * Several ENet hosts created with enet_host_create_shared() on one port must each take a share
+ * of the connections, every client must stay on the host it connected to, and a host created
+ * without sharing must not be able to take the port. The server's clients must then all join,
+ * spread over SERVER_SHARDS hosts, and receive both what is sent to them alone and broadcasts,
+ * whichever host they are on. Platforms without load balancing SO_REUSEPORT skip the first part.
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr size_t SHARED_HOSTS = 4;
+	constexpr size_t CLIENTS = 32;
+	constexpr size_t PACKETS_PER_CLIENT = 10;
+
+	template <typename Service, typename Done>
+	bool service_until(Service service, Done done) {
+		auto deadline = Clock::now() + std::chrono::seconds(10);
+		while (!done() && Clock::now() < deadline) {
+			service();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return done();
+	}
+
+	void test_shared_port() {
+		ENetAddress any = loopback(0);
+		std::vector<ENetHost*> hosts;
+		hosts.push_back(enet_host_create_shared(&any, CLIENTS, NetworkConstants::MAX_CHANNELS, 0, 0));
+		CHECK(hosts[0] != nullptr);
+		if (!hosts[0]) return;
+
+		ENetAddress address = address_of(hosts[0]);
+		while (hosts.size() < SHARED_HOSTS) {
+			ENetHost* host = enet_host_create_shared(&address, CLIENTS, NetworkConstants::MAX_CHANNELS, 0, 0);
+			if (!host) break;
+			hosts.push_back(host);
+		}
+		if (hosts.size() < SHARED_HOSTS) {
+			std::cout << "SO_REUSEPORT is not available, skipping the shared port checks" << std::endl;
+			for (ENetHost* host : hosts) enet_host_destroy(host);
+			return;
+		}
+
+		// A host that does not share the port cannot take it from the shared ones
+		ENetHost* unshared = enet_host_create(&address, 1, NetworkConstants::MAX_CHANNELS, 0, 0);
+		CHECK(unshared == nullptr);
+		if (unshared) enet_host_destroy(unshared);
+
+		std::vector<ENetHost*> clients;
+		std::vector<ENetPeer*> client_peers;
+		for (size_t i = 0; i < CLIENTS; i++) {
+			clients.push_back(enet_host_create(nullptr, 1, NetworkConstants::MAX_CHANNELS, 0, 0));
+			client_peers.push_back(enet_host_connect(clients.back(), &address, NetworkConstants::MAX_CHANNELS, 0));
+		}
+
+		std::vector<size_t> connections(SHARED_HOSTS, 0); // Connections each host accepted
+		std::vector<std::set<ENetHost*>> received_on(CLIENTS); // Hosts each client's packets arrived at
+		std::vector<size_t> received(CLIENTS, 0);
+		auto service = [&]() {
+			ENetEvent event;
+			for (ENetHost* client : clients) {
+				while (enet_host_service(client, &event, 0) > 0) {}
+			}
+			for (size_t h = 0; h < SHARED_HOSTS; h++) {
+				while (enet_host_service(hosts[h], &event, 0) > 0) {
+					if (event.type == ENET_EVENT_TYPE_CONNECT) connections[h]++;
+					if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+						size_t client = event.packet->data[0];
+						if (client < CLIENTS) {
+							received_on[client].insert(hosts[h]);
+							received[client]++;
+						}
+						enet_packet_destroy(event.packet);
+					}
+				}
+			}
+		};
+
+		size_t accepted = 0;
+		CHECK(service_until(service, [&]() {
+			accepted = 0;
+			for (size_t count : connections) accepted += count;
+			return accepted == CLIENTS;
+		}));
+		CHECK(accepted == CLIENTS);
+
+		// Every host takes a share, none takes them all
+		size_t busy = 0;
+		for (size_t count : connections) busy += count > 0 ? 1 : 0;
+		CHECK_MESSAGE(busy > 1, std::to_string(busy) + " of " + std::to_string(SHARED_HOSTS) + " hosts accepted connections");
+
+		// Later datagrams from a client reach the same host as its connection did
+		for (size_t i = 0; i < CLIENTS; i++) {
+			for (size_t p = 0; p < PACKETS_PER_CLIENT; p++) {
+				uint8_t data[16] = { static_cast<uint8_t>(i) };
+				enet_peer_send(client_peers[i], NetworkConstants::CHANNEL_EVENTS, enet_packet_create(data, sizeof(data), ENET_PACKET_FLAG_RELIABLE));
+			}
+			enet_host_flush(clients[i]);
+		}
+		CHECK(service_until(service, [&]() {
+			for (size_t count : received) if (count < PACKETS_PER_CLIENT) return false;
+			return true;
+		}));
+		for (size_t i = 0; i < CLIENTS; i++) {
+			CHECK_MESSAGE(received_on[i].size() == 1, "client " + std::to_string(i) + " reached " + std::to_string(received_on[i].size()) + " hosts");
+			CHECK(received[i] == PACKETS_PER_CLIENT);
+		}
+
+		for (ENetHost* client : clients) enet_host_destroy(client);
+		for (ENetHost* host : hosts) enet_host_destroy(host);
+	}
+
+	struct TestClient {
+		ENetHost* host = nullptr;
+		ENetPeer* peer = nullptr; // The server, as the client sees it
+		uint16_t id = 0; // Server-side ID, from ConnectionConfirmation
+		std::vector<std::string> state_changes;
+	};
+
+	// Decodes one received message, unpacking batches and decompressing compressed payloads
+	void handle_message(TestClient& client, const uint8_t* data, size_t size) {
+		PacketBuffer decompressed;
+		if (PacketCompression::is_compressed(data, size)) {
+			if (!PacketCompression::decompress_payload(data, size, decompressed)) return;
+			data = decompressed.data();
+			size = decompressed.size();
+		}
+		if (size == 0) return;
+
+		if (data[0] == PacketBatch::TYPE) {
+			PacketBatch::unpack(data, size, [&](const uint8_t* message, size_t length) { handle_message(client, message, length); });
+			return;
+		}
+
+		PacketInputArchive archive(data, size);
+		if (data[0] == ConnectionConfirmationPacket().header.type) {
+			ConnectionConfirmationPacket packet;
+			ConnectionConfirmationPacket::deserialize(packet, archive);
+			client.id = packet.client_assigned_id;
+		}
+		else if (data[0] == StateChangePacket().header.type) {
+			StateChangePacket packet;
+			StateChangePacket::deserialize(packet, archive);
+			client.state_changes.push_back(packet.new_state);
+		}
+	}
+
+	void test_server() {
+		auto server = std::make_shared<Server>("::1", 0);
+		CHECK(server->host != nullptr);
+		if (!server->host) return;
+		server->server_info.max_players = CLIENTS;
+		ENetAddress address = address_of(server->host);
+		server->start();
+
+		std::vector<TestClient> clients(CLIENTS);
+		for (TestClient& client : clients) {
+			client.host = enet_host_create(nullptr, 1, NetworkConstants::MAX_CHANNELS, 0, 0);
+			client.peer = enet_host_connect(client.host, &address, NetworkConstants::MAX_CHANNELS, 0);
+		}
+		std::vector<bool> initiated(CLIENTS, false);
+		auto service = [&]() {
+			for (size_t i = 0; i < CLIENTS; i++) {
+				TestClient& client = clients[i];
+				ENetEvent event;
+				while (enet_host_service(client.host, &event, 0) > 0) {
+					if (event.type != ENET_EVENT_TYPE_RECEIVE) continue;
+					handle_message(client, event.packet->data, event.packet->dataLength);
+					enet_packet_destroy(event.packet);
+				}
+				if (!initiated[i] && client.peer->state == ENET_PEER_STATE_CONNECTED) {
+					ConnectionInitiationPacket initiation("Player" + std::to_string(i));
+					enet_peer_send(client.peer, initiation.delivery().channel, initiation.to_enet_packet());
+					enet_host_flush(client.host);
+					initiated[i] = true;
+				}
+			}
+		};
+
+		bool joined = service_until(service, [&]() {
+			for (const TestClient& client : clients) if (client.id == 0) return false;
+			return true;
+		});
+		CHECK(joined);
+		std::vector<PeerEntry> peers = server->peers.get_all_peers();
+		CHECK(peers.size() == CLIENTS);
+
+		// A peer belongs to whichever of the server's hosts its connection reached
+		std::set<ENetHost*> hosts;
+		for (const PeerEntry& entry : peers) hosts.insert(entry.peer->host);
+		CHECK(hosts.size() <= NetworkConstants::SERVER_SHARDS);
+		if (NetworkConstants::SERVER_SHARDS == 1) CHECK(hosts.size() == 1 && *hosts.begin() == server->host);
+		else CHECK_MESSAGE(hosts.size() > 1, std::to_string(hosts.size()) + " hosts have peers");
+
+		// Sends to one peer and broadcasts both go out on each peer's own host
+		for (const TestClient& client : clients) {
+			StateChangePacket packet("To" + std::to_string(client.id));
+			CHECK(server->send_packet(packet, client.id));
+		}
+		StateChangePacket broadcast("Everyone");
+		CHECK(server->broadcast_packet(broadcast));
+		CHECK(service_until(service, [&]() {
+			for (const TestClient& client : clients) if (client.state_changes.size() < 2) return false;
+			return true;
+		}));
+		for (const TestClient& client : clients) {
+			CHECK(client.state_changes.size() == 2);
+			if (client.state_changes.size() != 2) continue;
+			CHECK(client.state_changes[0] == "To" + std::to_string(client.id));
+			CHECK(client.state_changes[1] == "Everyone");
+		}
+
+		// Leaving is handled on each peer's own host too
+		for (TestClient& client : clients) enet_peer_disconnect(client.peer, 0);
+		CHECK(service_until(service, [&]() { return server->peers.get_all_peers().empty(); }));
+		server->stop().get();
+		for (TestClient& client : clients) enet_host_destroy(client.host);
+	}
+}
+
+int main() {
+	Logger::init();
+	enet_initialize();
+
+	test_shared_port();
+	test_server();
+
+	enet_deinitialize();
+	return TestCheck::result();
+}
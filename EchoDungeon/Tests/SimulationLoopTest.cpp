@@ -0,0 +1,132 @@
+#include "Imports/common.h"
+#include "Game/World/Systems/SimulationLoop.h"
+#include "TestCheck.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Checks that SimulationLoop ticks at its tick rate with a constant delta time, that after
+ * a stall it runs at most MAX_CATCH_UP_TICKS ticks back to back and drops and counts the rest,
+ * that overlong ticks are counted as overruns, and that stop() ends the wait between ticks.
+ *
+ * The loop runs in real time, so the bounds leave room for a busy machine: ticks and dropped
+ * ticks together have to account for the wall time the loop ran, give or take a few ticks.
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr int TICK_RATE = 100;
+
+	void test_steady_rate() {
+		std::mutex mutex;
+		std::vector<float> deltas;
+		SimulationLoop loop([&](float delta_time) {
+			std::lock_guard<std::mutex> lock(mutex);
+			deltas.push_back(delta_time);
+		});
+
+		auto start = Clock::now();
+		loop.start(TICK_RATE);
+		CHECK(loop.is_running());
+		CHECK(loop.get_tick_rate() == TICK_RATE);
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		SimulationStats stats = loop.get_stats();
+		double ran_ms = elapsed_ms(start);
+		loop.stop();
+		CHECK(!loop.is_running());
+
+		// The first tick runs straight away, then one per interval
+		uint64_t expected = static_cast<uint64_t>(ran_ms * TICK_RATE / 1000.0) + 1;
+		uint64_t accounted = stats.ticks + stats.dropped_ticks;
+		CHECK_MESSAGE(accounted + 3 >= expected && accounted <= expected + 1,
+			std::to_string(stats.ticks) + " ticks and " + std::to_string(stats.dropped_ticks) + " dropped in " + std::to_string(ran_ms) + " ms");
+
+		std::lock_guard<std::mutex> lock(mutex);
+		CHECK(deltas.size() >= stats.ticks);
+		for (float delta_time : deltas) CHECK(delta_time == 1.0f / TICK_RATE);
+	}
+
+	void test_stall_catch_up() {
+		constexpr int STALL_TICKS = 20; // How long the first tick takes, in tick intervals
+		std::atomic<uint64_t> count{ 0 };
+		std::mutex mutex;
+		std::vector<Clock::time_point> started; // When each tick started
+		SimulationLoop loop([&](float) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				started.push_back(Clock::now());
+			}
+			if (count.fetch_add(1) == 0) std::this_thread::sleep_for(std::chrono::milliseconds(STALL_TICKS * 1000 / TICK_RATE));
+		});
+
+		auto start = Clock::now();
+		loop.start(TICK_RATE);
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		SimulationStats stats = loop.get_stats();
+		double ran_ms = elapsed_ms(start);
+		loop.stop();
+
+		// The stalled tick leaves STALL_TICKS intervals to catch up on, of which MAX_CATCH_UP_TICKS run
+		uint64_t expected_dropped = STALL_TICKS - SimulationLoop::MAX_CATCH_UP_TICKS;
+		CHECK_MESSAGE(stats.dropped_ticks + 2 >= expected_dropped && stats.dropped_ticks <= expected_dropped + 3,
+			std::to_string(stats.dropped_ticks) + " dropped");
+		CHECK(stats.overruns >= 1);
+		CHECK(stats.max_tick_ms >= STALL_TICKS * 1000.0 / TICK_RATE);
+		CHECK(stats.total_tick_ms >= stats.max_tick_ms);
+
+		uint64_t expected = static_cast<uint64_t>(ran_ms * TICK_RATE / 1000.0) + 1;
+		uint64_t accounted = stats.ticks + stats.dropped_ticks;
+		CHECK_MESSAGE(accounted + 3 >= expected && accounted <= expected + 1,
+			std::to_string(stats.ticks) + " ticks and " + std::to_string(stats.dropped_ticks) + " dropped in " + std::to_string(ran_ms) + " ms");
+
+		// Straight after the stall the catch-up ticks run back to back, never more than the cap
+		std::lock_guard<std::mutex> lock(mutex);
+		CHECK(started.size() > static_cast<size_t>(SimulationLoop::MAX_CATCH_UP_TICKS) + 1);
+		if (started.size() > static_cast<size_t>(SimulationLoop::MAX_CATCH_UP_TICKS) + 1) {
+			auto catch_up_end = started[SimulationLoop::MAX_CATCH_UP_TICKS];
+			auto catch_up_start = started[1];
+			double catch_up_ms = std::chrono::duration<double, std::milli>(catch_up_end - catch_up_start).count();
+			CHECK_MESSAGE(catch_up_ms < 1000.0 / TICK_RATE, std::to_string(catch_up_ms) + " ms for the catch-up ticks");
+		}
+	}
+
+	void test_stop_and_restart() {
+		std::atomic<uint64_t> count{ 0 };
+		SimulationLoop loop([&](float) { count.fetch_add(1); });
+
+		// One tick a second: stop() has to wake the wait rather than sit out the interval
+		loop.start(1);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		auto stopping = Clock::now();
+		loop.stop();
+		CHECK_MESSAGE(elapsed_ms(stopping) < 500.0, std::to_string(elapsed_ms(stopping)) + " ms to stop");
+		CHECK(count.load() == 1);
+		loop.stop(); // Stopping a stopped loop does nothing
+
+		// Restarting resets the stats and takes the new rate
+		loop.start(TICK_RATE);
+		loop.start(1); // Already running, ignored
+		CHECK(loop.get_tick_rate() == TICK_RATE);
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		loop.stop();
+		SimulationStats stats = loop.get_stats();
+		CHECK(stats.ticks == count.load() - 1);
+
+		loop.start(0);
+		CHECK(!loop.is_running());
+	}
+}
+
+int main() {
+	Logger::init();
+	test_steady_rate();
+	test_stall_catch_up();
+	test_stop_and_restart();
+	return TestCheck::result();
+}
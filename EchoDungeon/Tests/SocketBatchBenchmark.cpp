@@ -0,0 +1,185 @@
+#include "Imports/common.h"
+#include "Networking/Packet/PacketDelivery.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @brief Measures how many datagrams per second a server host sends and receives on loopback
+ * with ENet's stock one-system-call-per-datagram socket I/O, with sendmmsg/recvmmsg batches of
+ * NetworkConstants::SOCKET_BATCH_SIZE, and with batches sent through UDP segment offload.
+ *
+ * One server host and a number of client hosts connect over ::1. Sending, the server queues one
+ * unsequenced state packet per client and flushes, so every flush writes one datagram to each
+ * client (or several for payloads above the MTU); the clients drain their sockets between rounds,
+ * outside the timing. Receiving, the clients flush a round of datagrams to the server first,
+ * then the server services its host until its socket is empty. Datagrams are ENet's own counts,
+ * totalSentPackets and totalReceivedPackets. Batching only exists on Linux, elsewhere the batched
+ * rows say so.
+ *
+ * Usage: SocketBatchBenchmark [clients] [rounds]
+ */
+
+namespace {
+	using namespace TestSupport;
+
+	constexpr size_t ROUND_DATAGRAMS = 128; // Sent to the server per receive round, well within its socket buffer
+
+	enum class Mode { STOCK, BATCHED, SEGMENT_OFFLOAD };
+
+	const char* name_of(Mode mode) {
+		switch (mode) {
+		case Mode::STOCK: return "stock";
+		case Mode::BATCHED: return "batched";
+		default: return "batched+GSO";
+		}
+	}
+
+	class Loopback {
+	public:
+		ENetHost* server = nullptr;
+		std::vector<ENetHost*> clients;
+		std::vector<ENetPeer*> server_peers; // The clients, as the server sees them
+		std::vector<ENetPeer*> client_peers; // The server, as each client sees it
+
+		explicit Loopback(size_t count) {
+			server = create_host(count);
+			ENetAddress server_address = address_of(server);
+			for (size_t i = 0; i < count; i++) {
+				clients.push_back(create_host(1));
+				client_peers.push_back(enet_host_connect(clients.back(), &server_address, NetworkConstants::MAX_CHANNELS, 0));
+			}
+
+			auto deadline = Clock::now() + std::chrono::seconds(10);
+			while (server_peers.size() < count && Clock::now() < deadline) {
+				drain_clients();
+				ENetEvent event;
+				while (enet_host_service(server, &event, 1) > 0) {
+					if (event.type == ENET_EVENT_TYPE_CONNECT) server_peers.push_back(event.peer);
+				}
+			}
+			drain_clients();
+		}
+
+		~Loopback() {
+			for (ENetHost* client : clients) enet_host_destroy(client);
+			enet_host_destroy(server);
+		}
+
+		bool connected() const { return server_peers.size() == clients.size(); }
+
+		// Returns false where the platform has no batched socket I/O
+		bool set_mode(Mode mode) {
+			if (mode == Mode::STOCK) {
+				enet_host_batch_socket_io(server, 0, 0);
+				return true;
+			}
+			return enet_host_batch_socket_io(server, NetworkConstants::SOCKET_BATCH_SIZE, mode == Mode::SEGMENT_OFFLOAD) == 0;
+		}
+
+		void drain_clients() {
+			ENetEvent event;
+			for (ENetHost* client : clients) {
+				while (enet_host_service(client, &event, 0) > 0) {
+					if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+				}
+			}
+		}
+
+		void drain_server() {
+			ENetEvent event;
+			while (enet_host_service(server, &event, 0) > 0) {
+				if (event.type == ENET_EVENT_TYPE_RECEIVE) enet_packet_destroy(event.packet);
+			}
+		}
+	};
+
+	double send_rate(Loopback& loopback, size_t payload, size_t rounds) {
+		std::vector<uint8_t> data(payload, 0);
+		enet_uint32 flags = PacketDeliveries::UNSEQUENCED_STATE.enet_flags();
+		double seconds = 0.0;
+		size_t datagrams = 0;
+
+		for (size_t round = 0; round < rounds; round++) {
+			auto start = Clock::now();
+			enet_uint32 sent = loopback.server->totalSentPackets;
+			for (ENetPeer* peer : loopback.server_peers) {
+				enet_peer_send(peer, NetworkConstants::CHANNEL_STATE, enet_packet_create(data.data(), data.size(), flags));
+			}
+			enet_host_flush(loopback.server);
+			datagrams += loopback.server->totalSentPackets - sent;
+			seconds += elapsed_s(start);
+
+			loopback.drain_clients(); // Keeps the clients' socket buffers from filling up
+		}
+		return datagrams / seconds;
+	}
+
+	double receive_rate(Loopback& loopback, size_t payload, size_t rounds) {
+		std::vector<uint8_t> data(payload, 0);
+		enet_uint32 flags = PacketDeliveries::UNSEQUENCED_STATE.enet_flags();
+		double seconds = 0.0;
+		size_t datagrams = 0;
+		size_t dropped = 0;
+
+		for (size_t round = 0; round < rounds; round++) {
+			// The clients take turns, flushing one packet at a time so ENet does not pack them into one datagram
+			size_t expected = 0;
+			for (size_t i = 0; expected < ROUND_DATAGRAMS; i = (i + 1) % loopback.clients.size()) {
+				enet_uint32 sent = loopback.clients[i]->totalSentPackets;
+				enet_peer_send(loopback.client_peers[i], NetworkConstants::CHANNEL_STATE, enet_packet_create(data.data(), data.size(), flags));
+				enet_host_flush(loopback.clients[i]);
+				expected += loopback.clients[i]->totalSentPackets - sent;
+			}
+
+			auto start = Clock::now();
+			enet_uint32 received = loopback.server->totalReceivedPackets;
+			loopback.drain_server(); // Returns once the socket is empty
+			seconds += elapsed_s(start);
+			size_t arrived = loopback.server->totalReceivedPackets - received;
+			datagrams += arrived;
+			if (arrived < expected) dropped += expected - arrived;
+
+			loopback.drain_clients();
+		}
+		if (dropped > 0) std::printf("  (the server's socket buffer dropped %zu datagrams)\n", dropped);
+		return datagrams / seconds;
+	}
+}
+
+int main(int argc, char** argv) {
+	long clients_argument = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 0;
+	long rounds_argument = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 0;
+	size_t clients = clients_argument > 0 ? static_cast<size_t>(clients_argument) : 32;
+	size_t rounds = rounds_argument > 0 ? static_cast<size_t>(rounds_argument) : 2000;
+
+	Logger::init();
+	enet_initialize();
+
+	Loopback loopback(clients);
+	if (!loopback.connected()) {
+		std::printf("only %zu of %zu clients connected\n", loopback.server_peers.size(), clients);
+		enet_deinitialize();
+		return 1;
+	}
+
+	std::printf("%zu clients on ::1, %zu rounds, batches of %zu\n", clients, rounds, static_cast<size_t>(NetworkConstants::SOCKET_BATCH_SIZE));
+	for (size_t payload : { 100, 3000 }) {
+		std::printf("%zu byte payloads\n", payload);
+		for (Mode mode : { Mode::STOCK, Mode::BATCHED, Mode::SEGMENT_OFFLOAD }) {
+			if (!loopback.set_mode(mode)) {
+				std::printf("  %-12s batching unavailable on this platform\n", name_of(mode));
+				continue;
+			}
+			double sending = send_rate(loopback, payload, rounds);
+			double receiving = receive_rate(loopback, payload, rounds / 4 > 0 ? rounds / 4 : 1);
+			std::printf("  %-12s send %10.0f datagrams/s, receive %10.0f datagrams/s\n", name_of(mode), sending, receiving);
+		}
+	}
+
+	loopback.set_mode(Mode::STOCK);
+	enet_deinitialize();
+	return 0;
+}
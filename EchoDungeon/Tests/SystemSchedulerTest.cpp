@@ -0,0 +1,150 @@
+#include "Imports/common.h"
+#include "Game/World/Systems/SystemScheduler.h"
+#include "TestCheck.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checks that SystemScheduler runs each system at its rate (clamped to every tick), also
+ * when the rate does not divide the tick rate, that phases put systems on the ticks others leave
+ * free, the delta times systems are given, and that writers run before readers on a shared tick.
+ */
+
+namespace {
+	struct Runs {
+		std::vector<uint64_t> ticks; // Ticks the system ran on
+		std::vector<float> delta_times;
+	};
+
+	uint64_t current_tick = 0;
+
+	SystemScheduler::Run record(Runs& runs) {
+		return [&runs](float delta_time) {
+			runs.ticks.push_back(current_tick);
+			runs.delta_times.push_back(delta_time);
+		};
+	}
+
+	void run_ticks(SystemScheduler& scheduler, uint64_t count) {
+		for (current_tick = 0; current_tick < count; current_tick++) {
+			scheduler.run_tick(current_tick);
+		}
+	}
+
+	float period_of(const SystemScheduler& scheduler, const std::string& name) {
+		for (const SystemStats& stats : scheduler.get_stats()) {
+			if (stats.name == name) return stats.period;
+		}
+		return 0.0f;
+	}
+
+	size_t shared_ticks(const Runs& a, const Runs& b) {
+		size_t shared = 0;
+		for (uint64_t tick : a.ticks) {
+			for (uint64_t other : b.ticks) {
+				if (tick == other) shared++;
+			}
+		}
+		return shared;
+	}
+
+	void test_periods() {
+		SystemScheduler scheduler;
+		Runs unused;
+		scheduler.add_system("slow", 2.0f, 0, 0, 0, record(unused));
+		scheduler.add_system("uneven", 20.0f, 0, 0, 0, record(unused)); // 1.5 ticks
+		scheduler.add_system("too_fast", 60.0f, 0, 0, 0, record(unused)); // Clamped, with a warning
+		scheduler.add_system("every_tick", SystemScheduler::EVERY_TICK, 0, 0, 0, record(unused));
+		scheduler.set_tick_rate(30);
+
+		CHECK(period_of(scheduler, "slow") == 15.0f);
+		CHECK(period_of(scheduler, "uneven") == 1.5f);
+		CHECK(period_of(scheduler, "too_fast") == 1.0f);
+		CHECK(period_of(scheduler, "every_tick") == 1.0f);
+
+		scheduler.set_tick_rate(60);
+		CHECK(period_of(scheduler, "slow") == 30.0f);
+		CHECK(period_of(scheduler, "uneven") == 3.0f);
+		CHECK(period_of(scheduler, "too_fast") == 1.0f);
+	}
+
+	// Rates that do not divide the tick rate still run exactly that often each second, evenly spaced
+	void test_uneven_rates() {
+		for (float rate : { 7.0f, 12.0f, 20.0f, 25.0f }) {
+			SystemScheduler scheduler;
+			Runs runs;
+			scheduler.add_system("uneven", rate, 0, 0, 0, record(runs));
+			scheduler.set_tick_rate(30);
+			run_ticks(scheduler, 300);
+
+			std::string name = std::to_string(static_cast<int>(rate)) + "Hz";
+			CHECK_MESSAGE(runs.ticks.size() == static_cast<size_t>(rate) * 10, name);
+
+			float period = 30.0f / rate;
+			float total_time = 0.0f;
+			for (size_t i = 1; i < runs.ticks.size(); i++) {
+				uint64_t gap = runs.ticks[i] - runs.ticks[i - 1];
+				CHECK_MESSAGE(gap == static_cast<uint64_t>(std::floor(period)) || gap == static_cast<uint64_t>(std::ceil(period)), name);
+				CHECK_MESSAGE(std::fabs(runs.delta_times[i] - gap / 30.0f) < 1e-6f, name);
+				total_time += runs.delta_times[i];
+			}
+			// Delta times add up to the time between the first and last runs
+			CHECK_MESSAGE(std::fabs(total_time - (runs.ticks.back() - runs.ticks.front()) / 30.0f) < 1e-4f, name);
+		}
+	}
+
+	// The server's layout: 30 Hz replication, 20 Hz AI, 2 Hz spawning and physics every tick
+	void test_server_layout(int tick_rate) {
+		SystemScheduler scheduler;
+		Runs spawning, ai, physics, replication;
+		scheduler.add_system("spawning", 2.0f, 29, WORLD_PLAYERS, WORLD_ENEMIES | WORLD_NETWORK, record(spawning));
+		scheduler.add_system("ai", 20.0f, 0, WORLD_PLAYERS, WORLD_ENEMIES, record(ai));
+		scheduler.add_system("physics", SystemScheduler::EVERY_TICK, 0, WORLD_ENEMIES, WORLD_ENEMIES, record(physics));
+		scheduler.add_system("replication", 30.0f, 0, WORLD_ENEMIES, WORLD_NETWORK, record(replication));
+		scheduler.set_tick_rate(tick_rate);
+
+		run_ticks(scheduler, static_cast<uint64_t>(tick_rate) * 2);
+
+		std::string rate = std::to_string(tick_rate) + "Hz";
+		CHECK_MESSAGE(spawning.ticks.size() == 4 && ai.ticks.size() == 40 && replication.ticks.size() == 60, rate);
+		CHECK_MESSAGE(physics.ticks.size() == static_cast<size_t>(tick_rate) * 2, rate);
+		CHECK_MESSAGE(shared_ticks(spawning, ai) == 0, rate);
+		if (tick_rate == 60) {
+			CHECK_MESSAGE(shared_ticks(spawning, replication) == 0, rate);
+			CHECK_MESSAGE(shared_ticks(ai, replication) == 20, rate); // One tick in six
+		}
+
+		for (float delta_time : physics.delta_times) {
+			CHECK_MESSAGE(std::fabs(delta_time - 1.0f / tick_rate) < 1e-6f, rate);
+		}
+		for (float delta_time : replication.delta_times) {
+			CHECK_MESSAGE(std::fabs(delta_time - 1.0f / 30.0f) < 1e-6f, rate);
+		}
+	}
+
+	void test_writers_run_first() {
+		SystemScheduler scheduler;
+		std::vector<std::string> order;
+		scheduler.add_system("reader", SystemScheduler::EVERY_TICK, 0, WORLD_ENEMIES, WORLD_NETWORK,
+			[&order](float) { order.push_back("reader"); });
+		scheduler.add_system("writer", SystemScheduler::EVERY_TICK, 0, 0, WORLD_ENEMIES,
+			[&order](float) { order.push_back("writer"); });
+		scheduler.set_tick_rate(30);
+
+		scheduler.run_tick(0);
+		CHECK(order.size() == 2 && order[0] == "writer" && order[1] == "reader");
+	}
+}
+
+int main() {
+	Logger::init();
+
+	test_periods();
+	test_uneven_rates();
+	test_server_layout(30);
+	test_server_layout(60);
+	test_writers_run_first();
+
+	return TestCheck::result();
+}
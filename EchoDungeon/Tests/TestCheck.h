@@ -0,0 +1,33 @@
+#pragma once
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Minimal checks for the test executables run by ctest (see Tests/CMakeLists.txt).
+ * A failed CHECK prints where it failed and the test carries on, main returns
+ * TestCheck::result() so the test exits non-zero if any check failed.
+ */
+namespace TestCheck {
+	inline int failures = 0; // Failed checks so far
+
+	inline void fail(const char* file, int line, const std::string& what) {
+		failures++;
+		std::cerr << file << ":" << line << ": CHECK failed: " << what << std::endl;
+	}
+
+	inline int result() {
+		if (failures > 0) {
+			std::cerr << failures << " checks failed" << std::endl;
+			return 1;
+		}
+		std::cout << "All checks passed" << std::endl;
+		return 0;
+	}
+}
+
+#define CHECK(condition) \
+	do { if (!(condition)) TestCheck::fail(__FILE__, __LINE__, #condition); } while (false)
+
+// CHECK with extra context (eg the value or packet that failed) in the failure message
+#define CHECK_MESSAGE(condition, message) \
+	do { if (!(condition)) TestCheck::fail(__FILE__, __LINE__, std::string(#condition) + " (" + (message) + ")"); } while (false)
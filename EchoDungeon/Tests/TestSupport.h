@@ -0,0 +1,54 @@
+#pragma once
+#include "Imports/common.h"
+#include "Networking/NetworkConstants.h"
+#include <chrono>
+
+/**
+ * @brief Helpers shared by the tests and benchmarks: timing, and ENet hosts and addresses on
+ * the loopback interface (::1) with a port the OS picks, so runs never clash over a fixed port.
+ */
+namespace TestSupport {
+	using Clock = std::chrono::steady_clock;
+
+	// Time passed since since, in the unit the name says
+	inline double elapsed_s(Clock::time_point since) {
+		return std::chrono::duration<double>(Clock::now() - since).count();
+	}
+
+	inline double elapsed_ms(Clock::time_point since) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+	}
+
+	inline double elapsed_us(Clock::time_point since) {
+		return std::chrono::duration<double, std::micro>(Clock::now() - since).count();
+	}
+
+	inline double elapsed_ns(Clock::time_point since) {
+		return std::chrono::duration<double, std::nano>(Clock::now() - since).count();
+	}
+
+	// ::1 at port, 0 lets the OS pick one when binding
+	inline ENetAddress loopback(enet_uint16 port) {
+		ENetAddress address{};
+		enet_address_set_host_ip(&address, "::1");
+		address.port = port;
+		return address;
+	}
+
+	// Where to reach a socket bound on loopback. The socket reports its port, not a host to send to
+	inline ENetAddress address_of(ENetSocket socket) {
+		ENetAddress address{};
+		enet_socket_get_address(socket, &address);
+		return loopback(address.port);
+	}
+
+	inline ENetAddress address_of(ENetHost* host) {
+		return address_of(host->socket);
+	}
+
+	// An ENet host on loopback with room for peers connections, nullptr if it could not be created
+	inline ENetHost* create_host(size_t peers = 1) {
+		ENetAddress address = loopback(0);
+		return enet_host_create(&address, peers, NetworkConstants::MAX_CHANNELS, 0, 0);
+	}
+}
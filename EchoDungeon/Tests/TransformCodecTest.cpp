@@ -0,0 +1,153 @@
+#include "Imports/common.h"
+#include "Networking/Packet/TransformCodec.h"
+#include "TestCheck.h"
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Checks TransformCodec's error bounds: positions inside the level bounds come back
+ * within half a step (1/2048 of a unit), yaws within half a yaw step however far they have
+ * wound, and out of range or non-finite values map to defined steps.
+ */
+
+namespace {
+	constexpr float MAX_POSITION_ERROR = TransformCodec::POSITION_STEP / 2.0f; // 1/2048
+	constexpr float MAX_YAW_ERROR = TransformCodec::YAW_STEP / 2.0f;
+	constexpr float FLOAT_SLACK = 1e-5f; // Rounding of the float arithmetic itself, well below a step
+	constexpr float YAW_SLACK = 1e-4f; // Same for yaws, which are wrapped through a division first
+
+	// Distance between two angles in degrees, the short way round
+	float angle_between(float a, float b) {
+		float difference = std::fmod(std::fabs(a - b), 360.0f);
+		return (std::min)(difference, 360.0f - difference);
+	}
+
+	// Sweeps one axis in steps that do not line up with the codec's, so every offset within a step is hit
+	float worst_position_error(float min, float max) {
+		float worst = 0.0f;
+		for (int i = 0; ; i++) {
+			float value = min + static_cast<float>(i) * 0.000731f;
+			if (value > max) break;
+
+			float decoded = TransformCodec::dequantize_position(TransformCodec::quantize_position(value, min), min);
+			worst = (std::max)(worst, std::fabs(decoded - value));
+		}
+		return worst;
+	}
+
+	void test_position_error_bound() {
+		float worst_x = worst_position_error(TransformCodec::MIN_X, TransformCodec::MAX_X);
+		float worst_y = worst_position_error(TransformCodec::MIN_Y, TransformCodec::MAX_Y);
+		float worst_z = worst_position_error(TransformCodec::MIN_Z, TransformCodec::MAX_Z);
+		CHECK_MESSAGE(worst_x <= MAX_POSITION_ERROR + FLOAT_SLACK, std::to_string(worst_x));
+		CHECK_MESSAGE(worst_y <= MAX_POSITION_ERROR + FLOAT_SLACK, std::to_string(worst_y));
+		CHECK_MESSAGE(worst_z <= MAX_POSITION_ERROR + FLOAT_SLACK, std::to_string(worst_z));
+
+		// The bound is tight, a value halfway between two steps is off by the full half step
+		float halfway = TransformCodec::MIN_X + 100.5f * TransformCodec::POSITION_STEP;
+		float decoded = TransformCodec::dequantize_position(
+			TransformCodec::quantize_position(halfway, TransformCodec::MIN_X), TransformCodec::MIN_X);
+		CHECK(std::fabs(std::fabs(decoded - halfway) - MAX_POSITION_ERROR) <= FLOAT_SLACK);
+
+		// The border walls' outside faces are inside the bounds, so they are not clamped
+		for (float wall : { -LevelGenerator::OUTER_EXTENT, LevelGenerator::OUTER_EXTENT }) {
+			float wall_x = TransformCodec::dequantize_position(
+				TransformCodec::quantize_position(wall, TransformCodec::MIN_X), TransformCodec::MIN_X);
+			CHECK(std::fabs(wall_x - wall) <= MAX_POSITION_ERROR);
+		}
+	}
+
+	void test_position_clamping() {
+		CHECK(TransformCodec::quantize_position(-1000.0f, TransformCodec::MIN_X) == 0);
+		CHECK(TransformCodec::quantize_position(1000.0f, TransformCodec::MIN_X) == 65535);
+		CHECK(TransformCodec::quantize_position(TransformCodec::MIN_X, TransformCodec::MIN_X) == 0);
+		CHECK(TransformCodec::quantize_position(TransformCodec::MAX_X, TransformCodec::MIN_X) == 65535);
+
+		CHECK(TransformCodec::quantize_position(std::numeric_limits<float>::quiet_NaN(), TransformCodec::MIN_X) == 0);
+		CHECK(TransformCodec::quantize_position(std::numeric_limits<float>::infinity(), TransformCodec::MIN_X) == 65535);
+		CHECK(TransformCodec::quantize_position(-std::numeric_limits<float>::infinity(), TransformCodec::MIN_X) == 0);
+
+		// The batch version agrees with the scalar one, non-finite values included
+		float values[] = { 0.0f, std::numeric_limits<float>::quiet_NaN(), 31.99f, -std::numeric_limits<float>::infinity() };
+		uint16_t quantized[4];
+		TransformCodec::quantize_positions(values, quantized, 4, TransformCodec::MIN_Z);
+		for (size_t i = 0; i < 4; i++) {
+			CHECK(quantized[i] == TransformCodec::quantize_position(values[i], TransformCodec::MIN_Z));
+		}
+	}
+
+	void test_yaw_wrap() {
+		CHECK(TransformCodec::quantize_yaw(0.0f) == 0);
+		CHECK(TransformCodec::quantize_yaw(360.0f) == 0);
+		CHECK(TransformCodec::quantize_yaw(-360.0f) == 0);
+		CHECK(TransformCodec::quantize_yaw(720.0f) == 0);
+		CHECK(TransformCodec::quantize_yaw(-90.0f) == TransformCodec::quantize_yaw(270.0f));
+		CHECK(TransformCodec::quantize_yaw(450.0f) == TransformCodec::quantize_yaw(90.0f));
+		CHECK(TransformCodec::quantize_yaw(180.0f) == 32768);
+
+		// Just under a full turn rounds up to the next step, which wraps to 0 rather than overflowing
+		CHECK(TransformCodec::quantize_yaw(360.0f - TransformCodec::YAW_STEP / 4.0f) == 0);
+		CHECK(TransformCodec::quantize_yaw(-TransformCodec::YAW_STEP / 4.0f) == 0);
+
+		// Dequantized yaws are always in [0, 360)
+		CHECK(TransformCodec::dequantize_yaw(0) == 0.0f);
+		CHECK(TransformCodec::dequantize_yaw(65535) < 360.0f);
+
+		float worst = 0.0f;
+		for (int i = 0; ; i++) {
+			float degrees = -720.0f + static_cast<float>(i) * 0.00317f;
+			if (degrees > 720.0f) break;
+
+			float decoded = TransformCodec::dequantize_yaw(TransformCodec::quantize_yaw(degrees));
+			worst = (std::max)(worst, angle_between(decoded, degrees));
+		}
+		CHECK_MESSAGE(worst <= MAX_YAW_ERROR + YAW_SLACK, std::to_string(worst));
+
+		CHECK(TransformCodec::quantize_yaw(std::numeric_limits<float>::quiet_NaN()) == 0);
+		CHECK(TransformCodec::quantize_yaw(std::numeric_limits<float>::infinity()) == 0);
+		CHECK(TransformCodec::quantize_yaw(-std::numeric_limits<float>::infinity()) == 0);
+		CHECK(TransformCodec::quantize_yaw(1e30f) == 0); // Any finite value is a whole number of turns up there
+	}
+
+	// QuantizedTransform sends only position and yaw, the rest of the receiver's transform stays as spawned
+	void test_quantized_transform() {
+		ObjectTransform sent;
+		sent.set_position({ 1.2345f, 0.5f, -20.001f });
+		sent.set_rotation({ 10.0f, -123.4f, 5.0f });
+
+		PacketBuffer buffer;
+		{
+			BitPacketOutputArchive archive(buffer);
+			archive(QuantizedTransform(sent));
+			archive.flush();
+		}
+		CHECK(buffer.size() == 8);
+
+		ObjectTransform received;
+		received.set_rotation({ 1.0f, 0.0f, 2.0f });
+		received.set_scale({ 3.0f, 3.0f, 3.0f });
+		BitPacketInputArchive archive(buffer.data(), buffer.size());
+		archive(QuantizedTransform(received));
+
+		raylib::Vector3 position = received.get_position();
+		CHECK(std::fabs(position.x - 1.2345f) <= MAX_POSITION_ERROR + FLOAT_SLACK);
+		CHECK(std::fabs(position.y - 0.5f) <= MAX_POSITION_ERROR + FLOAT_SLACK);
+		CHECK(std::fabs(position.z + 20.001f) <= MAX_POSITION_ERROR + FLOAT_SLACK);
+
+		raylib::Vector3 rotation = received.get_rotation();
+		CHECK(angle_between(rotation.y, -123.4f) <= MAX_YAW_ERROR + YAW_SLACK);
+		CHECK(rotation.x == 1.0f && rotation.z == 2.0f);
+		CHECK(received.get_scale().x == 3.0f);
+	}
+}
+
+int main() {
+	Logger::init();
+
+	test_position_error_bound();
+	test_position_clamping();
+	test_yaw_wrap();
+	test_quantized_transform();
+
+	return TestCheck::result();
+}
@@ -0,0 +1,200 @@
+#include "JobSystem.h"
+#include "Imports/common.h"
+
+namespace {
+	// The JobSystem whose worker is running on this thread, and which worker it is
+	thread_local const JobSystem* current_system = nullptr;
+	thread_local size_t current_worker = 0;
+
+	// Runs one chunk, logging instead of propagating exceptions so the caller and the other chunks carry on
+	void run_chunk(const JobSystem::RangeJob& job, size_t begin, size_t end) {
+		try {
+			job(begin, end);
+		}
+		catch (const std::exception& e) {
+			ERROR(std::string("Parallel job threw an exception: ") + e.what());
+		}
+	}
+
+	// One parallel_for call's chunks, handed out one at a time to its caller and to the workers that took its tickets
+	class JobGroup {
+	public:
+		JobGroup(const JobSystem::RangeJob& job, size_t count, size_t grain)
+			: job(job), count(count), grain(grain), chunks((count + grain - 1) / grain), unfinished(chunks) {}
+
+		// Claim and run the next chunk, or return false if every chunk is already claimed
+		bool run_next() {
+			size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+			if (chunk >= chunks) return false;
+
+			size_t begin = chunk * grain;
+			run_chunk(job, begin, (std::min)(begin + grain, count));
+			if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				std::lock_guard<std::mutex> lock(mutex);
+				finished.notify_all();
+			}
+			return true;
+		}
+
+		// Block until every chunk has run, once none are left to claim
+		void wait() {
+			std::unique_lock<std::mutex> lock(mutex);
+			finished.wait(lock, [this]() { return unfinished.load(std::memory_order_acquire) == 0; });
+		}
+
+	private:
+		const JobSystem::RangeJob& job; // Only called while chunks are unclaimed, so before the caller returns
+		size_t count;
+		size_t grain;
+		size_t chunks;
+		std::atomic<size_t> next_chunk = 0;
+		std::atomic<size_t> unfinished; // Chunks not yet run to the end
+		std::mutex mutex; // Lets the caller sleep on finished
+		std::condition_variable finished;
+	};
+}
+
+/**
+ * @brief Starts the workers, each with an empty queue.
+ * @param worker_count The number of workers. With none, parallel_for runs its whole range inline.
+ */
+JobSystem::JobSystem(size_t worker_count) {
+	queues.reserve(worker_count);
+	for (size_t i = 0; i < worker_count; i++) {
+		queues.push_back(std::make_unique<JobQueue>());
+	}
+
+	workers.reserve(worker_count);
+	for (size_t i = 0; i < worker_count; i++) {
+		workers.emplace_back(&JobSystem::worker_loop, this, i);
+	}
+}
+
+/**
+ * @brief Lets the workers finish every queued job, then joins them.
+ */
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stopping = true;
+	}
+	job_available.notify_all();
+
+	for (std::thread& worker : workers) {
+		if (worker.joinable()) worker.join();
+	}
+}
+
+/**
+ * @brief Gets the job system shared by every world in the process, started on first use.
+ * The thread calling parallel_for works too, so one thread per core is left for it.
+ * @return The shared job system.
+ */
+JobSystem& JobSystem::shared() {
+	static JobSystem system((std::max)(1u, std::thread::hardware_concurrency()) - 1);
+	return system;
+}
+
+/**
+ * @brief Runs job over [0, count) in chunks of at most grain items, spread over the workers and the
+ * calling thread, and returns once every chunk has run. The calling thread only runs this call's
+ * chunks, never other callers' (eg another room's tick), and sleeps once the rest are running elsewhere.
+ * Chunks may run in any order and at once, so job must only touch state owned by the items in its
+ * chunk, or read state nothing writes.
+ * @param count The number of items.
+ * @param grain Items per chunk. Too small and queueing costs more than the work; too large and
+ * the last chunks leave threads idle.
+ * @param job Runs the items from begin up to (not including) end. An exception it throws is logged,
+ * and ends only its own chunk, whether the chunk runs inline or on a worker.
+ */
+void JobSystem::parallel_for(size_t count, size_t grain, const RangeJob& job) {
+	if (count == 0) return;
+	if (grain == 0) grain = 1;
+
+	size_t chunks = (count + grain - 1) / grain;
+	if (queues.empty() || chunks == 1) {
+		run_chunk(job, 0, count);
+		return;
+	}
+
+	// Tickets in the queues outlive the call when the caller claims the last chunks itself, so they share the group
+	auto group = std::make_shared<JobGroup>(job, count, grain);
+
+	// A ticket per worker that could help, each running the group's chunks until none are left
+	bool is_worker = current_system == this;
+	size_t tickets = (std::min)(chunks - 1, queues.size());
+	for (size_t i = 0; i < tickets; i++) {
+		// Spread the tickets from an outside thread over every queue, a worker keeps its own and lets the others steal
+		size_t queue_index = is_worker ? current_worker : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+		push(queue_index, [group]() { while (group->run_next()) {} });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+	}
+	job_available.notify_all();
+
+	// Help with this call's chunks only, then sleep until the ones running elsewhere are done
+	while (group->run_next()) {}
+	group->wait();
+}
+
+/**
+ * @brief Adds a job to the back of a queue.
+ * @param queue_index The queue.
+ * @param job The job.
+ */
+void JobSystem::push(size_t queue_index, Job job) {
+	JobQueue& queue = *queues[queue_index];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(std::move(job));
+	}
+	queued_jobs.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Runs the newest job in a queue or, if it is empty, the oldest job of the first other queue with any.
+ * @param queue_index The queue to take from first.
+ * @return Whether a job was run.
+ */
+bool JobSystem::run_one(size_t queue_index) {
+	Job job;
+
+	{
+		JobQueue& own = *queues[queue_index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			job = std::move(own.jobs.back());
+			own.jobs.pop_back();
+		}
+	}
+
+	for (size_t i = 1; !job && i < queues.size(); i++) {
+		JobQueue& victim = *queues[(queue_index + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+		}
+	}
+
+	if (!job) return false;
+
+	queued_jobs.fetch_sub(1, std::memory_order_acq_rel);
+	job();
+	return true;
+}
+
+void JobSystem::worker_loop(size_t index) {
+	current_system = this;
+	current_worker = index;
+
+	while (true) {
+		if (run_one(index)) continue;
+
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		job_available.wait(lock, [this]() { return stopping || queued_jobs.load(std::memory_order_acquire) > 0; });
+		if (stopping && queued_jobs.load(std::memory_order_acquire) == 0) return; // Stopping, and nothing left to run
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing worker threads for splitting one tick's loops (eg over every enemy) across cores.
+ *
+ * Each worker owns a deque of jobs: it takes jobs from the back of its own deque and, once that is
+ * empty, steals from the front of the others'. parallel_for() cuts a range into chunks and deals
+ * tickets for them out over the deques; a worker running a ticket claims that call's chunks until none
+ * are left. The calling thread claims chunks of its own call too, so several rooms' simulation threads
+ * can share one JobSystem without one room's tick running another's chunks.
+ */
+class JobSystem {
+public:
+	using Job = std::function<void()>;
+	using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+	explicit JobSystem(size_t worker_count); // 0 workers runs everything on the calling thread
+	~JobSystem(); // Runs every job already queued, then joins the workers
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	static JobSystem& shared(); // One worker per hardware thread besides the caller's
+
+	void parallel_for(size_t count, size_t grain, const RangeJob& job); // job(begin, end) over [0, count), grain items at a time
+	size_t get_worker_count() const { return workers.size(); }
+
+private:
+	struct JobQueue {
+		std::deque<Job> jobs; // Owner works from the back, thieves from the front
+		std::mutex mutex; // Guards jobs
+	};
+
+	std::vector<std::unique_ptr<JobQueue>> queues; // One per worker
+	std::vector<std::thread> workers;
+	std::atomic<size_t> queued_jobs = 0; // Jobs waiting in any queue
+	std::atomic<size_t> next_queue = 0; // Queue for the next chunk from a thread that is not a worker
+	std::mutex sleep_mutex; // Guards stopping, and lets idle workers sleep on job_available
+	std::condition_variable job_available;
+	bool stopping = false;
+
+	void push(size_t queue_index, Job job);
+	bool run_one(size_t queue_index); // Run a job from queue_index, or one stolen from another queue
+	void worker_loop(size_t index);
+};
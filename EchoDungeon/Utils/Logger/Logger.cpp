@@ -57,6 +57,17 @@ void Logger::log(spdlog::level::level_enum level, const std::string& message) {
 	spdlog::default_logger()->flush();
 }
 
+/**
+ * @brief Checks whether a message at a level would be logged, so callers can skip building it.
+ *
+ * @param level The level of the message
+ * @return true if the message would be logged (always true before init, so log() still reports the misuse)
+ */
+bool Logger::should_log(spdlog::level::level_enum level) {
+	if (!is_initialised) return true;
+	return spdlog::default_logger_raw()->should_log(level);
+}
+
 /**
  * @brief Generates a log filename based on current day and time
  *
@@ -67,7 +78,11 @@ std::string Logger::generate_filename() {
 	auto now = std::chrono::system_clock::now();
 	std::time_t now_c = std::chrono::system_clock::to_time_t(now);
 	std::tm tm_buf;
+#ifdef _WIN32
 	localtime_s(&tm_buf, &now_c);
+#else
+	localtime_r(&now_c, &tm_buf);
+#endif
 
 	// Format as YYYY_MM_DD_HH-MM-SS.log
 	std::ostringstream oss;
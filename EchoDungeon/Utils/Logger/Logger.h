@@ -12,6 +12,7 @@ public:
 	static void init(); // Initialise logger, set up files and sinks and allow logging
 
 	static void log(spdlog::level::level_enum level, const std::string& message); // Log a message with a specific level
+	static bool should_log(spdlog::level::level_enum level); // Whether a message at this level would be logged
 
 private:
 	static std::string folder_name; // Folder to store log files in
@@ -24,8 +25,12 @@ private:
 #define ADD_FUNCHEADER_TO_MSG(message) \
     (std::string("[") + __FUNCTION__ + "] [" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())).substr(0, 5) + "] " + (message))
 
-#define CRITICAL(message) Logger::log(spdlog::level::critical, ADD_FUNCHEADER_TO_MSG(message))
-#define TRACE(message) Logger::log(spdlog::level::trace, ADD_FUNCHEADER_TO_MSG(message))
-#define INFO(message) Logger::log(spdlog::level::info, ADD_FUNCHEADER_TO_MSG(message))
-#define WARNING(message) Logger::log(spdlog::level::warn, ADD_FUNCHEADER_TO_MSG(message))
-#define ERROR(message) Logger::log(spdlog::level::err, ADD_FUNCHEADER_TO_MSG(message))
\ No newline at end of file
+// The message is only built if it will be logged, so disabled levels (eg TRACE on hot paths) cost nothing
+#define LOG_AT_LEVEL(level, message) \
+    do { if (Logger::should_log(level)) Logger::log(level, ADD_FUNCHEADER_TO_MSG(message)); } while (false)
+
+#define CRITICAL(message) LOG_AT_LEVEL(spdlog::level::critical, message)
+#define TRACE(message) LOG_AT_LEVEL(spdlog::level::trace, message)
+#define INFO(message) LOG_AT_LEVEL(spdlog::level::info, message)
+#define WARNING(message) LOG_AT_LEVEL(spdlog::level::warn, message)
+#define ERROR(message) LOG_AT_LEVEL(spdlog::level::err, message)
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <utility>
+
+/**
+ * @brief Unbounded lock-free multi-producer single-consumer queue.
+ *
+ * Any number of threads may push(), only one thread may pop(). Pushing is a single atomic
+ * exchange, so producers never block each other or the consumer. Items pop in the order
+ * their pushes completed; items from one producer keep that producer's order.
+ *
+ * Intrusive linked list with a stub node (Dmitry Vyukov's MPSC queue). pop() can briefly
+ * report empty while a push is half done; the item is then returned by a later pop().
+ *
+ * Popped nodes go onto a free list that push() takes them back from, so once the queue has
+ * grown to its usual depth pushing allocates nothing. Only one producer at a time takes from
+ * the free list; one that finds another already taking allocates a node instead of waiting.
+ */
+template<class T>
+class MpscQueue {
+public:
+	MpscQueue() : head(&stub), tail(&stub) {}
+
+	~MpscQueue() {
+		T item;
+		while (pop(item)) {}
+		for (Node* node = free_nodes.load(std::memory_order_acquire); node != nullptr;) {
+			Node* next = node->next.load(std::memory_order_relaxed);
+			delete node;
+			node = next;
+		}
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	// Adds an item. Safe to call from any thread.
+	void push(T value) {
+		Node* node = take_free_node();
+		if (node == nullptr) node = new Node();
+		node->value = std::move(value);
+		push_node(node);
+	}
+
+	// Removes the oldest item into out. Only one thread may pop. Returns false if the queue is empty.
+	bool pop(T& out) {
+		Node* node = tail;
+		Node* next = node->next.load(std::memory_order_acquire);
+
+		// Skip over the stub
+		if (node == &stub) {
+			if (next == nullptr) return false;
+			tail = next;
+			node = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		if (next != nullptr) {
+			tail = next;
+			out = std::move(node->value);
+			free_node(node);
+			return true;
+		}
+
+		// node is the last item. If a producer has already swapped head, its link is not written yet.
+		if (node != head.load(std::memory_order_acquire)) return false;
+
+		// Put the stub back behind the last item so it can be taken out
+		push_node(&stub);
+		next = node->next.load(std::memory_order_acquire);
+		if (next != nullptr) {
+			tail = next;
+			out = std::move(node->value);
+			free_node(node);
+			return true;
+		}
+		return false;
+	}
+
+private:
+	struct Node {
+		std::atomic<Node*> next{ nullptr };
+		T value{};
+	};
+
+	void push_node(Node* node) {
+		node->next.store(nullptr, std::memory_order_relaxed);
+		Node* previous = head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+
+	// Pops the newest free node, nullptr if there is none or another producer is taking one.
+	// With one taker at a time a node cannot leave and come back mid-pop, so the exchange is ABA free.
+	Node* take_free_node() {
+		if (free_taker.test_and_set(std::memory_order_acquire)) return nullptr;
+		Node* node = free_nodes.load(std::memory_order_acquire);
+		while (node != nullptr && !free_nodes.compare_exchange_weak(node, node->next.load(std::memory_order_relaxed),
+			std::memory_order_acquire, std::memory_order_acquire)) {}
+		free_taker.clear(std::memory_order_release);
+		return node;
+	}
+
+	// Pushes a popped node onto the free list (consumer only)
+	void free_node(Node* node) {
+		Node* top = free_nodes.load(std::memory_order_relaxed);
+		do {
+			node->next.store(top, std::memory_order_relaxed);
+		} while (!free_nodes.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	Node stub; // Placeholder that keeps the list non-empty
+	std::atomic<Node*> head; // Newest node, producers swap themselves in here
+	Node* tail; // Oldest node, only touched by the consumer
+	std::atomic<Node*> free_nodes{ nullptr }; // Popped nodes ready for reuse, linked through next
+	std::atomic_flag free_taker = ATOMIC_FLAG_INIT; // Set while a producer takes from free_nodes
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief Bounded lock-free single-producer single-consumer ring buffer.
+ *
+ * One thread may push(), one (other) thread may pop(). Each side only writes its own index,
+ * so neither side ever waits on the other; push() fails when the ring is full.
+ * Capacity must be a power of two.
+ */
+template<class T, size_t Capacity>
+class SpscRing {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+	SpscRing() = default;
+	SpscRing(const SpscRing&) = delete;
+	SpscRing& operator=(const SpscRing&) = delete;
+
+	// Adds an item. Producer thread only. Returns false (and leaves value untouched) if the ring is full.
+	bool push(T& value) {
+		size_t write = write_index.load(std::memory_order_relaxed);
+		if (write - read_index.load(std::memory_order_acquire) == Capacity) return false;
+
+		slots[write & (Capacity - 1)] = std::move(value);
+		write_index.store(write + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Removes the oldest item into out. Consumer thread only. Returns false if the ring is empty.
+	bool pop(T& out) {
+		size_t read = read_index.load(std::memory_order_relaxed);
+		if (read == write_index.load(std::memory_order_acquire)) return false;
+
+		out = std::move(slots[read & (Capacity - 1)]);
+		slots[read & (Capacity - 1)] = T(); // Release whatever the item held now, not when the slot is reused
+		read_index.store(read + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	std::array<T, Capacity> slots{};
+	alignas(64) std::atomic<size_t> write_index{ 0 }; // Next slot to write, only stored by the producer
+	alignas(64) std::atomic<size_t> read_index{ 0 }; // Next slot to read, only stored by the consumer
+};
@@ -0,0 +1,63 @@
+#include "ThreadPool.h"
+#include "Imports/common.h"
+
+/**
+ * @brief Starts the worker threads.
+ * @param thread_count The number of workers, at least one is always started.
+ */
+ThreadPool::ThreadPool(size_t thread_count) {
+	if (thread_count == 0) thread_count = 1;
+
+	workers.reserve(thread_count);
+	for (size_t i = 0; i < thread_count; i++) {
+		workers.emplace_back(&ThreadPool::worker_loop, this);
+	}
+}
+
+/**
+ * @brief Lets the workers finish every submitted task, then joins them.
+ */
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	task_available.notify_all();
+
+	for (std::thread& worker : workers) {
+		if (worker.joinable()) worker.join();
+	}
+}
+
+/**
+ * @brief Queues a task to run on the next free worker.
+ * @param task The task to run.
+ */
+void ThreadPool::submit(Task task) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	task_available.notify_one();
+}
+
+void ThreadPool::worker_loop() {
+	while (true) {
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			task_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (tasks.empty()) return; // Stopping, and nothing left to run
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+
+		try {
+			task();
+		}
+		catch (const std::exception& e) {
+			ERROR(std::string("Thread pool task threw an exception: ") + e.what());
+		}
+	}
+}
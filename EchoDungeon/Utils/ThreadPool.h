@@ -0,0 +1,35 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running submitted tasks in submission order.
+ * Threads are started once, so submitting a task costs a queue push and a wake-up
+ * rather than creating (and joining) a thread.
+ */
+class ThreadPool {
+public:
+	using Task = std::function<void()>;
+
+	explicit ThreadPool(size_t thread_count); // Starts thread_count workers (at least one)
+	~ThreadPool(); // Runs every task already submitted, then joins the workers
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void submit(Task task); // Queue a task for the next free worker
+	size_t size() const { return workers.size(); }
+
+private:
+	std::vector<std::thread> workers;
+	std::deque<Task> tasks; // Waiting tasks, oldest first
+	std::mutex mutex; // Guards tasks and stopping
+	std::condition_variable task_available;
+	bool stopping = false;
+
+	void worker_loop();
+};
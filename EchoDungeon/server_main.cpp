@@ -0,0 +1,33 @@
+#include <iostream>
+#include <atomic>
+#include <csignal>
+#include "Imports/common.h"
+#include "Game/DedicatedServer.h"
+
+// Set by SIGTERM and SIGINT, the server loop shuts down cleanly once it sees it
+static std::atomic<bool> stop_requested = false;
+static_assert(std::atomic<bool>::is_always_lock_free, "Signal handlers may only touch lock-free atomics");
+
+extern "C" void request_stop(int) {
+	stop_requested.store(true);
+}
+
+int main(int argc, char** argv)
+{
+	std::string error;
+	std::optional<DedicatedServerConfig> config = DedicatedServerConfig::parse(argc, argv, error);
+	if (!config.has_value()) {
+		if (error.empty()) { // --help
+			std::cout << DedicatedServerConfig::usage();
+			return 0;
+		}
+		std::cerr << error << "\n\n" << DedicatedServerConfig::usage();
+		return 2;
+	}
+
+	std::signal(SIGTERM, request_stop);
+	std::signal(SIGINT, request_stop);
+
+	DedicatedServer server(*config); // Create dedicated server instance
+	return server.run(stop_requested); // Serve until SIGTERM or SIGINT
+}